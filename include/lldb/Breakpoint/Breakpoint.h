@@ -12,6 +12,8 @@
 
 // C Includes
 // C++ Includes
+#include <vector>
+
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Breakpoint/BreakpointLocationList.h"
@@ -227,6 +229,26 @@ public:
                     bool load_event,
                     bool delete_locations = false);
 
+    //------------------------------------------------------------------
+    /// Tell a set of breakpoints that the modules in \a module_list were
+    /// loaded. This does the same thing as calling ModulesChanged() on
+    /// each breakpoint, but searches the modules in parallel, one task
+    /// per module, which is a lot faster when a process loads many
+    /// shared libraries at once. Only resolvers whose
+    /// BreakpointResolver::CanResolveModulesInParallel() returns true
+    /// are run in parallel, the others search the modules in order on
+    /// the calling thread. The breakpoint sites and the location IDs end
+    /// up the same as they would with ModulesChanged().
+    ///
+    /// @param[in] breakpoints
+    ///    The breakpoints to resolve in the new modules.
+    /// @param[in] module_list
+    ///    The list of modules that were loaded.
+    //------------------------------------------------------------------
+    static void
+    ModulesDidLoad (const std::vector<lldb::BreakpointSP> &breakpoints,
+                    ModuleList &module_list);
+
 
     //------------------------------------------------------------------
     /// Tells the breakpoint the old module \a old_module_sp has been
@@ -663,6 +685,24 @@ private:
     std::string m_kind_description;
     bool m_resolve_indirect_symbols;
     
+    //------------------------------------------------------------------
+    /// Set breakpoint sites for the locations we already have in the
+    /// modules of \a module_list, and find out which of the modules
+    /// this breakpoint still has to search.
+    ///
+    /// @param[in] module_list
+    ///    The list of loaded modules, the caller must hold its mutex.
+    /// @param[out] unseen_modules
+    ///    Filled with one entry per module in \a module_list, \b true
+    ///    if the module passes the filter and has no locations yet.
+    ///
+    /// @return
+    ///    The number of modules that need to be searched.
+    //------------------------------------------------------------------
+    size_t
+    ResolveSitesInLoadedModules (ModuleList &module_list,
+                                 std::vector<bool> &unseen_modules);
+
     void
     SendBreakpointChangedEvent (lldb::BreakpointEventType eventKind);
     
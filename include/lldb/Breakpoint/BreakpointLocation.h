@@ -26,6 +26,7 @@
 #include "lldb/Host/Mutex.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Expression/ClangUserExpression.h"
+#include "lldb/Expression/ConditionProgram.h"
 
 namespace lldb_private {
 
@@ -376,6 +377,7 @@ public:
     
 protected:
     friend class BreakpointLocationList;
+    friend class BreakpointSite;
     friend class Process;
 
     //------------------------------------------------------------------
@@ -397,6 +399,13 @@ protected:
     bool
     IgnoreCountShouldStop();
 
+    //------------------------------------------------------------------
+    /// Add \a count hits that never got as far as ShouldStop, see
+    /// BreakpointSite::BumpHitCounts.
+    //------------------------------------------------------------------
+    void
+    BumpHitCount (uint32_t count);
+
 private:
 
     //------------------------------------------------------------------
@@ -442,6 +451,8 @@ private:
     std::unique_ptr<BreakpointOptions> m_options_ap; ///< Breakpoint options pointer, NULL if we're using our breakpoint's options.
     lldb::BreakpointSiteSP m_bp_site_sp; ///< Our breakpoint site (it may be shared by more than one location.)
     ClangUserExpression::ClangUserExpressionSP m_user_expression_sp; ///< The compiled expression to use in testing our condition.
+    std::unique_ptr<ConditionProgram> m_condition_program_ap; ///< The condition compiled for evaluation without Clang, if it is simple enough.
+    size_t m_condition_program_hash; ///< The hash of the condition source code m_condition_program_ap was compiled from.
     Mutex m_condition_mutex; ///< Guards parsing and evaluation of the condition, which could be evaluated by multiple processes.
     size_t m_condition_hash; ///< For testing whether the condition source code changed.
 
@@ -243,6 +243,25 @@ protected:
     
     void
     StopRecordingNewLocations();
+
+    //------------------------------------------------------------------
+    /// While deferring, AddLocation() doesn't set breakpoint sites for
+    /// the locations it creates, so breakpoint resolvers can run on
+    /// several threads without touching the process. The caller must
+    /// call ResolveBreakpointSite() on the new locations afterwards.
+    //------------------------------------------------------------------
+    void
+    SetDeferSiteResolution (bool defer);
+
+    //------------------------------------------------------------------
+    /// Sort the locations from index \a start_idx on by the position of
+    /// their module in \a modules, keeping the order in which they were
+    /// added within each module, and renumber them to match. Locations
+    /// added from several threads get the same IDs as if they had been
+    /// added one module at a time.
+    //------------------------------------------------------------------
+    void
+    SortLocationsByModule (size_t start_idx, const ModuleList &modules);
     
     lldb::BreakpointLocationSP
     AddLocation (const Address &addr,
@@ -266,6 +285,7 @@ protected:
     mutable Mutex m_mutex;
     lldb::break_id_t m_next_id;
     BreakpointLocationCollection *m_new_location_recorder;
+    bool m_defer_site_resolution;
 };
 
 } // namespace lldb_private
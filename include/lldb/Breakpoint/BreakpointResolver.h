@@ -97,6 +97,58 @@ public:
     ResolveBreakpointInModules (SearchFilter &filter,
                                 ModuleList &modules);
 
+    //------------------------------------------------------------------
+    /// Breakpoint::ModulesDidLoad() searches a batch of newly loaded
+    /// modules with one task per module, so the same resolver can be
+    /// searching several modules on different threads at once. A resolver
+    /// that returns true here must follow these rules while it searches:
+    ///
+    /// @li It only reads the module it is given, its own settings and
+    ///     the filter, and doesn't keep any state from one search to the
+    ///     next.
+    /// @li It only adds locations through Breakpoint::AddLocation(),
+    ///     which is locked. Breakpoint sites are set afterwards on the
+    ///     calling thread.
+    /// @li It doesn't change the target, the process or its language
+    ///     runtimes, none of which are locked for this.
+    /// @li It doesn't search other modules than the one it is given.
+    ///     Work that needs other modules can be recorded, under a lock,
+    ///     and finished in DidResolveModulesInParallel().
+    ///
+    /// Resolvers that return false, the default, search the new modules
+    /// one after another, the same way they do for ModulesChanged().
+    ///
+    /// @return
+    ///     True if this resolver can search several modules at once.
+    //------------------------------------------------------------------
+    virtual bool
+    CanResolveModulesInParallel () const
+    {
+        return false;
+    }
+
+    //------------------------------------------------------------------
+    /// Called on the calling thread before Breakpoint::ModulesDidLoad()
+    /// starts searching modules in parallel with this resolver.
+    //------------------------------------------------------------------
+    virtual void
+    WillResolveModulesInParallel ()
+    {
+    }
+
+    //------------------------------------------------------------------
+    /// Called on the calling thread once every module has been searched
+    /// in parallel, so the resolver can add the locations it had to put
+    /// off while searching.
+    ///
+    /// @param[in] filter
+    ///   The filter that managed the search for this resolver.
+    //------------------------------------------------------------------
+    virtual void
+    DidResolveModulesInParallel (SearchFilter &filter)
+    {
+    }
+
     //------------------------------------------------------------------
     /// Prints a canonical description for the breakpoint to the stream \a s.
     ///
@@ -112,6 +164,33 @@ public:
     virtual void
     Dump (Stream *s) const = 0;
 
+    //------------------------------------------------------------------
+    /// Record the time taken by one search for breakpoint locations.
+    /// A parallel search of several modules counts as one search that
+    /// took as long as the whole parallel search.
+    ///
+    /// @param[in] usec
+    ///   The time the search took in microseconds.
+    //------------------------------------------------------------------
+    void
+    AddResolveTime (uint64_t usec)
+    {
+        m_resolve_time_usec += usec;
+        ++m_num_resolves;
+    }
+
+    uint64_t
+    GetResolveTimeInMicroSeconds () const
+    {
+        return m_resolve_time_usec;
+    }
+
+    uint32_t
+    GetNumResolves () const
+    {
+        return m_num_resolves;
+    }
+
     //------------------------------------------------------------------
     /// An enumeration for keeping track of the concrete subclass that
     /// is actually instantiated. Values of this enumeration are kept in the 
@@ -146,6 +225,8 @@ protected:
 private:
     // Subclass identifier (for llvm isa/dyn_cast)
     const unsigned char SubclassID;
+    uint64_t m_resolve_time_usec;   // Total time spent searching for locations
+    uint32_t m_num_resolves;        // Number of searches
     DISALLOW_COPY_AND_ASSIGN(BreakpointResolver);
 };
 
@@ -46,6 +46,13 @@ public:
     virtual Searcher::Depth
     GetDepth ();
 
+    // Searches only read the module they are given
+    virtual bool
+    CanResolveModulesInParallel () const
+    {
+        return true;
+    }
+
     virtual void
     GetDescription (Stream *s);
 
@@ -17,6 +17,7 @@
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Breakpoint/BreakpointResolver.h"
+#include "lldb/Host/Mutex.h"
 
 namespace lldb_private {
 
@@ -73,6 +74,21 @@ public:
     virtual Searcher::Depth
     GetDepth ();
 
+    // Searches only read the module they are given. Re-exported symbols,
+    // which are resolved by searching other modules, are put off until the
+    // parallel search is done.
+    virtual bool
+    CanResolveModulesInParallel () const
+    {
+        return true;
+    }
+
+    virtual void
+    WillResolveModulesInParallel ();
+
+    virtual void
+    DidResolveModulesInParallel (SearchFilter &filter);
+
     virtual void
     GetDescription (Stream *s);
 
@@ -110,9 +126,15 @@ protected:
     RegularExpression m_regex;
     Breakpoint::MatchType m_match_type;
     bool m_skip_prologue;
+    bool m_defer_reexported_symbols;    // Set while modules are searched in parallel
+    Mutex m_deferred_mutex;
+    std::vector<Symbol *> m_deferred_reexported_symbols;
 
     void
     AddNameLookup (const ConstString &name, uint32_t name_type_mask);
+
+    void
+    AddReExportedSymbolLocation (SearchFilter &filter, Symbol *symbol);
 private:
     DISALLOW_COPY_AND_ASSIGN(BreakpointResolverName);
 };
@@ -185,6 +185,18 @@ public:
     //------------------------------------------------------------------
     lldb::BreakpointLocationSP
     GetOwnerAtIndex (size_t idx);
+
+    //------------------------------------------------------------------
+    /// Count hits of this site that didn't stop the process because the
+    /// remote stub found its owners' conditions to be false. The site
+    /// and each of its owners get \a count more hits, just as if
+    /// ShouldStop had been called and returned false for each of them.
+    ///
+    /// @param[in] count
+    ///     The number of hits to add.
+    //------------------------------------------------------------------
+    void
+    BumpHitCounts (uint32_t count);
     
     //------------------------------------------------------------------
     /// Check whether the owners of this breakpoint site have any
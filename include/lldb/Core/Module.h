@@ -11,6 +11,7 @@
 #define liblldb_Module_h_
 
 #include "lldb/Core/ArchSpec.h"
+#include "lldb/Core/UniqueCStringMap.h"
 #include "lldb/Core/UUID.h"
 #include "lldb/Host/FileSpec.h"
 #include "lldb/Host/Mutex.h"
@@ -663,6 +664,30 @@ public:
     lldb::CompUnitSP
     GetCompileUnitAtIndex (size_t idx);
 
+    //------------------------------------------------------------------
+    /// Find the compile units that may have line table entries for a
+    /// source file.
+    ///
+    /// The first call builds an index from source file basenames to
+    /// the compile units that refer to them in their name or in their
+    /// support files, so that callers don't have to parse the support
+    /// files and line tables of every compile unit in the module.
+    ///
+    /// @param[in] file_spec
+    ///     The source file to look for. Only its filename is used.
+    ///
+    /// @param[out] cu_indexes
+    ///     The sorted indexes of the matching compile units get
+    ///     appended to this list. If \a file_spec has no filename, the
+    ///     indexes of all compile units are appended.
+    ///
+    /// @return
+    ///     The number of indexes appended to \a cu_indexes.
+    //------------------------------------------------------------------
+    size_t
+    FindCompileUnitIndexesForSourceFile (const FileSpec &file_spec,
+                                         std::vector<uint32_t> &cu_indexes);
+
     const ConstString &
     GetObjectName() const;
 
@@ -744,6 +769,21 @@ public:
     GetSymbolVendor(bool can_create = true,
                     lldb_private::Stream *feedback_strm = NULL);
 
+    //------------------------------------------------------------------
+    /// Free debug information that the symbol vendor has parsed but
+    /// can parse again when it is needed. Nothing is done if the
+    /// symbol vendor hasn't been loaded.
+    ///
+    /// @param[in] mandatory
+    ///     If false, nothing is freed if the module mutex can't be
+    ///     acquired right away.
+    ///
+    /// @return
+    ///     The number of bytes that were freed.
+    //------------------------------------------------------------------
+    size_t
+    ReleaseUnusedMemory (bool mandatory);
+
     //------------------------------------------------------------------
     /// Get accessor the type list for this module.
     ///
@@ -1108,11 +1148,13 @@ protected:
     ClangASTContext             m_ast;          ///< The AST context for this module.
     PathMappingList             m_source_mappings; ///< Module specific source remappings for when you have debug info for a module that doesn't match where the sources currently are
     std::unique_ptr<lldb_private::SectionList> m_sections_ap; ///< Unified section list for module that is used by the ObjectFile and and ObjectFile instances for the debug info
+    UniqueCStringMap<uint32_t>  m_source_file_cu_index; ///< Source file basenames to the indexes of the compile units that refer to them
 
     bool                        m_did_load_objfile:1,
                                 m_did_load_symbol_vendor:1,
                                 m_did_parse_uuid:1,
                                 m_did_init_ast:1,
+                                m_did_index_source_files:1,
                                 m_is_dynamic_loader_module:1;
     mutable bool                m_file_has_changed:1,
                                 m_first_file_changed_log:1;   /// See if the module was modified after it was initially opened.
@@ -0,0 +1,133 @@
+//===-- ModuleCacheFile.h ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_ModuleCacheFile_h_
+#define liblldb_ModuleCacheFile_h_
+
+// C Includes
+// C++ Includes
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private.h"
+#include "lldb/Core/UUID.h"
+#include "lldb/Host/FileSpec.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class ModuleCacheFile ModuleCacheFile.h "lldb/Core/ModuleCacheFile.h"
+/// @brief A file in a cache directory that holds data computed from an
+/// object file, so that later debug sessions can reuse it.
+///
+/// Cache files are named after the UUID of the object file, with an
+/// extension that tells the different kinds of cached data apart. Every
+/// cache file starts with a header that records the object file it was
+/// made for, and a cache file is only used if the UUID, modification
+/// time and size of that object file all still match. Values in the
+/// header are stored little endian so cache directories can be shared
+/// between hosts:
+///
+///   uint32_t magic
+///   uint32_t version
+///   uint32_t uuid_byte_size
+///   uint8_t  uuid_bytes[uuid_byte_size]
+///   uint64_t object file modification time (seconds since 1970)
+///   uint64_t object file byte size
+///
+/// The data that follows the header is up to the user of the cache file.
+//----------------------------------------------------------------------
+class ModuleCacheFile
+{
+public:
+    ModuleCacheFile ();
+
+    //------------------------------------------------------------------
+    /// Find the cache file for \a objfile in \a cache_dir and remember
+    /// the UUID, modification time and size of \a objfile as they are
+    /// now.
+    ///
+    /// @return
+    ///     False if \a objfile has no UUID, in which case nothing can be
+    ///     cached for it.
+    //------------------------------------------------------------------
+    bool
+    SetObjectFile (const FileSpec &cache_dir,
+                   const char *file_extension,
+                   ObjectFile &objfile);
+
+    bool
+    IsValid () const
+    {
+        return (bool)m_file;
+    }
+
+    const FileSpec &
+    GetFileSpec () const
+    {
+        return m_file;
+    }
+
+    //------------------------------------------------------------------
+    /// Memory map the cache file and check its header.
+    ///
+    /// @param[out] data
+    ///     The contents of the cache file, little endian.
+    ///
+    /// @param[out] offset
+    ///     The offset of the first byte after the header.
+    ///
+    /// @param[in] log
+    ///     If not NULL, told why a cache file that exists wasn't used.
+    ///
+    /// @return
+    ///     True if the cache file exists and was made by \a version of
+    ///     the \a magic format for this version of the object file.
+    //------------------------------------------------------------------
+    bool
+    Read (uint32_t magic,
+          uint32_t version,
+          DataExtractor &data,
+          lldb::offset_t &offset,
+          Log *log);
+
+    //------------------------------------------------------------------
+    /// Write the header followed by the contents of the \a num_parts
+    /// streams in \a parts to the cache file, then remove the least
+    /// recently written cache files with the same extension until they
+    /// take up at most \a max_cache_byte_size bytes. A
+    /// \a max_cache_byte_size of zero means the cache size isn't
+    /// limited.
+    ///
+    /// The data is written to a temporary file that is renamed into
+    /// place, so other debug sessions never see a partially written
+    /// cache file.
+    //------------------------------------------------------------------
+    Error
+    Write (uint32_t magic,
+           uint32_t version,
+           const StreamString * const *parts,
+           size_t num_parts,
+           uint64_t max_cache_byte_size);
+
+protected:
+    void
+    TrimCacheDirectory (uint64_t max_cache_byte_size);
+
+    FileSpec m_cache_dir;
+    std::string m_file_extension;
+    FileSpec m_file;
+    FileSpec m_object_file_spec;
+    UUID m_uuid;
+    uint64_t m_object_file_mod_time;
+    uint64_t m_object_file_byte_size;
+};
+
+} // namespace lldb_private
+
+#endif  // liblldb_ModuleCacheFile_h_
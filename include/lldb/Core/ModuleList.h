@@ -481,6 +481,15 @@ public:
     size_t
     RemoveOrphans (bool mandatory);
 
+    //------------------------------------------------------------------
+    /// Free the debug information that the modules in this list have
+    /// parsed but can parse again when it is needed.
+    ///
+    /// @see Module::ReleaseUnusedMemory (bool)
+    //------------------------------------------------------------------
+    size_t
+    ReleaseUnusedMemory (bool mandatory);
+
     bool
     ResolveFileAddress (lldb::addr_t vm_addr,
                         Address& so_addr) const;
@@ -548,6 +557,9 @@ public:
 
     static size_t
     RemoveOrphanSharedModules (bool mandatory);
+
+    static size_t
+    ReleaseUnusedSharedModuleMemory (bool mandatory);
     
     static bool
     RemoveSharedModuleIfOrphaned (const Module *module_ptr);
@@ -81,6 +81,17 @@ public:
         m_map.push_back (e);
     }
 
+    //------------------------------------------------------------------
+    // Append all entries from another map. Like the other Append()
+    // functions, UniqueCStringMap<T>::Sort() must be called before
+    // doing any searches by name.
+    //------------------------------------------------------------------
+    void
+    Append (const UniqueCStringMap &rhs)
+    {
+        m_map.insert (m_map.end(), rhs.m_map.begin(), rhs.m_map.end());
+    }
+
     void
     Clear ()
     {
@@ -300,6 +311,22 @@ public:
     {
         std::sort (m_map.begin(), m_map.end());
     }
+
+    //------------------------------------------------------------------
+    // Sort the entries that were appended after the first \a num_sorted
+    // entries, which must already be sorted, and merge them with those.
+    // This is cheaper than Sort() when a few entries were appended to a
+    // large map.
+    //------------------------------------------------------------------
+    void
+    SortAppended (size_t num_sorted)
+    {
+        if (num_sorted >= m_map.size())
+            return;
+        iterator middle = m_map.begin() + num_sorted;
+        std::sort (middle, m_map.end());
+        std::inplace_merge (m_map.begin(), middle, m_map.end());
+    }
     
     //------------------------------------------------------------------
     // Since we are using a vector to contain our items it will always 
@@ -801,6 +801,34 @@ public:
     virtual bool
     SetData (DataExtractor &data, Error &error);
 
+    //------------------------------------------------------------------
+    /// Read the memory of this aggregate with a single memory read so
+    /// the children that live inside it can take their data from that
+    /// buffer instead of each reading their own. Members reached
+    /// through pointers are not part of the buffer. The buffer is
+    /// dropped when this value is updated.
+    ///
+    /// @param[in] byte_size
+    ///     The number of bytes to read from the start of this value,
+    ///     capped to the size of its type. Zero reads the whole value.
+    ///
+    /// @return
+    ///     True if the children can use prefetched data.
+    //------------------------------------------------------------------
+    bool
+    PrefetchChildrenData (uint64_t byte_size = 0);
+
+    //------------------------------------------------------------------
+    /// Get the bytes at [addr, addr + byte_size) from the data
+    /// prefetched by this value, or by the ancestors this value is
+    /// stored inside of.
+    ///
+    /// @return
+    ///     True if \a data was set to the prefetched bytes.
+    //------------------------------------------------------------------
+    bool
+    GetPrefetchedData (lldb::addr_t addr, uint64_t byte_size, DataExtractor &data);
+
     bool
     GetIsConstant () const
     {
@@ -1026,6 +1054,8 @@ protected:
     
     lldb::ValueObjectSP m_addr_of_valobj_sp; // We have to hold onto a shared pointer to this one because it is created
                                              // as an independent ValueObjectConstResult, which isn't managed by us.
+    lldb::DataBufferSP  m_prefetched_data_sp;    // The memory of this value read by PrefetchChildrenData()
+    lldb::addr_t        m_prefetched_data_addr;  // The load address m_prefetched_data_sp was read from
 
     lldb::Format                m_format;
     lldb::Format                m_last_format;
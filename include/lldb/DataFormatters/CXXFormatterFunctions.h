@@ -54,6 +54,21 @@ namespace lldb_private {
         size_t
         ExtractIndexFromString (const char* item_name);
         
+        // Read memory through the process when it is stopped, and from the
+        // object files of the target otherwise (e.g. a static shown with
+        // "target variable" before the program runs), where \a address
+        // and the pointers read are file addresses.
+        lldb::addr_t
+        ReadPointerFromTargetOrProcess (const ExecutionContextRef &exe_ctx_ref,
+                                        lldb::addr_t address,
+                                        Error &error);
+        
+        lldb::ValueObjectSP
+        CreateValueObjectFromTargetOrProcessAddress (const char* name,
+                                                     lldb::addr_t address,
+                                                     const ExecutionContextRef &exe_ctx_ref,
+                                                     ClangASTType type);
+        
         time_t
         GetOSXEpoch ();
         
@@ -568,7 +583,114 @@ namespace lldb_private {
         };
         
         SyntheticChildrenFrontEnd* LibstdcppMapIteratorSyntheticFrontEndCreator (CXXSyntheticChildren*, lldb::ValueObjectSP);
-        
+
+        class LibstdcppStdVectorSyntheticFrontEnd : public SyntheticChildrenFrontEnd
+        {
+        public:
+            LibstdcppStdVectorSyntheticFrontEnd (lldb::ValueObjectSP valobj_sp);
+
+            virtual size_t
+            CalculateNumChildren ();
+
+            virtual lldb::ValueObjectSP
+            GetChildAtIndex (size_t idx);
+
+            virtual bool
+            Update();
+
+            virtual bool
+            MightHaveChildren ();
+
+            virtual size_t
+            GetIndexOfChildWithName (const ConstString &name);
+
+            virtual
+            ~LibstdcppStdVectorSyntheticFrontEnd ();
+        private:
+            lldb::addr_t m_start;
+            ClangASTType m_element_type;
+            uint32_t m_element_size;
+            size_t m_count;
+            std::map<size_t,lldb::ValueObjectSP> m_children;
+        };
+
+        SyntheticChildrenFrontEnd* LibstdcppStdVectorSyntheticFrontEndCreator (CXXSyntheticChildren*, lldb::ValueObjectSP);
+
+        class LibstdcppStdListSyntheticFrontEnd : public SyntheticChildrenFrontEnd
+        {
+        public:
+            LibstdcppStdListSyntheticFrontEnd (lldb::ValueObjectSP valobj_sp);
+
+            virtual size_t
+            CalculateNumChildren ();
+
+            virtual lldb::ValueObjectSP
+            GetChildAtIndex (size_t idx);
+
+            virtual bool
+            Update();
+
+            virtual bool
+            MightHaveChildren ();
+
+            virtual size_t
+            GetIndexOfChildWithName (const ConstString &name);
+
+            virtual
+            ~LibstdcppStdListSyntheticFrontEnd ();
+        private:
+            size_t m_list_capping_size;
+            lldb::addr_t m_node_address;
+            ClangASTType m_element_type;
+            uint32_t m_data_offset;
+            size_t m_count;
+            std::vector<lldb::addr_t> m_nodes;
+            std::map<size_t,lldb::ValueObjectSP> m_children;
+        };
+
+        SyntheticChildrenFrontEnd* LibstdcppStdListSyntheticFrontEndCreator (CXXSyntheticChildren*, lldb::ValueObjectSP);
+
+        class LibstdcppStdMapSyntheticFrontEnd : public SyntheticChildrenFrontEnd
+        {
+        public:
+            LibstdcppStdMapSyntheticFrontEnd (lldb::ValueObjectSP valobj_sp);
+
+            virtual size_t
+            CalculateNumChildren ();
+
+            virtual lldb::ValueObjectSP
+            GetChildAtIndex (size_t idx);
+
+            virtual bool
+            Update();
+
+            virtual bool
+            MightHaveChildren ();
+
+            virtual size_t
+            GetIndexOfChildWithName (const ConstString &name);
+
+            virtual
+            ~LibstdcppStdMapSyntheticFrontEnd ();
+        private:
+            lldb::addr_t
+            ReadNodePointer (lldb::addr_t node, uint32_t offset);
+
+            lldb::addr_t
+            IncrementNode (lldb::addr_t node);
+
+            lldb::addr_t m_header_address;
+            ClangASTType m_element_type;
+            uint32_t m_ptr_size;
+            uint32_t m_data_offset;
+            size_t m_count;
+            bool m_garbage;
+            std::vector<lldb::addr_t> m_nodes;
+            std::map<size_t,lldb::ValueObjectSP> m_children;
+        };
+
+        SyntheticChildrenFrontEnd* LibstdcppStdMapSyntheticFrontEndCreator (CXXSyntheticChildren*, lldb::ValueObjectSP);
+
         class LibCxxMapIteratorSyntheticFrontEnd : public SyntheticChildrenFrontEnd
         {
         public:
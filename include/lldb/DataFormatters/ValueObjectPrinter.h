@@ -356,6 +356,13 @@ protected:
     uint32_t
     GetMaxNumChildrenToPrint (bool& print_dotdotdot);
     
+    void
+    PrefetchChildrenData (size_t num_children);
+    
+    void
+    PrefetchChildPointees (size_t num_children,
+                           uint32_t curr_ptr_depth);
+    
     void
     PrintChildren (uint32_t curr_ptr_depth);
     
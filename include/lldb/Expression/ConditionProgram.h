@@ -0,0 +1,132 @@
+//===-- ConditionProgram.h --------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_ConditionProgram_h_
+#define liblldb_ConditionProgram_h_
+
+// C Includes
+// C++ Includes
+#include <string>
+#include <vector>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private.h"
+#include "lldb/Core/Scalar.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class ConditionProgram ConditionProgram.h "lldb/Expression/ConditionProgram.h"
+/// @brief A compiled form of simple breakpoint conditions that can be
+///        evaluated without going through Clang.
+///
+/// Conditions like "i == 42 && p->state != 3" only compare variables
+/// with constants. Parsing such a condition with Clang and running it
+/// through the IR interpreter or the JIT every time the breakpoint is
+/// hit costs far more than reading the variables. A ConditionProgram
+/// compiles the condition once into a small stack machine program whose
+/// variable operands are frame variable expression paths, so evaluating
+/// it only reads the variables through their DWARF locations.
+///
+/// The supported language is integer and boolean constants, variable
+/// paths made of identifiers, ".", "->" and constant "[]" subscripts,
+/// the relational and equality operators, "!", "&&", "||" and
+/// parentheses. Conditions using anything else don't compile (IsValid()
+/// returns false), and evaluation fails if a variable can't be read as
+/// a scalar. Either way the caller should fall back to a full
+/// expression evaluation.
+//----------------------------------------------------------------------
+class ConditionProgram
+{
+public:
+    ConditionProgram (const char *condition_text);
+
+    ~ConditionProgram ();
+
+    bool
+    IsValid () const
+    {
+        return !m_instructions.empty();
+    }
+
+    //------------------------------------------------------------------
+    /// Evaluate the condition in the frame of \a exe_ctx.
+    ///
+    /// @param[out] result
+    ///     Whether the condition is true, if evaluation succeeded.
+    ///
+    /// @return
+    ///     True if the condition was evaluated, false if a variable
+    ///     couldn't be read or the program isn't valid.
+    //------------------------------------------------------------------
+    bool
+    Evaluate (ExecutionContext &exe_ctx, bool &result);
+
+    enum OpCode
+    {
+        eOpPushConstant,    // push m_constants[operand]
+        eOpPushVariable,    // push the value of m_variable_paths[operand]
+        eOpToBool,          // replace the top with 0 or 1
+        eOpNot,             // replace the top with its logical negation
+        eOpEqual,           // pop two values, push the comparison result
+        eOpNotEqual,
+        eOpLess,
+        eOpLessEqual,
+        eOpGreater,
+        eOpGreaterEqual,
+        eOpJumpIfFalse,     // jump to operand leaving the top if it is zero, pop it otherwise
+        eOpJumpIfTrue       // jump to operand leaving the top if it is non zero, pop it otherwise
+    };
+
+    struct Instruction
+    {
+        OpCode opcode;
+        uint32_t operand;
+    };
+
+    //------------------------------------------------------------------
+    /// Accessors for code that translates the program into another
+    /// form, like the agent expressions remote stubs can evaluate.
+    //------------------------------------------------------------------
+    const std::vector<Instruction> &
+    GetInstructions () const
+    {
+        return m_instructions;
+    }
+
+    const Scalar &
+    GetConstantAtIndex (uint32_t idx) const
+    {
+        return m_constants[idx];
+    }
+
+    const char *
+    GetVariablePathAtIndex (uint32_t idx) const
+    {
+        return m_variable_paths[idx].c_str();
+    }
+
+protected:
+    class Parser;
+
+    uint32_t
+    AddInstruction (OpCode opcode, uint32_t operand = 0);
+
+    std::vector<Instruction> m_instructions;
+    std::vector<Scalar> m_constants;
+    std::vector<std::string> m_variable_paths;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN (ConditionProgram);
+};
+
+} // namespace lldb_private
+
+#endif  // liblldb_ConditionProgram_h_
@@ -157,6 +157,26 @@ public:
 
     bool
     Update_DW_OP_addr (lldb::addr_t file_addr);
+
+    //------------------------------------------------------------------
+    /// Replace the DW_OP_GNU_addr_index and DW_OP_GNU_const_index
+    /// opcodes that split DWARF (-gsplit-dwarf) locations use with
+    /// DW_OP_addr and DW_OP_const opcodes, so the location can be
+    /// evaluated without the compile unit it came from.
+    ///
+    /// @param[in] debug_addr_data
+    ///     The .debug_addr section of the executable.
+    ///
+    /// @param[in] addr_base
+    ///     The DW_AT_GNU_addr_base of the compile unit.
+    ///
+    /// @return
+    ///     False if the location is a location list, contains unknown
+    ///     opcodes, or uses an index past the end of \a debug_addr_data.
+    //------------------------------------------------------------------
+    bool
+    Resolve_DW_OP_GNU_addr_index (const DataExtractor &debug_addr_data,
+                                  lldb::offset_t addr_base);
     
     //------------------------------------------------------------------
     /// Make the expression parser read its location information from a
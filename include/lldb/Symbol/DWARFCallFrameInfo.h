@@ -136,7 +136,7 @@ private:
 
     FDEEntryMap                 m_fde_index;
     bool                        m_fde_index_initialized;  // only scan the section for FDEs once
-    Mutex                       m_fde_index_mutex;        // and isolate the thread that does it
+    Mutex                       m_fde_index_mutex;        // guards m_fde_index_initialized and the scan
 
     bool                        m_is_eh_frame;
 
@@ -5,6 +5,7 @@
 #include "lldb/Core/ArchSpec.h"
 #include "lldb/Core/AddressRange.h"
 #include "lldb/Host/Mutex.h"
+#include "lldb/Symbol/UnwindPlanCache.h"
 
 namespace lldb_private {
 
@@ -80,6 +81,11 @@ private:
     lldb::UnwindAssemblySP
     GetUnwindAssemblyProfiler ();
 
+    void
+    AddUnwindPlanToCache (lldb_private::Thread& thread,
+                          UnwindPlanCache::PlanKind kind,
+                          const lldb::UnwindPlanSP &unwind_plan_sp);
+
     UnwindTable& m_unwind_table;
     AddressRange m_range;
 
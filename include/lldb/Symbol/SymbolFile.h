@@ -10,6 +10,8 @@
 #ifndef liblldb_SymbolFile_h_
 #define liblldb_SymbolFile_h_
 
+#include <vector>
+
 #include "lldb/lldb-private.h"
 #include "lldb/Core/PluginInterface.h"
 #include "lldb/Symbol/ClangASTType.h"
@@ -124,6 +126,10 @@ public:
     virtual size_t          ParseCompileUnitFunctions (const SymbolContext& sc) = 0;
     virtual bool            ParseCompileUnitLineTable (const SymbolContext& sc) = 0;
     virtual bool            ParseCompileUnitSupportFiles (const SymbolContext& sc, FileSpecList& support_files) = 0;
+    // Get the basenames of the compile unit at index "cu_idx" and of its
+    // support files without creating the compile unit. Return false if
+    // this can't be done cheaply, the support files will be parsed then.
+    virtual bool            GetCompileUnitSourceFileBasenames (uint32_t cu_idx, std::vector<ConstString> &basenames) { return false; }
     virtual size_t          ParseFunctionBlocks (const SymbolContext& sc) = 0;
     virtual size_t          ParseTypes (const SymbolContext& sc) = 0;
     virtual size_t          ParseVariablesForContext (const SymbolContext& sc) = 0;
@@ -150,6 +156,10 @@ public:
                                            const ConstString &name,
                                            const ClangNamespaceDecl *parent_namespace_decl) = 0;
 
+    // Free parsed debug information that can be parsed again from the
+    // object file when it is needed, returns the number of bytes freed.
+    virtual size_t          ReleaseUnusedMemory () { return 0; }
+
     ObjectFile*             GetObjectFile() { return m_obj_file; }
     const ObjectFile*       GetObjectFile() const { return m_obj_file; }
     
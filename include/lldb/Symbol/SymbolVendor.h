@@ -172,6 +172,11 @@ public:
     virtual void
     ClearSymtab ();
 
+    // Let the symbol file free parsed debug information that can be
+    // parsed again when it is needed.
+    virtual size_t
+    ReleaseUnusedMemory ();
+
     //------------------------------------------------------------------
     // PluginInterface protocol
     //------------------------------------------------------------------
@@ -105,6 +105,7 @@ protected:
     typedef collection::const_iterator  const_iterator;
     typedef RangeDataVector<lldb::addr_t, lldb::addr_t, uint32_t> FileRangeToIndexMap;
             void        InitNameIndexes ();
+            void        IndexDemangledNames ();
             void        InitAddressIndexes ();
 
     ObjectFile *        m_objfile;
@@ -116,7 +117,8 @@ protected:
     UniqueCStringMap<uint32_t> m_selector_to_index;
     mutable Mutex       m_mutex; // Provide thread safety for this symbol table
     bool                m_file_addr_to_index_computed:1,
-                        m_name_indexes_computed:1;
+                        m_name_indexes_computed:1,
+                        m_demangled_names_pending:1; // Demangled C++ names haven't been added to m_name_to_index yet
 private:
 
     bool
@@ -257,6 +257,11 @@ public:
         void
         SetRegisterInfo (uint32_t reg_num, const RegisterLocation register_location);
     
+        // Append the numbers of all registers that have a location in this
+        // row to REG_NUMS, in ascending order.
+        size_t
+        GetRegisterNumbers (std::vector<uint32_t> &reg_nums) const;
+
         lldb::addr_t
         GetOffset() const
         {
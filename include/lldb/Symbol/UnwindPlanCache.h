@@ -0,0 +1,160 @@
+//===-- UnwindPlanCache.h ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_UnwindPlanCache_h
+#define liblldb_UnwindPlanCache_h
+
+// C Includes
+// C++ Includes
+#include <vector>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private.h"
+#include "lldb/Core/ModuleCacheFile.h"
+#include "lldb/Host/Mutex.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class UnwindPlanCache UnwindPlanCache.h "lldb/Symbol/UnwindPlanCache.h"
+/// @brief A per-module cache of computed UnwindPlans.
+///
+/// Profiling the assembly of a function to build its UnwindPlan means
+/// emulating every instruction in the function, which is expensive to
+/// do for every function on every stack we walk. This cache keeps the
+/// UnwindPlans computed for an ObjectFile in a vector sorted by the file
+/// address of the function they were made for, and can write them to a
+/// ModuleCacheFile so that the next debug session that loads the same
+/// binary can reuse them. Plans read from a cache file have " (from the
+/// unwind plan cache)" appended to their source name.
+///
+/// Only UnwindPlans whose register numbers mean the same thing from one
+/// session to the next can be saved: plans in the eRegisterKindLLDB
+/// numbering depend on the register context that was in use, so they
+/// must be converted (see UnwindPlanCache::ConvertRegisterKind) first.
+/// Plans that refer to DWARF expressions point into the eh_frame data
+/// of this session and are never saved.
+//----------------------------------------------------------------------
+class UnwindPlanCache
+{
+public:
+    enum PlanKind
+    {
+        ePlanKindCallSite = 0,  // eh_frame derived UnwindPlan
+        ePlanKindNonCallSite,   // Assembly profiled UnwindPlan, valid at all instructions
+        ePlanKindFast,          // Assembly profiled UnwindPlan, valid at call sites only
+        kNumPlanKinds
+    };
+
+    UnwindPlanCache (ObjectFile &objfile);
+
+    ~UnwindPlanCache ();
+
+    //------------------------------------------------------------------
+    /// Read the UnwindPlans previously saved for this module, if any.
+    ///
+    /// @param[in] cache_dir
+    ///     The directory the cache files live in.
+    ///
+    /// @return
+    ///     True if a cache file for this module was found and loaded.
+    //------------------------------------------------------------------
+    bool
+    Load (const FileSpec &cache_dir);
+
+    //------------------------------------------------------------------
+    /// Write the cached UnwindPlans back to the cache file given to
+    /// UnwindPlanCache::Load() if any plans were added since, then trim
+    /// the cache directory so the unwind plan cache files take up at
+    /// most \a max_cache_byte_size bytes. Files that were written least
+    /// recently are removed first. A \a max_cache_byte_size of zero
+    /// means the cache size isn't limited.
+    //------------------------------------------------------------------
+    bool
+    Save (uint64_t max_cache_byte_size);
+
+    //------------------------------------------------------------------
+    /// Find a cached UnwindPlan of kind \a kind for the function whose
+    /// address range is \a func_range.
+    //------------------------------------------------------------------
+    lldb::UnwindPlanSP
+    FindUnwindPlan (const AddressRange &func_range, PlanKind kind);
+
+    //------------------------------------------------------------------
+    /// Cache \a plan_sp as the UnwindPlan of kind \a kind for the
+    /// function whose address range is \a func_range.
+    //------------------------------------------------------------------
+    void
+    AddUnwindPlan (const AddressRange &func_range, PlanKind kind, const lldb::UnwindPlanSP &plan_sp);
+
+    //------------------------------------------------------------------
+    /// Forget the UnwindPlan of kind \a kind for the function whose
+    /// address range is \a func_range so that it isn't saved, e.g.
+    /// because it turned out to be wrong while unwinding.
+    //------------------------------------------------------------------
+    void
+    RemoveUnwindPlan (const AddressRange &func_range, PlanKind kind);
+
+    size_t
+    GetSize ();
+
+    //------------------------------------------------------------------
+    /// Make a copy of \a plan whose register numbers are in the \a kind
+    /// numbering, using \a reg_ctx to convert them.
+    ///
+    /// @return
+    ///     The converted UnwindPlan, or an empty shared pointer if any
+    ///     of the registers can't be expressed in the \a kind numbering.
+    //------------------------------------------------------------------
+    static lldb::UnwindPlanSP
+    ConvertRegisterKind (const UnwindPlan &plan, RegisterContext &reg_ctx, lldb::RegisterKind kind);
+
+    static bool
+    CanSaveUnwindPlan (const UnwindPlan &plan);
+
+protected:
+    struct Entry
+    {
+        lldb::addr_t func_file_addr;
+        lldb::addr_t func_byte_size;
+        PlanKind kind;
+        lldb::UnwindPlanSP plan_sp;
+
+        bool
+        operator < (const Entry &rhs) const
+        {
+            if (func_file_addr != rhs.func_file_addr)
+                return func_file_addr < rhs.func_file_addr;
+            return kind < rhs.kind;
+        }
+    };
+
+    typedef std::vector<Entry> collection;
+    typedef collection::iterator iterator;
+
+    bool
+    ReadUnwindPlan (const DataExtractor &data, lldb::offset_t *offset_ptr, UnwindPlan &plan);
+
+    void
+    WriteUnwindPlan (Stream &strm, const UnwindPlan &plan);
+
+    ObjectFile &m_object_file;
+    Mutex m_mutex;
+    collection m_entries;   // Sorted by function file address, then kind
+    ModuleCacheFile m_cache_file;   // Where the plans were loaded from and will be saved to
+    bool m_dirty;           // Plans were added since the cache file was read
+
+private:
+    DISALLOW_COPY_AND_ASSIGN (UnwindPlanCache);
+};
+
+} // namespace lldb_private
+
+#endif  // liblldb_UnwindPlanCache_h
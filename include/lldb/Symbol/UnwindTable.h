@@ -15,6 +15,7 @@
 
 #include "lldb/lldb-private.h" 
 #include "lldb/Host/Mutex.h"
+#include "lldb/Symbol/UnwindPlanCache.h"
 
 namespace lldb_private {
 
@@ -46,6 +47,19 @@ public:
     bool
     GetArchitecture (lldb_private::ArchSpec &arch);
 
+    // The UnwindPlans computed for the functions in this ObjectFile, loaded
+    // from the directory in the "target.unwind-plan-cache-path" setting when
+    // the table is first used.
+    UnwindPlanCache &
+    GetUnwindPlanCache ();
+
+    // Write the cached UnwindPlans out so the next session that loads this
+    // ObjectFile can reuse them, keeping the unwind plan cache files under
+    // max_cache_byte_size bytes in total (zero means no limit). This must be
+    // called while the ObjectFile and its sections are still alive.
+    bool
+    SaveUnwindPlanCache (uint64_t max_cache_byte_size);
+
 private:
     void
     Dump (Stream &s);
@@ -63,6 +77,8 @@ private:
     Mutex               m_mutex;
 
     DWARFCallFrameInfo* m_eh_frame;
+
+    UnwindPlanCache     m_plan_cache;
     
     DISALLOW_COPY_AND_ASSIGN (UnwindTable);
 };
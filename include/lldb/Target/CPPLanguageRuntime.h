@@ -135,7 +135,19 @@ public:
     
     static bool
     StripNamespacesFromVariableName (const char *name, const char *&base_name_start, const char *&base_name_end);
-    
+
+    // Get the decl context and basename that MethodName would extract from
+    // the demangled version of MANGLED_NAME, without demangling it. Only
+    // mangled function names whose context consists of plain identifiers
+    // are handled, false is returned for everything else (templates,
+    // operators, substitutions, anonymous namespaces, ...) and the name
+    // must be demangled to find out.
+    static bool
+    GetContextAndBasenameFromMangledName (const char *mangled_name,
+                                          ConstString &context,
+                                          ConstString &basename,
+                                          bool &has_qualifiers);
+
     // in some cases, compilers will output different names for one same type. when tht happens, it might be impossible
     // to construct SBType objects for a valid type, because the name that is available is not the same as the name that
     // can be used as a search key in FindTypes(). the equivalents map here is meant to return possible alternative names
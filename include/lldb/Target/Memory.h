@@ -30,6 +30,33 @@ namespace lldb_private {
     class MemoryCache
     {
     public:
+        //------------------------------------------------------------------
+        // Counters that show how effective the cache is. They are kept for
+        // the lifetime of the process and aren't reset when the cache is
+        // cleared.
+        //------------------------------------------------------------------
+        struct Statistics
+        {
+            Statistics () :
+                num_line_hits (0),
+                num_line_misses (0),
+                num_read_ahead_lines (0),
+                num_prefetched_lines (0),
+                num_uncached_reads (0),
+                num_process_reads (0),
+                num_process_bytes_read (0)
+            {
+            }
+
+            uint64_t num_line_hits;         // Cache lines that were used without reading from the process
+            uint64_t num_line_misses;       // Cache lines that had to be read from the process when they were needed
+            uint64_t num_read_ahead_lines;  // Extra cache lines read after a miss because of a sequential or strided access pattern
+            uint64_t num_prefetched_lines;  // Cache lines read by MemoryCache::Prefetch()
+            uint64_t num_uncached_reads;    // Reads larger than a cache line that went straight to the process
+            uint64_t num_process_reads;     // Requests sent to the process to fill cache lines
+            uint64_t num_process_bytes_read;// Bytes read from the process to fill cache lines
+        };
+
         //------------------------------------------------------------------
         // Constructors and Destructors
         //------------------------------------------------------------------
@@ -48,12 +75,26 @@ namespace lldb_private {
               void *dst, 
               size_t dst_len,
               Error &error);
+
+        //------------------------------------------------------------------
+        /// Read the cache lines that contain each of \a addrs and that
+        /// aren't cached yet, using as few process memory requests as
+        /// possible.
+        //------------------------------------------------------------------
+        void
+        Prefetch (const lldb::addr_t *addrs, size_t num_addrs);
         
         uint32_t
         GetMemoryCacheLineSize() const
         {
             return m_cache_line_byte_size ;
         }
+
+        void
+        GetStatistics (Statistics &stats) const;
+
+        void
+        ResetStatistics ();
         
         void
         AddInvalidRange (lldb::addr_t base_addr, lldb::addr_t byte_size);
@@ -69,9 +110,27 @@ namespace lldb_private {
         //------------------------------------------------------------------
         Process &m_process;
         uint32_t m_cache_line_byte_size;
-        Mutex m_mutex;
+        mutable Mutex m_mutex;
         BlockMap m_cache;
         InvalidRanges m_invalid_ranges;
+        Statistics m_stats;
+        // State used to detect sequential and strided access patterns
+        lldb::addr_t m_last_miss_addr;      // Address of the last cache line that missed
+        lldb::addr_t m_last_miss_stride;    // Distance between the last two cache lines that missed
+        lldb::addr_t m_next_read_addr;      // Address right after the last cache lines read from the process
+        uint32_t m_read_ahead_line_count;   // Number of cache lines to read on the next sequential miss
+
+        // Must be called with m_mutex locked
+        void
+        FetchCacheLines (std::vector<lldb::addr_t> &line_addrs);
+
+        // Must be called with m_mutex locked
+        uint32_t
+        CalculateLinesToRead (lldb::addr_t line_addr);
+
+        // Must be called with m_mutex locked
+        size_t
+        ReadCacheLines (lldb::addr_t line_addr, uint32_t num_lines, Error &error);
     private:
         DISALLOW_COPY_AND_ASSIGN (MemoryCache);
     };
@@ -101,6 +101,9 @@ public:
     
     void
     SetDetachKeepsStopped (bool keep_stopped);
+
+    uint64_t
+    GetMemoryCacheReadAheadSize () const;
 };
 
 typedef std::shared_ptr<ProcessProperties> ProcessPropertiesSP;
@@ -2794,6 +2797,147 @@ public:
                             void *buf, 
                             size_t size,
                             Error &error);
+
+    //------------------------------------------------------------------
+    /// Actually do the reading of several ranges of memory from a
+    /// process in one request.
+    ///
+    /// Subclasses whose debug connection can read many ranges in a
+    /// single round trip should override this function. The default
+    /// implementation doesn't handle any ranges, which makes
+    /// Process::ReadMemoryRangesFromInferior() read each range
+    /// separately using Process::DoReadMemory().
+    ///
+    /// @param[in] num_ranges
+    ///     The number of entries in \a addrs, \a sizes, \a bufs and
+    ///     \a bytes_read.
+    ///
+    /// @param[in] addrs
+    ///     The load address to start reading each range from.
+    ///
+    /// @param[in] sizes
+    ///     The number of bytes to read for each range.
+    ///
+    /// @param[out] bufs
+    ///     A buffer for each range that is large enough to hold the
+    ///     size of that range.
+    ///
+    /// @param[out] bytes_read
+    ///     The number of bytes that were read into each buffer.
+    ///
+    /// @return
+    ///     The number of ranges, starting at index zero, that were
+    ///     handled. Ranges that weren't handled will be requested
+    ///     again, so subclasses can stop early if their transfer size
+    ///     limits are reached. Zero means ranges can't be read in
+    ///     batches.
+    //------------------------------------------------------------------
+    virtual size_t
+    DoReadMemoryRanges (size_t num_ranges,
+                        const lldb::addr_t *addrs,
+                        const size_t *sizes,
+                        uint8_t *const *bufs,
+                        size_t *bytes_read,
+                        Error &error)
+    {
+        return 0;
+    }
+
+    //------------------------------------------------------------------
+    /// Check whether Process::DoReadMemoryRanges() can read several
+    /// ranges of memory in one request.
+    ///
+    /// Subclasses that override Process::DoReadMemoryRanges() should
+    /// override this function too, so that callers don't set up batched
+    /// reads that would only end up being read one range at a time.
+    //------------------------------------------------------------------
+    virtual bool
+    CanReadMemoryRanges ()
+    {
+        return false;
+    }
+
+    //------------------------------------------------------------------
+    /// Read several ranges of memory from a process, removing any
+    /// traps that may have been inserted into the memory.
+    ///
+    /// The ranges are read with as few requests as possible using
+    /// Process::DoReadMemoryRanges(). If \a allow_fallback is true,
+    /// ranges that can't be read that way are read one at a time
+    /// using Process::ReadMemoryFromInferior().
+    ///
+    /// @return
+    ///     The number of ranges, starting at index zero, that were
+    ///     read. Individual ranges may still have zero bytes read.
+    //------------------------------------------------------------------
+    size_t
+    ReadMemoryRangesFromInferior (size_t num_ranges,
+                                  const lldb::addr_t *addrs,
+                                  const size_t *sizes,
+                                  uint8_t *const *bufs,
+                                  size_t *bytes_read,
+                                  bool allow_fallback,
+                                  Error &error);
+
+    //------------------------------------------------------------------
+    /// Let the process know that memory at each of \a addrs is about
+    /// to be read.
+    ///
+    /// Any of the memory cache lines that contain these addresses and
+    /// aren't already cached are read using as few requests as
+    /// possible. This is only a hint, nothing is read if the process
+    /// can't read multiple ranges of memory at once.
+    //------------------------------------------------------------------
+    void
+    PrefetchMemory (const lldb::addr_t *addrs,
+                    size_t num_addrs);
+
+    //------------------------------------------------------------------
+    /// Get the largest number of bytes that a single call to
+    /// Process::DoReadMemory() can read efficiently.
+    ///
+    /// The memory cache reads ahead up to this many bytes when it sees
+    /// memory being read sequentially. Subclasses that pay a large
+    /// per request cost, like remote connections, should override this
+    /// function. The default of zero disables reading ahead.
+    //------------------------------------------------------------------
+    virtual size_t
+    GetMaxMemoryReadSize ()
+    {
+        return 0;
+    }
+
+    //------------------------------------------------------------------
+    /// Get the largest number of bytes the memory cache reads ahead.
+    ///
+    /// This is the "target.process.memory-cache-read-ahead-size" setting
+    /// if it is set, capped at GetMaxMemoryReadSize() when the process
+    /// plugin has a limit, and GetMaxMemoryReadSize() otherwise.
+    //------------------------------------------------------------------
+    size_t
+    GetMemoryReadAheadSize ();
+
+    //------------------------------------------------------------------
+    /// Get the counters that show how effective the memory cache has
+    /// been for this process.
+    //------------------------------------------------------------------
+    void
+    GetMemoryCacheStatistics (MemoryCache::Statistics &stats) const
+    {
+        m_memory_cache.GetStatistics (stats);
+    }
+
+    void
+    ResetMemoryCacheStatistics ()
+    {
+        m_memory_cache.ResetStatistics ();
+    }
+
+    uint32_t
+    GetMemoryCacheLineSize () const
+    {
+        return m_memory_cache.GetMemoryCacheLineSize ();
+    }
     
     //------------------------------------------------------------------
     /// Reads an unsigned integer of the specified byte size from 
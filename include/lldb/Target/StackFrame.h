@@ -430,6 +430,16 @@ public:
         return m_concrete_frame_index;
     }
 
+    //------------------------------------------------------------------
+    /// Query how the unwinder found the caller of this frame.
+    ///
+    /// @return
+    ///   A short description of the unwind method, e.g. "frame pointer"
+    ///   or "unwind plan", or NULL if the unwinder doesn't say.
+    //------------------------------------------------------------------
+    const char *
+    GetUnwindMethod ();
+
     //------------------------------------------------------------------
     /// Create a ValueObject for a given Variable in this StackFrame.
     ///
@@ -174,6 +174,15 @@ public:
     bool
     GetDisplayExpressionsInCrashlogs () const;
 
+    bool
+    GetLazyDemangling () const;
+
+    FileSpec
+    GetUnwindPlanCachePath () const;
+
+    uint64_t
+    GetUnwindPlanCacheMaxByteSize () const;
+
     LoadScriptFromSymFile
     GetLoadScriptFromSymbolFile() const;
 
@@ -507,6 +516,12 @@ public:
     static FileSpecList
     GetDefaultDebugFileSearchPaths ();
 
+    static FileSpec
+    GetDefaultUnwindPlanCachePath ();
+
+    static uint64_t
+    GetDefaultUnwindPlanCacheMaxByteSize ();
+
     static ArchSpec
     GetDefaultArchitecture ();
 
@@ -1155,6 +1170,28 @@ public:
         return m_persistent_variables;
     }
 
+    //------------------------------------------------------------------
+    /// Cache of user expressions that were parsed and JITed for this
+    /// target, so that evaluating the same expression text in the same
+    /// context again can skip the Clang parse and the JIT. The key is
+    /// built by ClangUserExpression::Evaluate() and describes everything
+    /// the compiled code depends on. The cache is cleared whenever
+    /// modules or symbols are loaded or unloaded, and when the process
+    /// goes away.
+    //------------------------------------------------------------------
+    std::shared_ptr<ClangUserExpression>
+    GetCachedUserExpression (const std::string &key);
+
+    void
+    CacheUserExpression (const std::string &key,
+                         const std::shared_ptr<ClangUserExpression> &user_expression_sp);
+
+    void
+    RemoveCachedUserExpression (const std::string &key);
+
+    void
+    ClearUserExpressionCache ();
+
     //------------------------------------------------------------------
     // Target Stop Hooks
     //------------------------------------------------------------------
@@ -1356,6 +1393,9 @@ protected:
     std::unique_ptr<ClangASTSource> m_scratch_ast_source_ap;
     std::unique_ptr<ClangASTImporter> m_ast_importer_ap;
     ClangPersistentVariables m_persistent_variables;      ///< These are the persistent variables associated with this process for the expression parser.
+    typedef std::map<std::string, std::shared_ptr<ClangUserExpression> > UserExpressionCache;
+    UserExpressionCache m_user_expression_cache;          ///< Parsed and JITed user expressions, see GetCachedUserExpression()
+    Mutex           m_user_expression_cache_mutex;
 
     std::unique_ptr<SourceManager> m_source_manager_ap;
 
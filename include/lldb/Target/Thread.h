@@ -50,6 +50,9 @@ public:
     
     bool
     GetTraceEnabledState() const;
+
+    bool
+    GetFramePointerUnwind() const;
     
     bool
     GetStepInAvoidsNoDebug () const;
@@ -84,6 +84,15 @@ public:
         Mutex::Locker locker(m_unwind_mutex);
         return DoCreateRegisterContextForFrame (frame);
     }
+
+    // A short description of how the caller of frame FRAME_IDX was found,
+    // or NULL if the frame hasn't been unwound or the unwinder doesn't say.
+    const char *
+    GetUnwindMethodAtIndex (uint32_t frame_idx)
+    {
+        Mutex::Locker locker(m_unwind_mutex);
+        return DoGetUnwindMethodAtIndex (frame_idx);
+    }
     
     Thread &
     GetThread()
@@ -109,6 +118,12 @@ protected:
     virtual lldb::RegisterContextSP
     DoCreateRegisterContextForFrame (StackFrame *frame) = 0;
 
+    virtual const char *
+    DoGetUnwindMethodAtIndex (uint32_t frame_idx)
+    {
+        return NULL;
+    }
+
     Thread &m_thread;
     Mutex  m_unwind_mutex;
 private:
@@ -0,0 +1,88 @@
+//===-- TaskPool.h ----------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_TaskPool_h_
+#define liblldb_TaskPool_h_
+
+#if defined(__cplusplus)
+
+#include <stdint.h>
+#include <functional>
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+// TaskPool
+//
+// A small helper for running independent pieces of work on a set of
+// host threads. The work is described as a range of integer indexes
+// and a callback that gets invoked once for each index. Indexes are
+// handed out to the worker threads dynamically so that slow items
+// don't stall the other workers.
+//
+// The callback must be safe to call concurrently from multiple
+// threads for different indexes. All calls have completed when
+// TaskPool::MapOverIndexes() returns.
+//----------------------------------------------------------------------
+class TaskPool
+{
+public:
+    typedef std::function<void(uint32_t idx)> IndexCallback;
+
+    //------------------------------------------------------------------
+    /// Get the number of worker threads that will be used to service
+    /// a large enough range of work.
+    ///
+    /// @return
+    ///     The number of CPUs on the host, or the value that was set
+    ///     using TaskPool::SetMaxNumWorkers() if it was smaller.
+    //------------------------------------------------------------------
+    static uint32_t
+    GetNumWorkers ();
+
+    //------------------------------------------------------------------
+    /// Limit the number of worker threads that are used.
+    ///
+    /// @param[in] max_num_workers
+    ///     The maximum number of threads to use. Zero means use as
+    ///     many threads as there are CPUs and one means run all work
+    ///     on the calling thread.
+    //------------------------------------------------------------------
+    static void
+    SetMaxNumWorkers (uint32_t max_num_workers);
+
+    //------------------------------------------------------------------
+    /// Call \a callback for every index in [\a begin, \a end).
+    ///
+    /// The calling thread also participates in the work, so if only a
+    /// single worker is available, or there is only one index, all
+    /// work is done synchronously without creating any threads.
+    ///
+    /// @param[in] begin
+    ///     The first index to pass to \a callback.
+    ///
+    /// @param[in] end
+    ///     One past the last index to pass to \a callback.
+    ///
+    /// @param[in] callback
+    ///     The function to call for each index.
+    //------------------------------------------------------------------
+    static void
+    MapOverIndexes (uint32_t begin,
+                    uint32_t end,
+                    const IndexCallback &callback);
+
+private:
+    TaskPool () = delete;
+};
+
+} // namespace lldb_private
+
+#endif  // #if defined(__cplusplus)
+#endif  // liblldb_TaskPool_h_
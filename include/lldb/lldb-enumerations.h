@@ -547,6 +547,11 @@ namespace lldb {
         eSectionTypeELFRelocationEntries, // Elf SHT_REL or SHT_REL section
         eSectionTypeELFDynamicLinkInfo,   // Elf SHT_DYNAMIC section
         eSectionTypeEHFrame,
+        eSectionTypeDWARFDebugNames,      // DWARF5 .debug_names accelerator table
+        eSectionTypeDWARFGdbIndex,        // .gdb_index accelerator table
+        eSectionTypeDWARFDebugAddr,       // Address table for split DWARF DW_FORM_GNU_addr_index values
+        eSectionTypeDWARFDebugStrOffsets, // String offsets for split DWARF DW_FORM_GNU_str_index values
+        eSectionTypeDWARFDebugCUIndex,    // Compile unit index of a .dwp split DWARF package
         eSectionTypeOther
         
     } SectionType;
@@ -231,6 +231,11 @@ SBDebugger::MemoryPressureDetected ()
     }
     
     ModuleList::RemoveOrphanSharedModules(mandatory);
+    const size_t bytes_released = ModuleList::ReleaseUnusedSharedModuleMemory(mandatory);
+    if (log)
+    {
+        log->Printf ("SBDebugger::MemoryPressureDetected () released %" PRIu64 " bytes of debug information", (uint64_t)bytes_released);
+    }
 }
 
 SBDebugger::SBDebugger () :
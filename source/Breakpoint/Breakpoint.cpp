@@ -25,9 +25,11 @@
 #include "lldb/Core/Section.h"
 #include "lldb/Core/Stream.h"
 #include "lldb/Core/StreamString.h"
+#include "lldb/Host/TimeValue.h"
 #include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/ThreadSpec.h"
+#include "lldb/Utility/TaskPool.h"
 #include "lldb/lldb-private-log.h"
 #include "llvm/Support/Casting.h"
 
@@ -345,14 +347,22 @@ void
 Breakpoint::ResolveBreakpoint ()
 {
     if (m_resolver_sp)
+    {
+        TimeValue start_time (TimeValue::Now());
         m_resolver_sp->ResolveBreakpoint(*m_filter_sp);
+        m_resolver_sp->AddResolveTime ((TimeValue::Now() - start_time) / TimeValue::NanoSecPerMicroSec);
+    }
 }
 
 void
 Breakpoint::ResolveBreakpointInModules (ModuleList &module_list)
 {
     if (m_resolver_sp)
+    {
+        TimeValue start_time (TimeValue::Now());
         m_resolver_sp->ResolveBreakpointInModules(*m_filter_sp, module_list);
+        m_resolver_sp->AddResolveTime ((TimeValue::Now() - start_time) / TimeValue::NanoSecPerMicroSec);
+    }
 }
 
 void
@@ -371,51 +381,19 @@ Breakpoint::ModulesChanged (ModuleList &module_list, bool load, bool delete_loca
     Mutex::Locker modules_mutex(module_list.GetMutex());
     if (load)
     {
-        // The logic for handling new modules is:
-        // 1) If the filter rejects this module, then skip it.
-        // 2) Run through the current location list and if there are any locations
-        //    for that module, we mark the module as "seen" and we don't try to re-resolve
-        //    breakpoint locations for that module.
-        //    However, we do add breakpoint sites to these locations if needed.
-        // 3) If we don't see this module in our breakpoint location list, call ResolveInModules.
-
         ModuleList new_modules;  // We'll stuff the "unseen" modules in this list, and then resolve
                                  // them after the locations pass.  Have to do it this way because
                                  // resolving breakpoints will add new locations potentially.
 
-        const size_t num_locs = m_locations.GetSize();
-        size_t num_modules = module_list.GetSize();
-        for (size_t i = 0; i < num_modules; i++)
+        std::vector<bool> unseen_modules;
+        if (ResolveSitesInLoadedModules (module_list, unseen_modules) > 0)
         {
-            bool seen = false;
-            ModuleSP module_sp (module_list.GetModuleAtIndexUnlocked (i));
-            if (!m_filter_sp->ModulePasses (module_sp))
-                continue;
-
-            for (size_t loc_idx = 0; loc_idx < num_locs; loc_idx++)
+            const size_t num_modules = module_list.GetSize();
+            for (size_t i = 0; i < num_modules; i++)
             {
-                BreakpointLocationSP break_loc = m_locations.GetByIndex(loc_idx);
-                if (!break_loc->IsEnabled())
-                    continue;
-                SectionSP section_sp (break_loc->GetAddress().GetSection());
-                if (!section_sp || section_sp->GetModule() == module_sp)
-                {
-                    if (!seen)
-                        seen = true;
-
-                    if (!break_loc->ResolveBreakpointSite())
-                    {
-                        Log *log (lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
-                        if (log)
-                            log->Printf ("Warning: could not set breakpoint site for breakpoint location %d of breakpoint %d.\n",
-                                         break_loc->GetID(), GetID());
-                    }
-                }
+                if (unseen_modules[i])
+                    new_modules.AppendIfNeeded (module_list.GetModuleAtIndexUnlocked (i));
             }
-
-            if (!seen)
-                new_modules.AppendIfNeeded (module_sp);
-
         }
         
         if (new_modules.GetSize() > 0)
@@ -498,6 +476,207 @@ Breakpoint::ModulesChanged (ModuleList &module_list, bool load, bool delete_loca
     }
 }
 
+size_t
+Breakpoint::ResolveSitesInLoadedModules (ModuleList &module_list, std::vector<bool> &unseen_modules)
+{
+    // The logic for handling new modules is:
+    // 1) If the filter rejects this module, then skip it.
+    // 2) Run through the current location list and if there are any locations
+    //    for that module, we mark the module as "seen" and we don't try to re-resolve
+    //    breakpoint locations for that module.
+    //    However, we do add breakpoint sites to these locations if needed.
+    // 3) If we don't see this module in our breakpoint location list, it has to be searched.
+
+    const size_t num_locs = m_locations.GetSize();
+    const size_t num_modules = module_list.GetSize();
+    size_t num_unseen = 0;
+    unseen_modules.assign (num_modules, false);
+    for (size_t i = 0; i < num_modules; i++)
+    {
+        bool seen = false;
+        ModuleSP module_sp (module_list.GetModuleAtIndexUnlocked (i));
+        if (!m_filter_sp->ModulePasses (module_sp))
+            continue;
+
+        for (size_t loc_idx = 0; loc_idx < num_locs; loc_idx++)
+        {
+            BreakpointLocationSP break_loc = m_locations.GetByIndex(loc_idx);
+            if (!break_loc->IsEnabled())
+                continue;
+            SectionSP section_sp (break_loc->GetAddress().GetSection());
+            if (!section_sp || section_sp->GetModule() == module_sp)
+            {
+                if (!seen)
+                    seen = true;
+
+                if (!break_loc->ResolveBreakpointSite())
+                {
+                    Log *log (lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+                    if (log)
+                        log->Printf ("Warning: could not set breakpoint site for breakpoint location %d of breakpoint %d.\n",
+                                     break_loc->GetID(), GetID());
+                }
+            }
+        }
+
+        if (!seen)
+        {
+            unseen_modules[i] = true;
+            ++num_unseen;
+        }
+    }
+    return num_unseen;
+}
+
+void
+Breakpoint::ModulesDidLoad (const std::vector<BreakpointSP> &breakpoints, ModuleList &module_list)
+{
+    // Work on a copy so the tasks below don't have to hold the mutex of the
+    // target's module list.
+    ModuleList modules (module_list);
+    const size_t num_modules = modules.GetSize();
+    if (num_modules < 2 || TaskPool::GetNumWorkers() < 2)
+    {
+        for (size_t i = 0; i < breakpoints.size(); ++i)
+            breakpoints[i]->ModulesChanged (modules, true);
+        return;
+    }
+
+    // Symbol files can't be searched from more than one thread at a time, so
+    // rather than running the breakpoints in parallel we run each module on
+    // its own task, and have that task search the module for every breakpoint
+    // that needs it.
+    struct PendingBreakpoint
+    {
+        BreakpointSP bp_sp;
+        std::vector<bool> unseen_modules;
+        size_t first_new_idx;
+        bool resolved_serially;
+        BreakpointEventData *new_locations_event;
+    };
+
+    std::vector<PendingBreakpoint> pending;
+    for (size_t i = 0; i < breakpoints.size(); ++i)
+    {
+        BreakpointSP bp_sp (breakpoints[i]);
+        PendingBreakpoint pending_bp;
+        if (bp_sp->ResolveSitesInLoadedModules (modules, pending_bp.unseen_modules) == 0)
+            continue;
+
+        pending_bp.bp_sp = bp_sp;
+        pending_bp.first_new_idx = bp_sp->m_locations.GetSize();
+        pending_bp.resolved_serially = false;
+        pending_bp.new_locations_event = NULL;
+        if (!bp_sp->IsInternal())
+        {
+            pending_bp.new_locations_event = new BreakpointEventData (eBreakpointEventTypeLocationsAdded, bp_sp);
+            bp_sp->m_locations.StartRecordingNewLocations(pending_bp.new_locations_event->GetBreakpointLocationCollection());
+        }
+        bp_sp->m_locations.SetDeferSiteResolution (true);
+        pending.push_back (pending_bp);
+    }
+
+    if (pending.empty())
+        return;
+
+    // Resolvers that search the target as a whole rather than module by
+    // module only get called once for all the new modules. Resolvers that
+    // aren't safe to run on several modules at once (see
+    // BreakpointResolver::CanResolveModulesInParallel()) search the new
+    // modules one after another here too, just like ModulesChanged() would.
+    for (size_t i = 0; i < pending.size(); ++i)
+    {
+        Breakpoint &bp = *pending[i].bp_sp;
+        if (!bp.m_resolver_sp ||
+            bp.m_resolver_sp->GetDepth() == Searcher::eDepthTarget ||
+            !bp.m_resolver_sp->CanResolveModulesInParallel())
+        {
+            pending[i].resolved_serially = true;
+            ModuleList new_modules;
+            for (size_t module_idx = 0; module_idx < num_modules; ++module_idx)
+            {
+                if (pending[i].unseen_modules[module_idx])
+                    new_modules.AppendIfNeeded (modules.GetModuleAtIndex (module_idx));
+            }
+            bp.ResolveBreakpointInModules (new_modules);
+            pending[i].unseen_modules.assign (num_modules, false);
+        }
+    }
+
+    // The tasks run side by side, so the time each of them takes doesn't
+    // say how long the breakpoints took to resolve. Time the whole parallel
+    // search instead and count it as one search for every breakpoint that
+    // took part.
+    TimeValue start_time (TimeValue::Now());
+    for (size_t i = 0; i < pending.size(); ++i)
+    {
+        if (!pending[i].resolved_serially)
+            pending[i].bp_sp->m_resolver_sp->WillResolveModulesInParallel();
+    }
+
+    TaskPool::MapOverIndexes (0, num_modules, [&modules, &pending] (uint32_t module_idx)
+    {
+        ModuleList module_list;
+        module_list.Append (modules.GetModuleAtIndex (module_idx));
+        for (size_t i = 0; i < pending.size(); ++i)
+        {
+            if (pending[i].unseen_modules[module_idx])
+            {
+                Breakpoint &bp = *pending[i].bp_sp;
+                bp.m_resolver_sp->ResolveBreakpointInModules (*bp.m_filter_sp, module_list);
+            }
+        }
+    });
+
+    for (size_t i = 0; i < pending.size(); ++i)
+    {
+        if (!pending[i].resolved_serially)
+        {
+            Breakpoint &bp = *pending[i].bp_sp;
+            bp.m_resolver_sp->DidResolveModulesInParallel (*bp.m_filter_sp);
+        }
+    }
+    const uint64_t parallel_resolve_usec = (TimeValue::Now() - start_time) / TimeValue::NanoSecPerMicroSec;
+    for (size_t i = 0; i < pending.size(); ++i)
+    {
+        if (!pending[i].resolved_serially)
+            pending[i].bp_sp->m_resolver_sp->AddResolveTime (parallel_resolve_usec);
+    }
+
+    // Now put the new locations in the order a serial search would have found
+    // them in, and set their breakpoint sites.
+    for (size_t i = 0; i < pending.size(); ++i)
+    {
+        Breakpoint &bp = *pending[i].bp_sp;
+        bp.m_locations.SetDeferSiteResolution (false);
+        if (!pending[i].resolved_serially)
+            bp.m_locations.SortLocationsByModule (pending[i].first_new_idx, modules);
+
+        const size_t num_locs = bp.m_locations.GetSize();
+        for (size_t loc_idx = pending[i].first_new_idx; loc_idx < num_locs; ++loc_idx)
+        {
+            BreakpointLocationSP break_loc (bp.m_locations.GetByIndex (loc_idx));
+            if (!break_loc->ResolveBreakpointSite())
+            {
+                Log *log (lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+                if (log)
+                    log->Printf ("Warning: could not set breakpoint site for breakpoint location %d of breakpoint %d.\n",
+                                 break_loc->GetID(), bp.GetID());
+            }
+        }
+
+        BreakpointEventData *new_locations_event = pending[i].new_locations_event;
+        if (new_locations_event)
+        {
+            bp.m_locations.StopRecordingNewLocations();
+            if (new_locations_event->GetBreakpointLocationCollection().GetSize() != 0)
+                bp.SendBreakpointChangedEvent (new_locations_event);
+            else
+                delete new_locations_event;
+        }
+    }
+}
+
 void
 Breakpoint::ModuleReplaced (ModuleSP old_module_sp, ModuleSP new_module_sp)
 {
@@ -620,6 +799,13 @@ Breakpoint::GetDescription (Stream *s, lldb::DescriptionLevel level, bool show_l
         s->EOL ();
             //s->Indent();
         GetOptions()->GetDescription(s, level);
+        if (m_resolver_sp)
+        {
+            s->Indent();
+            s->Printf ("Resolve time: %.3f ms in %u searches.\n",
+                       m_resolver_sp->GetResolveTimeInMicroSeconds() / 1000.0,
+                       m_resolver_sp->GetNumResolves());
+        }
         break;
 
     default: 
@@ -213,6 +213,13 @@ void
 BreakpointList::UpdateBreakpoints (ModuleList& module_list, bool added, bool delete_locations)
 {
     Mutex::Locker locker(m_mutex);
+    if (added)
+    {
+        std::vector<BreakpointSP> breakpoints (m_breakpoints.begin(), m_breakpoints.end());
+        Breakpoint::ModulesDidLoad (breakpoints, module_list);
+        return;
+    }
+
     for (const auto &bp_sp : m_breakpoints)
         bp_sp->ModulesChanged (module_list, added, delete_locations);
 
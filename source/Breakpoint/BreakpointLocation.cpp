@@ -51,6 +51,8 @@ BreakpointLocation::BreakpointLocation
     m_owner (owner),
     m_options_ap (),
     m_bp_site_sp (),
+    m_condition_program_ap (),
+    m_condition_program_hash (0),
     m_condition_mutex ()
 {
     if (check_for_resolver)
@@ -272,9 +274,32 @@ BreakpointLocation::ConditionSaysStop (ExecutionContext &exe_ctx, Error &error)
     if (!condition_text)
     {
         m_user_expression_sp.reset();
+        m_condition_program_ap.reset();
         return false;
     }
     
+    // Simple conditions can be evaluated by reading the variables they
+    // compare, which is much cheaper than running the condition through
+    // the expression parser on every hit. If that doesn't work out for
+    // this hit, fall back to the full expression.
+    if (!m_condition_program_ap || condition_hash != m_condition_program_hash)
+    {
+        m_condition_program_ap.reset(new ConditionProgram(condition_text));
+        m_condition_program_hash = condition_hash;
+    }
+    
+    if (m_condition_program_ap->IsValid())
+    {
+        bool condition_result = false;
+        if (m_condition_program_ap->Evaluate(exe_ctx, condition_result))
+        {
+            if (log)
+                log->Printf("Condition evaluated without the expression parser, result is %s.\n",
+                            condition_result ? "true" : "false");
+            return condition_result;
+        }
+    }
+    
     if (condition_hash != m_condition_hash ||
         !m_user_expression_sp ||
         !m_user_expression_sp->MatchesContext(exe_ctx))
@@ -411,6 +436,12 @@ BreakpointLocation::IgnoreCountShouldStop()
     return true;
 }
 
+void
+BreakpointLocation::BumpHitCount (uint32_t count)
+{
+    m_hit_count += count;
+}
+
 const BreakpointOptions *
 BreakpointLocation::GetOptionsNoCreate () const
 {
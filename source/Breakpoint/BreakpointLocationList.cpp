@@ -10,6 +10,9 @@
 
 // C Includes
 // C++ Includes
+#include <algorithm>
+#include <map>
+
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Breakpoint/BreakpointLocationList.h"
@@ -18,6 +21,7 @@
 #include "lldb/Breakpoint/Breakpoint.h"
 #include "lldb/Core/ArchSpec.h"
 #include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
 #include "lldb/Core/Section.h"
 #include "lldb/Target/SectionLoadList.h"
 #include "lldb/Target/Target.h"
@@ -32,7 +36,8 @@ BreakpointLocationList::BreakpointLocationList(Breakpoint &owner) :
     m_address_to_location (),
     m_mutex (Mutex::eMutexTypeRecursive),
     m_next_id (0),
-    m_new_location_recorder (NULL)
+    m_new_location_recorder (NULL),
+    m_defer_site_resolution (false)
 {
 }
 
@@ -259,7 +264,8 @@ BreakpointLocationList::AddLocation (const Address &addr, bool resolve_indirect_
 		bp_loc_sp = Create (addr, resolve_indirect_symbols);
 		if (bp_loc_sp)
 		{
-	    	bp_loc_sp->ResolveBreakpointSite();
+            if (!m_defer_site_resolution)
+                bp_loc_sp->ResolveBreakpointSite();
 
 		    if (new_location)
 	    	    *new_location = true;
@@ -345,3 +351,50 @@ BreakpointLocationList::StopRecordingNewLocations ()
     m_new_location_recorder = NULL;
 }
 
+void
+BreakpointLocationList::SetDeferSiteResolution (bool defer)
+{
+    Mutex::Locker locker (m_mutex);
+    m_defer_site_resolution = defer;
+}
+
+void
+BreakpointLocationList::SortLocationsByModule (size_t start_idx, const ModuleList &modules)
+{
+    Mutex::Locker locker (m_mutex);
+    const size_t num_locations = m_locations.size();
+    if (start_idx + 1 >= num_locations)
+        return;
+
+    const size_t num_modules = modules.GetSize();
+    std::map<const Module *, size_t> module_order;
+    for (size_t i = 0; i < num_modules; ++i)
+        module_order[modules.GetModulePointerAtIndex(i)] = i;
+
+    // Locations in modules that aren't in the list go last
+    std::vector<std::pair<size_t, BreakpointLocationSP> > sorted_locations;
+    sorted_locations.reserve (num_locations - start_idx);
+    for (size_t i = start_idx; i < num_locations; ++i)
+    {
+        ModuleSP module_sp (m_locations[i]->GetAddress().GetModule());
+        std::map<const Module *, size_t>::const_iterator pos = module_order.find (module_sp.get());
+        sorted_locations.push_back (std::make_pair (pos == module_order.end() ? num_modules : pos->second, m_locations[i]));
+    }
+    std::stable_sort (sorted_locations.begin(),
+                      sorted_locations.end(),
+                      [] (const std::pair<size_t, BreakpointLocationSP> &lhs,
+                          const std::pair<size_t, BreakpointLocationSP> &rhs) -> bool
+                      {
+                          return lhs.first < rhs.first;
+                      });
+
+    // The new locations were given the IDs at the end of the ID range,
+    // hand them out again in the sorted order.
+    lldb::break_id_t next_id = m_next_id - (lldb::break_id_t)(num_locations - start_idx);
+    for (size_t i = start_idx; i < num_locations; ++i)
+    {
+        m_locations[i] = sorted_locations[i - start_idx].second;
+        m_locations[i]->m_loc_id = ++next_id;
+    }
+}
+
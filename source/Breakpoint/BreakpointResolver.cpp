@@ -35,7 +35,9 @@ using namespace lldb;
 //----------------------------------------------------------------------
 BreakpointResolver::BreakpointResolver (Breakpoint *bkpt, const unsigned char resolverTy) :
     m_breakpoint (bkpt),
-    SubclassID (resolverTy)
+    SubclassID (resolverTy),
+    m_resolve_time_usec (0),
+    m_num_resolves (0)
 {
 }
 
@@ -72,10 +72,13 @@ BreakpointResolverFileLine::SearchCallback
     // So we go through the match list and pull out the sets that have the same file spec in their line_entry
     // and treat each set separately.
     
-    const size_t num_comp_units = context.module_sp->GetNumCompileUnits();
+    // Only look at the compile units that refer to a file with the right
+    // basename, the others can't have any line entries for it.
+    std::vector<uint32_t> cu_indexes;
+    const size_t num_comp_units = context.module_sp->FindCompileUnitIndexesForSourceFile (m_file_spec, cu_indexes);
     for (size_t i = 0; i < num_comp_units; i++)
     {
-        CompUnitSP cu_sp (context.module_sp->GetCompileUnitAtIndex (i));
+        CompUnitSP cu_sp (context.module_sp->GetCompileUnitAtIndex (cu_indexes[i]));
         if (cu_sp)
         {
             if (filter.CompUnitPasses(*cu_sp))
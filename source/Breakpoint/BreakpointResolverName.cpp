@@ -36,7 +36,10 @@ BreakpointResolverName::BreakpointResolverName (Breakpoint *bkpt,
     m_class_name (),
     m_regex (),
     m_match_type (type),
-    m_skip_prologue (skip_prologue)
+    m_skip_prologue (skip_prologue),
+    m_defer_reexported_symbols (false),
+    m_deferred_mutex (),
+    m_deferred_reexported_symbols ()
 {
     
     if (m_match_type == Breakpoint::Regexp)
@@ -62,7 +65,10 @@ BreakpointResolverName::BreakpointResolverName (Breakpoint *bkpt,
                                                 bool skip_prologue) :
     BreakpointResolver (bkpt, BreakpointResolver::NameResolver),
     m_match_type (Breakpoint::Exact),
-    m_skip_prologue (skip_prologue)
+    m_skip_prologue (skip_prologue),
+    m_defer_reexported_symbols (false),
+    m_deferred_mutex (),
+    m_deferred_reexported_symbols ()
 {
     for (size_t i = 0; i < num_names; i++)
     {
@@ -76,7 +82,10 @@ BreakpointResolverName::BreakpointResolverName (Breakpoint *bkpt,
                                                 bool skip_prologue) :
     BreakpointResolver (bkpt, BreakpointResolver::NameResolver),
     m_match_type (Breakpoint::Exact),
-    m_skip_prologue (skip_prologue)
+    m_skip_prologue (skip_prologue),
+    m_defer_reexported_symbols (false),
+    m_deferred_mutex (),
+    m_deferred_reexported_symbols ()
 {
     for (const std::string& name : names)
     {
@@ -91,7 +100,10 @@ BreakpointResolverName::BreakpointResolverName (Breakpoint *bkpt,
     m_class_name (NULL),
     m_regex (func_regex),
     m_match_type (Breakpoint::Regexp),
-    m_skip_prologue (skip_prologue)
+    m_skip_prologue (skip_prologue),
+    m_defer_reexported_symbols (false),
+    m_deferred_mutex (),
+    m_deferred_reexported_symbols ()
 {
 }
 
@@ -107,7 +119,10 @@ BreakpointResolverName::BreakpointResolverName
     m_class_name (class_name),
     m_regex (),
     m_match_type (type),
-    m_skip_prologue (skip_prologue)
+    m_skip_prologue (skip_prologue),
+    m_defer_reexported_symbols (false),
+    m_deferred_mutex (),
+    m_deferred_reexported_symbols ()
 {
     LookupInfo lookup;
     lookup.name.SetCString(method);
@@ -293,6 +308,15 @@ BreakpointResolverName::SearchCallback
                 {
                     if (sc.symbol->GetType() == eSymbolTypeReExported)
                     {
+                        // Resolving a re-exported symbol searches other
+                        // modules, which isn't allowed while modules are
+                        // searched in parallel.
+                        if (m_defer_reexported_symbols)
+                        {
+                            Mutex::Locker locker (m_deferred_mutex);
+                            m_deferred_reexported_symbols.push_back (sc.symbol);
+                            continue;
+                        }
                         const Symbol *actual_symbol = sc.symbol->ResolveReExportedSymbol(m_breakpoint->GetTarget());
                         if (actual_symbol)
                         {
@@ -337,6 +361,56 @@ BreakpointResolverName::SearchCallback
     return Searcher::eCallbackReturnContinue;
 }
 
+void
+BreakpointResolverName::WillResolveModulesInParallel ()
+{
+    m_defer_reexported_symbols = true;
+}
+
+void
+BreakpointResolverName::DidResolveModulesInParallel (SearchFilter &filter)
+{
+    m_defer_reexported_symbols = false;
+    std::vector<Symbol *> symbols;
+    {
+        Mutex::Locker locker (m_deferred_mutex);
+        symbols.swap (m_deferred_reexported_symbols);
+    }
+    for (size_t i = 0; i < symbols.size(); ++i)
+        AddReExportedSymbolLocation (filter, symbols[i]);
+}
+
+void
+BreakpointResolverName::AddReExportedSymbolLocation (SearchFilter &filter, Symbol *symbol)
+{
+    const Symbol *actual_symbol = symbol->ResolveReExportedSymbol(m_breakpoint->GetTarget());
+    if (!actual_symbol)
+        return;
+
+    Address break_addr (actual_symbol->GetAddress());
+    if (m_skip_prologue && break_addr.IsValid())
+    {
+        const uint32_t prologue_byte_size = symbol->GetPrologueByteSize();
+        if (prologue_byte_size)
+            break_addr.SetOffset(break_addr.GetOffset() + prologue_byte_size);
+    }
+
+    if (break_addr.IsValid() && filter.AddressPasses(break_addr))
+    {
+        bool new_location;
+        BreakpointLocationSP bp_loc_sp (m_breakpoint->AddLocation(break_addr, &new_location));
+        if (bp_loc_sp)
+            bp_loc_sp->SetIsReExported(true);
+        Log *log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+        if (log && bp_loc_sp && new_location && !m_breakpoint->IsInternal())
+        {
+            StreamString s;
+            bp_loc_sp->GetDescription(&s, lldb::eDescriptionLevelVerbose);
+            log->Printf ("Added location: %s\n", s.GetData());
+        }
+    }
+}
+
 Searcher::Depth
 BreakpointResolverName::GetDepth()
 {
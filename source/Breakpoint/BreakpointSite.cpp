@@ -192,6 +192,16 @@ BreakpointSite::GetOwnerAtIndex (size_t index)
     return m_owners.GetByIndex (index);
 }
 
+void
+BreakpointSite::BumpHitCounts (uint32_t count)
+{
+    Mutex::Locker locker(m_owners_mutex);
+    m_hit_count += count;
+    const size_t owner_count = m_owners.GetSize();
+    for (size_t i = 0; i < owner_count; i++)
+        m_owners.GetByIndex(i)->BumpHitCount (count);
+}
+
 bool
 BreakpointSite::ValidForThisThread (Thread *thread)
 {
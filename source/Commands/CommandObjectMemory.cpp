@@ -1668,6 +1668,125 @@ protected:
 };
 
 
+//----------------------------------------------------------------------
+// Show the memory cache statistics for the current process
+//----------------------------------------------------------------------
+class CommandObjectMemoryCacheStats : public CommandObjectParsed
+{
+public:
+    class CommandOptions : public Options
+    {
+    public:
+
+        CommandOptions (CommandInterpreter &interpreter) :
+            Options (interpreter)
+        {
+            OptionParsingStarting ();
+        }
+
+        ~CommandOptions ()
+        {
+        }
+
+        Error
+        SetOptionValue (uint32_t option_idx, const char *option_arg)
+        {
+            Error error;
+            const int short_option = m_getopt_table[option_idx].val;
+
+            switch (short_option)
+            {
+                case 'r':
+                    m_reset = true;
+                    break;
+                default:
+                    error.SetErrorStringWithFormat("invalid short option character '%c'", short_option);
+                    break;
+            }
+            return error;
+        }
+
+        void
+        OptionParsingStarting ()
+        {
+            m_reset = false;
+        }
+
+        const OptionDefinition*
+        GetDefinitions ()
+        {
+            return g_option_table;
+        }
+
+        // Options table: Required for subclasses of Options.
+
+        static OptionDefinition g_option_table[];
+
+        // Instance variables to hold the values for command options.
+        bool m_reset;
+    };
+
+    CommandObjectMemoryCacheStats (CommandInterpreter &interpreter) :
+        CommandObjectParsed (interpreter,
+                             "memory cache-stats",
+                             "Show how effective the memory cache of the current process has been.",
+                             "memory cache-stats [--reset]",
+                             eFlagRequiresProcess),
+        m_options (interpreter)
+    {
+    }
+
+    ~CommandObjectMemoryCacheStats ()
+    {
+    }
+
+    Options *
+    GetOptions ()
+    {
+        return &m_options;
+    }
+
+protected:
+    bool
+    DoExecute (Args& command, CommandReturnObject &result)
+    {
+        Process *process = m_exe_ctx.GetProcessPtr();
+        MemoryCache::Statistics stats;
+        process->GetMemoryCacheStatistics (stats);
+
+        Stream &strm = result.GetOutputStream();
+        const uint64_t num_lines_used = stats.num_line_hits + stats.num_line_misses;
+        strm.Printf ("Memory cache statistics for process %" PRIu64 ":\n", process->GetID());
+        strm.Printf ("  cache line size:         %u bytes\n", process->GetMemoryCacheLineSize());
+        strm.Printf ("  max read-ahead size:     %" PRIu64 " bytes\n", (uint64_t)process->GetMemoryReadAheadSize());
+        strm.Printf ("  cache line hits:         %" PRIu64 "\n", stats.num_line_hits);
+        strm.Printf ("  cache line misses:       %" PRIu64 "\n", stats.num_line_misses);
+        if (num_lines_used > 0)
+            strm.Printf ("  hit rate:                %.1f%%\n", (double)stats.num_line_hits * 100.0 / (double)num_lines_used);
+        strm.Printf ("  lines read ahead:        %" PRIu64 "\n", stats.num_read_ahead_lines);
+        strm.Printf ("  lines prefetched:        %" PRIu64 "\n", stats.num_prefetched_lines);
+        strm.Printf ("  uncached reads:          %" PRIu64 "\n", stats.num_uncached_reads);
+        strm.Printf ("  process reads:           %" PRIu64 "\n", stats.num_process_reads);
+        strm.Printf ("  process bytes read:      %" PRIu64 "\n", stats.num_process_bytes_read);
+
+        if (m_options.m_reset)
+            process->ResetMemoryCacheStatistics ();
+
+        result.SetStatus (eReturnStatusSuccessFinishResult);
+        return true;
+    }
+
+    CommandOptions m_options;
+};
+
+OptionDefinition
+CommandObjectMemoryCacheStats::CommandOptions::g_option_table[] =
+{
+{ LLDB_OPT_SET_1, false, "reset", 'r', OptionParser::eNoArgument, NULL, 0, eArgTypeNone, "Reset the statistics to zero after showing them." },
+{ 0, false, NULL, 0, 0, NULL, 0, eArgTypeNone, NULL }
+};
+
+
 //-------------------------------------------------------------------------
 // CommandObjectMemory
 //-------------------------------------------------------------------------
@@ -1678,6 +1797,7 @@ CommandObjectMemory::CommandObjectMemory (CommandInterpreter &interpreter) :
                             "A set of commands for operating on memory.",
                             "memory <subcommand> [<subcommand-options>]")
 {
+    LoadSubCommand ("cache-stats", CommandObjectSP (new CommandObjectMemoryCacheStats (interpreter)));
     LoadSubCommand ("find", CommandObjectSP (new CommandObjectMemoryFind (interpreter)));
     LoadSubCommand ("read",  CommandObjectSP (new CommandObjectMemoryRead (interpreter)));
     LoadSubCommand ("write", CommandObjectSP (new CommandObjectMemoryWrite (interpreter)));
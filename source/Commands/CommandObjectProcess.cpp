@@ -13,6 +13,7 @@
 
 // C Includes
 // C++ Includes
+#include <map>
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Breakpoint/Breakpoint.h"
@@ -21,16 +22,21 @@
 #include "lldb/Core/State.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/PluginManager.h"
+#include "lldb/Core/StreamFile.h"
+#include "lldb/Core/StreamString.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Interpreter/Args.h"
 #include "lldb/Interpreter/Options.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
 #include "lldb/Interpreter/CommandReturnObject.h"
+#include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Target/Platform.h"
 #include "lldb/Target/Process.h"
+#include "lldb/Target/SectionLoadList.h"
 #include "lldb/Target/StopInfo.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
+#include "lldb/Target/Unwind.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -1425,6 +1431,491 @@ protected:
     }
 };
 
+//-------------------------------------------------------------------------
+// CommandObjectProcessSample
+//-------------------------------------------------------------------------
+#pragma mark CommandObjectProcessSample
+
+class CommandObjectProcessSample : public CommandObjectParsed
+{
+public:
+    class CommandOptions : public Options
+    {
+    public:
+        
+        CommandOptions (CommandInterpreter &interpreter) :
+            Options(interpreter)
+        {
+            // Keep default values of all options in one place: OptionParsingStarting ()
+            OptionParsingStarting ();
+        }
+
+        ~CommandOptions ()
+        {
+        }
+
+        Error
+        SetOptionValue (uint32_t option_idx, const char *option_arg)
+        {
+            Error error;
+            const int short_option = m_getopt_table[option_idx].val;
+            bool success = false;
+            switch (short_option)
+            {
+                case 'c':
+                    m_count = Args::StringToUInt32 (option_arg, 0, 0, &success);
+                    if (!success || m_count == 0)
+                        error.SetErrorStringWithFormat ("invalid sample count: \"%s\"", option_arg);
+                    break;
+
+                case 'i':
+                    m_interval_msec = Args::StringToUInt32 (option_arg, 0, 0, &success);
+                    if (!success)
+                        error.SetErrorStringWithFormat ("invalid sample interval: \"%s\"", option_arg);
+                    break;
+
+                case 'd':
+                    m_max_depth = Args::StringToUInt32 (option_arg, 0, 0, &success);
+                    if (!success || m_max_depth == 0)
+                        error.SetErrorStringWithFormat ("invalid stack depth: \"%s\"", option_arg);
+                    break;
+
+                case 'f':
+                    m_folded = true;
+                    break;
+
+                case 'o':
+                    m_outfile.assign (option_arg);
+                    break;
+
+                default:
+                    error.SetErrorStringWithFormat("invalid short option character '%c'", short_option);
+                    break;
+            }
+            return error;
+        }
+
+        void
+        OptionParsingStarting ()
+        {
+            m_count = 100;
+            m_interval_msec = 10;
+            m_max_depth = 128;
+            m_folded = false;
+            m_outfile.clear();
+        }
+
+        const OptionDefinition*
+        GetDefinitions ()
+        {
+            return g_option_table;
+        }
+
+        // Options table: Required for subclasses of Options.
+
+        static OptionDefinition g_option_table[];
+
+        // Instance variables to hold the values for command options.
+        uint32_t m_count;
+        uint32_t m_interval_msec;
+        uint32_t m_max_depth;
+        bool m_folded;
+        std::string m_outfile;
+    };
+
+    CommandObjectProcessSample (CommandInterpreter &interpreter) :
+        CommandObjectParsed (interpreter,
+                             "process sample",
+                             "Periodically stop the current process, record the stack of every thread and report where the threads spent their time.",
+                             "process sample [<cmd-options>]",
+                             eFlagRequiresProcess      |
+                             eFlagTryTargetAPILock     |
+                             eFlagProcessMustBeLaunched),
+        m_options (interpreter)
+    {
+        SetHelpLong ("The process is stopped every <interval> milliseconds and only the pc values of the stack of every thread are recorded "
+                     "while it is stopped; the stacks are symbolicated once all the samples have been taken.  "
+                     "The process is left in the state it was found in.\n"
+                     "The time spent walking the stacks dominates how long each sample keeps the process stopped, "
+                     "setting target.process.thread.frame-pointer-unwind to true shortens it for code built with frame pointers.\n"
+                     "The report is a call tree for every thread, or with --folded one line per distinct stack in the "
+                     "folded format that flame graph tools take as input.\n");
+    }
+
+    ~CommandObjectProcessSample ()
+    {
+    }
+
+    Options *
+    GetOptions ()
+    {
+        return &m_options;
+    }
+
+protected:
+    // The pc values of one thread's stack, youngest frame first, are
+    // stored in m_pcs starting at first_pc_idx.
+    struct StackSample
+    {
+        uint32_t thread_index_id;
+        lldb::tid_t tid;
+        size_t first_pc_idx;
+        uint32_t num_pcs;
+    };
+
+    struct CallTreeNode
+    {
+        CallTreeNode (const ConstString &n) :
+            name (n),
+            count (0),
+            children ()
+        {
+        }
+
+        ConstString name;
+        uint32_t count;
+        std::map<const char *, size_t> children;   // Child name to index in m_nodes
+    };
+
+    // Sorts node indexes by descending sample count.
+    struct CallTreeNodeCountGreater
+    {
+        CallTreeNodeCountGreater (const std::vector<CallTreeNode> &nodes) :
+            m_nodes (nodes)
+        {
+        }
+
+        bool
+        operator () (size_t lhs, size_t rhs) const
+        {
+            return m_nodes[lhs].count > m_nodes[rhs].count;
+        }
+
+        const std::vector<CallTreeNode> &m_nodes;
+    };
+
+    Error
+    ResumeProcess (Process *process)
+    {
+        {
+            Mutex::Locker locker (process->GetThreadList().GetMutex());
+            const uint32_t num_threads = process->GetThreadList().GetSize();
+            for (uint32_t idx=0; idx<num_threads; ++idx)
+            {
+                const bool override_suspend = false;
+                process->GetThreadList().GetThreadAtIndex(idx)->SetResumeState (eStateRunning, override_suspend);
+            }
+        }
+        return process->Resume();
+    }
+
+    // Record the pc values of every thread's stack. This is all the work
+    // done while the process is stopped, the symbolication is left for
+    // after the last sample.
+    void
+    CaptureStacks (Process *process)
+    {
+        ThreadList &thread_list = process->GetThreadList();
+        Mutex::Locker locker (thread_list.GetMutex());
+        const uint32_t num_threads = thread_list.GetSize();
+        for (uint32_t idx = 0; idx < num_threads; ++idx)
+        {
+            ThreadSP thread_sp (thread_list.GetThreadAtIndex (idx, false));
+            if (!thread_sp)
+                continue;
+            Unwind *unwinder = thread_sp->GetUnwinder();
+            if (unwinder == NULL)
+                continue;
+
+            StackSample sample;
+            sample.thread_index_id = thread_sp->GetIndexID();
+            sample.tid = thread_sp->GetID();
+            sample.first_pc_idx = m_pcs.size();
+            sample.num_pcs = 0;
+            for (uint32_t frame_idx = 0; frame_idx < m_options.m_max_depth; ++frame_idx)
+            {
+                lldb::addr_t cfa = LLDB_INVALID_ADDRESS;
+                lldb::addr_t pc = LLDB_INVALID_ADDRESS;
+                if (!unwinder->GetFrameInfoAtIndex (frame_idx, cfa, pc))
+                    break;
+                m_pcs.push_back (pc);
+                ++sample.num_pcs;
+            }
+            if (sample.num_pcs > 0)
+                m_samples.push_back (sample);
+        }
+    }
+
+    // Name the code at LOOKUP_ADDR as "module`function" the way stack
+    // frames are named in backtraces.
+    ConstString
+    GetFrameName (Target &target, lldb::addr_t lookup_addr)
+    {
+        std::map<lldb::addr_t, ConstString>::const_iterator pos = m_frame_names.find (lookup_addr);
+        if (pos != m_frame_names.end())
+            return pos->second;
+
+        StreamString name;
+        Address so_addr;
+        if (target.GetSectionLoadList().ResolveLoadAddress (lookup_addr, so_addr))
+        {
+            SymbolContext sc;
+            so_addr.CalculateSymbolContext (&sc, eSymbolContextModule | eSymbolContextFunction | eSymbolContextSymbol);
+            if (sc.module_sp)
+                name.Printf ("%s`", sc.module_sp->GetFileSpec().GetFilename().AsCString("<unknown>"));
+            ConstString func_name (sc.GetFunctionName());
+            if (func_name)
+                name.PutCString (func_name.GetCString());
+            else
+                name.Printf ("0x%" PRIx64, lookup_addr);
+        }
+        else
+            name.Printf ("0x%" PRIx64, lookup_addr);
+
+        ConstString frame_name (name.GetData());
+        m_frame_names[lookup_addr] = frame_name;
+        return frame_name;
+    }
+
+    size_t
+    GetChildNode (size_t parent_idx, const ConstString &name)
+    {
+        std::map<const char *, size_t>::const_iterator pos = m_nodes[parent_idx].children.find (name.GetCString());
+        if (pos != m_nodes[parent_idx].children.end())
+            return pos->second;
+        const size_t child_idx = m_nodes.size();
+        m_nodes.push_back (CallTreeNode (name));
+        m_nodes[parent_idx].children[name.GetCString()] = child_idx;
+        return child_idx;
+    }
+
+    // Merge the recorded stacks into a call tree whose top level nodes
+    // are the threads.
+    void
+    BuildCallTree (Target &target)
+    {
+        m_nodes.push_back (CallTreeNode (ConstString()));
+        for (size_t sample_idx = 0; sample_idx < m_samples.size(); ++sample_idx)
+        {
+            const StackSample &sample = m_samples[sample_idx];
+            StreamString thread_name;
+            thread_name.Printf ("thread #%u: tid = 0x%4.4" PRIx64, sample.thread_index_id, sample.tid);
+            size_t node_idx = GetChildNode (0, ConstString (thread_name.GetData()));
+            m_nodes[node_idx].count++;
+            // Walk from the oldest frame to the youngest one. The pc of any
+            // frame but the youngest is a return address which may be the
+            // first address of the next function, so look up the call
+            // instruction before it.
+            for (uint32_t i = sample.num_pcs; i > 0; --i)
+            {
+                const uint32_t frame_idx = i - 1;
+                lldb::addr_t lookup_addr = m_pcs[sample.first_pc_idx + frame_idx];
+                if (frame_idx > 0)
+                    lookup_addr -= 1;
+                node_idx = GetChildNode (node_idx, GetFrameName (target, lookup_addr));
+                m_nodes[node_idx].count++;
+            }
+        }
+    }
+
+    void
+    GetSortedChildren (size_t node_idx, std::vector<size_t> &children)
+    {
+        children.clear();
+        std::map<const char *, size_t>::const_iterator pos, end = m_nodes[node_idx].children.end();
+        for (pos = m_nodes[node_idx].children.begin(); pos != end; ++pos)
+            children.push_back (pos->second);
+        std::stable_sort (children.begin(), children.end(), CallTreeNodeCountGreater (m_nodes));
+    }
+
+    void
+    DumpCallTree (Stream &strm, size_t node_idx, uint32_t depth)
+    {
+        if (depth > 0)
+            strm.Printf ("%*s%u %s\n", (int)(depth * 2), "", m_nodes[node_idx].count, m_nodes[node_idx].name.GetCString());
+        std::vector<size_t> children;
+        GetSortedChildren (node_idx, children);
+        for (size_t i = 0; i < children.size(); ++i)
+        {
+            if (depth == 0)
+                strm.Printf ("%s\n", m_nodes[children[i]].name.GetCString());
+            DumpCallTree (strm, children[i], depth == 0 ? 1 : depth + 1);
+        }
+    }
+
+    // Print one "frame;frame;frame count" line for every stack that was
+    // sampled, oldest frame first.
+    void
+    DumpFoldedStacks (Stream &strm, size_t node_idx, const std::string &path)
+    {
+        uint32_t children_count = 0;
+        std::vector<size_t> children;
+        GetSortedChildren (node_idx, children);
+        for (size_t i = 0; i < children.size(); ++i)
+        {
+            const CallTreeNode &child = m_nodes[children[i]];
+            children_count += child.count;
+            std::string child_path (path);
+            if (!child_path.empty())
+                child_path.append (1, ';');
+            child_path.append (child.name.GetCString());
+            DumpFoldedStacks (strm, children[i], child_path);
+        }
+        if (node_idx != 0 && m_nodes[node_idx].count > children_count)
+            strm.Printf ("%s %u\n", path.c_str(), m_nodes[node_idx].count - children_count);
+    }
+
+    bool
+    DoExecute (Args& command, CommandReturnObject &result)
+    {
+        Process *process = m_exe_ctx.GetProcessPtr();
+        Target *target = m_exe_ctx.GetTargetPtr();
+
+        if (command.GetArgumentCount() != 0)
+        {
+            result.AppendErrorWithFormat ("'%s' takes no arguments:\nUsage: %s\n",
+                                          m_cmd_name.c_str(),
+                                          m_cmd_syntax.c_str());
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+
+        StateType state = process->GetState();
+        if (state != eStateStopped && state != eStateRunning)
+        {
+            result.AppendErrorWithFormat ("Process cannot be sampled from its current state (%s).\n",
+                                          StateAsCString(state));
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+
+        m_pcs.clear();
+        m_samples.clear();
+        m_nodes.clear();
+        m_frame_names.clear();
+
+        // Keep the stops and resumes to ourselves, nobody else needs to
+        // hear about them.
+        Listener listener ("lldb.process.sample");
+        const bool resume_when_done = state == eStateRunning;
+        uint32_t num_samples = 0;
+        uint64_t total_stop_nsec = 0;
+        uint64_t max_stop_nsec = 0;
+        bool stopped_for_other_reason = false;
+        Error error;
+        {
+            Process::ProcessEventHijacker hijacker (*process, &listener);
+
+            if (state == eStateStopped)
+                error = ResumeProcess (process);
+
+            while (error.Success() && num_samples < m_options.m_count)
+            {
+                if (m_options.m_interval_msec > 0)
+                    usleep (m_options.m_interval_msec * 1000);
+
+                TimeValue halt_time (TimeValue::Now());
+                error = process->Halt();
+                if (error.Fail())
+                    break;
+
+                TimeValue timeout (halt_time);
+                timeout.OffsetWithSeconds (10);
+                EventSP event_sp;
+                state = process->WaitForProcessToStop (&timeout, &event_sp, true, &listener);
+                if (state != eStateStopped)
+                    break;
+                if (!Process::ProcessEventData::GetInterruptedFromEvent (event_sp.get()))
+                {
+                    // The process stopped on its own before our halt got to
+                    // it, hand it back to the user rather than stepping over
+                    // whatever stopped it.
+                    stopped_for_other_reason = true;
+                    break;
+                }
+
+                CaptureStacks (process);
+                ++num_samples;
+
+                if (num_samples < m_options.m_count || resume_when_done)
+                    error = ResumeProcess (process);
+                const uint64_t stop_nsec = TimeValue::Now() - halt_time;
+                total_stop_nsec += stop_nsec;
+                if (stop_nsec > max_stop_nsec)
+                    max_stop_nsec = stop_nsec;
+            }
+        }
+
+        if (error.Fail())
+            result.AppendWarningWithFormat ("sampling stopped early: %s\n", error.AsCString());
+        else if (stopped_for_other_reason)
+        {
+            result.AppendWarning ("the process stopped on its own while it was being sampled");
+            result.SetDidChangeProcessState (true);
+        }
+        else if (state != eStateStopped && state != eStateRunning)
+        {
+            result.AppendWarningWithFormat ("the process %s while it was being sampled\n", StateAsCString (state));
+            result.SetDidChangeProcessState (true);
+        }
+
+        if (num_samples == 0)
+        {
+            result.AppendError ("no samples were taken");
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+
+        BuildCallTree (*target);
+
+        Stream *strm = &result.GetOutputStream();
+        std::unique_ptr<StreamFile> outfile_ap;
+        if (!m_options.m_outfile.empty())
+        {
+            outfile_ap.reset (new StreamFile (m_options.m_outfile.c_str()));
+            if (!outfile_ap->GetFile().IsValid())
+            {
+                result.AppendErrorWithFormat ("unable to open '%s' for writing\n", m_options.m_outfile.c_str());
+                result.SetStatus (eReturnStatusFailed);
+                return false;
+            }
+            strm = outfile_ap.get();
+        }
+
+        result.GetOutputStream().Printf ("%u samples of process %" PRIu64 ", stopped %" PRIu64 " us on average and %" PRIu64 " us at most per sample\n",
+                                         num_samples,
+                                         process->GetID(),
+                                         total_stop_nsec / num_samples / 1000,
+                                         max_stop_nsec / 1000);
+        if (m_options.m_folded)
+            DumpFoldedStacks (*strm, 0, std::string());
+        else
+            DumpCallTree (*strm, 0, 0);
+
+        if (outfile_ap.get())
+            result.GetOutputStream().Printf ("Wrote the samples to '%s'.\n", m_options.m_outfile.c_str());
+        result.SetStatus (eReturnStatusSuccessFinishResult);
+        return result.Succeeded();
+    }
+
+    CommandOptions m_options;
+    std::vector<lldb::addr_t> m_pcs;
+    std::vector<StackSample> m_samples;
+    std::vector<CallTreeNode> m_nodes;                  // Node zero is the root of the call tree
+    std::map<lldb::addr_t, ConstString> m_frame_names;  // Lookup address to frame name
+};
+
+OptionDefinition
+CommandObjectProcessSample::CommandOptions::g_option_table[] =
+{
+{ LLDB_OPT_SET_ALL, false, "count",    'c', OptionParser::eRequiredArgument, NULL, 0, eArgTypeCount,           "The number of samples to take (default 100)."},
+{ LLDB_OPT_SET_ALL, false, "interval", 'i', OptionParser::eRequiredArgument, NULL, 0, eArgTypeUnsignedInteger, "The number of milliseconds to let the process run between samples (default 10)."},
+{ LLDB_OPT_SET_ALL, false, "depth",    'd', OptionParser::eRequiredArgument, NULL, 0, eArgTypeCount,           "The maximum number of frames to record for each thread (default 128)."},
+{ LLDB_OPT_SET_ALL, false, "folded",   'f', OptionParser::eNoArgument,       NULL, 0, eArgTypeNone,            "Print one line per distinct stack in the folded stack format instead of a call tree."},
+{ LLDB_OPT_SET_ALL, false, "outfile",  'o', OptionParser::eRequiredArgument, NULL, 0, eArgTypeFilename,        "Write the report to the given file instead of the command output."},
+{ 0, false, NULL, 0, 0, NULL, 0, eArgTypeNone, NULL }
+};
+
 //-------------------------------------------------------------------------
 // CommandObjectProcessKill
 //-------------------------------------------------------------------------
@@ -1921,6 +2412,7 @@ CommandObjectMultiwordProcess::CommandObjectMultiwordProcess (CommandInterpreter
     LoadSubCommand ("status",      CommandObjectSP (new CommandObjectProcessStatus    (interpreter)));
     LoadSubCommand ("interrupt",   CommandObjectSP (new CommandObjectProcessInterrupt (interpreter)));
     LoadSubCommand ("kill",        CommandObjectSP (new CommandObjectProcessKill      (interpreter)));
+    LoadSubCommand ("sample",      CommandObjectSP (new CommandObjectProcessSample    (interpreter)));
     LoadSubCommand ("plugin",      CommandObjectSP (new CommandObjectProcessPlugin    (interpreter)));
     LoadSubCommand ("save-core",   CommandObjectSP (new CommandObjectProcessSaveCore  (interpreter)));
 }
@@ -36,6 +36,7 @@
 #include "lldb/Target/ThreadPlanStepOut.h"
 #include "lldb/Target/ThreadPlanStepRange.h"
 #include "lldb/Target/ThreadPlanStepInRange.h"
+#include "lldb/Utility/TaskPool.h"
 
 
 using namespace lldb;
@@ -170,6 +171,34 @@ public:
     }
 
 protected:
+    //------------------------------------------------------------------
+    // Unwind the stacks of several threads at once. The backtraces are
+    // still printed one thread at a time afterwards, but from frames
+    // that have already been computed.
+    //------------------------------------------------------------------
+    void
+    ComputeBacktraces (Process *process, const std::vector<ThreadSP> &thread_sps)
+    {
+        if (thread_sps.size() < 2 || TaskPool::GetNumWorkers() < 2)
+            return;
+
+        // Set up the state that is shared by all the unwinders before
+        // there is more than one of them.
+        process->GetABI();
+        process->GetDynamicLoader();
+
+        const uint32_t start = m_options.m_start;
+        const uint32_t count = m_options.m_count;
+        TaskPool::MapOverIndexes (0, thread_sps.size(), [&thread_sps, start, count] (uint32_t thread_idx)
+        {
+            Thread *thread = thread_sps[thread_idx].get();
+            if (count == UINT32_MAX || start + count < start)
+                thread->GetStackFrameCount();
+            else if (count > 0)
+                thread->GetStackFrameAtIndex (start + count - 1);
+        });
+    }
+
     void
     DoExtendedBacktrace (Thread *thread, CommandReturnObject &result)
     {
@@ -223,8 +252,13 @@ protected:
         else if (command.GetArgumentCount() == 1 && ::strcmp (command.GetArgumentAtIndex(0), "all") == 0)
         {
             Process *process = m_exe_ctx.GetProcessPtr();
-            uint32_t idx = 0;
+            std::vector<ThreadSP> thread_sps;
             for (ThreadSP thread_sp : process->Threads())
+                thread_sps.push_back (thread_sp);
+            ComputeBacktraces (process, thread_sps);
+
+            uint32_t idx = 0;
+            for (ThreadSP thread_sp : thread_sps)
             {
                 if (idx != 0)
                     result.AppendMessage("");
@@ -276,6 +310,8 @@ protected:
                 
             }
             
+            ComputeBacktraces (process, thread_sps);
+
             for (uint32_t i = 0; i < num_args; i++)
             {
                 if (!thread_sps[i]->GetStatus (strm,
@@ -9,26 +9,64 @@
 #include "lldb/Core/ConstString.h"
 #include "lldb/Core/Stream.h"
 #include "lldb/Host/Mutex.h"
-#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/Allocator.h"
+#include "llvm/Support/AlignOf.h"
+#include "llvm/Support/RWMutex.h"
 
 using namespace lldb_private;
 
 
+//----------------------------------------------------------------------
+// The string pool is split into a number of independently locked
+// shards. The shard for a string is chosen by hashing the string, so
+// threads that are creating unrelated strings rarely contend on the
+// same lock. Each shard is guarded by a reader/writer lock so that the
+// common case of looking up a string that is already in the pool only
+// needs a shared lock.
+//
+// The hash of a string is computed once per lookup. It picks the shard
+// and is then handed to the shard's hash table, and it is stored in the
+// pool entry so strings already in the pool never need to be hashed
+// again to find their shard.
+//----------------------------------------------------------------------
 class Pool
 {
 public:
     typedef const char * StringPoolValueType;
-    typedef llvm::StringMap<StringPoolValueType, llvm::BumpPtrAllocator> StringPool;
-    typedef llvm::StringMapEntry<StringPoolValueType> StringPoolEntryType;
-    
+
+    //------------------------------------------------------------------
+    // A pool entry is allocated with the NULL terminated string right
+    // after it, so the entry for a const C string is found by stepping
+    // back from the string.
+    //------------------------------------------------------------------
+    struct StringPoolEntryType
+    {
+        uint32_t m_hash;
+        uint32_t m_length;
+        StringPoolValueType m_value;   // The mangled counterpart, if any
+
+        const char *
+        GetKeyData () const
+        {
+            return reinterpret_cast<const char *>(this + 1);
+        }
+
+        llvm::StringRef
+        GetKey () const
+        {
+            return llvm::StringRef (GetKeyData(), m_length);
+        }
+    };
+
     //------------------------------------------------------------------
     // Default constructor
     //
     // Initialize the member variables and create the empty string.
     //------------------------------------------------------------------
     Pool () :
-        m_mutex (Mutex::eMutexTypeRecursive),
-        m_string_map ()
+        m_string_pools ()
     {
     }
 
@@ -47,14 +85,13 @@ public:
         return *reinterpret_cast<StringPoolEntryType*>(ptr);
     }
 
+    // The key of a string pool entry never changes once it has been
+    // created, so no locking is needed to get the length.
     size_t
     GetConstCStringLength (const char *ccstr) const
     {
         if (ccstr)
-        {
-            const StringPoolEntryType&entry = GetStringMapEntryFromKeyData (ccstr);
-            return entry.getKey().size();
-        }
+            return GetStringMapEntryFromKeyData (ccstr).m_length;
         return 0;
     }
 
@@ -62,7 +99,12 @@ public:
     GetMangledCounterpart (const char *ccstr) const
     {
         if (ccstr)
-            return GetStringMapEntryFromKeyData (ccstr).getValue();
+        {
+            const StringPoolEntryType &entry = GetStringMapEntryFromKeyData (ccstr);
+            const PoolShard &shard = GetShard (entry.m_hash);
+            llvm::sys::SmartScopedReader<false> reader_locker (shard.m_mutex);
+            return entry.m_value;
+        }
         return 0;
     }
 
@@ -71,8 +113,8 @@ public:
     {
         if (key_ccstr && value_ccstr)
         {
-            GetStringMapEntryFromKeyData (key_ccstr).setValue(value_ccstr);
-            GetStringMapEntryFromKeyData (value_ccstr).setValue(key_ccstr);
+            SetValue (key_ccstr, value_ccstr);
+            SetValue (value_ccstr, key_ccstr);
             return true;
         }
         return false;
@@ -90,12 +132,7 @@ public:
     GetConstCStringWithLength (const char *cstr, size_t cstr_len)
     {
         if (cstr)
-        {
-            Mutex::Locker locker (m_mutex);
-            llvm::StringRef string_ref (cstr, cstr_len);
-            StringPoolEntryType& entry = m_string_map.GetOrCreateValue (string_ref, (StringPoolValueType)NULL);
-            return entry.getKeyData();
-        }
+            return GetConstCStringWithStringRef (llvm::StringRef (cstr, cstr_len));
         return NULL;
     }
 
@@ -104,9 +141,18 @@ public:
     {
         if (string_ref.data())
         {
-            Mutex::Locker locker (m_mutex);
-            StringPoolEntryType& entry = m_string_map.GetOrCreateValue (string_ref, (StringPoolValueType)NULL);
-            return entry.getKeyData();
+            const HashedString key (string_ref);
+            PoolShard &shard = GetShard (key.hash);
+            {
+                // Most strings are already in the pool, so try to find
+                // the string while only holding a shared lock first.
+                llvm::sys::SmartScopedReader<false> reader_locker (shard.m_mutex);
+                StringPoolEntryType *entry = shard.Find (key);
+                if (entry)
+                    return entry->GetKeyData();
+            }
+            llvm::sys::SmartScopedWriter<false> writer_locker (shard.m_mutex);
+            return shard.GetOrCreate (key, NULL).GetKeyData();
         }
         return NULL;
     }
@@ -116,15 +162,23 @@ public:
     {
         if (demangled_cstr)
         {
-            Mutex::Locker locker (m_mutex);
-            // Make string pool entry with the mangled counterpart already set
-            StringPoolEntryType& entry = m_string_map.GetOrCreateValue (llvm::StringRef (demangled_cstr), mangled_ccstr);
+            const char *demangled_ccstr = NULL;
+            {
+                const HashedString key ((llvm::StringRef (demangled_cstr)));
+                PoolShard &shard = GetShard (key.hash);
+                llvm::sys::SmartScopedWriter<false> writer_locker (shard.m_mutex);
+                // Make string pool entry with the mangled counterpart already set
+                StringPoolEntryType &entry = shard.GetOrCreate (key, mangled_ccstr);
+
+                // Extract the const version of the demangled_cstr
+                demangled_ccstr = entry.GetKeyData();
+            }
 
-            // Extract the const version of the demangled_cstr
-            const char *demangled_ccstr = entry.getKeyData();
             // Now assign the demangled const string as the counterpart of the
-            // mangled const string...
-            GetStringMapEntryFromKeyData (mangled_ccstr).setValue(demangled_ccstr);
+            // mangled const string. The mangled string may live in another
+            // shard, so this is done after releasing the first lock to make
+            // sure we never hold two shard locks at once.
+            SetValue (mangled_ccstr, demangled_ccstr);
             // Return the constant demangled C string
             return demangled_ccstr;
         }
@@ -150,28 +204,167 @@ public:
     size_t
     MemorySize() const
     {
-        Mutex::Locker locker (m_mutex);
         size_t mem_size = sizeof(Pool);
-        const_iterator end = m_string_map.end();
-        for (const_iterator pos = m_string_map.begin(); pos != end; ++pos)
+        for (size_t i=0; i<kNumShards; ++i)
         {
-            mem_size += sizeof(StringPoolEntryType) + pos->getKey().size();
+            const PoolShard &shard = m_string_pools[i];
+            llvm::sys::SmartScopedReader<false> reader_locker (shard.m_mutex);
+            mem_size += shard.m_string_map.getMemorySize();
+            const_iterator end = shard.m_string_map.end();
+            for (const_iterator pos = shard.m_string_map.begin(); pos != end; ++pos)
+            {
+                mem_size += sizeof(StringPoolEntryType) + pos->first->m_length + 1;
+            }
         }
         return mem_size;
     }
 
 protected:
+    //------------------------------------------------------------------
+    // A string to look up along with its hash.
+    //------------------------------------------------------------------
+    struct HashedString
+    {
+        explicit
+        HashedString (const llvm::StringRef &s) :
+            string (s),
+            hash (llvm::HashString (s))
+        {
+        }
+
+        llvm::StringRef string;
+        uint32_t hash;
+    };
+
+    //------------------------------------------------------------------
+    // Lets the hash table in each shard find entries by a HashedString
+    // without hashing the string again, and rehash entries with the
+    // hash they already store.
+    //------------------------------------------------------------------
+    struct StringPoolEntryInfo
+    {
+        static inline StringPoolEntryType *
+        getEmptyKey ()
+        {
+            return llvm::DenseMapInfo<StringPoolEntryType *>::getEmptyKey();
+        }
+
+        static inline StringPoolEntryType *
+        getTombstoneKey ()
+        {
+            return llvm::DenseMapInfo<StringPoolEntryType *>::getTombstoneKey();
+        }
+
+        static unsigned
+        getHashValue (const HashedString &key)
+        {
+            return key.hash;
+        }
+
+        static unsigned
+        getHashValue (const StringPoolEntryType *entry)
+        {
+            return entry->m_hash;
+        }
+
+        static bool
+        isEqual (const HashedString &lhs, const StringPoolEntryType *rhs)
+        {
+            if (rhs == getEmptyKey() || rhs == getTombstoneKey())
+                return false;
+            return lhs.hash == rhs->m_hash && lhs.string == rhs->GetKey();
+        }
+
+        static bool
+        isEqual (const StringPoolEntryType *lhs, const StringPoolEntryType *rhs)
+        {
+            return lhs == rhs;
+        }
+    };
+
     //------------------------------------------------------------------
     // Typedefs
     //------------------------------------------------------------------
+    typedef llvm::DenseMap<StringPoolEntryType *, bool, StringPoolEntryInfo> StringPool;
     typedef StringPool::iterator iterator;
     typedef StringPool::const_iterator const_iterator;
 
+    enum { kNumShards = 256 };
+
+    struct PoolShard
+    {
+        PoolShard () :
+            m_mutex (),
+            m_string_map (),
+            m_allocator ()
+        {
+        }
+
+        // The caller must hold m_mutex.
+        StringPoolEntryType *
+        Find (const HashedString &key) const
+        {
+            const_iterator pos = m_string_map.find_as (key);
+            if (pos != m_string_map.end())
+                return pos->first;
+            return NULL;
+        }
+
+        // The caller must hold m_mutex for writing.
+        StringPoolEntryType &
+        GetOrCreate (const HashedString &key, StringPoolValueType value)
+        {
+            StringPoolEntryType *entry = Find (key);
+            if (entry == NULL)
+            {
+                const size_t length = key.string.size();
+                void *mem = m_allocator.Allocate (sizeof(StringPoolEntryType) + length + 1,
+                                                  llvm::alignOf<StringPoolEntryType>());
+                entry = static_cast<StringPoolEntryType *>(mem);
+                entry->m_hash = key.hash;
+                entry->m_length = length;
+                entry->m_value = value;
+                char *key_data = const_cast<char *>(entry->GetKeyData());
+                if (length > 0)
+                    ::memcpy (key_data, key.string.data(), length);
+                key_data[length] = '\0';
+                m_string_map.insert (std::make_pair (entry, true));
+            }
+            return *entry;
+        }
+
+        mutable llvm::sys::SmartRWMutex<false> m_mutex;
+        StringPool m_string_map;
+        llvm::BumpPtrAllocator m_allocator;
+    };
+
+    // The hash tables index their buckets with the low bits of the hash,
+    // so use the high bits to pick the shard.
+    PoolShard &
+    GetShard (uint32_t hash)
+    {
+        return m_string_pools[(hash >> 24) & (kNumShards - 1)];
+    }
+
+    const PoolShard &
+    GetShard (uint32_t hash) const
+    {
+        return m_string_pools[(hash >> 24) & (kNumShards - 1)];
+    }
+
+    void
+    SetValue (const char *key_ccstr, const char *value_ccstr)
+    {
+        StringPoolEntryType &entry = GetStringMapEntryFromKeyData (key_ccstr);
+        PoolShard &shard = GetShard (entry.m_hash);
+        llvm::sys::SmartScopedWriter<false> writer_locker (shard.m_mutex);
+        entry.m_value = value_ccstr;
+    }
+
     //------------------------------------------------------------------
     // Member variables
     //------------------------------------------------------------------
-    mutable Mutex m_mutex;
-    StringPool m_string_map;
+    PoolShard m_string_pools[kNumShards];
 };
 
 //----------------------------------------------------------------------
@@ -2233,6 +2233,15 @@ FormatPromptRecurse
                                             reg_num = LLDB_REGNUM_GENERIC_FLAGS;
                                             var_success = true;
                                         }
+                                        else if (IsToken (var_name_begin, "unwind-method}"))
+                                        {
+                                            cstr = frame->GetUnwindMethod();
+                                            if (cstr)
+                                            {
+                                                s.PutCString(cstr);
+                                                var_success = true;
+                                            }
+                                        }
                                         else if (IsToken (var_name_begin, "reg."))
                                         {
                                             reg_ctx = frame->GetRegisterContext().get();
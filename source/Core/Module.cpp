@@ -148,10 +148,12 @@ Module::Module (const ModuleSpec &module_spec) :
     m_ast (),
     m_source_mappings (),
     m_sections_ap(),
+    m_source_file_cu_index(),
     m_did_load_objfile (false),
     m_did_load_symbol_vendor (false),
     m_did_parse_uuid (false),
     m_did_init_ast (false),
+    m_did_index_source_files (false),
     m_is_dynamic_loader_module (false),
     m_file_has_changed (false),
     m_first_file_changed_log (false)
@@ -253,10 +255,12 @@ Module::Module(const FileSpec& file_spec,
     m_ast (),
     m_source_mappings (),
     m_sections_ap(),
+    m_source_file_cu_index(),
     m_did_load_objfile (false),
     m_did_load_symbol_vendor (false),
     m_did_parse_uuid (false),
     m_did_init_ast (false),
+    m_did_index_source_files (false),
     m_is_dynamic_loader_module (false),
     m_file_has_changed (false),
     m_first_file_changed_log (false)
@@ -300,10 +304,12 @@ Module::Module () :
     m_ast (),
     m_source_mappings (),
     m_sections_ap(),
+    m_source_file_cu_index(),
     m_did_load_objfile (false),
     m_did_load_symbol_vendor (false),
     m_did_parse_uuid (false),
     m_did_init_ast (false),
+    m_did_index_source_files (false),
     m_is_dynamic_loader_module (false),
     m_file_has_changed (false),
     m_first_file_changed_log (false)
@@ -534,6 +540,64 @@ Module::GetCompileUnitAtIndex (size_t index)
     return cu_sp;
 }
 
+size_t
+Module::FindCompileUnitIndexesForSourceFile (const FileSpec &file_spec, std::vector<uint32_t> &cu_indexes)
+{
+    Mutex::Locker locker (m_mutex);
+    const size_t start_size = cu_indexes.size();
+    const uint32_t num_comp_units = GetNumCompileUnits ();
+    const ConstString &basename = file_spec.GetFilename();
+    if (!basename)
+    {
+        for (uint32_t cu_idx = 0; cu_idx < num_comp_units; ++cu_idx)
+            cu_indexes.push_back (cu_idx);
+        return cu_indexes.size() - start_size;
+    }
+
+    if (m_did_index_source_files == false)
+    {
+        Timer scoped_timer(__PRETTY_FUNCTION__, "Module::FindCompileUnitIndexesForSourceFile - index source files");
+        m_did_index_source_files = true;
+
+        SymbolVendor *symbols = GetSymbolVendor ();
+        SymbolFile *symbol_file = symbols ? symbols->GetSymbolFile() : NULL;
+        std::vector<ConstString> basenames;
+        for (uint32_t cu_idx = 0; cu_idx < num_comp_units; ++cu_idx)
+        {
+            basenames.clear();
+            if (symbol_file == NULL || !symbol_file->GetCompileUnitSourceFileBasenames (cu_idx, basenames))
+            {
+                // The symbol file can't tell us, so make the compile unit
+                // and go through its support files.
+                CompUnitSP cu_sp (GetCompileUnitAtIndex (cu_idx));
+                if (!cu_sp)
+                    continue;
+                basenames.push_back (cu_sp->GetFilename());
+                FileSpecList &support_files = cu_sp->GetSupportFiles();
+                const size_t num_support_files = support_files.GetSize();
+                for (size_t file_idx = 0; file_idx < num_support_files; ++file_idx)
+                    basenames.push_back (support_files.GetFileSpecAtIndex (file_idx).GetFilename());
+            }
+
+            // Many files are included more than once, only add each
+            // basename once per compile unit.
+            std::sort (basenames.begin(), basenames.end());
+            std::vector<ConstString>::iterator end = std::unique (basenames.begin(), basenames.end());
+            for (std::vector<ConstString>::iterator pos = basenames.begin(); pos != end; ++pos)
+            {
+                if (*pos)
+                    m_source_file_cu_index.Append (pos->GetCString(), cu_idx);
+            }
+        }
+        m_source_file_cu_index.Sort();
+        m_source_file_cu_index.SizeToFit();
+    }
+
+    m_source_file_cu_index.GetValues (basename.GetCString(), cu_indexes);
+    std::sort (cu_indexes.begin() + start_size, cu_indexes.end());
+    return cu_indexes.size() - start_size;
+}
+
 bool
 Module::ResolveFileAddress (lldb::addr_t vm_addr, Address& so_addr)
 {
@@ -1055,6 +1119,20 @@ Module::GetSymbolVendor (bool can_create, lldb_private::Stream *feedback_strm)
     return m_symfile_ap.get();
 }
 
+size_t
+Module::ReleaseUnusedMemory (bool mandatory)
+{
+    Mutex::Locker locker;
+    if (mandatory)
+        locker.Lock (m_mutex);
+    else if (!locker.TryLock (m_mutex))
+        return 0;
+
+    if (m_symfile_ap.get())
+        return m_symfile_ap->ReleaseUnusedMemory();
+    return 0;
+}
+
 void
 Module::SetFileSpecAndObjectName (const FileSpec &file, const ConstString &object_name)
 {
@@ -1473,6 +1551,8 @@ Module::SetSymbolFileFileSpec (const FileSpec &file)
     m_symfile_spec = file;
     m_symfile_ap.reset();
     m_did_load_symbol_vendor = false;
+    m_source_file_cu_index.Clear();
+    m_did_index_source_files = false;
 }
 
 bool
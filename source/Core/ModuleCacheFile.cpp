@@ -0,0 +1,249 @@
+//===-- ModuleCacheFile.cpp -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Core/ModuleCacheFile.h"
+
+// C Includes
+#include <stdio.h>
+#include <string.h>
+
+// C++ Includes
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Core/DataBuffer.h"
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/Error.h"
+#include "lldb/Core/Log.h"
+#include "lldb/Core/StreamString.h"
+#include "lldb/Host/File.h"
+#include "lldb/Host/Host.h"
+#include "lldb/Symbol/ObjectFile.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+
+struct CacheFileInfo
+{
+    CacheFileInfo (const FileSpec &f, uint64_t m, uint64_t s) :
+        file (f),
+        mod_time (m),
+        byte_size (s)
+    {
+    }
+
+    bool
+    operator < (const CacheFileInfo &rhs) const
+    {
+        return mod_time < rhs.mod_time;
+    }
+
+    FileSpec file;
+    uint64_t mod_time;
+    uint64_t byte_size;
+};
+
+struct FindCacheFilesBaton
+{
+    const std::string *file_extension;
+    std::vector<CacheFileInfo> infos;
+};
+
+} // anonymous namespace
+
+static FileSpec::EnumerateDirectoryResult
+FindCacheFilesCallback (void *baton,
+                        FileSpec::FileType file_type,
+                        const FileSpec &file_spec)
+{
+    FindCacheFilesBaton *find_baton = static_cast<FindCacheFilesBaton *>(baton);
+    const char *filename = file_spec.GetFilename().GetCString();
+    if (filename)
+    {
+        const size_t filename_len = ::strlen(filename);
+        const std::string &extension = *find_baton->file_extension;
+        if (filename_len > extension.size() &&
+            extension.compare(filename + filename_len - extension.size()) == 0)
+        {
+            find_baton->infos.push_back(CacheFileInfo (file_spec,
+                                                       file_spec.GetModificationTime().GetAsSecondsSinceJan1_1970(),
+                                                       file_spec.GetByteSize()));
+        }
+    }
+    return FileSpec::eEnumerateDirectoryResultNext;
+}
+
+ModuleCacheFile::ModuleCacheFile () :
+    m_cache_dir (),
+    m_file_extension (),
+    m_file (),
+    m_object_file_spec (),
+    m_uuid (),
+    m_object_file_mod_time (0),
+    m_object_file_byte_size (0)
+{
+}
+
+bool
+ModuleCacheFile::SetObjectFile (const FileSpec &cache_dir,
+                                const char *file_extension,
+                                ObjectFile &objfile)
+{
+    m_file.Clear();
+
+    // Without a UUID we can't tell one version of a binary from another,
+    // so don't cache anything.
+    if (!objfile.GetUUID (&m_uuid) || !m_uuid.IsValid())
+        return false;
+
+    m_cache_dir = cache_dir;
+    m_file_extension = file_extension;
+    std::string cache_filename (m_uuid.GetAsString());
+    cache_filename.append (m_file_extension);
+    m_file = cache_dir.CopyByAppendingPathComponent (cache_filename.c_str());
+    m_object_file_spec = objfile.GetFileSpec();
+    m_object_file_mod_time = m_object_file_spec.GetModificationTime().GetAsSecondsSinceJan1_1970();
+    m_object_file_byte_size = m_object_file_spec.GetByteSize();
+    return true;
+}
+
+bool
+ModuleCacheFile::Read (uint32_t magic,
+                       uint32_t version,
+                       DataExtractor &data,
+                       lldb::offset_t &offset,
+                       Log *log)
+{
+    if (!m_file || !m_file.Exists())
+        return false;
+
+    DataBufferSP data_sp (m_file.MemoryMapFileContents());
+    if (!data_sp || data_sp->GetByteSize() == 0)
+        return false;
+
+    data.SetData (data_sp);
+    data.SetByteOrder (eByteOrderLittle);
+    data.SetAddressByteSize (4);
+    offset = 0;
+    if (data.GetU32 (&offset) != magic)
+        return false;
+    if (data.GetU32 (&offset) != version)
+        return false;
+
+    const uint32_t uuid_byte_size = data.GetU32 (&offset);
+    const void *uuid_bytes = data.GetData (&offset, uuid_byte_size);
+    if (uuid_bytes == NULL || uuid_byte_size != m_uuid.GetByteSize() ||
+        ::memcmp (uuid_bytes, m_uuid.GetBytes(), uuid_byte_size) != 0)
+        return false;
+
+    const uint64_t mod_time = data.GetU64 (&offset);
+    const uint64_t byte_size = data.GetU64 (&offset);
+    if (mod_time != m_object_file_mod_time || byte_size != m_object_file_byte_size)
+    {
+        if (log)
+            log->Printf ("ModuleCacheFile::Read ignoring '%s', '%s' changed since it was written",
+                         m_file.GetPath().c_str(),
+                         m_object_file_spec.GetPath().c_str());
+        return false;
+    }
+    return true;
+}
+
+Error
+ModuleCacheFile::Write (uint32_t magic,
+                        uint32_t version,
+                        const StreamString * const *parts,
+                        size_t num_parts,
+                        uint64_t max_cache_byte_size)
+{
+    Error error;
+    if (!m_file)
+    {
+        error.SetErrorString ("no cache file");
+        return error;
+    }
+
+    StreamString header (Stream::eBinary, 4, eByteOrderLittle);
+    header.PutHex32 (magic);
+    header.PutHex32 (version);
+    header.PutHex32 (m_uuid.GetByteSize());
+    header.PutRawBytes (m_uuid.GetBytes(), m_uuid.GetByteSize());
+    header.PutHex64 (m_object_file_mod_time);
+    header.PutHex64 (m_object_file_byte_size);
+
+    std::string cache_dir_path (m_cache_dir.GetPath());
+    Host::MakeDirectory (cache_dir_path.c_str(), eFilePermissionsDirectoryDefault);
+
+    // Write to a temporary file and rename it into place so that other
+    // debugger sessions never see a partially written cache file.
+    std::string cache_path (m_file.GetPath());
+    StreamString tmp_path;
+    tmp_path.Printf ("%s.%" PRIu64 ".tmp", cache_path.c_str(), Host::GetCurrentProcessID());
+    {
+        File file (tmp_path.GetString().c_str(),
+                   File::eOpenOptionWrite | File::eOpenOptionCanCreate | File::eOpenOptionTruncate,
+                   lldb::eFilePermissionsFileDefault);
+        for (size_t i=0; error.Success() && i<=num_parts; ++i)
+        {
+            const StreamString *part = i == 0 ? &header : parts[i - 1];
+            size_t num_bytes = part->GetSize();
+            error = file.Write (part->GetData(), num_bytes);
+            if (error.Success() && num_bytes != part->GetSize())
+                error.SetErrorString ("short write");
+        }
+    }
+
+    if (error.Success() && ::rename (tmp_path.GetString().c_str(), cache_path.c_str()) != 0)
+        error.SetErrorToErrno();
+
+    if (error.Fail())
+    {
+        Host::Unlink (tmp_path.GetString().c_str());
+        return error;
+    }
+
+    if (max_cache_byte_size > 0)
+        TrimCacheDirectory (max_cache_byte_size);
+    return error;
+}
+
+void
+ModuleCacheFile::TrimCacheDirectory (uint64_t max_cache_byte_size)
+{
+    FindCacheFilesBaton baton;
+    baton.file_extension = &m_file_extension;
+    std::string cache_dir_path (m_cache_dir.GetPath());
+    FileSpec::EnumerateDirectory (cache_dir_path.c_str(),
+                                  false,    // find_directories
+                                  true,     // find_files
+                                  false,    // find_other
+                                  FindCacheFilesCallback,
+                                  &baton);
+
+    std::vector<CacheFileInfo> &infos = baton.infos;
+    uint64_t total_byte_size = 0;
+    for (size_t i=0; i<infos.size(); ++i)
+        total_byte_size += infos[i].byte_size;
+
+    if (total_byte_size <= max_cache_byte_size)
+        return;
+
+    // Remove the oldest files first
+    std::sort (infos.begin(), infos.end());
+    for (size_t i=0; i<infos.size() && total_byte_size > max_cache_byte_size; ++i)
+    {
+        if (Host::Unlink (infos[i].file.GetPath().c_str()).Success())
+            total_byte_size -= infos[i].byte_size;
+    }
+}
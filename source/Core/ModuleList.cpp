@@ -286,6 +286,32 @@ ModuleList::RemoveOrphans (bool mandatory)
     return remove_count;
 }
 
+size_t
+ModuleList::ReleaseUnusedMemory (bool mandatory)
+{
+    Mutex::Locker locker;
+    
+    if (mandatory)
+    {
+        locker.Lock (m_modules_mutex);
+    }
+    else
+    {
+        if (!locker.TryLock(m_modules_mutex))
+            return 0;
+    }
+    // Don't hold on to our mutex while we wait for the module mutexes,
+    // a module can be busy looking up shared modules.
+    collection modules (m_modules);
+    locker.Unlock();
+
+    size_t bytes_released = 0;
+    collection::const_iterator pos, end = modules.end();
+    for (pos = modules.begin(); pos != end; ++pos)
+        bytes_released += (*pos)->ReleaseUnusedMemory (mandatory);
+    return bytes_released;
+}
+
 size_t
 ModuleList::Remove (ModuleList &module_list)
 {
@@ -891,6 +917,12 @@ ModuleList::RemoveOrphanSharedModules (bool mandatory)
     return GetSharedModuleList ().RemoveOrphans(mandatory);
 }
 
+size_t
+ModuleList::ReleaseUnusedSharedModuleMemory (bool mandatory)
+{
+    return GetSharedModuleList ().ReleaseUnusedMemory(mandatory);
+}
+
 Error
 ModuleList::GetSharedModule
 (
@@ -83,6 +83,8 @@ ValueObject::ValueObject (ValueObject &parent) :
     m_dynamic_value (NULL),
     m_synthetic_value(NULL),
     m_deref_valobj(NULL),
+    m_prefetched_data_sp(),
+    m_prefetched_data_addr(LLDB_INVALID_ADDRESS),
     m_format (eFormatDefault),
     m_last_format (eFormatDefault),
     m_last_format_mgr_revision(0),
@@ -129,6 +131,8 @@ ValueObject::ValueObject (ExecutionContextScope *exe_scope,
     m_dynamic_value (NULL),
     m_synthetic_value(NULL),
     m_deref_valobj(NULL),
+    m_prefetched_data_sp(),
+    m_prefetched_data_addr(LLDB_INVALID_ADDRESS),
     m_format (eFormatDefault),
     m_last_format (eFormatDefault),
     m_last_format_mgr_revision(0),
@@ -187,6 +191,10 @@ ValueObject::UpdateValueIfNeeded (bool update_format)
     {
         m_update_point.SetUpdated();
         
+        // The memory may have changed since it was prefetched
+        m_prefetched_data_sp.reset();
+        m_prefetched_data_addr = LLDB_INVALID_ADDRESS;
+        
         // Save the old value using swap to avoid a string copy which
         // also will clear our m_value_str
         if (m_value_str.empty())
@@ -1157,6 +1165,71 @@ ValueObject::SetData (DataExtractor &data, Error &error)
     return true;
 }
 
+bool
+ValueObject::PrefetchChildrenData (uint64_t byte_size)
+{
+    if (!UpdateValueIfNeeded(false))
+        return false;
+    
+    if (m_prefetched_data_sp)
+        return true;
+    
+    // Only aggregates have children stored inside of them
+    if (!GetClangType().IsAggregateType())
+        return false;
+    
+    AddressType address_type = eAddressTypeInvalid;
+    const addr_t addr = GetAddressOf(true, &address_type);
+    if (address_type != eAddressTypeLoad || addr == LLDB_INVALID_ADDRESS || addr == 0)
+        return false;
+    
+    const uint64_t value_byte_size = GetByteSize();
+    if (byte_size == 0 || byte_size > value_byte_size)
+        byte_size = value_byte_size;
+    if (byte_size == 0)
+        return false;
+    
+    // Don't read huge values when only a few children will be looked at,
+    // leave those to the children themselves
+    static const uint64_t g_max_prefetch_byte_size = 1024 * 1024;
+    lldb::ProcessSP process_sp(GetProcessSP());
+    if (!process_sp || byte_size > g_max_prefetch_byte_size)
+        return false;
+    
+    DataBufferSP data_sp(new DataBufferHeap(byte_size, 0));
+    Error error;
+    if (process_sp->ReadMemory(addr, data_sp->GetBytes(), byte_size, error) != byte_size)
+        return false;
+    
+    m_prefetched_data_sp = data_sp;
+    m_prefetched_data_addr = addr;
+    return true;
+}
+
+bool
+ValueObject::GetPrefetchedData (addr_t addr, uint64_t byte_size, DataExtractor &data)
+{
+    // Every ancestor is updated before this value is, so their data is
+    // from the same stop
+    for (ValueObject *valobj = this; valobj != NULL; valobj = valobj->m_parent)
+    {
+        if (!valobj->m_prefetched_data_sp)
+            continue;
+        const addr_t data_addr = valobj->m_prefetched_data_addr;
+        const uint64_t data_byte_size = valobj->m_prefetched_data_sp->GetByteSize();
+        if (addr >= data_addr && byte_size <= data_byte_size && addr - data_addr <= data_byte_size - byte_size)
+        {
+            lldb::ProcessSP process_sp(GetProcessSP());
+            if (!process_sp)
+                return false;
+            data.SetByteOrder(process_sp->GetByteOrder());
+            data.SetAddressByteSize(process_sp->GetAddressByteSize());
+            return data.SetData(valobj->m_prefetched_data_sp, addr - data_addr, byte_size) == byte_size;
+        }
+    }
+    return false;
+}
+
 // will compute strlen(str), but without consuming more than
 // maxlen bytes out of str (this serves the purpose of reading
 // chunks of a string without having to worry about
@@ -209,7 +209,15 @@ ValueObjectChild::UpdateValue ()
                 const bool thread_and_frame_only_if_stopped = true;
                 ExecutionContext exe_ctx (GetExecutionContextRef().Lock(thread_and_frame_only_if_stopped));
                 if (GetClangType().GetTypeInfo() & ClangASTType::eTypeHasValue)
-                    m_error = m_value.GetValueAsData (&exe_ctx, m_data, 0, GetModule().get());
+                {
+                    // Use the memory of our parent or its parents if they
+                    // already read it, see ValueObject::PrefetchChildrenData()
+                    if (m_value.GetValueType() == Value::eValueTypeLoadAddress &&
+                        parent->GetPrefetchedData (m_value.GetScalar().ULongLong(LLDB_INVALID_ADDRESS), GetByteSize(), m_data))
+                        m_error.Clear();
+                    else
+                        m_error = m_value.GetValueAsData (&exe_ctx, m_data, 0, GetModule().get());
+                }
                 else
                     m_error.Clear(); // No value so nothing to read...
             }
@@ -15,11 +15,14 @@
 
 #include "lldb/Core/DataBufferHeap.h"
 #include "lldb/Core/Error.h"
+#include "lldb/Core/State.h"
 #include "lldb/Core/Stream.h"
 #include "lldb/Core/ValueObject.h"
 #include "lldb/Core/ValueObjectConstResult.h"
+#include "lldb/Core/ValueObjectMemory.h"
 #include "lldb/Host/Endian.h"
 #include "lldb/Symbol/ClangASTContext.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 
 #include <algorithm>
@@ -1350,6 +1353,59 @@ lldb_private::formatters::ExtractIndexFromString (const char* item_name)
     return idx;
 }
 
+// Static data can be read from the object files, but only at its file
+// address, so use those unless there is a stopped process
+static bool
+HasStoppedProcess (const ExecutionContext &exe_ctx)
+{
+    Process *process = exe_ctx.GetProcessPtr();
+    return process && StateIsStoppedState(process->GetState(), true);
+}
+
+lldb::addr_t
+lldb_private::formatters::ReadPointerFromTargetOrProcess (const ExecutionContextRef &exe_ctx_ref,
+                                                          lldb::addr_t address,
+                                                          Error &error)
+{
+    ExecutionContext exe_ctx(exe_ctx_ref);
+    if (HasStoppedProcess(exe_ctx))
+        return exe_ctx.GetProcessPtr()->ReadPointerFromMemory(address, error);
+    Target *target = exe_ctx.GetTargetPtr();
+    if (!target)
+    {
+        error.SetErrorString("no target");
+        return LLDB_INVALID_ADDRESS;
+    }
+    Address so_addr;
+    if (!target->GetImages().ResolveFileAddress(address, so_addr))
+    {
+        error.SetErrorStringWithFormat("0x%" PRIx64 " isn't in any module", address);
+        return LLDB_INVALID_ADDRESS;
+    }
+    const bool prefer_file_cache = true;
+    return target->ReadUnsignedIntegerFromMemory(so_addr,
+                                                 prefer_file_cache,
+                                                 target->GetArchitecture().GetAddressByteSize(),
+                                                 LLDB_INVALID_ADDRESS,
+                                                 error);
+}
+
+lldb::ValueObjectSP
+lldb_private::formatters::CreateValueObjectFromTargetOrProcessAddress (const char* name,
+                                                                       lldb::addr_t address,
+                                                                       const ExecutionContextRef &exe_ctx_ref,
+                                                                       ClangASTType type)
+{
+    ExecutionContext exe_ctx(exe_ctx_ref);
+    if (HasStoppedProcess(exe_ctx))
+        return ValueObject::CreateValueObjectFromAddress(name, address, exe_ctx, type);
+    Target *target = exe_ctx.GetTargetPtr();
+    Address so_addr;
+    if (!target || !target->GetImages().ResolveFileAddress(address, so_addr))
+        return lldb::ValueObjectSP();
+    return ValueObjectMemory::Create(exe_ctx.GetBestExecutionContextScope(), name, so_addr, type);
+}
+
 lldb_private::formatters::VectorIteratorSyntheticFrontEnd::VectorIteratorSyntheticFrontEnd (lldb::ValueObjectSP valobj_sp,
                                                                                             ConstString item_name) :
 SyntheticChildrenFrontEnd(*valobj_sp.get()),
@@ -898,15 +898,9 @@ FormatManager::LoadLibStdcppFormatters()
     SyntheticChildren::Flags stl_synth_flags;
     stl_synth_flags.SetCascades(true).SetSkipPointers(false).SetSkipReferences(false);
     
-    gnu_category_sp->GetRegexTypeSyntheticsContainer()->Add(RegularExpressionSP(new RegularExpression("^std::vector<.+>(( )?&)?$")),
-                                                       SyntheticChildrenSP(new ScriptedSyntheticChildren(stl_synth_flags,
-                                                                                                 "lldb.formatters.cpp.gnu_libstdcpp.StdVectorSynthProvider")));
-    gnu_category_sp->GetRegexTypeSyntheticsContainer()->Add(RegularExpressionSP(new RegularExpression("^std::map<.+> >(( )?&)?$")),
-                                                       SyntheticChildrenSP(new ScriptedSyntheticChildren(stl_synth_flags,
-                                                                                                 "lldb.formatters.cpp.gnu_libstdcpp.StdMapSynthProvider")));
-    gnu_category_sp->GetRegexTypeSyntheticsContainer()->Add(RegularExpressionSP(new RegularExpression("^std::list<.+>(( )?&)?$")),
-                                                       SyntheticChildrenSP(new ScriptedSyntheticChildren(stl_synth_flags,
-                                                                                                 "lldb.formatters.cpp.gnu_libstdcpp.StdListSynthProvider")));
+    AddCXXSynthetic(gnu_category_sp, lldb_private::formatters::LibstdcppStdVectorSyntheticFrontEndCreator, "libstdc++ std::vector synthetic children", ConstString("^std::vector<.+>(( )?&)?$"), stl_synth_flags, true);
+    AddCXXSynthetic(gnu_category_sp, lldb_private::formatters::LibstdcppStdMapSyntheticFrontEndCreator, "libstdc++ std::map synthetic children", ConstString("^std::map<.+> >(( )?&)?$"), stl_synth_flags, true);
+    AddCXXSynthetic(gnu_category_sp, lldb_private::formatters::LibstdcppStdListSyntheticFrontEndCreator, "libstdc++ std::list synthetic children", ConstString("^std::list<.+>(( )?&)?$"), stl_synth_flags, true);
     
     stl_summary_flags.SetDontShowChildren(false);stl_summary_flags.SetSkipPointers(true);
     gnu_category_sp->GetRegexTypeSummariesContainer()->Add(RegularExpressionSP(new RegularExpression("^std::vector<.+>(( )?&)?$")),
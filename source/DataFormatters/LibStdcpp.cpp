@@ -329,3 +329,117 @@ lldb_private::formatters::LibStdcppVectorIteratorSyntheticFrontEndCreator (CXXSy
         return NULL;
     return (new VectorIteratorSyntheticFrontEnd(valobj_sp,g_item_name));
 }
+
+/*
+ (std::vector<int, std::allocator<int> >) v = {
+ (std::_Vector_base<int, std::allocator<int> >) std::_Vector_base<int, std::allocator<int> > = {
+ (std::_Vector_base<int, std::allocator<int> >::_Vector_impl) _M_impl = {
+ (int *) _M_start = 0x00000001001037a0
+ (int *) _M_finish = 0x00000001001037ac
+ (int *) _M_end_of_storage = 0x00000001001037b0
+ }
+ }
+ }
+ */
+
+lldb_private::formatters::LibstdcppStdVectorSyntheticFrontEnd::LibstdcppStdVectorSyntheticFrontEnd (lldb::ValueObjectSP valobj_sp) :
+    SyntheticChildrenFrontEnd(*valobj_sp.get()),
+    m_start(0),
+    m_element_type(),
+    m_element_size(0),
+    m_count(0),
+    m_children()
+{
+    if (valobj_sp)
+        Update();
+}
+
+size_t
+lldb_private::formatters::LibstdcppStdVectorSyntheticFrontEnd::CalculateNumChildren ()
+{
+    return m_count;
+}
+
+lldb::ValueObjectSP
+lldb_private::formatters::LibstdcppStdVectorSyntheticFrontEnd::GetChildAtIndex (size_t idx)
+{
+    if (idx >= m_count)
+        return lldb::ValueObjectSP();
+    
+    auto cached = m_children.find(idx);
+    if (cached != m_children.end())
+        return cached->second;
+    
+    // the elements are contiguous, so compute the address of the child
+    // instead of going through the _M_start pointer value object
+    lldb::addr_t child_address = m_start + idx * m_element_size;
+    StreamString name;
+    name.Printf("[%" PRIu64 "]", (uint64_t)idx);
+    ValueObjectSP child_sp = ValueObject::CreateValueObjectFromAddress(name.GetData(), child_address, m_backend.GetExecutionContextRef(), m_element_type);
+    m_children[idx] = child_sp;
+    return child_sp;
+}
+
+bool
+lldb_private::formatters::LibstdcppStdVectorSyntheticFrontEnd::Update()
+{
+    m_start = 0;
+    m_count = 0;
+    m_children.clear();
+    
+    ValueObjectSP impl_sp(m_backend.GetChildMemberWithName(ConstString("_M_impl"), true));
+    if (!impl_sp)
+        return false;
+    ValueObjectSP start_sp(impl_sp->GetChildMemberWithName(ConstString("_M_start"), true));
+    ValueObjectSP finish_sp(impl_sp->GetChildMemberWithName(ConstString("_M_finish"), true));
+    ValueObjectSP end_sp(impl_sp->GetChildMemberWithName(ConstString("_M_end_of_storage"), true));
+    if (!start_sp || !finish_sp || !end_sp)
+        return false;
+    
+    m_element_type = start_sp->GetClangType().GetPointeeType();
+    m_element_size = m_element_type.GetByteSize();
+    if (m_element_size == 0)
+        return false;
+    
+    lldb::addr_t start_val = start_sp->GetValueAsUnsigned(0);
+    lldb::addr_t finish_val = finish_sp->GetValueAsUnsigned(0);
+    lldb::addr_t end_val = end_sp->GetValueAsUnsigned(0);
+    
+    // before a vector has been constructed it contains garbage, so make
+    // sure the pointers are sane before trusting the size they imply
+    if (start_val == 0 || finish_val == 0 || end_val == 0)
+        return false;
+    if (start_val >= finish_val || finish_val > end_val)
+        return false;
+    if ((finish_val - start_val) % m_element_size)
+        return false;
+    
+    m_start = start_val;
+    m_count = (finish_val - start_val) / m_element_size;
+    return false;
+}
+
+bool
+lldb_private::formatters::LibstdcppStdVectorSyntheticFrontEnd::MightHaveChildren ()
+{
+    return true;
+}
+
+size_t
+lldb_private::formatters::LibstdcppStdVectorSyntheticFrontEnd::GetIndexOfChildWithName (const ConstString &name)
+{
+    if (!m_count)
+        return UINT32_MAX;
+    return ExtractIndexFromString(name.GetCString());
+}
+
+lldb_private::formatters::LibstdcppStdVectorSyntheticFrontEnd::~LibstdcppStdVectorSyntheticFrontEnd ()
+{}
+
+SyntheticChildrenFrontEnd*
+lldb_private::formatters::LibstdcppStdVectorSyntheticFrontEndCreator (CXXSyntheticChildren*, lldb::ValueObjectSP valobj_sp)
+{
+    if (!valobj_sp)
+        return NULL;
+    return (new LibstdcppStdVectorSyntheticFrontEnd(valobj_sp));
+}
@@ -0,0 +1,174 @@
+//===-- LibStdcppList.cpp ----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/lldb-python.h"
+
+#include "lldb/DataFormatters/CXXFormatterFunctions.h"
+
+#include "lldb/Core/Error.h"
+#include "lldb/Core/Stream.h"
+#include "lldb/Core/ValueObject.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/Target.h"
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::formatters;
+
+/*
+ (std::list<int, std::allocator<int> >) l = {
+ (std::_List_base<int, std::allocator<int> >) std::_List_base<int, std::allocator<int> > = {
+ (std::_List_base<int, std::allocator<int> >::_List_impl) _M_impl = {
+ (std::__detail::_List_node_base) _M_node = {
+ (std::__detail::_List_node_base *) _M_next = 0x0000000100103910
+ (std::__detail::_List_node_base *) _M_prev = 0x0000000100103950
+ }
+ }
+ }
+ }
+ 
+ Each element lives in a _List_node, right after the _M_next and _M_prev
+ pointers of its _List_node_base. The list is circular through _M_node.
+ */
+
+lldb_private::formatters::LibstdcppStdListSyntheticFrontEnd::LibstdcppStdListSyntheticFrontEnd (lldb::ValueObjectSP valobj_sp) :
+    SyntheticChildrenFrontEnd(*valobj_sp.get()),
+    m_list_capping_size(0),
+    m_node_address(0),
+    m_element_type(),
+    m_data_offset(0),
+    m_count(UINT32_MAX),
+    m_nodes(),
+    m_children()
+{
+    if (valobj_sp)
+        Update();
+}
+
+size_t
+lldb_private::formatters::LibstdcppStdListSyntheticFrontEnd::CalculateNumChildren ()
+{
+    if (m_count != UINT32_MAX)
+        return m_count;
+    m_count = 0;
+    if (m_node_address == 0)
+        return 0;
+    
+    // walk the _M_next pointers straight from memory, remembering the node
+    // addresses so that fetching a child doesn't need to walk the list again
+    const ExecutionContextRef &exe_ctx_ref(m_backend.GetExecutionContextRef());
+    Error error;
+    lldb::addr_t node = ReadPointerFromTargetOrProcess(exe_ctx_ref, m_node_address, error);
+    while (node != m_node_address)
+    {
+        if (error.Fail() || node == 0 || node == LLDB_INVALID_ADDRESS)
+        {
+            m_nodes.clear();
+            return 0;
+        }
+        m_nodes.push_back(node);
+        // Floyd's cycle detection: after 2n steps the fast walker is at
+        // m_nodes[2n-1] and the slow one at m_nodes[n-1]
+        const size_t num_nodes = m_nodes.size();
+        if ((num_nodes % 2) == 0 && m_nodes[num_nodes / 2 - 1] == m_nodes[num_nodes - 1])
+        {
+            m_nodes.clear();
+            return 0;
+        }
+        if (num_nodes >= m_list_capping_size)
+            break;
+        node = ReadPointerFromTargetOrProcess(exe_ctx_ref, node, error);
+    }
+    return m_count = m_nodes.size();
+}
+
+lldb::ValueObjectSP
+lldb_private::formatters::LibstdcppStdListSyntheticFrontEnd::GetChildAtIndex (size_t idx)
+{
+    if (idx >= CalculateNumChildren())
+        return lldb::ValueObjectSP();
+    
+    auto cached = m_children.find(idx);
+    if (cached != m_children.end())
+        return cached->second;
+    
+    StreamString name;
+    name.Printf("[%" PRIu64 "]", (uint64_t)idx);
+    return (m_children[idx] = CreateValueObjectFromTargetOrProcessAddress(name.GetData(), m_nodes[idx] + m_data_offset, m_backend.GetExecutionContextRef(), m_element_type));
+}
+
+bool
+lldb_private::formatters::LibstdcppStdListSyntheticFrontEnd::Update()
+{
+    m_node_address = 0;
+    m_count = UINT32_MAX;
+    m_nodes.clear();
+    m_children.clear();
+    m_list_capping_size = 0;
+    TargetSP target_sp(m_backend.GetTargetSP());
+    if (!target_sp)
+        return false;
+    m_list_capping_size = target_sp->GetMaximumNumberOfChildrenToDisplay();
+    if (m_list_capping_size == 0)
+        m_list_capping_size = 255;
+    
+    ValueObjectSP impl_sp(m_backend.GetChildMemberWithName(ConstString("_M_impl"), true));
+    if (!impl_sp)
+        return false;
+    ValueObjectSP node_sp(impl_sp->GetChildMemberWithName(ConstString("_M_node"), true));
+    if (!node_sp)
+        return false;
+    
+    ClangASTType list_type = m_backend.GetClangType();
+    if (list_type.IsReferenceType())
+        list_type = list_type.GetNonReferenceType();
+    if (list_type.GetNumTemplateArguments() == 0)
+        return false;
+    lldb::TemplateArgumentKind kind;
+    m_element_type = list_type.GetTemplateArgument(0, kind);
+    if (!m_element_type)
+        return false;
+    
+    // the element follows the _M_next and _M_prev pointers, aligned as
+    // the element type requires
+    const uint32_t ptr_size = target_sp->GetArchitecture().GetAddressByteSize();
+    uint32_t align = m_element_type.GetTypeBitAlign() / 8;
+    if (align < ptr_size)
+        align = ptr_size;
+    m_data_offset = ((2 * ptr_size + align - 1) / align) * align;
+    
+    lldb::addr_t node_address = node_sp->GetAddressOf();
+    if (node_address == 0 || node_address == LLDB_INVALID_ADDRESS)
+        return false;
+    m_node_address = node_address;
+    return false;
+}
+
+bool
+lldb_private::formatters::LibstdcppStdListSyntheticFrontEnd::MightHaveChildren ()
+{
+    return true;
+}
+
+size_t
+lldb_private::formatters::LibstdcppStdListSyntheticFrontEnd::GetIndexOfChildWithName (const ConstString &name)
+{
+    return ExtractIndexFromString(name.GetCString());
+}
+
+lldb_private::formatters::LibstdcppStdListSyntheticFrontEnd::~LibstdcppStdListSyntheticFrontEnd ()
+{}
+
+SyntheticChildrenFrontEnd*
+lldb_private::formatters::LibstdcppStdListSyntheticFrontEndCreator (CXXSyntheticChildren*, lldb::ValueObjectSP valobj_sp)
+{
+    if (!valobj_sp)
+        return NULL;
+    return (new LibstdcppStdListSyntheticFrontEnd(valobj_sp));
+}
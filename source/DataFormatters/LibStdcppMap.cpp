@@ -0,0 +1,247 @@
+//===-- LibStdcppMap.cpp -----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/lldb-python.h"
+
+#include "lldb/DataFormatters/CXXFormatterFunctions.h"
+
+#include "lldb/Core/Error.h"
+#include "lldb/Core/Stream.h"
+#include "lldb/Core/ValueObject.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/Target.h"
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::formatters;
+
+/*
+ (std::map<int, int, std::less<int>, std::allocator<std::pair<const int, int> > >) m = {
+ (std::_Rb_tree<int, std::pair<const int, int>, std::_Select1st<std::pair<const int, int> >, std::less<int>, std::allocator<std::pair<const int, int> > >) _M_t = {
+ (std::_Rb_tree<...>::_Rb_tree_impl<std::less<int>, false>) _M_impl = {
+ (std::_Rb_tree_node_base) _M_header = {
+ (std::_Rb_tree_color) _M_color = _S_red
+ (std::_Rb_tree_node_base::_Base_ptr) _M_parent = 0x0000000100103910
+ (std::_Rb_tree_node_base::_Base_ptr) _M_left = 0x00000001001038c0
+ (std::_Rb_tree_node_base::_Base_ptr) _M_right = 0x0000000100103960
+ }
+ (size_t) _M_node_count = 3
+ }
+ }
+ }
+ 
+ _M_header is the end() node: its _M_parent is the root of the tree and
+ its _M_left and _M_right are the leftmost and rightmost nodes. Each
+ element lives in an _Rb_tree_node, right after its _Rb_tree_node_base.
+ */
+
+// offsets of the _Rb_tree_node_base pointers, in pointer sized units
+// (_M_color is an enum, padded to a pointer)
+enum
+{
+    eRbTreeParent = 1,
+    eRbTreeLeft = 2,
+    eRbTreeRight = 3
+};
+
+lldb_private::formatters::LibstdcppStdMapSyntheticFrontEnd::LibstdcppStdMapSyntheticFrontEnd (lldb::ValueObjectSP valobj_sp) :
+    SyntheticChildrenFrontEnd(*valobj_sp.get()),
+    m_header_address(0),
+    m_element_type(),
+    m_ptr_size(0),
+    m_data_offset(0),
+    m_count(0),
+    m_garbage(false),
+    m_nodes(),
+    m_children()
+{
+    if (valobj_sp)
+        Update();
+}
+
+lldb::addr_t
+lldb_private::formatters::LibstdcppStdMapSyntheticFrontEnd::ReadNodePointer (lldb::addr_t node, uint32_t offset)
+{
+    Error error;
+    lldb::addr_t value = ReadPointerFromTargetOrProcess(m_backend.GetExecutionContextRef(), node + offset * m_ptr_size, error);
+    if (error.Fail())
+        return 0;
+    return value;
+}
+
+//----------------------------------------------------------------------
+// The in-order successor of node, as computed by libstdc++'s
+// _Rb_tree_increment(). A well formed tree never takes more than
+// m_count steps to find it, so if we do the tree is garbage (most
+// likely not constructed yet) and we return zero.
+//----------------------------------------------------------------------
+lldb::addr_t
+lldb_private::formatters::LibstdcppStdMapSyntheticFrontEnd::IncrementNode (lldb::addr_t node)
+{
+    size_t steps_left = m_count;
+    lldb::addr_t x = ReadNodePointer(node, eRbTreeRight);
+    if (x != 0)
+    {
+        lldb::addr_t left;
+        while ((left = ReadNodePointer(x, eRbTreeLeft)) != 0)
+        {
+            if (steps_left-- == 0)
+                return 0;
+            x = left;
+        }
+        return x;
+    }
+    
+    x = node;
+    lldb::addr_t y = ReadNodePointer(x, eRbTreeParent);
+    while (y != 0 && x == ReadNodePointer(y, eRbTreeRight))
+    {
+        if (steps_left-- == 0)
+            return 0;
+        x = y;
+        y = ReadNodePointer(y, eRbTreeParent);
+    }
+    if (y == 0)
+        return 0;
+    // going up from the rightmost node ends with x at the header, which
+    // is already the successor (end())
+    if (ReadNodePointer(x, eRbTreeRight) != y)
+        x = y;
+    return x;
+}
+
+size_t
+lldb_private::formatters::LibstdcppStdMapSyntheticFrontEnd::CalculateNumChildren ()
+{
+    return m_count;
+}
+
+lldb::ValueObjectSP
+lldb_private::formatters::LibstdcppStdMapSyntheticFrontEnd::GetChildAtIndex (size_t idx)
+{
+    if (idx >= m_count || m_garbage)
+        return lldb::ValueObjectSP();
+    
+    auto cached = m_children.find(idx);
+    if (cached != m_children.end())
+        return cached->second;
+    
+    // the nodes found so far are cached, so printing the whole map walks
+    // the tree once instead of once per child
+    if (m_nodes.empty())
+    {
+        lldb::addr_t leftmost = ReadNodePointer(m_header_address, eRbTreeLeft);
+        if (leftmost == 0 || leftmost == m_header_address)
+        {
+            m_garbage = true;
+            return lldb::ValueObjectSP();
+        }
+        m_nodes.push_back(leftmost);
+    }
+    while (m_nodes.size() <= idx)
+    {
+        lldb::addr_t next = IncrementNode(m_nodes.back());
+        if (next == 0 || next == m_header_address)
+        {
+            m_garbage = true;
+            return lldb::ValueObjectSP();
+        }
+        m_nodes.push_back(next);
+    }
+    
+    StreamString name;
+    name.Printf("[%" PRIu64 "]", (uint64_t)idx);
+    return (m_children[idx] = CreateValueObjectFromTargetOrProcessAddress(name.GetData(), m_nodes[idx] + m_data_offset, m_backend.GetExecutionContextRef(), m_element_type));
+}
+
+bool
+lldb_private::formatters::LibstdcppStdMapSyntheticFrontEnd::Update()
+{
+    m_header_address = 0;
+    m_count = 0;
+    m_garbage = false;
+    m_nodes.clear();
+    m_children.clear();
+    
+    ValueObjectSP tree_sp(m_backend.GetChildMemberWithName(ConstString("_M_t"), true));
+    if (!tree_sp)
+        return false;
+    ValueObjectSP impl_sp(tree_sp->GetChildMemberWithName(ConstString("_M_impl"), true));
+    if (!impl_sp)
+        return false;
+    ValueObjectSP header_sp(impl_sp->GetChildMemberWithName(ConstString("_M_header"), true));
+    ValueObjectSP node_count_sp(impl_sp->GetChildMemberWithName(ConstString("_M_node_count"), true));
+    if (!header_sp || !node_count_sp)
+        return false;
+    
+    // the value_type is the second template argument of the _Rb_tree, this
+    // spares us from making up the name of the std::pair and looking it up
+    ClangASTType tree_type = tree_sp->GetClangType();
+    if (tree_type.GetNumTemplateArguments() < 2)
+        return false;
+    lldb::TemplateArgumentKind kind;
+    m_element_type = tree_type.GetTemplateArgument(1, kind);
+    if (!m_element_type)
+        return false;
+    
+    TargetSP target_sp(m_backend.GetTargetSP());
+    if (!target_sp)
+        return false;
+    m_ptr_size = target_sp->GetArchitecture().GetAddressByteSize();
+    uint32_t align = m_element_type.GetTypeBitAlign() / 8;
+    if (align == 0)
+        align = 1;
+    const uint32_t node_base_size = header_sp->GetClangType().GetByteSize();
+    m_data_offset = ((node_base_size + align - 1) / align) * align;
+    
+    lldb::addr_t header_address = header_sp->GetAddressOf();
+    if (header_address == 0 || header_address == LLDB_INVALID_ADDRESS)
+        return false;
+    // an empty tree has no root
+    lldb::addr_t root = ReadNodePointer(header_address, eRbTreeParent);
+    if (root == 0)
+        return false;
+    // the parent of the root is the header, unless the map hasn't been
+    // constructed yet and all of this is garbage
+    if (ReadNodePointer(root, eRbTreeParent) != header_address)
+        return false;
+    m_header_address = header_address;
+    // _M_node_count can be garbage too, cap it like the std::list front
+    // end caps its walk
+    size_t capping_size = target_sp->GetMaximumNumberOfChildrenToDisplay();
+    if (capping_size == 0)
+        capping_size = 255;
+    m_count = node_count_sp->GetValueAsUnsigned(0);
+    if (m_count > capping_size)
+        m_count = capping_size;
+    return false;
+}
+
+bool
+lldb_private::formatters::LibstdcppStdMapSyntheticFrontEnd::MightHaveChildren ()
+{
+    return true;
+}
+
+size_t
+lldb_private::formatters::LibstdcppStdMapSyntheticFrontEnd::GetIndexOfChildWithName (const ConstString &name)
+{
+    return ExtractIndexFromString(name.GetCString());
+}
+
+lldb_private::formatters::LibstdcppStdMapSyntheticFrontEnd::~LibstdcppStdMapSyntheticFrontEnd ()
+{}
+
+SyntheticChildrenFrontEnd*
+lldb_private::formatters::LibstdcppStdMapSyntheticFrontEndCreator (CXXSyntheticChildren*, lldb::ValueObjectSP valobj_sp)
+{
+    if (!valobj_sp)
+        return NULL;
+    return (new LibstdcppStdMapSyntheticFrontEnd(valobj_sp));
+}
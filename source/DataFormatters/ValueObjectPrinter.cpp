@@ -16,6 +16,7 @@
 #include "lldb/Core/Debugger.h"
 #include "lldb/DataFormatters/DataVisualization.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 
 using namespace lldb;
@@ -513,6 +514,65 @@ ValueObjectPrinter::PrintChildrenPostamble (bool print_dotdotdot)
     }
 }
 
+void
+ValueObjectPrinter::PrefetchChildrenData (size_t num_children)
+{
+    // The children of an aggregate each read their own value from memory,
+    // which for a large array means one read per element. Read the part
+    // of the aggregate that will be printed at once and let the children
+    // slice their values out of it. Pointees aren't part of it, so
+    // nothing beyond the pointer depth is read.
+    ValueObject* synth_m_valobj = GetValueObjectForChildrenGeneration();
+    uint64_t byte_size = 0;
+    ClangASTType element_type;
+    if (synth_m_valobj == m_valobj && m_valobj->GetClangType().IsArrayType(&element_type, NULL, NULL))
+        byte_size = element_type.GetByteSize() * num_children;
+    m_valobj->PrefetchChildrenData(byte_size);
+}
+
+void
+ValueObjectPrinter::PrefetchChildPointees (size_t num_children,
+                                           uint32_t curr_ptr_depth)
+{
+    // Printing an array of pointers usually follows each of the pointers,
+    // one memory read at a time. Tell the process about all of them up
+    // front so it can fetch the memory in as few requests as possible.
+    // The children are made before they are printed only when we know
+    // from the element type that they are pointers and the process can
+    // read them in a batch.
+    if (num_children < 2)
+        return;
+    ProcessSP process_sp(m_valobj->GetProcessSP());
+    if (!process_sp || !process_sp->CanReadMemoryRanges())
+        return;
+    ValueObject* synth_m_valobj = GetValueObjectForChildrenGeneration();
+    ClangASTType element_type;
+    if (synth_m_valobj != m_valobj ||
+        !m_valobj->GetClangType().IsArrayType(&element_type, NULL, NULL) ||
+        !element_type.IsPointerType())
+        return;
+    
+    uint32_t cstr_length = 0;
+    bool follow_pointers = curr_ptr_depth > 0 || element_type.IsCStringType(cstr_length);
+    std::vector<addr_t> addrs;
+    for (size_t idx=0; idx<num_children; ++idx)
+    {
+        ValueObjectSP child_sp(m_valobj->GetChildAtIndex(idx, true));
+        if (!child_sp)
+            continue;
+        // All elements share a type, so they share a summary too.
+        if (idx == 0 && !follow_pointers)
+            follow_pointers = (bool)child_sp->GetSummaryFormat();
+        if (!follow_pointers)
+            return;
+        const addr_t addr = child_sp->GetPointerValue();
+        if (addr != LLDB_INVALID_ADDRESS && addr != 0)
+            addrs.push_back(addr);
+    }
+    if (addrs.size() > 1)
+        process_sp->PrefetchMemory(&addrs[0], addrs.size());
+}
+
 void
 ValueObjectPrinter::PrintChildren (uint32_t curr_ptr_depth)
 {
@@ -524,6 +584,10 @@ ValueObjectPrinter::PrintChildren (uint32_t curr_ptr_depth)
     {
         PrintChildrenPreamble ();
         
+        PrefetchChildrenData (num_children);
+        
+        PrefetchChildPointees (num_children, curr_ptr_depth);
+        
         for (size_t idx=0; idx<num_children; ++idx)
         {
             ValueObjectSP child_sp(synth_m_valobj->GetChildAtIndex(idx, true));
@@ -558,6 +622,8 @@ ValueObjectPrinter::PrintChildrenOneLiner (bool hide_names)
     
     if (num_children)
     {
+        PrefetchChildrenData (num_children);
+        
         m_stream->PutChar('(');
         
         for (uint32_t idx=0; idx<num_children; ++idx)
@@ -9,6 +9,7 @@
 
 // C Includes
 #include <stdio.h>
+#include <string.h>
 #if HAVE_SYS_TYPES_H
 #  include <sys/types.h>
 #endif
@@ -1005,15 +1006,58 @@ ClangUserExpression::Evaluate (ExecutionContext &exe_ctx,
     if (process == NULL || !process->CanJIT())
         execution_policy = eExecutionPolicyNever;
     
-    ClangUserExpressionSP user_expression_sp (new ClangUserExpression (expr_cstr, expr_prefix, language, desired_type));
+    const bool keep_expression_in_memory = true;
+    const bool generate_debug_info = options.GetGenerateDebugInfo();
+
+    // Look for an expression that was already parsed and JITed from the
+    // same text in the same context. The parse binds names as seen from
+    // the frame's PC, so the PC is part of the key. Expressions that
+    // mention '$' may define persistent variables while being parsed,
+    // so they are always parsed again.
+    ClangUserExpressionSP user_expression_sp;
+    std::string cache_key;
+    Target *target = exe_ctx.GetTargetPtr();
+    if (target && ::strchr (expr_cstr, '$') == NULL)
+    {
+        lldb::addr_t context_addr = LLDB_INVALID_ADDRESS;
+        StackFrame *frame = exe_ctx.GetFramePtr();
+        if (frame)
+            context_addr = frame->GetFrameCodeAddress().GetLoadAddress (target);
+        const size_t prefix_len = expr_prefix ? ::strlen (expr_prefix) : 0;
+        StreamString key;
+        key.Printf ("%i:%i:%i:%i:0x%" PRIx64 ":%" PRIu64 ":",
+                    language,
+                    desired_type,
+                    execution_policy,
+                    generate_debug_info,
+                    context_addr,
+                    (uint64_t)prefix_len);
+        if (prefix_len)
+            key.Write (expr_prefix, prefix_len);
+        key.PutCString (expr_cstr);
+        cache_key.swap (key.GetString());
+
+        user_expression_sp = target->GetCachedUserExpression (cache_key);
+        // The cache and this function hold a reference each, any other
+        // reference means the expression is still running (e.g. a breakpoint
+        // condition hit while running it), so it can't be used again yet.
+        if (user_expression_sp && (user_expression_sp.use_count() > 2 || !user_expression_sp->MatchesContext (exe_ctx)))
+            user_expression_sp.reset();
+    }
+
+    const bool cached = (bool)user_expression_sp;
+    if (!cached)
+        user_expression_sp.reset (new ClangUserExpression (expr_cstr, expr_prefix, language, desired_type));
 
     StreamString error_stream;
         
     if (log)
-        log->Printf("== [ClangUserExpression::Evaluate] Parsing expression %s ==", expr_cstr);
-    
-    const bool keep_expression_in_memory = true;
-    const bool generate_debug_info = options.GetGenerateDebugInfo();
+    {
+        if (cached)
+            log->Printf("== [ClangUserExpression::Evaluate] Reusing parsed expression %s ==", expr_cstr);
+        else
+            log->Printf("== [ClangUserExpression::Evaluate] Parsing expression %s ==", expr_cstr);
+    }
     
     if (options.InvokeCancelCallback (lldb::eExpressionEvaluationParse))
     {
@@ -1022,11 +1066,11 @@ ClangUserExpression::Evaluate (ExecutionContext &exe_ctx,
         return lldb::eExpressionInterrupted;
     }
     
-    if (!user_expression_sp->Parse (error_stream,
-                                    exe_ctx,
-                                    execution_policy,
-                                    keep_expression_in_memory,
-                                    generate_debug_info))
+    if (!cached && !user_expression_sp->Parse (error_stream,
+                                               exe_ctx,
+                                               execution_policy,
+                                               keep_expression_in_memory,
+                                               generate_debug_info))
     {
         if (error_stream.GetString().empty())
             error.SetExpressionError (lldb::eExpressionParseError, "expression failed to parse, unknown error");
@@ -1037,6 +1081,9 @@ ClangUserExpression::Evaluate (ExecutionContext &exe_ctx,
     {
         lldb::ClangExpressionVariableSP expr_result;
 
+        if (!cached && !cache_key.empty())
+            target->CacheUserExpression (cache_key, user_expression_sp);
+
         if (execution_policy == eExecutionPolicyNever &&
             !user_expression_sp->CanInterpret())
         {
@@ -1071,6 +1118,11 @@ ClangUserExpression::Evaluate (ExecutionContext &exe_ctx,
                 if (log)
                     log->Printf("== [ClangUserExpression::Evaluate] Execution completed abnormally ==");
                 
+                // Don't reuse an expression that may have been left half way
+                // through, parse it again next time
+                if (!cache_key.empty())
+                    target->RemoveCachedUserExpression (cache_key);
+                
                 if (error_stream.GetString().empty())
                     error.SetExpressionError (execution_results, "expression failed to execute, unknown error");
                 else
@@ -0,0 +1,466 @@
+//===-- ConditionProgram.cpp ------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Expression/ConditionProgram.h"
+
+// C Includes
+#include <ctype.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+// C++ Includes
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Core/Error.h"
+#include "lldb/Core/ValueObject.h"
+#include "lldb/Symbol/ClangASTType.h"
+#include "lldb/Target/ExecutionContext.h"
+#include "lldb/Target/StackFrame.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+//----------------------------------------------------------------------
+// A recursive descent parser for the supported subset of C, emitting
+// instructions as it goes. Precedence follows C:
+//
+//   or         := and ("||" and)*
+//   and        := equality ("&&" equality)*
+//   equality   := relational (("==" | "!=") relational)*
+//   relational := unary (("<" | "<=" | ">" | ">=") unary)*
+//   unary      := "!" unary | "-" integer | primary
+//   primary    := integer | "true" | "false" | "NULL" | "nullptr"
+//               | path | "(" or ")"
+//   path       := identifier ("." identifier | "->" identifier | "[" integer "]")*
+//----------------------------------------------------------------------
+class ConditionProgram::Parser
+{
+public:
+    Parser (ConditionProgram &program, const char *text) :
+        m_program (program),
+        m_pos (text)
+    {
+    }
+
+    bool
+    ParseCondition ()
+    {
+        if (!ParseOr())
+            return false;
+        SkipSpaces();
+        return *m_pos == '\0';
+    }
+
+private:
+    void
+    SkipSpaces ()
+    {
+        while (isspace(*m_pos))
+            ++m_pos;
+    }
+
+    bool
+    Consume (const char *token)
+    {
+        SkipSpaces();
+        const size_t token_len = ::strlen (token);
+        if (::strncmp (m_pos, token, token_len) != 0)
+            return false;
+        m_pos += token_len;
+        return true;
+    }
+
+    static bool
+    IsIdentifierStart (char c)
+    {
+        return isalpha(c) || c == '_';
+    }
+
+    bool
+    ParseIdentifier (std::string &identifier)
+    {
+        SkipSpaces();
+        if (!IsIdentifierStart(*m_pos))
+            return false;
+        const char *start = m_pos;
+        while (isalnum(*m_pos) || *m_pos == '_')
+            ++m_pos;
+        identifier.append (start, m_pos - start);
+        return true;
+    }
+
+    // Parse an integer literal the way C does, including the type the
+    // suffixes and the magnitude give it. If negate is true, the literal
+    // is the operand of a unary minus.
+    bool
+    ParseInteger (Scalar &value, bool negate)
+    {
+        SkipSpaces();
+        if (!isdigit(*m_pos))
+            return false;
+        char *end = NULL;
+        const unsigned long long uval = ::strtoull (m_pos, &end, 0);
+        if (end == m_pos)
+            return false;
+        m_pos = end;
+
+        bool is_unsigned = false;
+        uint32_t num_longs = 0;
+        while (true)
+        {
+            if (*m_pos == 'u' || *m_pos == 'U')
+                is_unsigned = true;
+            else if (*m_pos == 'l' || *m_pos == 'L')
+                ++num_longs;
+            else
+                break;
+            ++m_pos;
+        }
+        // "10ul" is fine, "10x" or "1.5" aren't integers
+        if (isalnum(*m_pos) || *m_pos == '_' || *m_pos == '.')
+            return false;
+
+        if (is_unsigned)
+        {
+            if (num_longs == 0 && uval <= UINT_MAX)
+                value = (unsigned int)uval;
+            else
+                value = (unsigned long long)uval;
+            if (negate)
+                value.UnaryNegate();
+        }
+        else if (num_longs == 0 && uval <= (unsigned long long)INT_MAX + (negate ? 1 : 0))
+            value = negate ? (int)(0 - uval) : (int)uval;
+        else if (uval <= (unsigned long long)LLONG_MAX + (negate ? 1 : 0))
+            value = negate ? (long long)(0 - uval) : (long long)uval;
+        else
+        {
+            value = (unsigned long long)uval;
+            if (negate)
+                value.UnaryNegate();
+        }
+        return true;
+    }
+
+    bool
+    ParsePrimary ()
+    {
+        if (Consume ("("))
+            return ParseOr() && Consume (")");
+
+        SkipSpaces();
+        Scalar value;
+        if (isdigit(*m_pos))
+        {
+            if (!ParseInteger (value, false))
+                return false;
+            m_program.m_constants.push_back (value);
+            m_program.AddInstruction (eOpPushConstant, m_program.m_constants.size() - 1);
+            return true;
+        }
+
+        std::string path;
+        if (!ParseIdentifier (path))
+            return false;
+
+        if (path == "true" || path == "false" || path == "NULL" || path == "nullptr")
+        {
+            value = (path == "true") ? 1 : 0;
+            m_program.m_constants.push_back (value);
+            m_program.AddInstruction (eOpPushConstant, m_program.m_constants.size() - 1);
+            return true;
+        }
+
+        // Build the path without spaces, StackFrame doesn't expect any
+        while (true)
+        {
+            if (Consume ("."))
+            {
+                path.push_back ('.');
+                if (!ParseIdentifier (path))
+                    return false;
+            }
+            else if (Consume ("->"))
+            {
+                path.append ("->");
+                if (!ParseIdentifier (path))
+                    return false;
+            }
+            else if (Consume ("["))
+            {
+                SkipSpaces();
+                const char *index_start = m_pos;
+                while (isdigit(*m_pos))
+                    ++m_pos;
+                if (m_pos == index_start)
+                    return false;
+                path.push_back ('[');
+                path.append (index_start, m_pos - index_start);
+                path.push_back (']');
+                if (!Consume ("]"))
+                    return false;
+            }
+            else
+                break;
+        }
+        m_program.m_variable_paths.push_back (path);
+        m_program.AddInstruction (eOpPushVariable, m_program.m_variable_paths.size() - 1);
+        return true;
+    }
+
+    bool
+    ParseUnary ()
+    {
+        if (Consume ("!"))
+        {
+            if (!ParseUnary())
+                return false;
+            m_program.AddInstruction (eOpNot);
+            return true;
+        }
+        if (Consume ("-"))
+        {
+            // Only negative constants, so there is no arithmetic to do
+            Scalar value;
+            if (!ParseInteger (value, true))
+                return false;
+            m_program.m_constants.push_back (value);
+            m_program.AddInstruction (eOpPushConstant, m_program.m_constants.size() - 1);
+            return true;
+        }
+        return ParsePrimary();
+    }
+
+    bool
+    ParseRelational ()
+    {
+        if (!ParseUnary())
+            return false;
+        while (true)
+        {
+            OpCode opcode;
+            if (Consume ("<="))
+                opcode = eOpLessEqual;
+            else if (Consume (">="))
+                opcode = eOpGreaterEqual;
+            else if (Consume ("<"))
+                opcode = eOpLess;
+            else if (Consume (">"))
+                opcode = eOpGreater;
+            else
+                return true;
+            if (!ParseUnary())
+                return false;
+            m_program.AddInstruction (opcode);
+        }
+    }
+
+    bool
+    ParseEquality ()
+    {
+        if (!ParseRelational())
+            return false;
+        while (true)
+        {
+            OpCode opcode;
+            if (Consume ("=="))
+                opcode = eOpEqual;
+            else if (Consume ("!="))
+                opcode = eOpNotEqual;
+            else
+                return true;
+            if (!ParseRelational())
+                return false;
+            m_program.AddInstruction (opcode);
+        }
+    }
+
+    // "&&" and "||" short circuit like in C, so conditions like
+    // "p && p->state == 3" don't read through NULL pointers.
+    bool
+    ParseLogical (const char *token, OpCode jump_opcode, bool (Parser::*parse_operand)())
+    {
+        if (!(this->*parse_operand)())
+            return false;
+        std::vector<uint32_t> jumps;
+        while (Consume (token))
+        {
+            m_program.AddInstruction (eOpToBool);
+            jumps.push_back (m_program.AddInstruction (jump_opcode));
+            if (!(this->*parse_operand)())
+                return false;
+        }
+        if (!jumps.empty())
+        {
+            m_program.AddInstruction (eOpToBool);
+            const uint32_t end = m_program.m_instructions.size();
+            for (size_t i = 0; i < jumps.size(); ++i)
+                m_program.m_instructions[jumps[i]].operand = end;
+        }
+        return true;
+    }
+
+    bool
+    ParseAnd ()
+    {
+        return ParseLogical ("&&", eOpJumpIfFalse, &Parser::ParseEquality);
+    }
+
+    bool
+    ParseOr ()
+    {
+        return ParseLogical ("||", eOpJumpIfTrue, &Parser::ParseAnd);
+    }
+
+    ConditionProgram &m_program;
+    const char *m_pos;
+};
+
+ConditionProgram::ConditionProgram (const char *condition_text) :
+    m_instructions (),
+    m_constants (),
+    m_variable_paths ()
+{
+    if (condition_text == NULL)
+        return;
+    Parser parser (*this, condition_text);
+    if (!parser.ParseCondition())
+    {
+        m_instructions.clear();
+        m_constants.clear();
+        m_variable_paths.clear();
+    }
+}
+
+ConditionProgram::~ConditionProgram ()
+{
+}
+
+uint32_t
+ConditionProgram::AddInstruction (OpCode opcode, uint32_t operand)
+{
+    Instruction instruction = { opcode, operand };
+    m_instructions.push_back (instruction);
+    return m_instructions.size() - 1;
+}
+
+bool
+ConditionProgram::Evaluate (ExecutionContext &exe_ctx, bool &result)
+{
+    StackFrame *frame = exe_ctx.GetFramePtr();
+    if (!IsValid() || frame == NULL)
+        return false;
+
+    const uint32_t path_options = StackFrame::eExpressionPathOptionsAllowDirectIVarAccess |
+                                  StackFrame::eExpressionPathOptionsNoSyntheticChildren |
+                                  StackFrame::eExpressionPathOptionsNoSyntheticArrayRange;
+    const uint32_t value_type_mask = ClangASTType::eTypeIsScalar |
+                                     ClangASTType::eTypeIsPointer |
+                                     ClangASTType::eTypeIsEnumeration;
+    std::vector<Scalar> stack;
+    const uint32_t num_instructions = m_instructions.size();
+    uint32_t pc = 0;
+    while (pc < num_instructions)
+    {
+        const Instruction &instruction = m_instructions[pc++];
+        switch (instruction.opcode)
+        {
+        case eOpPushConstant:
+            stack.push_back (m_constants[instruction.operand]);
+            break;
+
+        case eOpPushVariable:
+            {
+                VariableSP var_sp;
+                Error error;
+                ValueObjectSP valobj_sp (frame->GetValueForVariableExpressionPath (m_variable_paths[instruction.operand].c_str(),
+                                                                                   eNoDynamicValues,
+                                                                                   path_options,
+                                                                                   var_sp,
+                                                                                   error));
+                if (!valobj_sp || error.Fail())
+                    return false;
+                if (valobj_sp->GetTypeInfo() & ClangASTType::eTypeIsReference)
+                {
+                    valobj_sp = valobj_sp->Dereference (error);
+                    if (!valobj_sp || error.Fail())
+                        return false;
+                }
+                // Aggregates would need the full expression parser
+                if ((valobj_sp->GetTypeInfo() & value_type_mask) == 0)
+                    return false;
+                Scalar value;
+                if (!valobj_sp->ResolveValue (value))
+                    return false;
+                // C promotes values narrower than int to int before it
+                // compares them, but the Scalar for an unsigned char, short
+                // or bool is unsigned and would compare unsigned against a
+                // negative constant.
+                if ((valobj_sp->GetTypeInfo() & ClangASTType::eTypeIsPointer) == 0 &&
+                    valobj_sp->GetByteSize() * 8 < 32)
+                    value.Cast (Scalar::e_sint);
+                stack.push_back (value);
+            }
+            break;
+
+        case eOpToBool:
+        case eOpNot:
+            if (stack.empty())
+                return false;
+            {
+                const bool is_true = !stack.back().IsZero();
+                stack.back() = (instruction.opcode == eOpNot) ? !is_true : is_true;
+            }
+            break;
+
+        case eOpEqual:
+        case eOpNotEqual:
+        case eOpLess:
+        case eOpLessEqual:
+        case eOpGreater:
+        case eOpGreaterEqual:
+            if (stack.size() < 2)
+                return false;
+            {
+                const Scalar rhs (stack.back());
+                stack.pop_back();
+                const Scalar &lhs = stack.back();
+                bool compare_result = false;
+                switch (instruction.opcode)
+                {
+                case eOpEqual:          compare_result = lhs == rhs; break;
+                case eOpNotEqual:       compare_result = lhs != rhs; break;
+                case eOpLess:           compare_result = lhs <  rhs; break;
+                case eOpLessEqual:      compare_result = lhs <= rhs; break;
+                case eOpGreater:        compare_result = lhs >  rhs; break;
+                case eOpGreaterEqual:   compare_result = lhs >= rhs; break;
+                default:                break;
+                }
+                stack.back() = compare_result;
+            }
+            break;
+
+        case eOpJumpIfFalse:
+        case eOpJumpIfTrue:
+            if (stack.empty())
+                return false;
+            if (stack.back().IsZero() == (instruction.opcode == eOpJumpIfFalse))
+                pc = instruction.operand;
+            else
+                stack.pop_back();
+            break;
+        }
+    }
+
+    if (stack.size() != 1)
+        return false;
+    result = !stack.back().IsZero();
+    return true;
+}
@@ -200,6 +200,8 @@ DW_OP_value_to_name (uint32_t val)
     case 0x9a: return "DW_OP_call_ref";
 //    case DW_OP_APPLE_array_ref: return "DW_OP_APPLE_array_ref";
 //    case DW_OP_APPLE_extern: return "DW_OP_APPLE_extern";
+    case 0xfb: return "DW_OP_GNU_addr_index";
+    case 0xfc: return "DW_OP_GNU_const_index";
     case DW_OP_APPLE_uninit: return "DW_OP_APPLE_uninit";
 //    case DW_OP_APPLE_assign: return "DW_OP_APPLE_assign";
 //    case DW_OP_APPLE_address_of: return "DW_OP_APPLE_address_of";
@@ -600,6 +602,12 @@ DWARFExpression::DumpLocation (Stream *s, lldb::offset_t offset, lldb::offset_t
         case DW_OP_GNU_push_tls_address:
             s->PutCString("DW_OP_GNU_push_tls_address");  // 0xe0
             break;
+        case DW_OP_GNU_addr_index:                                          // 0xfb 1 ULEB128 index into .debug_addr
+            s->Printf("DW_OP_GNU_addr_index(0x%" PRIx64 ")", m_data.GetULEB128(&offset));
+            break;
+        case DW_OP_GNU_const_index:                                         // 0xfc 1 ULEB128 index into .debug_addr
+            s->Printf("DW_OP_GNU_const_index(0x%" PRIx64 ")", m_data.GetULEB128(&offset));
+            break;
         case DW_OP_APPLE_uninit:
             s->PutCString("DW_OP_APPLE_uninit");  // 0xF0
             break;
@@ -1000,6 +1008,8 @@ GetOpcodeDataSize (const DataExtractor &data, const lldb::offset_t data_offset,
         case DW_OP_regx:        // 0x90 1 ULEB128 register
         case DW_OP_fbreg:       // 0x91 1 SLEB128 offset
         case DW_OP_piece:       // 0x93 1 ULEB128 size of piece addressed
+        case DW_OP_GNU_addr_index:  // 0xfb 1 ULEB128 index into .debug_addr (split DWARF)
+        case DW_OP_GNU_const_index: // 0xfc 1 ULEB128 index into .debug_addr (split DWARF)
             data.Skip_LEB128(&offset); 
             return offset - data_offset;   
             
@@ -1107,6 +1117,52 @@ DWARFExpression::Update_DW_OP_addr (lldb::addr_t file_addr)
     return false;
 }
 
+bool
+DWARFExpression::Resolve_DW_OP_GNU_addr_index (const DataExtractor &debug_addr_data, lldb::offset_t addr_base)
+{
+    if (IsLocationList())
+        return false;
+
+    const uint32_t addr_byte_size = m_data.GetAddressByteSize();
+    const ByteOrder byte_order = m_data.GetByteOrder();
+    StreamString strm (Stream::eBinary, addr_byte_size, byte_order);
+    bool resolved_any = false;
+    lldb::offset_t offset = 0;
+    while (m_data.ValidOffset(offset))
+    {
+        const lldb::offset_t op_offset = offset;
+        const uint8_t op = m_data.GetU8(&offset);
+        const offset_t op_arg_size = GetOpcodeDataSize (m_data, offset, op);
+        if (op_arg_size == LLDB_INVALID_OFFSET)
+            return false;
+
+        if (op == DW_OP_GNU_addr_index || op == DW_OP_GNU_const_index)
+        {
+            const uint64_t index = m_data.GetULEB128(&offset);
+            lldb::offset_t addr_offset = addr_base + index * addr_byte_size;
+            if (!debug_addr_data.ValidOffsetForDataOfSize (addr_offset, addr_byte_size))
+                return false;
+            const uint64_t value = debug_addr_data.GetMaxU64 (&addr_offset, addr_byte_size);
+            if (op == DW_OP_GNU_addr_index)
+                strm.PutHex8 (DW_OP_addr);
+            else
+                strm.PutHex8 (addr_byte_size == 8 ? DW_OP_const8u : DW_OP_const4u);
+            strm.PutMaxHex64 (value, addr_byte_size, byte_order);
+            resolved_any = true;
+        }
+        else
+        {
+            offset += op_arg_size;
+            strm.Write (m_data.PeekData (op_offset, offset - op_offset), offset - op_offset);
+        }
+    }
+
+    // The byte order and address size of m_data don't change
+    if (resolved_any)
+        m_data.SetData (DataBufferSP (new DataBufferHeap (strm.GetData(), strm.GetSize())));
+    return true;
+}
+
 bool
 DWARFExpression::LocationListContainsAddress (lldb::addr_t loclist_base_addr, lldb::addr_t addr) const
 {
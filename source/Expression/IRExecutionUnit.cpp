@@ -795,6 +795,11 @@ IRExecutionUnit::CommitAllocations (lldb::ProcessSP &process_sp)
         case lldb::eSectionTypeDWARFAppleTypes:
         case lldb::eSectionTypeDWARFAppleNamespaces:
         case lldb::eSectionTypeDWARFAppleObjC:
+        case lldb::eSectionTypeDWARFDebugNames:
+        case lldb::eSectionTypeDWARFGdbIndex:
+        case lldb::eSectionTypeDWARFDebugAddr:
+        case lldb::eSectionTypeDWARFDebugStrOffsets:
+        case lldb::eSectionTypeDWARFDebugCUIndex:
             err.Clear();
             break;
         default:
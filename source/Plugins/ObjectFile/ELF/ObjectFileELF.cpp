@@ -288,9 +288,23 @@ ObjectFileELF::CreateInstance (const lldb::ModuleSP &module_sp,
         const uint8_t *magic = data_sp->GetBytes() + data_offset;
         if (ELFHeader::MagicBytesMatch(magic))
         {
+            // Core files only need their headers and notes mapped in. The
+            // rest is the memory of the process, which ProcessElfCore maps
+            // in as it reads it.
+            lldb::offset_t map_length = length;
+            DataExtractor header_data (data_sp, eByteOrderLittle, 4);
+            lldb::offset_t header_offset = data_offset;
+            elf::ELFHeader header;
+            if (file && header.Parse (header_data, &header_offset) && header.e_type == llvm::ELF::ET_CORE)
+            {
+                const lldb::offset_t core_headers_size = GetCoreFileHeadersSize (*file, file_offset, header);
+                if (core_headers_size > 0 && core_headers_size < map_length)
+                    map_length = core_headers_size;
+            }
+
             // Update the data to contain the entire file if it doesn't already
-            if (data_sp->GetByteSize() < length) {
-                data_sp = file->MemoryMapFileContents(file_offset, length);
+            if (data_sp->GetByteSize() < map_length) {
+                data_sp = file->MemoryMapFileContents(file_offset, map_length);
                 data_offset = 0;
                 magic = data_sp->GetBytes();
             }
@@ -416,6 +430,38 @@ calc_gnu_debuglink_crc32(const void *buf, size_t size)
     return calc_crc32(0U, buf, size);
 }
 
+//----------------------------------------------------------------------
+// GetCoreFileHeadersSize
+//
+// Returns the number of bytes at the start of a core file that hold its
+// ELF header, program headers and PT_NOTE segments, or zero if the
+// program headers can't be read.
+//----------------------------------------------------------------------
+lldb::offset_t
+ObjectFileELF::GetCoreFileHeadersSize (const lldb_private::FileSpec &file,
+                                       lldb::offset_t file_offset,
+                                       const elf::ELFHeader &header)
+{
+    const size_t ph_size = header.e_phnum * header.e_phentsize;
+    lldb::offset_t headers_size = std::max<lldb::offset_t> (header.e_ehsize, header.e_phoff + ph_size);
+
+    DataBufferSP ph_data_sp (file.ReadFileContents (file_offset + header.e_phoff, ph_size));
+    if (!ph_data_sp || ph_data_sp->GetByteSize() != ph_size)
+        return 0;
+    DataExtractor ph_data (ph_data_sp, header.GetByteOrder(), header.Is32Bit() ? 4 : 8);
+
+    lldb::offset_t offset = 0;
+    for (uint32_t idx = 0; idx < header.e_phnum; ++idx)
+    {
+        ELFProgramHeader program_header;
+        if (program_header.Parse (ph_data, &offset) == false)
+            return 0;
+        if (program_header.p_type == llvm::ELF::PT_NOTE)
+            headers_size = std::max<lldb::offset_t> (headers_size, program_header.p_offset + program_header.p_filesz);
+    }
+    return headers_size;
+}
+
 uint32_t
 ObjectFileELF::CalculateELFNotesSegmentsCRC32 (const ProgramHeaderColl& program_headers,
                                                DataExtractor& object_data)
@@ -483,9 +529,10 @@ ObjectFileELF::GetModuleSpecifications (const lldb_private::FileSpec& file,
                     spec.GetArchitecture().GetTriple().setVendorName(Host::GetVendorString().GetCString());
 
                     // Try to get the UUID from the section list. Usually that's at the end, so
-                    // map the file in if we don't have it already.
+                    // map the file in if we don't have it already. Core files get theirs from
+                    // their notes, and mapping up to the end of a core would map all of it.
                     size_t section_header_end = header.e_shoff + header.e_shnum * header.e_shentsize;
-                    if (section_header_end > data_sp->GetByteSize())
+                    if (section_header_end > data_sp->GetByteSize() && header.e_type != llvm::ELF::ET_CORE)
                     {
                         data_sp = file.MemoryMapFileContents (file_offset, section_header_end);
                         data.SetData(data_sp);
@@ -514,28 +561,15 @@ ObjectFileELF::GetModuleSpecifications (const lldb_private::FileSpec& file,
                             // Thus we will need to fallback to something simpler.
                             if (header.e_type == llvm::ELF::ET_CORE)
                             {
-                                size_t program_headers_end = header.e_phoff + header.e_phnum * header.e_phentsize;
-                                if (program_headers_end > data_sp->GetByteSize())
+                                const lldb::offset_t core_headers_size = GetCoreFileHeadersSize (file, file_offset, header);
+                                if (core_headers_size > data_sp->GetByteSize())
                                 {
-                                    data_sp = file.MemoryMapFileContents(file_offset, program_headers_end);
+                                    data_sp = file.MemoryMapFileContents(file_offset, core_headers_size);
                                     data.SetData(data_sp);
                                 }
                                 ProgramHeaderColl program_headers;
                                 GetProgramHeaderInfo(program_headers, data, header);
 
-                                size_t segment_data_end = 0;
-                                for (ProgramHeaderCollConstIter I = program_headers.begin();
-                                     I != program_headers.end(); ++I)
-                                {
-                                     segment_data_end = std::max<unsigned long long> (I->p_offset + I->p_filesz, segment_data_end);
-                                }
-
-                                if (segment_data_end > data_sp->GetByteSize())
-                                {
-                                    data_sp = file.MemoryMapFileContents(file_offset, segment_data_end);
-                                    data.SetData(data_sp);
-                                }
-
                                 core_notes_crc = CalculateELFNotesSegmentsCRC32 (program_headers, data);
                             }
                             else
@@ -1161,6 +1195,17 @@ ObjectFileELF::CreateSections(SectionList &unified_section_list)
             static ConstString g_sect_name_dwarf_debug_pubtypes (".debug_pubtypes");
             static ConstString g_sect_name_dwarf_debug_ranges (".debug_ranges");
             static ConstString g_sect_name_dwarf_debug_str (".debug_str");
+            static ConstString g_sect_name_dwarf_debug_names (".debug_names");
+            static ConstString g_sect_name_gdb_index (".gdb_index");
+            static ConstString g_sect_name_dwarf_debug_addr (".debug_addr");
+            static ConstString g_sect_name_dwarf_debug_str_offsets (".debug_str_offsets");
+            static ConstString g_sect_name_dwarf_debug_cu_index (".debug_cu_index");
+            static ConstString g_sect_name_dwarf_debug_abbrev_dwo (".debug_abbrev.dwo");
+            static ConstString g_sect_name_dwarf_debug_info_dwo (".debug_info.dwo");
+            static ConstString g_sect_name_dwarf_debug_line_dwo (".debug_line.dwo");
+            static ConstString g_sect_name_dwarf_debug_loc_dwo (".debug_loc.dwo");
+            static ConstString g_sect_name_dwarf_debug_str_dwo (".debug_str.dwo");
+            static ConstString g_sect_name_dwarf_debug_str_offsets_dwo (".debug_str_offsets.dwo");
             static ConstString g_sect_name_eh_frame (".eh_frame");
 
             SectionType sect_type = eSectionTypeOther;
@@ -1191,8 +1236,15 @@ ObjectFileELF::CreateSections(SectionList &unified_section_list)
             // .debug_pubtypes – Lookup table for mapping type names to compilation units
             // .debug_ranges – Address ranges used in DW_AT_ranges attributes
             // .debug_str – String table used in .debug_info
+            // .debug_names – DWARF5 name index mapping names to DIEs
+            // .gdb_index – Name and address index built by the linker or gdb-add-index, https://sourceware.org/gdb/onlinedocs/gdb/Index-Section-Format.html
+            // .debug_addr – Address table used by split DWARF (-gsplit-dwarf) units, http://gcc.gnu.org/wiki/DebugFission
+            // .debug_str_offsets – String offsets table used by split DWARF units
+            // .debug_cu_index – Compile unit index of a .dwp split DWARF package
+            // .debug_*.dwo – Split DWARF sections in .dwo and .dwp files. These files only contain
+            //                debug information, so they use the same section types as the
+            //                sections without the .dwo suffix
             // MISSING? .gnu_debugdata - "mini debuginfo / MiniDebugInfo" section, http://sourceware.org/gdb/onlinedocs/gdb/MiniDebugInfo.html
-            // MISSING? .debug-index - http://src.chromium.org/viewvc/chrome/trunk/src/build/gdb-add-index?pathrev=144644
             // MISSING? .debug_types - Type descriptions from DWARF 4? See http://gcc.gnu.org/wiki/DwarfSeparateTypeInfo
             else if (name == g_sect_name_dwarf_debug_abbrev)    sect_type = eSectionTypeDWARFDebugAbbrev;
             else if (name == g_sect_name_dwarf_debug_aranges)   sect_type = eSectionTypeDWARFDebugAranges;
@@ -1205,6 +1257,17 @@ ObjectFileELF::CreateSections(SectionList &unified_section_list)
             else if (name == g_sect_name_dwarf_debug_pubtypes)  sect_type = eSectionTypeDWARFDebugPubTypes;
             else if (name == g_sect_name_dwarf_debug_ranges)    sect_type = eSectionTypeDWARFDebugRanges;
             else if (name == g_sect_name_dwarf_debug_str)       sect_type = eSectionTypeDWARFDebugStr;
+            else if (name == g_sect_name_dwarf_debug_names)     sect_type = eSectionTypeDWARFDebugNames;
+            else if (name == g_sect_name_gdb_index)             sect_type = eSectionTypeDWARFGdbIndex;
+            else if (name == g_sect_name_dwarf_debug_addr)      sect_type = eSectionTypeDWARFDebugAddr;
+            else if (name == g_sect_name_dwarf_debug_str_offsets) sect_type = eSectionTypeDWARFDebugStrOffsets;
+            else if (name == g_sect_name_dwarf_debug_cu_index)  sect_type = eSectionTypeDWARFDebugCUIndex;
+            else if (name == g_sect_name_dwarf_debug_abbrev_dwo) sect_type = eSectionTypeDWARFDebugAbbrev;
+            else if (name == g_sect_name_dwarf_debug_info_dwo)  sect_type = eSectionTypeDWARFDebugInfo;
+            else if (name == g_sect_name_dwarf_debug_line_dwo)  sect_type = eSectionTypeDWARFDebugLine;
+            else if (name == g_sect_name_dwarf_debug_loc_dwo)   sect_type = eSectionTypeDWARFDebugLoc;
+            else if (name == g_sect_name_dwarf_debug_str_dwo)   sect_type = eSectionTypeDWARFDebugStr;
+            else if (name == g_sect_name_dwarf_debug_str_offsets_dwo) sect_type = eSectionTypeDWARFDebugStrOffsets;
             else if (name == g_sect_name_eh_frame)              sect_type = eSectionTypeEHFrame;
 
             switch (header.sh_type)
@@ -1266,6 +1329,10 @@ ObjectFileELF::CreateSections(SectionList &unified_section_list)
                 eSectionTypeDWARFDebugPubNames,
                 eSectionTypeDWARFDebugPubTypes,
                 eSectionTypeDWARFDebugRanges,
+                eSectionTypeDWARFDebugNames,
+                eSectionTypeDWARFGdbIndex,
+                eSectionTypeDWARFDebugAddr,
+                eSectionTypeDWARFDebugStrOffsets,
                 eSectionTypeELFSymbolTable,
             };
             SectionList *elf_section_list = m_sections_ap.get();
@@ -256,6 +256,12 @@ private:
                          lldb_private::DataExtractor &data,
                          const elf::ELFHeader &header);
 
+    // Returns the size of the headers and notes at the start of a core file.
+    static lldb::offset_t
+    GetCoreFileHeadersSize(const lldb_private::FileSpec &file,
+                           lldb::offset_t file_offset,
+                           const elf::ELFHeader &header);
+
     // Finds PT_NOTE segments and calculates their crc sum.
     static uint32_t
     CalculateELFNotesSegmentsCRC32(const ProgramHeaderColl& program_headers,
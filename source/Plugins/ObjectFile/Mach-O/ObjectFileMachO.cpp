@@ -1096,6 +1096,11 @@ ObjectFileMachO::GetAddressClass (lldb::addr_t file_addr)
                     case eSectionTypeDWARFAppleTypes:
                     case eSectionTypeDWARFAppleNamespaces:
                     case eSectionTypeDWARFAppleObjC:
+                    case eSectionTypeDWARFDebugNames:
+                    case eSectionTypeDWARFGdbIndex:
+                    case eSectionTypeDWARFDebugAddr:
+                    case eSectionTypeDWARFDebugStrOffsets:
+                    case eSectionTypeDWARFDebugCUIndex:
                         return eAddressClassDebug;
                     case eSectionTypeEHFrame:               return eAddressClassRuntime;
                     case eSectionTypeELFSymbolTable:
@@ -11,6 +11,8 @@
 
 // C Includes
 #include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
 #include <poll.h>
 #include <string.h>
 #include <stdint.h>
@@ -19,6 +21,7 @@
 #include <sys/socket.h>
 #include <sys/syscall.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <sys/user.h>
 #include <sys/wait.h>
 
@@ -70,6 +73,12 @@
 // fall back on kill() if tgkill isn't available
 #define tgkill(pid, tid, sig)  syscall(SYS_tgkill, pid, tid, sig)
 
+// process_vm_readv and process_vm_writev were added in Linux 3.2. Call them
+// through syscall() so we don't depend on the C library having wrappers.
+#if defined(__NR_process_vm_readv) && defined(__NR_process_vm_writev)
+  #define LLDB_HAVE_PROCESS_VM_READV 1
+#endif
+
 using namespace lldb_private;
 
 // FIXME: this code is host-dependent with respect to types and
@@ -225,8 +234,8 @@ PtraceWrapper(int req, pid_t pid, void *addr, void *data, size_t data_size)
 // functions without needed to go thru the thread funnel.
 
 static size_t
-DoReadMemory(lldb::pid_t pid,
-             lldb::addr_t vm_addr, void *buf, size_t size, Error &error)
+DoReadMemoryWithPtrace(lldb::pid_t pid,
+                       lldb::addr_t vm_addr, void *buf, size_t size, Error &error)
 {
     // ptrace word size is determined by the host, not the child
     static const unsigned word_size = sizeof(void*);
@@ -285,8 +294,8 @@ DoReadMemory(lldb::pid_t pid,
 }
 
 static size_t
-DoWriteMemory(lldb::pid_t pid,
-              lldb::addr_t vm_addr, const void *buf, size_t size, Error &error)
+DoWriteMemoryWithPtrace(lldb::pid_t pid,
+                        lldb::addr_t vm_addr, const void *buf, size_t size, Error &error)
 {
     // ptrace word size is determined by the host, not the child
     static const unsigned word_size = sizeof(void*);
@@ -331,8 +340,8 @@ DoWriteMemory(lldb::pid_t pid,
         else
         {
             unsigned char buff[8];
-            if (DoReadMemory(pid, vm_addr,
-                             buff, word_size, error) != word_size)
+            if (DoReadMemoryWithPtrace(pid, vm_addr,
+                                       buff, word_size, error) != word_size)
             {
                 if (log)
                     ProcessPOSIXLog::DecNestLevel();
@@ -341,8 +350,8 @@ DoWriteMemory(lldb::pid_t pid,
 
             memcpy(buff, src, remainder);
 
-            if (DoWriteMemory(pid, vm_addr,
-                              buff, word_size, error) != word_size)
+            if (DoWriteMemoryWithPtrace(pid, vm_addr,
+                                        buff, word_size, error) != word_size)
             {
                 if (log)
                     ProcessPOSIXLog::DecNestLevel();
@@ -365,6 +374,133 @@ DoWriteMemory(lldb::pid_t pid,
     return bytes_written;
 }
 
+// Transfer as much memory as possible using process_vm_readv (or
+// process_vm_writev when \a write is true). These calls transfer the whole
+// buffer with a single system call, but fail for pages that aren't mapped
+// readable (or writable) in the inferior, so the number of bytes that were
+// actually transferred is returned and the caller has to deal with the rest.
+static size_t
+TransferMemoryWithProcessVM(ProcessMonitor *monitor, lldb::addr_t vm_addr,
+                            void *buf, size_t size, bool write)
+{
+#if defined(LLDB_HAVE_PROCESS_VM_READV)
+    // The monitor remembers if the kernel doesn't support these calls so we
+    // don't keep trying them.
+    if (!monitor->GetProcessVMSupported())
+        return 0;
+
+    const lldb::pid_t pid = monitor->GetPID();
+
+    size_t bytes_transferred = 0;
+    while (bytes_transferred < size)
+    {
+        struct iovec local_iov;
+        local_iov.iov_base = static_cast<uint8_t *>(buf) + bytes_transferred;
+        local_iov.iov_len = size - bytes_transferred;
+        struct iovec remote_iov;
+        remote_iov.iov_base = reinterpret_cast<void *>(vm_addr + bytes_transferred);
+        remote_iov.iov_len = size - bytes_transferred;
+
+        const long result = syscall(write ? __NR_process_vm_writev : __NR_process_vm_readv,
+                                    static_cast<pid_t>(pid), &local_iov, 1UL, &remote_iov, 1UL, 0UL);
+        if (result <= 0)
+        {
+            if (result < 0 && errno == ENOSYS)
+                monitor->SetProcessVMSupported(false);
+            break;
+        }
+        bytes_transferred += result;
+    }
+    return bytes_transferred;
+#else
+    return 0;
+#endif
+}
+
+// Transfer memory using /proc/<pid>/mem. Unlike process_vm_readv this goes
+// through the same access checks as ptrace, so it can read pages that
+// aren't readable by the inferior itself and write to read only text pages
+// on kernels that allow it.
+static size_t
+TransferMemoryWithProcMem(lldb::pid_t pid, lldb::addr_t vm_addr,
+                          void *buf, size_t size, bool write)
+{
+    char mem_path[PATH_MAX];
+    ::snprintf(mem_path, sizeof(mem_path), "/proc/%" PRIu64 "/mem", pid);
+    int fd = ::open(mem_path, write ? O_RDWR : O_RDONLY);
+    if (fd < 0)
+        return 0;
+
+    size_t bytes_transferred = 0;
+    while (bytes_transferred < size)
+    {
+        uint8_t *local_addr = static_cast<uint8_t *>(buf) + bytes_transferred;
+        // Use the 64 bit offset versions so addresses above 2GB work on
+        // 32 bit hosts too.
+        const off64_t remote_addr = vm_addr + bytes_transferred;
+        ssize_t result;
+        if (write)
+            result = ::pwrite64(fd, local_addr, size - bytes_transferred, remote_addr);
+        else
+            result = ::pread64(fd, local_addr, size - bytes_transferred, remote_addr);
+        if (result <= 0)
+        {
+            if (result < 0 && errno == EINTR)
+                continue;
+            break;
+        }
+        bytes_transferred += result;
+    }
+    ::close(fd);
+    return bytes_transferred;
+}
+
+static size_t
+DoReadMemory(ProcessMonitor *monitor,
+             lldb::addr_t vm_addr, void *buf, size_t size, Error &error)
+{
+    const lldb::pid_t pid = monitor->GetPID();
+    uint8_t *dst = static_cast<uint8_t *>(buf);
+
+    // Try the bulk transfers first and only fall back to reading a word at
+    // a time with ptrace for whatever they couldn't read.
+    size_t bytes_read = TransferMemoryWithProcessVM(monitor, vm_addr, dst, size, false);
+    if (bytes_read < size)
+        bytes_read += TransferMemoryWithProcMem(pid, vm_addr + bytes_read, dst + bytes_read, size - bytes_read, false);
+
+    Log *log (ProcessPOSIXLog::GetLogIfAllCategoriesSet (POSIX_LOG_MEMORY));
+    if (log && ProcessPOSIXLog::AtTopNestLevel())
+        log->Printf ("ProcessMonitor::%s(%" PRIu64 ", %p, %p, %zd, _) bulk read %zd bytes", __FUNCTION__,
+                     pid, (void*)vm_addr, buf, size, bytes_read);
+
+    if (bytes_read < size)
+        bytes_read += DoReadMemoryWithPtrace(pid, vm_addr + bytes_read, dst + bytes_read, size - bytes_read, error);
+    return bytes_read;
+}
+
+static size_t
+DoWriteMemory(ProcessMonitor *monitor,
+              lldb::addr_t vm_addr, const void *buf, size_t size, Error &error)
+{
+    const lldb::pid_t pid = monitor->GetPID();
+    // The bulk transfer functions take a non-const buffer since they are
+    // used for both reading and writing, they won't modify it when writing.
+    uint8_t *src = static_cast<uint8_t *>(const_cast<void *>(buf));
+
+    size_t bytes_written = TransferMemoryWithProcessVM(monitor, vm_addr, src, size, true);
+    if (bytes_written < size)
+        bytes_written += TransferMemoryWithProcMem(pid, vm_addr + bytes_written, src + bytes_written, size - bytes_written, true);
+
+    Log *log (ProcessPOSIXLog::GetLogIfAllCategoriesSet (POSIX_LOG_MEMORY));
+    if (log && ProcessPOSIXLog::AtTopNestLevel())
+        log->Printf ("ProcessMonitor::%s(%" PRIu64 ", %p, %p, %zd, _) bulk wrote %zd bytes", __FUNCTION__,
+                     pid, (void*)vm_addr, buf, size, bytes_written);
+
+    if (bytes_written < size)
+        bytes_written += DoWriteMemoryWithPtrace(pid, vm_addr + bytes_written, src + bytes_written, size - bytes_written, error);
+    return bytes_written;
+}
+
 // Simple helper function to ensure flags are enabled on the given file
 // descriptor.
 static bool
@@ -430,9 +566,7 @@ private:
 void
 ReadOperation::Execute(ProcessMonitor *monitor)
 {
-    lldb::pid_t pid = monitor->GetPID();
-
-    m_result = DoReadMemory(pid, m_addr, m_buff, m_size, m_error);
+    m_result = DoReadMemory(monitor, m_addr, m_buff, m_size, m_error);
 }
 
 //------------------------------------------------------------------------------
@@ -460,9 +594,7 @@ private:
 void
 WriteOperation::Execute(ProcessMonitor *monitor)
 {
-    lldb::pid_t pid = monitor->GetPID();
-
-    m_result = DoWriteMemory(pid, m_addr, m_buff, m_size, m_error);
+    m_result = DoWriteMemory(monitor, m_addr, m_buff, m_size, m_error);
 }
 
 
@@ -1013,7 +1145,8 @@ ProcessMonitor::ProcessMonitor(ProcessPOSIX *process,
       m_monitor_thread(LLDB_INVALID_HOST_THREAD),
       m_pid(LLDB_INVALID_PROCESS_ID),
       m_terminal_fd(-1),
-      m_operation(0)
+      m_operation(0),
+      m_process_vm_supported(true)
 {
     std::unique_ptr<LaunchArgs> args(new LaunchArgs(this, module, argv, envp,
                                      stdin_path, stdout_path, stderr_path,
@@ -1066,7 +1199,8 @@ ProcessMonitor::ProcessMonitor(ProcessPOSIX *process,
       m_monitor_thread(LLDB_INVALID_HOST_THREAD),
       m_pid(LLDB_INVALID_PROCESS_ID),
       m_terminal_fd(-1),
-      m_operation(0)
+      m_operation(0),
+      m_process_vm_supported(true)
 {
     sem_init(&m_operation_pending, 0, 0);
     sem_init(&m_operation_done, 0, 0);
@@ -89,6 +89,15 @@ public:
     int
     GetTerminalFD() const { return m_terminal_fd; }
 
+    /// Returns false once process_vm_readv or process_vm_writev have failed
+    /// because the kernel doesn't have them.  Memory is only transferred on
+    /// the operation thread, so this needs no locking.
+    bool
+    GetProcessVMSupported() const { return m_process_vm_supported; }
+
+    void
+    SetProcessVMSupported(bool supported) { m_process_vm_supported = supported; }
+
     /// Reads @p size bytes from address @vm_adder in the inferior process
     /// address space.
     ///
@@ -208,6 +217,9 @@ private:
     sem_t m_operation_pending;
     sem_t m_operation_done;
 
+    // Whether the kernel supports process_vm_readv and process_vm_writev.
+    bool m_process_vm_supported;
+
 
     struct OperationArgs
     {
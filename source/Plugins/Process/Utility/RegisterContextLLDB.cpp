@@ -53,6 +53,7 @@ RegisterContextLLDB::RegisterContextLLDB
     m_fallback_unwind_plan_sp (),
     m_all_registers_available(false),
     m_frame_type (-1),
+    m_unwind_method (eUnwindMethodUnwindPlan),
     m_cfa (LLDB_INVALID_ADDRESS),
     m_start_pc (),
     m_current_pc (),
@@ -508,6 +509,19 @@ RegisterContextLLDB::InitializeNonZerothFrame()
         }
     }
 
+    // When sampling stacks, follow the frame pointer chain and only build the
+    // UnwindPlans for this function if the chain doesn't check out.
+    if (m_thread.GetFramePointerUnwind())
+    {
+        if (TryFramePointerUnwind (process, abi))
+        {
+            UnwindLogMsg ("initialized frame current pc is 0x%" PRIx64 " cfa is 0x%" PRIx64 " using the frame pointer",
+                    (uint64_t) m_current_pc.GetLoadAddress (exe_ctx.GetTargetPtr()), (uint64_t) m_cfa);
+            return;
+        }
+        m_unwind_method = eUnwindMethodFramePointerMismatch;
+    }
+
     // We've set m_frame_type and m_sym_ctx before this call.
     m_fast_unwind_plan_sp = GetFastUnwindPlanForFrame ();
 
@@ -613,6 +627,82 @@ RegisterContextLLDB::IsFrameZero () const
     return m_frame_number == 0;
 }
 
+// Use the architecture default UnwindPlan, which finds the caller by following
+// the frame pointer, for this frame if the frame pointer chain looks sane: the
+// CFA it gives must be above the CFA of the frame below this one, and the
+// return address saved there must point into a loaded section. Otherwise
+// leave this frame alone so it gets its full UnwindPlan.
+
+bool
+RegisterContextLLDB::TryFramePointerUnwind (Process *process, ABI *abi)
+{
+    // A frame that was interrupted by a trap handler or the debugger can be
+    // stopped anywhere in its prologue or epilogue, where its frame pointer
+    // isn't set up.
+    if (abi == NULL
+        || m_frame_type != eNormalFrame
+        || GetNextFrame()->m_frame_type != eNormalFrame)
+        return false;
+
+    UnwindPlanSP arch_default_sp (new UnwindPlan (lldb::eRegisterKindGeneric));
+    if (!abi->CreateDefaultUnwindPlan (*arch_default_sp))
+        return false;
+    UnwindPlan::RowSP row = arch_default_sp->GetRowForFunctionOffset (0);
+    if (!row.get())
+        return false;
+    const int row_register_kind = arch_default_sp->GetRegisterKind ();
+
+    addr_t cfa_regval = LLDB_INVALID_ADDRESS;
+    if (!ReadGPRValue (row_register_kind, row->GetCFARegister(), cfa_regval) || cfa_regval == LLDB_INVALID_ADDRESS)
+        return false;
+    const addr_t cfa = cfa_regval + row->GetCFAOffset();
+
+    addr_t next_frame_cfa;
+    if (!GetNextFrame()->GetCFA (next_frame_cfa) || cfa <= next_frame_cfa || !abi->CallFrameAddressIsValid (cfa))
+    {
+        UnwindLogMsg ("frame pointer cfa 0x%" PRIx64 " is not above the next frame's cfa, using the full UnwindPlan", (uint64_t) cfa);
+        return false;
+    }
+
+    uint32_t pc_regnum = LLDB_INVALID_REGNUM;
+    UnwindPlan::Row::RegisterLocation pc_regloc;
+    if (!m_thread.GetRegisterContext()->ConvertBetweenRegisterKinds (eRegisterKindGeneric, LLDB_REGNUM_GENERIC_PC, row_register_kind, pc_regnum)
+        || !row->GetRegisterInfo (pc_regnum, pc_regloc)
+        || !pc_regloc.IsAtCFAPlusOffset())
+        return false;
+
+    Error error;
+    addr_t caller_pc = process->ReadPointerFromMemory (cfa + pc_regloc.GetOffset(), error);
+    if (error.Fail())
+        return false;
+    caller_pc = abi->FixCodeAddress (caller_pc);
+    Address caller_pc_addr;
+    if (!abi->CodeAddressIsValid (caller_pc)
+        || !process->GetTarget().GetSectionLoadList().ResolveLoadAddress (caller_pc, caller_pc_addr))
+    {
+        UnwindLogMsg ("frame pointer return address 0x%" PRIx64 " is not in a loaded section, using the full UnwindPlan", (uint64_t) caller_pc);
+        return false;
+    }
+
+    m_fast_unwind_plan_sp.reset ();
+    m_full_unwind_plan_sp = arch_default_sp;
+    m_cfa = cfa;
+    m_unwind_method = eUnwindMethodFramePointer;
+    return true;
+}
+
+const char *
+RegisterContextLLDB::GetUnwindMethodName () const
+{
+    switch (m_unwind_method)
+    {
+        case eUnwindMethodUnwindPlan:           return "unwind plan";
+        case eUnwindMethodFramePointer:         return "frame pointer";
+        case eUnwindMethodFramePointerMismatch: return "unwind plan, frame pointer mismatch";
+    }
+    return NULL;
+}
+
 
 // Find a fast unwind plan for this frame, if possible.
 //
@@ -84,6 +84,11 @@ public:
     bool
     ReadPC (lldb::addr_t& start_pc);
 
+    // How this frame's CFA and the caller's registers were found, for
+    // reporting in backtraces.
+    const char *
+    GetUnwindMethodName () const;
+
 private:
 
     enum FrameType
@@ -95,6 +100,13 @@ private:
         eNotAValidFrame  // this frame is invalid for some reason - most likely it is past the top (end) of the stack
     };
 
+    enum UnwindMethod
+    {
+        eUnwindMethodUnwindPlan,            // the fast or full UnwindPlan for the function
+        eUnwindMethodFramePointer,          // the frame pointer chain, via the architecture default UnwindPlan
+        eUnwindMethodFramePointerMismatch   // the full UnwindPlan, because the frame pointer chain looked invalid
+    };
+
     // UnwindLLDB needs to pass around references to RegisterLocations
     friend class UnwindLLDB;
 
@@ -186,6 +198,9 @@ private:
     lldb::UnwindPlanSP
     GetFullUnwindPlanForFrame ();
 
+    bool
+    TryFramePointerUnwind (lldb_private::Process *process, lldb_private::ABI *abi);
+
     void
     UnwindLogMsg (const char *fmt, ...) __attribute__ ((format (printf, 2, 3)));
 
@@ -209,6 +224,7 @@ private:
 
     bool m_all_registers_available;               // Can we retrieve all regs or just nonvolatile regs?
     int m_frame_type;                             // enum FrameType
+    UnwindMethod m_unwind_method;
 
     lldb::addr_t m_cfa;
     lldb_private::Address m_start_pc;
@@ -299,6 +299,14 @@ UnwindLLDB::DoGetFrameInfoAtIndex (uint32_t idx, addr_t& cfa, addr_t& pc)
     return false;
 }
 
+const char *
+UnwindLLDB::DoGetUnwindMethodAtIndex (uint32_t idx)
+{
+    if (idx < m_frames.size() && m_frames[idx]->reg_ctx_lldb_sp)
+        return m_frames[idx]->reg_ctx_lldb_sp->GetUnwindMethodName();
+    return NULL;
+}
+
 lldb::RegisterContextSP
 UnwindLLDB::DoCreateRegisterContextForFrame (StackFrame *frame)
 {
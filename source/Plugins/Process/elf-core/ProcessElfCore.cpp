@@ -10,6 +10,9 @@
 // C Includes
 #include <stdlib.h>
 
+// C++ Includes
+#include <algorithm>
+
 // Other libraries and framework includes
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/Module.h"
@@ -111,7 +114,11 @@ ProcessElfCore::ProcessElfCore(Target& target, Listener &listener,
     m_signals_sp (),
     m_thread_data_valid(false),
     m_thread_data(),
-    m_core_aranges ()
+    m_core_aranges (),
+    m_core_windows_mutex (),
+    m_core_windows (),
+    m_core_window_clock (0),
+    m_core_file_size (0)
 {
 }
 
@@ -197,6 +204,7 @@ ProcessElfCore::DoLoadCore ()
     SetCanJIT(false);
 
     m_thread_data_valid = true;
+    m_core_file_size = m_core_file.GetByteSize();
 
     bool ranges_are_sorted = true;
     lldb::addr_t vm_addr = 0;
@@ -309,52 +317,137 @@ ProcessElfCore::DoReadMemory (lldb::addr_t addr, void *buf, size_t size, Error &
     if (core_objfile == NULL)
         return 0;
 
-    // Get the address range
-    const VMRangeToFileOffset::Entry *address_range = m_core_aranges.FindEntryThatContains (addr);
-    if (address_range == NULL || address_range->GetRangeEnd() < addr)
+    uint8_t *dst = (uint8_t *)buf;
+    size_t bytes_read = 0;
+    while (bytes_read < size)
     {
+        // Get the address range, reads can span adjacent segments
+        const lldb::addr_t curr_addr = addr + bytes_read;
+        const VMRangeToFileOffset::Entry *address_range = m_core_aranges.FindEntryThatContains (curr_addr);
+        if (address_range == NULL)
+            break;
+
+        // Convert the address into core file offset
+        const lldb::addr_t offset = curr_addr - address_range->GetRangeBase();
+        const lldb::addr_t file_start = address_range->data.GetRangeBase();
+        const size_t bytes_to_read = std::min<lldb::addr_t> (size - bytes_read, address_range->GetRangeEnd() - curr_addr);
+
+        // Figure out how many of those bytes are stored in the core file. The
+        // rest of the segment isn't in the file and reads as zeros.
+        size_t bytes_in_file = 0;
+        if (address_range->data.GetByteSize() > offset)
+            bytes_in_file = std::min<lldb::addr_t> (bytes_to_read, address_range->data.GetByteSize() - offset);
+
+        const size_t bytes_copied = ReadCoreFileData (file_start + offset, dst + bytes_read, bytes_in_file);
+        if (bytes_copied < bytes_in_file)
+        {
+            // The core file was truncated, the rest of the data is gone
+            bytes_read += bytes_copied;
+            break;
+        }
+
+        // Pad remaining bytes
+        if (bytes_to_read > bytes_copied)
+            memset (dst + bytes_read + bytes_copied, 0, bytes_to_read - bytes_copied);
+        bytes_read += bytes_to_read;
+    }
+
+    if (bytes_read == 0)
         error.SetErrorStringWithFormat ("core file does not contain 0x%" PRIx64, addr);
-        return 0;
+    return bytes_read;
+}
+
+//------------------------------------------------------------------
+// Core files can be many gigabytes in size, so ObjectFileELF only maps
+// in their headers and notes. Memory reads map fixed size windows of
+// the core file on demand and copy straight out of them. Only the pages
+// that get read are ever brought in, and a window that hasn't been used
+// for a while is unmapped once too many are mapped.
+//------------------------------------------------------------------
+static const lldb::offset_t k_core_window_size = 64 * 1024 * 1024;
+static const size_t k_max_core_windows = sizeof(void *) > 4 ? 64 : 4;
+
+lldb::DataBufferSP
+ProcessElfCore::GetCoreFileWindow (lldb::offset_t file_offset, lldb::offset_t &window_offset)
+{
+    Mutex::Locker locker (m_core_windows_mutex);
+    if (file_offset >= m_core_file_size)
+        return lldb::DataBufferSP();
+
+    const lldb::offset_t window_start = file_offset - (file_offset % k_core_window_size);
+    window_offset = file_offset - window_start;
+
+    ++m_core_window_clock;
+    CoreFileWindowMap::iterator pos = m_core_windows.find (window_start);
+    if (pos != m_core_windows.end())
+    {
+        pos->second.last_use = m_core_window_clock;
+        return pos->second.data_sp;
     }
 
-    // Convert the address into core file offset
-    const lldb::addr_t offset = addr - address_range->GetRangeBase();
-    const lldb::addr_t file_start = address_range->data.GetRangeBase();
-    const lldb::addr_t file_end = address_range->data.GetRangeEnd();
-    size_t bytes_to_read = size; // Number of bytes to read from the core file
-    size_t bytes_copied = 0;     // Number of bytes actually read from the core file
-    size_t zero_fill_size = 0;   // Padding
-    lldb::addr_t bytes_left = 0; // Number of bytes available in the core file from the given address
-
-    // Figure out how many on-disk bytes remain in this segment
-    // starting at the given offset
-    if (file_end > file_start + offset)
-        bytes_left = file_end - (file_start + offset);
-
-    // Figure out how many bytes we need to zero-fill if we are
-    // reading more bytes than available in the on-disk segment
-    if (bytes_to_read > bytes_left)
+    if (m_core_windows.size() >= k_max_core_windows)
     {
-        zero_fill_size = bytes_to_read - bytes_left;
-        bytes_to_read = bytes_left;
+        // Readers hold on to the window they are copying from, so the
+        // mapping only goes away once they are done with it
+        CoreFileWindowMap::iterator lru_pos = m_core_windows.begin();
+        for (pos = m_core_windows.begin(); pos != m_core_windows.end(); ++pos)
+        {
+            if (pos->second.last_use < lru_pos->second.last_use)
+                lru_pos = pos;
+        }
+        m_core_windows.erase (lru_pos);
     }
 
-    // If there is data available on the core file read it
-    if (bytes_to_read)
-        bytes_copied = core_objfile->CopyData(offset + file_start, bytes_to_read, buf);
+    const size_t window_size = std::min<lldb::offset_t> (k_core_window_size, m_core_file_size - window_start);
+    CoreFileWindow window;
+    window.data_sp = m_core_file.MemoryMapFileContents (window_start, window_size);
+    window.last_use = m_core_window_clock;
+    if (window.data_sp)
+    {
+        Log *log (GetLogIfAllCategoriesSet (LIBLLDB_LOG_MMAP));
+        if (log)
+            log->Printf ("ProcessElfCore::%s mapped 0x%" PRIx64 " bytes of the core file at offset 0x%" PRIx64,
+                         __FUNCTION__, (uint64_t)window_size, window_start);
+        m_core_windows[window_start] = window;
+    }
+    return window.data_sp;
+}
 
-    assert(zero_fill_size <= size);
-    // Pad remaining bytes
-    if (zero_fill_size)
-        memset(((char *)buf) + bytes_copied, 0, zero_fill_size);
+size_t
+ProcessElfCore::ReadCoreFileData (lldb::offset_t file_offset, void *dst, size_t dst_len)
+{
+    uint8_t *dst_bytes = (uint8_t *)dst;
+    size_t bytes_copied = 0;
+    while (bytes_copied < dst_len)
+    {
+        lldb::offset_t window_offset = 0;
+        lldb::DataBufferSP window_sp (GetCoreFileWindow (file_offset + bytes_copied, window_offset));
+        if (!window_sp)
+        {
+            // We couldn't map the data in, fall back to reading it from the
+            // core file.
+            Error error;
+            bytes_copied += m_core_file.ReadFileContents (file_offset + bytes_copied, dst_bytes + bytes_copied, dst_len - bytes_copied, &error);
+            break;
+        }
 
-    return bytes_copied + zero_fill_size;
+        if (window_offset >= window_sp->GetByteSize())
+            break;
+        const size_t bytes_to_copy = std::min<size_t> (window_sp->GetByteSize() - window_offset, dst_len - bytes_copied);
+        memcpy (dst_bytes + bytes_copied, window_sp->GetBytes() + window_offset, bytes_to_copy);
+        bytes_copied += bytes_to_copy;
+    }
+    return bytes_copied;
 }
 
 void
 ProcessElfCore::Clear()
 {
     m_thread_list.Clear();
+    {
+        Mutex::Locker locker (m_core_windows_mutex);
+        m_core_windows.clear();
+    }
     m_os = llvm::Triple::UnknownOS;
     m_signals_sp.reset();
 }
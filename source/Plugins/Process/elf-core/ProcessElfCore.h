@@ -19,11 +19,13 @@
 
 // C++ Includes
 #include <list>
+#include <map>
 #include <vector>
 
 // Other libraries and framework includes
 #include "lldb/Core/ConstString.h"
 #include "lldb/Core/Error.h"
+#include "lldb/Host/Mutex.h"
 #include "lldb/Target/Process.h"
 
 #include "Plugins/ObjectFile/ELF/ELFHeader.h"
@@ -149,6 +151,14 @@ private:
     typedef lldb_private::Range<lldb::addr_t, lldb::addr_t> FileRange;
     typedef lldb_private::RangeDataArray<lldb::addr_t, lldb::addr_t, FileRange, 1> VMRangeToFileOffset;
 
+    // A memory mapped window of the core file
+    struct CoreFileWindow
+    {
+        lldb::DataBufferSP data_sp;
+        uint64_t last_use;
+    };
+    typedef std::map<lldb::offset_t, CoreFileWindow> CoreFileWindowMap;
+
     lldb::ModuleSP m_core_module_sp;
     lldb_private::FileSpec m_core_file;
     std::string  m_dyld_plugin_name;
@@ -169,6 +179,14 @@ private:
     // Address ranges found in the core
     VMRangeToFileOffset m_core_aranges;
 
+    // Windows of the core file that are mapped in, keyed by file offset.
+    // Only the windows memory is read from get mapped, and the least
+    // recently used ones are unmapped when there are too many.
+    lldb_private::Mutex m_core_windows_mutex;
+    CoreFileWindowMap m_core_windows;
+    uint64_t m_core_window_clock;
+    lldb::offset_t m_core_file_size;
+
     // Parse thread(s) data structures(prstatus, prpsinfo) from given NOTE segment
     void
     ParseThreadContextsFromNoteSegment (const elf::ELFProgramHeader *segment_header,
@@ -181,6 +199,15 @@ private:
     // Parse a contiguous address range of the process from LOAD segment
     lldb::addr_t
     AddAddressRangeFromLoadSegment(const elf::ELFProgramHeader *header);
+
+    // Get the mapped window of the core file that contains FILE_OFFSET
+    // and the offset of FILE_OFFSET within it
+    lldb::DataBufferSP
+    GetCoreFileWindow (lldb::offset_t file_offset, lldb::offset_t &window_offset);
+
+    // Copy DST_LEN bytes at FILE_OFFSET in the core file to DST
+    size_t
+    ReadCoreFileData (lldb::offset_t file_offset, void *dst, size_t dst_len);
 };
 
 #endif  // liblldb_ProcessElffCore_h_
@@ -0,0 +1,720 @@
+//===-- GDBRemoteAgentExpression.cpp ----------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "GDBRemoteAgentExpression.h"
+
+// C Includes
+#include <ctype.h>
+#include <stdlib.h>
+
+// C++ Includes
+#include <string>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Core/ConstString.h"
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/Scalar.h"
+#include "lldb/Core/dwarf.h"
+#include "lldb/Expression/DWARFExpression.h"
+#include "lldb/Symbol/Block.h"
+#include "lldb/Symbol/ClangASTType.h"
+#include "lldb/Symbol/CompileUnit.h"
+#include "lldb/Symbol/FuncUnwinders.h"
+#include "lldb/Symbol/Function.h"
+#include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Symbol/Type.h"
+#include "lldb/Symbol/UnwindPlan.h"
+#include "lldb/Symbol/UnwindTable.h"
+#include "lldb/Symbol/Variable.h"
+#include "lldb/Symbol/VariableList.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/Thread.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+// Agent expression opcodes, see "Bytecode Descriptions" in the GDB manual
+enum
+{
+    eAgentOpAdd             = 0x02,
+    eAgentOpSub             = 0x03,
+    eAgentOpLogNot          = 0x0e,
+    eAgentOpEqual           = 0x13,
+    eAgentOpLessSigned      = 0x14,
+    eAgentOpLessUnsigned    = 0x15,
+    eAgentOpExt             = 0x16,
+    eAgentOpRef8            = 0x17,
+    eAgentOpRef16           = 0x18,
+    eAgentOpRef32           = 0x19,
+    eAgentOpRef64           = 0x1a,
+    eAgentOpIfGoto          = 0x20,
+    eAgentOpConst8          = 0x22,
+    eAgentOpConst16         = 0x23,
+    eAgentOpConst32         = 0x24,
+    eAgentOpConst64         = 0x25,
+    eAgentOpReg             = 0x26,
+    eAgentOpEnd             = 0x27,
+    eAgentOpDup             = 0x28,
+    eAgentOpPop             = 0x29,
+    eAgentOpZeroExt         = 0x2a,
+    eAgentOpSwap            = 0x2b
+};
+
+bool
+GDBRemoteAgentExpression::Compile (const ConditionProgram &program,
+                                   Thread &thread,
+                                   const Address &address,
+                                   std::vector<uint8_t> &bytecode)
+{
+    bytecode.clear();
+    if (!program.IsValid())
+        return false;
+
+    GDBRemoteAgentExpression agent_expression (thread, address, bytecode);
+    if (!agent_expression.CompileProgram (program))
+    {
+        bytecode.clear();
+        return false;
+    }
+    return true;
+}
+
+GDBRemoteAgentExpression::GDBRemoteAgentExpression (Thread &thread,
+                                                    const Address &address,
+                                                    std::vector<uint8_t> &bytecode) :
+    m_thread (thread),
+    m_address (address),
+    m_sc (),
+    m_bytecode (bytecode)
+{
+    m_address.CalculateSymbolContext (&m_sc,
+                                      eSymbolContextModule |
+                                      eSymbolContextCompUnit |
+                                      eSymbolContextFunction |
+                                      eSymbolContextBlock);
+}
+
+// Integers narrower than int are promoted to int before they are compared
+static void
+PromoteValueType (uint32_t &bit_size, bool &is_signed)
+{
+    if (bit_size < 32)
+    {
+        bit_size = 32;
+        is_signed = true;
+    }
+}
+
+bool
+GDBRemoteAgentExpression::CompileProgram (const ConditionProgram &program)
+{
+    const std::vector<ConditionProgram::Instruction> &instructions = program.GetInstructions();
+    const uint32_t num_instructions = instructions.size();
+
+    // Jumps go to instruction indexes in the program and to absolute
+    // bytecode offsets in agent expressions, so remember where each
+    // instruction starts and patch the jumps at the end.
+    std::vector<uint32_t> instruction_offsets;
+    std::vector<std::pair<uint32_t, uint32_t> > jump_patches;
+    std::vector<ValueType> stack;
+    ValueType int_type = { 32, true };
+
+    for (uint32_t idx = 0; idx < num_instructions; ++idx)
+    {
+        instruction_offsets.push_back (m_bytecode.size());
+        const ConditionProgram::Instruction &instruction = instructions[idx];
+        switch (instruction.opcode)
+        {
+        case ConditionProgram::eOpPushConstant:
+            {
+                const Scalar &constant = program.GetConstantAtIndex (instruction.operand);
+                ValueType value_type;
+                value_type.bit_size = constant.GetByteSize() * 8;
+                switch (constant.GetType())
+                {
+                case Scalar::e_sint:
+                case Scalar::e_slong:
+                case Scalar::e_slonglong:
+                    value_type.is_signed = true;
+                    AppendConstant ((uint64_t)constant.SLongLong());
+                    break;
+                case Scalar::e_uint:
+                case Scalar::e_ulong:
+                case Scalar::e_ulonglong:
+                    value_type.is_signed = false;
+                    AppendConstant (constant.ULongLong());
+                    break;
+                default:
+                    return false;
+                }
+                PromoteValueType (value_type.bit_size, value_type.is_signed);
+                stack.push_back (value_type);
+            }
+            break;
+
+        case ConditionProgram::eOpPushVariable:
+            {
+                ValueType value_type;
+                if (!CompileVariablePath (program.GetVariablePathAtIndex (instruction.operand), value_type))
+                    return false;
+                PromoteValueType (value_type.bit_size, value_type.is_signed);
+                stack.push_back (value_type);
+            }
+            break;
+
+        case ConditionProgram::eOpToBool:
+        case ConditionProgram::eOpNot:
+            if (stack.empty())
+                return false;
+            AppendOpcode (eAgentOpLogNot);
+            if (instruction.opcode == ConditionProgram::eOpToBool)
+                AppendOpcode (eAgentOpLogNot);
+            stack.back() = int_type;
+            break;
+
+        case ConditionProgram::eOpEqual:
+        case ConditionProgram::eOpNotEqual:
+        case ConditionProgram::eOpLess:
+        case ConditionProgram::eOpLessEqual:
+        case ConditionProgram::eOpGreater:
+        case ConditionProgram::eOpGreaterEqual:
+            if (stack.size() < 2)
+                return false;
+            {
+                const ValueType rhs = stack.back();
+                stack.pop_back();
+                if (!CompileComparison (instruction.opcode, stack.back(), rhs))
+                    return false;
+                stack.back() = int_type;
+            }
+            break;
+
+        case ConditionProgram::eOpJumpIfFalse:
+        case ConditionProgram::eOpJumpIfTrue:
+            if (stack.empty() || instruction.operand > num_instructions)
+                return false;
+            // "if_goto" always pops the value it tests, but the program
+            // keeps it when it jumps, so test a copy and pop the original
+            // when falling through.
+            AppendOpcode (eAgentOpDup);
+            if (instruction.opcode == ConditionProgram::eOpJumpIfFalse)
+                AppendOpcode (eAgentOpLogNot);
+            AppendOpcode (eAgentOpIfGoto);
+            jump_patches.push_back (std::make_pair ((uint32_t)m_bytecode.size(), instruction.operand));
+            AppendOpcode (0);
+            AppendOpcode (0);
+            AppendOpcode (eAgentOpPop);
+            stack.pop_back();
+            break;
+        }
+    }
+
+    if (stack.size() != 1)
+        return false;
+    instruction_offsets.push_back (m_bytecode.size());
+    AppendOpcode (eAgentOpEnd);
+
+    // Jump targets are 16 bit offsets
+    if (m_bytecode.size() > UINT16_MAX)
+        return false;
+    for (size_t i = 0; i < jump_patches.size(); ++i)
+    {
+        const uint32_t target_offset = instruction_offsets[jump_patches[i].second];
+        m_bytecode[jump_patches[i].first] = (uint8_t)(target_offset >> 8);
+        m_bytecode[jump_patches[i].first + 1] = (uint8_t)target_offset;
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------
+// Compare the two values on top of the stack with the usual arithmetic
+// conversions of C. Values are kept sign or zero extended to 64 bits,
+// so the only conversion that changes bits is turning a negative signed
+// value into a narrower unsigned type.
+//----------------------------------------------------------------------
+bool
+GDBRemoteAgentExpression::CompileComparison (ConditionProgram::OpCode opcode,
+                                             const ValueType &lhs,
+                                             const ValueType &rhs)
+{
+    ValueType common_type;
+    if (lhs.is_signed == rhs.is_signed)
+    {
+        common_type.is_signed = lhs.is_signed;
+        common_type.bit_size = std::max (lhs.bit_size, rhs.bit_size);
+    }
+    else
+    {
+        const ValueType &unsigned_type = lhs.is_signed ? rhs : lhs;
+        const ValueType &signed_type = lhs.is_signed ? lhs : rhs;
+        common_type = (unsigned_type.bit_size >= signed_type.bit_size) ? unsigned_type : signed_type;
+    }
+
+    if (!common_type.is_signed && common_type.bit_size < 64)
+    {
+        if (rhs.is_signed)
+            AppendOpcode (eAgentOpZeroExt, common_type.bit_size);
+        if (lhs.is_signed)
+        {
+            AppendOpcode (eAgentOpSwap);
+            AppendOpcode (eAgentOpZeroExt, common_type.bit_size);
+            AppendOpcode (eAgentOpSwap);
+        }
+    }
+
+    const uint8_t less_opcode = common_type.is_signed ? eAgentOpLessSigned : eAgentOpLessUnsigned;
+    switch (opcode)
+    {
+    case ConditionProgram::eOpEqual:
+        AppendOpcode (eAgentOpEqual);
+        break;
+    case ConditionProgram::eOpNotEqual:
+        AppendOpcode (eAgentOpEqual);
+        AppendOpcode (eAgentOpLogNot);
+        break;
+    case ConditionProgram::eOpLess:
+        AppendOpcode (less_opcode);
+        break;
+    case ConditionProgram::eOpGreaterEqual:
+        AppendOpcode (less_opcode);
+        AppendOpcode (eAgentOpLogNot);
+        break;
+    case ConditionProgram::eOpGreater:
+        AppendOpcode (eAgentOpSwap);
+        AppendOpcode (less_opcode);
+        break;
+    case ConditionProgram::eOpLessEqual:
+        AppendOpcode (eAgentOpSwap);
+        AppendOpcode (less_opcode);
+        AppendOpcode (eAgentOpLogNot);
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+static const char *
+SkipIdentifier (const char *pos)
+{
+    if (!isalpha(*pos) && *pos != '_')
+        return pos;
+    while (isalnum(*pos) || *pos == '_')
+        ++pos;
+    return pos;
+}
+
+//----------------------------------------------------------------------
+// Push the value of a ConditionProgram variable path. While walking the
+// path the top of the stack is the address of the current value, or
+// the value itself if the variable lives in a register.
+//----------------------------------------------------------------------
+bool
+GDBRemoteAgentExpression::CompileVariablePath (const char *path, ValueType &value_type)
+{
+    const char *pos = SkipIdentifier (path);
+    if (pos == path)
+        return false;
+
+    VariableSP var_sp (FindVariable (ConstString (path, pos - path)));
+    if (!var_sp || var_sp->GetType() == NULL)
+        return false;
+    ClangASTType clang_type (var_sp->GetType()->GetClangFullType());
+
+    bool is_register_value = false;
+    if (!CompileLocation (var_sp->LocationExpression(), false, is_register_value))
+        return false;
+
+    const uint32_t pointer_size = m_thread.GetProcess()->GetAddressByteSize();
+    bool is_address = !is_register_value;
+    while (clang_type.IsValid())
+    {
+        // References are followed like C does it implicitly
+        if (clang_type.IsReferenceType())
+        {
+            if (is_address && !AppendLoad (pointer_size))
+                return false;
+            is_address = true;
+            clang_type = clang_type.GetNonReferenceType();
+        }
+
+        if (*pos == '\0')
+            break;
+
+        if (pos[0] == '.' || (pos[0] == '-' && pos[1] == '>'))
+        {
+            if (pos[0] == '-')
+            {
+                ClangASTType pointee_type;
+                if (!clang_type.IsPointerType (&pointee_type))
+                    return false;
+                if (is_address && !AppendLoad (pointer_size))
+                    return false;
+                clang_type = pointee_type;
+                ++pos;
+            }
+            else if (!is_address)
+                return false;
+            is_address = true;
+
+            const char *member_start = ++pos;
+            pos = SkipIdentifier (pos);
+            if (pos == member_start)
+                return false;
+            const std::string member_name (member_start, pos - member_start);
+            if (!CompileMember (member_name.c_str(), clang_type))
+                return false;
+        }
+        else if (pos[0] == '[')
+        {
+            char *index_end = NULL;
+            const uint64_t index = ::strtoull (pos + 1, &index_end, 10);
+            if (index_end == pos + 1 || *index_end != ']')
+                return false;
+            pos = index_end + 1;
+
+            ClangASTType element_type;
+            if (clang_type.IsArrayType (&element_type, NULL, NULL))
+            {
+                if (!is_address)
+                    return false;
+            }
+            else if (clang_type.IsPointerType (&element_type))
+            {
+                if (is_address && !AppendLoad (pointer_size))
+                    return false;
+                is_address = true;
+            }
+            else
+                return false;
+
+            const uint64_t element_size = element_type.GetByteSize();
+            if (element_size == 0)
+                return false;
+            AppendOffset ((int64_t)(index * element_size));
+            clang_type = element_type;
+        }
+        else
+            return false;
+    }
+
+    // Only values the agent can read with a single load and compare as
+    // integers
+    const uint32_t value_type_mask = ClangASTType::eTypeIsScalar |
+                                     ClangASTType::eTypeIsPointer |
+                                     ClangASTType::eTypeIsEnumeration;
+    if (!clang_type.IsValid() || (clang_type.GetTypeInfo() & value_type_mask) == 0)
+        return false;
+    uint64_t count = 0;
+    const Encoding encoding = clang_type.GetEncoding (count);
+    if (encoding != eEncodingSint && encoding != eEncodingUint)
+        return false;
+    const uint64_t byte_size = clang_type.GetByteSize();
+    if (is_address)
+    {
+        if (!AppendLoad (byte_size))
+            return false;
+    }
+    else if (byte_size < 8)
+    {
+        // The rest of the register isn't part of the value
+        if (byte_size != 1 && byte_size != 2 && byte_size != 4)
+            return false;
+        AppendOpcode (eAgentOpZeroExt, byte_size * 8);
+    }
+    else if (byte_size != 8)
+        return false;
+
+    value_type.bit_size = byte_size * 8;
+    value_type.is_signed = (encoding == eEncodingSint);
+    if (value_type.is_signed && value_type.bit_size < 64)
+        AppendOpcode (eAgentOpExt, value_type.bit_size);
+    return true;
+}
+
+//----------------------------------------------------------------------
+// Add the offset of the data member \a member_name to the address on
+// top of the stack and update \a clang_type to the member's type.
+//----------------------------------------------------------------------
+bool
+GDBRemoteAgentExpression::CompileMember (const char *member_name, ClangASTType &clang_type)
+{
+    std::vector<uint32_t> child_indexes;
+    if (clang_type.GetIndexOfChildMemberWithName (member_name, true, child_indexes) == 0)
+        return false;
+
+    int64_t member_offset = 0;
+    for (size_t i = 0; i < child_indexes.size(); ++i)
+    {
+        std::string child_name;
+        uint32_t child_byte_size = 0;
+        int32_t child_byte_offset = 0;
+        uint32_t child_bitfield_bit_size = 0;
+        uint32_t child_bitfield_bit_offset = 0;
+        bool child_is_base_class = false;
+        bool child_is_deref_of_parent = false;
+        ClangASTType child_type (clang_type.GetChildClangTypeAtIndex (NULL,
+                                                                      NULL,
+                                                                      child_indexes[i],
+                                                                      false,
+                                                                      true,
+                                                                      false,
+                                                                      child_name,
+                                                                      child_byte_size,
+                                                                      child_byte_offset,
+                                                                      child_bitfield_bit_size,
+                                                                      child_bitfield_bit_offset,
+                                                                      child_is_base_class,
+                                                                      child_is_deref_of_parent));
+        // Virtual base class offsets are only known at run time, and bit
+        // fields can't be read with a plain load
+        if (!child_type.IsValid() || child_is_base_class || child_is_deref_of_parent || child_bitfield_bit_size != 0)
+            return false;
+        member_offset += child_byte_offset;
+        clang_type = child_type;
+    }
+    AppendOffset (member_offset);
+    return true;
+}
+
+//----------------------------------------------------------------------
+// Push the address described by the DWARF location \a location, or the
+// value of the register it names in which case \a is_register_value is
+// set. Only locations made of a single operation that computes a static
+// address or a register, frame base or CFA relative one are supported.
+//----------------------------------------------------------------------
+bool
+GDBRemoteAgentExpression::CompileLocation (DWARFExpression &location,
+                                           bool is_frame_base,
+                                           bool &is_register_value)
+{
+    is_register_value = false;
+
+    DataExtractor opcodes;
+    if (!location.IsValid() || location.IsLocationList() || !location.GetExpressionData (opcodes))
+        return false;
+
+    const RegisterKind reg_kind = (RegisterKind)location.GetRegisterKind();
+    uint32_t remote_reg_num = LLDB_INVALID_REGNUM;
+    lldb::offset_t offset = 0;
+    const uint8_t op = opcodes.GetU8 (&offset);
+    if (op == DW_OP_addr)
+    {
+        const addr_t file_addr = opcodes.GetAddress (&offset);
+        Address so_addr;
+        if (!m_sc.module_sp || !m_sc.module_sp->ResolveFileAddress (file_addr, so_addr))
+            return false;
+        const addr_t load_addr = so_addr.GetLoadAddress (&m_thread.GetProcess()->GetTarget());
+        if (load_addr == LLDB_INVALID_ADDRESS)
+            return false;
+        AppendConstant (load_addr);
+    }
+    else if (op == DW_OP_fbreg)
+    {
+        const int64_t frame_base_offset = opcodes.GetSLEB128 (&offset);
+        if (is_frame_base || !CompileFrameBase())
+            return false;
+        AppendOffset (frame_base_offset);
+    }
+    else if ((op >= DW_OP_breg0 && op <= DW_OP_breg31) || op == DW_OP_bregx)
+    {
+        const uint32_t reg_num = (op == DW_OP_bregx) ? opcodes.GetULEB128 (&offset) : op - DW_OP_breg0;
+        const int64_t reg_offset = opcodes.GetSLEB128 (&offset);
+        if (!GetRemoteRegisterNumber (reg_kind, reg_num, remote_reg_num))
+            return false;
+        AppendRegister (remote_reg_num);
+        AppendOffset (reg_offset);
+    }
+    else if ((op >= DW_OP_reg0 && op <= DW_OP_reg31) || op == DW_OP_regx)
+    {
+        const uint32_t reg_num = (op == DW_OP_regx) ? opcodes.GetULEB128 (&offset) : op - DW_OP_reg0;
+        if (!GetRemoteRegisterNumber (reg_kind, reg_num, remote_reg_num))
+            return false;
+        AppendRegister (remote_reg_num);
+        is_register_value = true;
+    }
+    else if (op == DW_OP_call_frame_cfa)
+    {
+        if (!CompileCanonicalFrameAddress())
+            return false;
+    }
+    else
+        return false;
+
+    // Anything after the first operation (pieces, DW_OP_stack_value...)
+    // describes something else than an address
+    return offset == opcodes.GetByteSize();
+}
+
+bool
+GDBRemoteAgentExpression::CompileFrameBase ()
+{
+    if (m_sc.function == NULL)
+        return false;
+    // A register frame base means the register holds the frame base, so
+    // either way the top of the stack is the frame base address
+    bool is_register_value = false;
+    return CompileLocation (m_sc.function->GetFrameBaseExpression(), true, is_register_value);
+}
+
+//----------------------------------------------------------------------
+// Push the CFA at the breakpoint address using the eh_frame unwind
+// plan, which describes every instruction of the function.
+//----------------------------------------------------------------------
+bool
+GDBRemoteAgentExpression::CompileCanonicalFrameAddress ()
+{
+    ObjectFile *objfile = m_sc.module_sp ? m_sc.module_sp->GetObjectFile() : NULL;
+    if (objfile == NULL)
+        return false;
+
+    SymbolContext sc (m_sc);
+    FuncUnwindersSP func_unwinders_sp (objfile->GetUnwindTable().GetFuncUnwindersContainingAddress (m_address, sc));
+    if (!func_unwinders_sp)
+        return false;
+
+    const addr_t func_file_addr = func_unwinders_sp->GetFunctionStartAddress().GetFileAddress();
+    const addr_t file_addr = m_address.GetFileAddress();
+    if (func_file_addr == LLDB_INVALID_ADDRESS || file_addr < func_file_addr)
+        return false;
+    const int func_offset = file_addr - func_file_addr;
+
+    UnwindPlanSP unwind_plan_sp (func_unwinders_sp->GetUnwindPlanAtCallSite (func_offset));
+    if (!unwind_plan_sp || !unwind_plan_sp->PlanValidAtAddress (m_address))
+        return false;
+    UnwindPlan::RowSP row_sp (unwind_plan_sp->GetRowForFunctionOffset (func_offset));
+    if (!row_sp)
+        return false;
+
+    uint32_t remote_reg_num = LLDB_INVALID_REGNUM;
+    if (!GetRemoteRegisterNumber (unwind_plan_sp->GetRegisterKind(), row_sp->GetCFARegister(), remote_reg_num))
+        return false;
+    AppendRegister (remote_reg_num);
+    AppendOffset (row_sp->GetCFAOffset());
+    return true;
+}
+
+//----------------------------------------------------------------------
+// Look the variable up the way StackFrame::GetInScopeVariableList()
+// does, so the stub reads the same variable the client would.
+//----------------------------------------------------------------------
+VariableSP
+GDBRemoteAgentExpression::FindVariable (const ConstString &name)
+{
+    VariableList variable_list;
+    if (m_sc.block)
+        m_sc.block->AppendVariables (true, true, true, &variable_list);
+    if (m_sc.comp_unit)
+    {
+        VariableListSP global_variable_list_sp (m_sc.comp_unit->GetVariableList (true));
+        if (global_variable_list_sp)
+            variable_list.AddVariables (global_variable_list_sp.get());
+    }
+    return variable_list.FindVariable (name);
+}
+
+// The stub numbers registers like the 'p' packet does, which is the
+// LLDB register numbering of the GDB remote register context
+bool
+GDBRemoteAgentExpression::GetRemoteRegisterNumber (RegisterKind kind,
+                                                   uint32_t reg_num,
+                                                   uint32_t &remote_reg_num)
+{
+    RegisterContextSP reg_ctx_sp (m_thread.GetRegisterContext());
+    if (!reg_ctx_sp)
+        return false;
+    if (!reg_ctx_sp->ConvertBetweenRegisterKinds (kind, reg_num, eRegisterKindLLDB, remote_reg_num))
+        return false;
+    return remote_reg_num <= UINT16_MAX;
+}
+
+void
+GDBRemoteAgentExpression::AppendOpcode (uint8_t opcode)
+{
+    m_bytecode.push_back (opcode);
+}
+
+void
+GDBRemoteAgentExpression::AppendOpcode (uint8_t opcode, uint8_t operand)
+{
+    m_bytecode.push_back (opcode);
+    m_bytecode.push_back (operand);
+}
+
+// Push a 64 bit value with the shortest constant opcode, they all zero
+// extend their big endian operand
+void
+GDBRemoteAgentExpression::AppendConstant (uint64_t value)
+{
+    uint32_t num_bytes = 8;
+    if (value <= UINT8_MAX)
+    {
+        AppendOpcode (eAgentOpConst8);
+        num_bytes = 1;
+    }
+    else if (value <= UINT16_MAX)
+    {
+        AppendOpcode (eAgentOpConst16);
+        num_bytes = 2;
+    }
+    else if (value <= UINT32_MAX)
+    {
+        AppendOpcode (eAgentOpConst32);
+        num_bytes = 4;
+    }
+    else
+        AppendOpcode (eAgentOpConst64);
+
+    for (int shift = (num_bytes - 1) * 8; shift >= 0; shift -= 8)
+        m_bytecode.push_back ((uint8_t)(value >> shift));
+}
+
+void
+GDBRemoteAgentExpression::AppendOffset (int64_t offset)
+{
+    if (offset > 0)
+    {
+        AppendConstant (offset);
+        AppendOpcode (eAgentOpAdd);
+    }
+    else if (offset < 0)
+    {
+        AppendConstant (0 - (uint64_t)offset);
+        AppendOpcode (eAgentOpSub);
+    }
+}
+
+void
+GDBRemoteAgentExpression::AppendRegister (uint32_t remote_reg_num)
+{
+    AppendOpcode (eAgentOpReg);
+    m_bytecode.push_back ((uint8_t)(remote_reg_num >> 8));
+    m_bytecode.push_back ((uint8_t)remote_reg_num);
+}
+
+// Replace the address on top of the stack with the zero extended value
+// stored there
+bool
+GDBRemoteAgentExpression::AppendLoad (uint64_t byte_size)
+{
+    switch (byte_size)
+    {
+    case 1: AppendOpcode (eAgentOpRef8);  return true;
+    case 2: AppendOpcode (eAgentOpRef16); return true;
+    case 4: AppendOpcode (eAgentOpRef32); return true;
+    case 8: AppendOpcode (eAgentOpRef64); return true;
+    default:
+        break;
+    }
+    return false;
+}
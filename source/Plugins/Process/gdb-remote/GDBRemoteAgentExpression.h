@@ -0,0 +1,136 @@
+//===-- GDBRemoteAgentExpression.h ------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_GDBRemoteAgentExpression_h_
+#define liblldb_GDBRemoteAgentExpression_h_
+
+// C Includes
+// C++ Includes
+#include <vector>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private.h"
+#include "lldb/Core/Address.h"
+#include "lldb/Expression/ConditionProgram.h"
+#include "lldb/Symbol/SymbolContext.h"
+
+//----------------------------------------------------------------------
+/// @class GDBRemoteAgentExpression GDBRemoteAgentExpression.h
+/// @brief Translates simple breakpoint conditions into the agent
+///        expression bytecode GDB remote stubs evaluate.
+///
+/// Stubs that list "ConditionalBreakpoints+" in their qSupported reply
+/// accept ";X<len>,<hex bytes>" agent expressions after the kind field
+/// of Z0 and Z1 packets. They evaluate them when the breakpoint is hit
+/// and only report the hit if one of them is true, which saves the stop
+/// reply, thread update and continue round trips for every hit where
+/// the condition is false.
+///
+/// Only a ConditionProgram whose variables have a static address, or a
+/// register, frame base or CFA relative location at the breakpoint
+/// address, and whose values are integers, enumerations or pointers is
+/// translated. Compile() fails for anything else and the condition is
+/// left to the client.
+//----------------------------------------------------------------------
+class GDBRemoteAgentExpression
+{
+public:
+    //------------------------------------------------------------------
+    /// Compile \a program for a breakpoint at \a address.
+    ///
+    /// @param[in] thread
+    ///     Any thread of the process, used to map DWARF and unwind
+    ///     register numbers to the ones the stub uses.
+    ///
+    /// @param[out] bytecode
+    ///     The agent expression, ending with the "end" opcode.
+    ///
+    /// @return
+    ///     True if the whole program could be translated.
+    //------------------------------------------------------------------
+    static bool
+    Compile (const lldb_private::ConditionProgram &program,
+             lldb_private::Thread &thread,
+             const lldb_private::Address &address,
+             std::vector<uint8_t> &bytecode);
+
+private:
+    // The C type of a value on the agent expression stack, the stack
+    // itself always holds 64 bit values
+    struct ValueType
+    {
+        uint32_t bit_size;
+        bool is_signed;
+    };
+
+    GDBRemoteAgentExpression (lldb_private::Thread &thread,
+                              const lldb_private::Address &address,
+                              std::vector<uint8_t> &bytecode);
+
+    bool
+    CompileProgram (const lldb_private::ConditionProgram &program);
+
+    bool
+    CompileComparison (lldb_private::ConditionProgram::OpCode opcode,
+                       const ValueType &lhs,
+                       const ValueType &rhs);
+
+    bool
+    CompileVariablePath (const char *path, ValueType &value_type);
+
+    bool
+    CompileMember (const char *member_name, lldb_private::ClangASTType &clang_type);
+
+    bool
+    CompileLocation (lldb_private::DWARFExpression &location,
+                     bool is_frame_base,
+                     bool &is_register_value);
+
+    bool
+    CompileFrameBase ();
+
+    bool
+    CompileCanonicalFrameAddress ();
+
+    lldb::VariableSP
+    FindVariable (const lldb_private::ConstString &name);
+
+    bool
+    GetRemoteRegisterNumber (lldb::RegisterKind kind,
+                             uint32_t reg_num,
+                             uint32_t &remote_reg_num);
+
+    void
+    AppendOpcode (uint8_t opcode);
+
+    void
+    AppendOpcode (uint8_t opcode, uint8_t operand);
+
+    void
+    AppendConstant (uint64_t value);
+
+    void
+    AppendOffset (int64_t offset);
+
+    void
+    AppendRegister (uint32_t remote_reg_num);
+
+    bool
+    AppendLoad (uint64_t byte_size);
+
+    lldb_private::Thread &m_thread;
+    lldb_private::Address m_address;
+    lldb_private::SymbolContext m_sc;
+    std::vector<uint8_t> &m_bytecode;
+
+    DISALLOW_COPY_AND_ASSIGN (GDBRemoteAgentExpression);
+};
+
+#endif  // liblldb_GDBRemoteAgentExpression_h_
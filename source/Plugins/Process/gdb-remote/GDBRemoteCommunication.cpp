@@ -16,7 +16,12 @@
 #include <sys/stat.h>
 
 // C++ Includes
+#include <algorithm>
+#include <vector>
+
 // Other libraries and framework includes
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Compression.h"
 #include "lldb/Core/ConnectionFileDescriptor.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/StreamFile.h"
@@ -25,6 +30,7 @@
 #include "lldb/Host/Host.h"
 #include "lldb/Host/TimeValue.h"
 #include "lldb/Target/Process.h"
+#include "Utility/LZ4Block.h"
 
 // Project includes
 #include "ProcessGDBRemoteLog.h"
@@ -146,6 +152,10 @@ GDBRemoteCommunication::GDBRemoteCommunication(const char *comm_name,
     m_history (512),
     m_send_acks (true),
     m_is_platform (is_platform),
+    m_send_compression_type (CompressionType::None),
+    m_recv_compression_type (CompressionType::None),
+    m_compression_min_size (0),
+    m_compression_stats (),
     m_listen_thread (LLDB_INVALID_HOST_THREAD),
     m_listen_url ()
 {
@@ -173,6 +183,263 @@ GDBRemoteCommunication::CalculcateChecksum (const char *payload, size_t payload_
     return checksum & 255;
 }
 
+//----------------------------------------------------------------------
+// Replace the contents of DST with the packet bytes in [BEGIN, END) with
+// their run-length encoding and escapes expanded.
+//----------------------------------------------------------------------
+static void
+ExpandPacketBytes (const char *begin, const char *end, std::string &dst)
+{
+    // Clear dst in case there is some existing data in it.
+    dst.clear();
+    // Reserve enough byte for the most common case (no RLE used)
+    dst.reserve(end - begin);
+    for (const char *c = begin; c != end; ++c)
+    {
+        if (*c == '*')
+        {
+            // '*' indicates RLE. Next character will give us the
+            // repeat count and previous character is what is to be
+            // repeated.
+            if (dst.empty() || c + 1 == end)
+                break;
+            char char_to_repeat = dst.back();
+            // Number of time the previous character is repeated
+            int repeat_count = *++c + 3 - ' ';
+            // We have the char_to_repeat and repeat_count. Now push
+            // it in the packet.
+            for (int i = 0; i < repeat_count; ++i)
+                dst.push_back(char_to_repeat);
+        }
+        else if (*c == 0x7d)
+        {
+            // 0x7d is the escape character.  The next character is to
+            // be XOR'd with 0x20.
+            if (c + 1 == end)
+                break;
+            char escapee = *++c ^ 0x20;
+            dst.push_back(escapee);
+        }
+        else
+        {
+            dst.push_back(*c);
+        }
+    }
+}
+
+static const size_t k_max_decompressed_size = 64 * 1024 * 1024;
+
+static bool
+CompressBytes (GDBRemoteCommunication::CompressionType compression_type,
+               const char *src,
+               size_t src_len,
+               std::string &dst)
+{
+    dst.clear();
+    switch (compression_type)
+    {
+    case GDBRemoteCommunication::CompressionType::None:
+        break;
+
+    case GDBRemoteCommunication::CompressionType::LZ4:
+        LZ4Block::Compress ((const uint8_t *)src, src_len, dst);
+        return true;
+
+    case GDBRemoteCommunication::CompressionType::ZlibDeflate:
+        if (llvm::zlib::isAvailable())
+        {
+            llvm::SmallVector<char, 0> compressed;
+            if (llvm::zlib::compress (llvm::StringRef(src, src_len), compressed, llvm::zlib::BestSpeedCompression) == llvm::zlib::StatusOK)
+            {
+                dst.assign (compressed.data(), compressed.size());
+                return true;
+            }
+        }
+        break;
+    }
+    return false;
+}
+
+static bool
+DecompressBytes (GDBRemoteCommunication::CompressionType compression_type,
+                 const char *src,
+                 size_t src_len,
+                 size_t decompressed_size,
+                 std::string &dst)
+{
+    dst.clear();
+    if (decompressed_size > k_max_decompressed_size)
+        return false;
+    switch (compression_type)
+    {
+    case GDBRemoteCommunication::CompressionType::None:
+        break;
+
+    case GDBRemoteCommunication::CompressionType::LZ4:
+        return LZ4Block::Decompress ((const uint8_t *)src, src_len, decompressed_size, dst);
+
+    case GDBRemoteCommunication::CompressionType::ZlibDeflate:
+        if (llvm::zlib::isAvailable())
+        {
+            llvm::SmallVector<char, 0> decompressed;
+            if (llvm::zlib::uncompress (llvm::StringRef(src, src_len), decompressed, decompressed_size) == llvm::zlib::StatusOK &&
+                decompressed.size() == decompressed_size)
+            {
+                dst.assign (decompressed.data(), decompressed.size());
+                return true;
+            }
+        }
+        break;
+    }
+    return false;
+}
+
+const char *
+GDBRemoteCommunication::GetCompressionTypeAsCString (CompressionType compression_type)
+{
+    switch (compression_type)
+    {
+    case CompressionType::None:         return "none";
+    case CompressionType::LZ4:          return "lz4";
+    case CompressionType::ZlibDeflate:  return "zlib-deflate";
+    }
+    return "none";
+}
+
+GDBRemoteCommunication::CompressionType
+GDBRemoteCommunication::GetCompressionTypeFromCString (const char *name)
+{
+    if (name)
+    {
+        if (::strcmp (name, "lz4") == 0)
+            return CompressionType::LZ4;
+        if (::strcmp (name, "zlib-deflate") == 0)
+            return CompressionType::ZlibDeflate;
+    }
+    return CompressionType::None;
+}
+
+bool
+GDBRemoteCommunication::IsCompressionTypeAvailable (CompressionType compression_type)
+{
+    switch (compression_type)
+    {
+    case CompressionType::None:         return false;
+    case CompressionType::LZ4:          return true;
+    case CompressionType::ZlibDeflate:  return llvm::zlib::isAvailable();
+    }
+    return false;
+}
+
+void
+GDBRemoteCommunication::CompressPayload (const char *payload,
+                                         size_t payload_length,
+                                         std::string &framed_payload)
+{
+    std::string compressed;
+    if (payload_length >= m_compression_min_size &&
+        CompressBytes (m_send_compression_type, payload, payload_length, compressed) &&
+        compressed.size() < payload_length)
+    {
+        StreamString header;
+        header.Printf ("C%" PRIu64 ":", (uint64_t)payload_length);
+        framed_payload = header.GetString();
+        framed_payload.reserve (framed_payload.size() + compressed.size() + compressed.size() / 16);
+        for (size_t i = 0; i < compressed.size(); ++i)
+        {
+            // Escape everything that has a meaning in the packet framing
+            const char ch = compressed[i];
+            if (ch == '#' || ch == '$' || ch == '}' || ch == '*')
+            {
+                framed_payload.push_back (0x7d);
+                framed_payload.push_back (ch ^ 0x20);
+            }
+            else
+            {
+                framed_payload.push_back (ch);
+            }
+        }
+        // Escaping can eat up the savings for payloads that barely compress
+        if (framed_payload.size() <= payload_length)
+        {
+            ++m_compression_stats.num_packets_compressed;
+            m_compression_stats.num_uncompressed_bytes += payload_length;
+            m_compression_stats.num_compressed_bytes += framed_payload.size();
+            return;
+        }
+    }
+    framed_payload.assign (1, 'N');
+    framed_payload.append (payload, payload_length);
+    ++m_compression_stats.num_packets_uncompressed;
+}
+
+bool
+GDBRemoteCommunication::DecompressPacket (std::string &packet_str)
+{
+    Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_PACKETS));
+    if (!packet_str.empty())
+    {
+        if (packet_str[0] == 'N')
+        {
+            packet_str.erase (0, 1);
+            ++m_compression_stats.num_packets_uncompressed;
+            return true;
+        }
+
+        if (packet_str[0] == 'C')
+        {
+            const size_t colon_pos = packet_str.find (':');
+            if (colon_pos != std::string::npos)
+            {
+                char *end = NULL;
+                const uint64_t decompressed_size = ::strtoull (packet_str.c_str() + 1, &end, 10);
+                if (end == packet_str.c_str() + colon_pos)
+                {
+                    std::string decompressed;
+                    const size_t compressed_size = packet_str.size() - colon_pos - 1;
+                    if (DecompressBytes (m_recv_compression_type,
+                                         packet_str.data() + colon_pos + 1,
+                                         compressed_size,
+                                         decompressed_size,
+                                         decompressed))
+                    {
+                        ++m_compression_stats.num_packets_compressed;
+                        m_compression_stats.num_uncompressed_bytes += decompressed.size();
+                        m_compression_stats.num_compressed_bytes += compressed_size;
+                        // The compressed bytes are the payload as it would
+                        // have been sent uncompressed, so expand its escapes
+                        // and run-length encoding now.
+                        ExpandPacketBytes (decompressed.data(), decompressed.data() + decompressed.size(), packet_str);
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+    if (log)
+        log->Printf ("error: failed to decompress %s packet", GetCompressionTypeAsCString (m_recv_compression_type));
+    return false;
+}
+
+void
+GDBRemoteCommunication::DumpCompressionStatistics (Stream &strm) const
+{
+    const CompressionStatistics stats = GetCompressionStatistics ();
+    strm.Printf ("send compression:         %s\n", GetCompressionTypeAsCString (m_send_compression_type));
+    strm.Printf ("receive compression:      %s\n", GetCompressionTypeAsCString (m_recv_compression_type));
+    strm.Printf ("compressed packets:       %" PRIu64 "\n", stats.num_packets_compressed);
+    strm.Printf ("uncompressed packets:     %" PRIu64 "\n", stats.num_packets_uncompressed);
+    strm.Printf ("bytes before compression: %" PRIu64 "\n", stats.num_uncompressed_bytes);
+    strm.Printf ("bytes after compression:  %" PRIu64 "\n", stats.num_compressed_bytes);
+    if (stats.num_uncompressed_bytes > stats.num_compressed_bytes)
+    {
+        const uint64_t bytes_saved = stats.num_uncompressed_bytes - stats.num_compressed_bytes;
+        strm.Printf ("bytes saved:              %" PRIu64 " (%.1f%%)\n",
+                     bytes_saved,
+                     (100.0 * bytes_saved) / stats.num_uncompressed_bytes);
+    }
+}
+
 size_t
 GDBRemoteCommunication::SendAck ()
 {
@@ -211,6 +478,14 @@ GDBRemoteCommunication::SendPacketNoLock (const char *payload, size_t payload_le
 {
     if (IsConnected())
     {
+        std::string framed_payload;
+        if (m_send_compression_type != CompressionType::None)
+        {
+            CompressPayload (payload, payload_length, framed_payload);
+            payload = framed_payload.data();
+            payload_length = framed_payload.size();
+        }
+
         StreamString packet(0, 4, eByteOrderBig);
 
         packet.PutChar('$');
@@ -516,39 +791,9 @@ GDBRemoteCommunication::CheckForPacket (const uint8_t *src, size_t src_len, Stri
 
             m_history.AddPacket (m_bytes.c_str(), total_length, History::ePacketTypeRecv, total_length);
 
-            // Clear packet_str in case there is some existing data in it.
-            packet_str.clear();
             // Copy the packet from m_bytes to packet_str expanding the
-            // run-length encoding in the process.
-            // Reserve enough byte for the most common case (no RLE used)
-            packet_str.reserve(m_bytes.length());
-            for (std::string::const_iterator c = m_bytes.begin() + content_start; c != m_bytes.begin() + content_end; ++c)
-            {
-                if (*c == '*')
-                {
-                    // '*' indicates RLE. Next character will give us the
-                    // repeat count and previous character is what is to be
-                    // repeated.
-                    char char_to_repeat = packet_str.back();
-                    // Number of time the previous character is repeated
-                    int repeat_count = *++c + 3 - ' ';
-                    // We have the char_to_repeat and repeat_count. Now push
-                    // it in the packet.
-                    for (int i = 0; i < repeat_count; ++i)
-                        packet_str.push_back(char_to_repeat);
-                }
-                else if (*c == 0x7d)
-                {
-                    // 0x7d is the escape character.  The next character is to
-                    // be XOR'd with 0x20.
-                    char escapee = *++c ^ 0x20;
-                    packet_str.push_back(escapee);
-                }
-                else
-                {
-                    packet_str.push_back(*c);
-                }
-            }
+            // run-length encoding and escapes in the process.
+            ExpandPacketBytes (m_bytes.data() + content_start, m_bytes.data() + content_end, packet_str);
 
             if (m_bytes[0] == '$')
             {
@@ -560,7 +805,9 @@ GDBRemoteCommunication::CheckForPacket (const uint8_t *src, size_t src_len, Stri
                     {
                         const char *packet_checksum_cstr = &m_bytes[checksum_idx];
                         char packet_checksum = strtol (packet_checksum_cstr, NULL, 16);
-                        char actual_checksum = CalculcateChecksum (packet_str.c_str(), packet_str.size());
+                        // The checksum covers the packet bytes as they were sent,
+                        // before any escapes or run-length encoding are expanded
+                        char actual_checksum = CalculcateChecksum (m_bytes.data() + content_start, content_length);
                         success = packet_checksum == actual_checksum;
                         if (!success)
                         {
@@ -571,7 +818,16 @@ GDBRemoteCommunication::CheckForPacket (const uint8_t *src, size_t src_len, Stri
                                              (uint8_t)packet_checksum,
                                              (uint8_t)actual_checksum);
                         }
-                        // Send the ack or nack if needed
+                    }
+
+                    // Decompress before acking so a packet that can't be
+                    // decompressed gets a nack and is sent again
+                    if (success && m_recv_compression_type != CompressionType::None)
+                        success = DecompressPacket (packet_str);
+
+                    // Send the ack or nack if needed
+                    if (GetSendAcks ())
+                    {
                         if (!success)
                             SendNack();
                         else
@@ -48,6 +48,30 @@ public:
         ErrorDisconnected,  // We were disconnected
         ErrorNoSequenceLock // We couldn't get the sequence lock for a multi-packet request
     };
+
+    enum class CompressionType
+    {
+        None = 0,       // Packets are sent as is
+        LZ4,            // LZ4 block format, always available
+        ZlibDeflate     // zlib deflate stream, only if LLVM was built with zlib
+    };
+
+    struct CompressionStatistics
+    {
+        CompressionStatistics () :
+            num_packets_compressed (0),
+            num_packets_uncompressed (0),
+            num_uncompressed_bytes (0),
+            num_compressed_bytes (0)
+        {
+        }
+
+        uint64_t num_packets_compressed;    // Packets that went over the wire compressed
+        uint64_t num_packets_uncompressed;  // Packets that were too small or didn't compress
+        uint64_t num_uncompressed_bytes;    // Payload bytes of the compressed packets before compression
+        uint64_t num_compressed_bytes;      // Payload bytes of the compressed packets on the wire
+    };
+
     //------------------------------------------------------------------
     // Constructors and Destructors
     //------------------------------------------------------------------
@@ -129,7 +153,48 @@ public:
 
     void
     DumpHistory(lldb_private::Stream &strm);
-    
+
+    //------------------------------------------------------------------
+    // Packet compression.
+    //
+    // Once compression has been negotiated with the QEnableCompression
+    // packet every packet that the remote stub sends is framed as either
+    // "N<payload>" (not compressed) or "C<size>:<compressed payload>"
+    // where <size> is the decimal size of the uncompressed payload.
+    // Packets sent by the client are never compressed.
+    //------------------------------------------------------------------
+    static const char *
+    GetCompressionTypeAsCString (CompressionType compression_type);
+
+    static CompressionType
+    GetCompressionTypeFromCString (const char *name);
+
+    // Returns true if this side of the connection can encode and decode
+    // packets using COMPRESSION_TYPE.
+    static bool
+    IsCompressionTypeAvailable (CompressionType compression_type);
+
+    CompressionType
+    GetSendCompressionType () const
+    {
+        return m_send_compression_type;
+    }
+
+    CompressionType
+    GetReceiveCompressionType () const
+    {
+        return m_recv_compression_type;
+    }
+
+    CompressionStatistics
+    GetCompressionStatistics () const
+    {
+        return m_compression_stats;
+    }
+
+    void
+    DumpCompressionStatistics (lldb_private::Stream &strm) const;
+
 protected:
 
     class History
@@ -252,6 +317,17 @@ protected:
     bool
     WaitForNotRunningPrivate (const lldb_private::TimeValue *timeout_ptr);
 
+    // Frame PAYLOAD for sending with the current send compression type.
+    void
+    CompressPayload (const char *payload,
+                     size_t payload_length,
+                     std::string &framed_payload);
+
+    // Remove the compression framing from a received packet and
+    // decompress it if needed.
+    bool
+    DecompressPacket (std::string &packet_str);
+
     //------------------------------------------------------------------
     // Classes that inherit from GDBRemoteCommunication can see and modify these
     //------------------------------------------------------------------
@@ -268,6 +344,10 @@ protected:
     bool m_is_platform; // Set to true if this class represents a platform,
                         // false if this class represents a debug session for
                         // a single process
+    CompressionType m_send_compression_type;
+    CompressionType m_recv_compression_type;
+    uint32_t m_compression_min_size;    // Don't compress payloads smaller than this
+    CompressionStatistics m_compression_stats;
     
 
     lldb_private::Error
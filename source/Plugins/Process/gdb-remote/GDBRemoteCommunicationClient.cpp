@@ -14,6 +14,7 @@
 #include <sys/stat.h>
 
 // C++ Includes
+#include <algorithm>
 #include <sstream>
 
 // Other libraries and framework includes
@@ -76,6 +77,9 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient(bool is_platform) :
     m_supports_qXfer_libraries_svr4_read (eLazyBoolCalculate),
     m_supports_augmented_libraries_svr4_read (eLazyBoolCalculate),
     m_supports_jThreadExtendedInfo (eLazyBoolCalculate),
+    m_supports_qMultiMemRead (eLazyBoolCalculate),
+    m_supports_jThreadsInfo (eLazyBoolCalculate),
+    m_supports_conditional_breakpoints (eLazyBoolCalculate),
     m_supports_qProcessInfoPID (true),
     m_supports_qfProcessInfo (true),
     m_supports_qUserName (true),
@@ -111,7 +115,8 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient(bool is_platform) :
     m_gdb_server_name(),
     m_gdb_server_version(UINT32_MAX),
     m_default_packet_timeout (0),
-    m_max_packet_size (0)
+    m_max_packet_size (0),
+    m_supported_compressions ()
 {
 }
 
@@ -208,6 +213,78 @@ GDBRemoteCommunicationClient::GetQXferAuxvReadSupported ()
     return (m_supports_qXfer_auxv_read == eLazyBoolYes);
 }
 
+bool
+GDBRemoteCommunicationClient::GetMultiMemReadSupported ()
+{
+    if (m_supports_qMultiMemRead == eLazyBoolCalculate)
+    {
+        GetRemoteQSupported();
+    }
+    return (m_supports_qMultiMemRead == eLazyBoolYes);
+}
+
+bool
+GDBRemoteCommunicationClient::GetThreadsInfoSupported ()
+{
+    if (m_supports_jThreadsInfo == eLazyBoolCalculate)
+    {
+        GetRemoteQSupported();
+    }
+    return (m_supports_jThreadsInfo == eLazyBoolYes);
+}
+
+void
+GDBRemoteCommunicationClient::SetThreadsInfoSupported (bool supported)
+{
+    m_supports_jThreadsInfo = supported ? eLazyBoolYes : eLazyBoolNo;
+}
+
+bool
+GDBRemoteCommunicationClient::GetConditionalBreakpointsSupported ()
+{
+    if (m_supports_conditional_breakpoints == eLazyBoolCalculate)
+    {
+        GetRemoteQSupported();
+    }
+    return (m_supports_conditional_breakpoints == eLazyBoolYes);
+}
+
+bool
+GDBRemoteCommunicationClient::GetCompressionSupported (CompressionType compression_type)
+{
+    if (m_max_packet_size == 0)
+    {
+        GetRemoteQSupported();
+    }
+    if (!IsCompressionTypeAvailable (compression_type))
+        return false;
+    return std::find (m_supported_compressions.begin(),
+                      m_supported_compressions.end(),
+                      compression_type) != m_supported_compressions.end();
+}
+
+bool
+GDBRemoteCommunicationClient::EnableCompression (CompressionType compression_type, uint32_t min_size)
+{
+    if (!GetCompressionSupported (compression_type))
+        return false;
+
+    StreamString packet;
+    packet.Printf ("QEnableCompression:type:%s;minsize:%u;",
+                   GetCompressionTypeAsCString (compression_type),
+                   min_size);
+    StringExtractorGDBRemote response;
+    if (SendPacketAndWaitForResponse (packet.GetData(), packet.GetSize(), response, false) == PacketResult::Success &&
+        response.IsOKResponse())
+    {
+        // The OK response was sent uncompressed, everything after it
+        // will be compressed.
+        m_recv_compression_type = compression_type;
+        return true;
+    }
+    return false;
+}
+
 uint64_t
 GDBRemoteCommunicationClient::GetRemoteMaxPacketSize()
 {
@@ -323,6 +400,9 @@ GDBRemoteCommunicationClient::ResetDiscoverableSettings()
     m_supports_qXfer_libraries_read = eLazyBoolCalculate;
     m_supports_qXfer_libraries_svr4_read = eLazyBoolCalculate;
     m_supports_augmented_libraries_svr4_read = eLazyBoolCalculate;
+    m_supports_qMultiMemRead = eLazyBoolCalculate;
+    m_supports_jThreadsInfo = eLazyBoolCalculate;
+    m_supports_conditional_breakpoints = eLazyBoolCalculate;
 
     m_supports_qProcessInfoPID = true;
     m_supports_qfProcessInfo = true;
@@ -350,6 +430,9 @@ GDBRemoteCommunicationClient::ResetDiscoverableSettings()
     m_default_packet_timeout = 0;
 
     m_max_packet_size = 0;
+    m_supported_compressions.clear();
+    m_send_compression_type = CompressionType::None;
+    m_recv_compression_type = CompressionType::None;
 }
 
 void
@@ -360,7 +443,11 @@ GDBRemoteCommunicationClient::GetRemoteQSupported ()
     m_supports_qXfer_libraries_read = eLazyBoolNo;
     m_supports_qXfer_libraries_svr4_read = eLazyBoolNo;
     m_supports_augmented_libraries_svr4_read = eLazyBoolNo;
+    m_supports_qMultiMemRead = eLazyBoolNo;
+    m_supports_jThreadsInfo = eLazyBoolNo;
+    m_supports_conditional_breakpoints = eLazyBoolNo;
     m_max_packet_size = UINT64_MAX;  // It's supposed to always be there, but if not, we assume no limit
+    m_supported_compressions.clear();
 
     StringExtractorGDBRemote response;
     if (SendPacketAndWaitForResponse("qSupported",
@@ -379,6 +466,12 @@ GDBRemoteCommunicationClient::GetRemoteQSupported ()
         }
         if (::strstr (response_cstr, "qXfer:libraries:read+"))
             m_supports_qXfer_libraries_read = eLazyBoolYes;
+        if (::strstr (response_cstr, "qMultiMemRead+"))
+            m_supports_qMultiMemRead = eLazyBoolYes;
+        if (::strstr (response_cstr, "jThreadsInfo+"))
+            m_supports_jThreadsInfo = eLazyBoolYes;
+        if (::strstr (response_cstr, "ConditionalBreakpoints+"))
+            m_supports_conditional_breakpoints = eLazyBoolYes;
 
         const char *packet_size_str = ::strstr (response_cstr, "PacketSize=");
         if (packet_size_str)
@@ -393,6 +486,25 @@ GDBRemoteCommunicationClient::GetRemoteQSupported ()
                     log->Printf ("Garbled PacketSize spec in qSupported response");
             }
         }
+
+        const char *compressions_str = ::strstr (response_cstr, "SupportedCompressions=");
+        if (compressions_str)
+        {
+            // A comma separated list of codec names, most preferred first
+            compressions_str += ::strlen ("SupportedCompressions=");
+            const char *compressions_end = compressions_str + ::strcspn (compressions_str, ";");
+            while (compressions_str < compressions_end)
+            {
+                const size_t name_len = std::min<size_t>(::strcspn (compressions_str, ",;"), compressions_end - compressions_str);
+                const std::string name (compressions_str, name_len);
+                const CompressionType compression_type = GetCompressionTypeFromCString (name.c_str());
+                if (compression_type != CompressionType::None)
+                    m_supported_compressions.push_back (compression_type);
+                compressions_str += name_len;
+                if (compressions_str < compressions_end)
+                    ++compressions_str; // Skip the comma
+            }
+        }
     }
 }
 
@@ -532,6 +644,88 @@ GDBRemoteCommunicationClient::GetxPacketSupported ()
     return m_supports_x;
 }
 
+size_t
+GDBRemoteCommunicationClient::ReadMemoryRanges (size_t num_ranges,
+                                                const lldb::addr_t *addrs,
+                                                const size_t *sizes,
+                                                uint8_t *const *bufs,
+                                                size_t *bytes_read,
+                                                uint64_t max_bytes)
+{
+    if (num_ranges == 0 || max_bytes == 0 || !GetMultiMemReadSupported())
+        return 0;
+
+    const uint64_t max_packet_size = GetRemoteMaxPacketSize();
+    StreamString packet;
+    packet.PutCString ("qMultiMemRead:");
+    std::vector<size_t> request_sizes;
+    uint64_t total_bytes = 0;
+    // The reply hex encodes every byte and has a count for every range, and
+    // the stub will refuse a request whose reply won't fit in a packet.
+    uint64_t reply_size = 0;
+    size_t num_sent;
+    for (num_sent = 0; num_sent < num_ranges; ++num_sent)
+    {
+        size_t size = sizes[num_sent];
+        if (total_bytes + size > max_bytes)
+        {
+            // Always send at least one range, even if it has to be
+            // shortened to fit.
+            if (num_sent > 0)
+                break;
+            size = max_bytes;
+        }
+        if (max_packet_size != UINT64_MAX && reply_size + 17 + 2 * (uint64_t)size > max_packet_size)
+        {
+            if (num_sent > 0 || max_packet_size <= 17 + 1)
+                break;
+            size = (max_packet_size - 17) / 2;
+        }
+        char range[64];
+        const int range_len = ::snprintf (range, sizeof(range), "%" PRIx64 ",%" PRIx64 ";", (uint64_t)addrs[num_sent], (uint64_t)size);
+        if (num_sent > 0 && packet.GetSize() + range_len >= max_packet_size)
+            break;
+        packet.Write (range, range_len);
+        request_sizes.push_back (size);
+        total_bytes += size;
+        reply_size += 17 + 2 * (uint64_t)size;
+    }
+
+    StringExtractorGDBRemote response;
+    if (SendPacketAndWaitForResponse (packet.GetData(), packet.GetSize(), response, true) != PacketResult::Success)
+        return 0;
+
+    if (response.IsUnsupportedResponse())
+    {
+        m_supports_qMultiMemRead = eLazyBoolNo;
+        return 0;
+    }
+
+    if (!response.IsNormalResponse())
+        return 0;
+
+    // The response starts with the number of bytes that were read for
+    // each range...
+    for (size_t i=0; i<num_sent; ++i)
+    {
+        const uint64_t count = response.GetHexMaxU64 (false, UINT64_MAX);
+        if (count > request_sizes[i])
+            return 0;
+        bytes_read[i] = count;
+        const char separator = (i + 1 < num_sent) ? ',' : ';';
+        if (response.GetChar() != separator)
+            return 0;
+    }
+
+    // ...followed by the bytes for all ranges.
+    for (size_t i=0; i<num_sent; ++i)
+    {
+        if (bytes_read[i] > 0 && response.GetHexBytes (bufs[i], bytes_read[i], 0xdd) != bytes_read[i])
+            return 0;
+    }
+    return num_sent;
+}
+
 GDBRemoteCommunicationClient::PacketResult
 GDBRemoteCommunicationClient::SendPacketsAndConcatenateResponses
 (
@@ -2904,25 +3098,24 @@ GDBRemoteCommunicationClient::GetThreadStopInfo (lldb::tid_t tid, StringExtracto
 
 
 uint8_t
-GDBRemoteCommunicationClient::SendGDBStoppointTypePacket (GDBStoppointType type, bool insert,  addr_t addr, uint32_t length)
+GDBRemoteCommunicationClient::SendGDBStoppointTypePacket (GDBStoppointType type, bool insert,  addr_t addr, uint32_t length, const char *conditions)
 {
     // Check if the stub is known not to support this breakpoint type
     if (!SupportsGDBStoppointPacket(type))
         return UINT8_MAX;
     // Construct the breakpoint packet
-    char packet[64];
-    const int packet_len = ::snprintf (packet, 
-                                       sizeof(packet), 
-                                       "%c%i,%" PRIx64 ",%x",
-                                       insert ? 'Z' : 'z', 
-                                       type, 
-                                       addr, 
-                                       length);
-    // Check we havent overwritten the end of the packet buffer
-    assert (packet_len + 1 < (int)sizeof(packet));
+    StreamString packet;
+    packet.Printf ("%c%i,%" PRIx64 ",%x",
+                   insert ? 'Z' : 'z',
+                   type,
+                   addr,
+                   length);
+    // The conditions are already encoded as ";X<len>,<hex bytes>" lists
+    if (insert && conditions && conditions[0])
+        packet.PutCString (conditions);
     StringExtractorGDBRemote response;
     // Try to send the breakpoint packet, and check that it was correctly sent
-    if (SendPacketAndWaitForResponse(packet, packet_len, response, true) == PacketResult::Success)
+    if (SendPacketAndWaitForResponse(packet.GetData(), packet.GetSize(), response, true) == PacketResult::Success)
     {
         // Receive and OK packet when the breakpoint successfully placed
         if (response.IsOKResponse())
@@ -382,7 +382,8 @@ public:
     SendGDBStoppointTypePacket (GDBStoppointType type,   // Type of breakpoint or watchpoint
                                 bool insert,              // Insert or remove?
                                 lldb::addr_t addr,        // Address of breakpoint or watchpoint
-                                uint32_t length);         // Byte Size of breakpoint or watchpoint
+                                uint32_t length,          // Byte Size of breakpoint or watchpoint
+                                const char *conditions = NULL); // ";X<len>,<hex>" agent expression conditions
 
     void
     TestPacketSpeed (const uint32_t num_packets);
@@ -414,6 +415,73 @@ public:
     uint64_t
     GetRemoteMaxPacketSize();
 
+    bool
+    GetMultiMemReadSupported ();
+
+    bool
+    GetThreadsInfoSupported ();
+
+    void
+    SetThreadsInfoSupported (bool supported);
+
+    // Returns true if the remote stub can evaluate breakpoint conditions
+    // sent as agent expressions in Z0 and Z1 packets, and only reports
+    // the hits where one of them is true.
+    bool
+    GetConditionalBreakpointsSupported ();
+
+    // Returns true if the remote stub listed COMPRESSION_TYPE in the
+    // "SupportedCompressions" field of its qSupported response and we
+    // can decode it.
+    bool
+    GetCompressionSupported (CompressionType compression_type);
+
+    //------------------------------------------------------------------
+    /// Ask the remote stub to compress all the packets it sends us from
+    /// now on with \a compression_type.
+    ///
+    /// @param[in] compression_type
+    ///     The codec to use, which must be supported by both sides.
+    ///
+    /// @param[in] min_size
+    ///     Payloads smaller than this are sent uncompressed.
+    ///
+    /// @return
+    ///     True if the remote stub agreed, false otherwise in which case
+    ///     packets are still sent uncompressed.
+    //------------------------------------------------------------------
+    bool
+    EnableCompression (CompressionType compression_type, uint32_t min_size);
+
+    //------------------------------------------------------------------
+    /// Read several ranges of memory using a single qMultiMemRead
+    /// packet.
+    ///
+    /// The packet is:
+    ///     qMultiMemRead:<addr>,<len>;<addr>,<len>;...
+    /// and the response is the number of bytes that were read for each
+    /// range, followed by the hex encoded bytes for all ranges:
+    ///     <count>,<count>,...;<hex bytes>
+    ///
+    /// Only as many ranges as fit into the remote packet size limit,
+    /// and whose sizes add up to no more than \a max_bytes, are sent.
+    /// Callers should call this function again for any ranges that
+    /// weren't handled.
+    ///
+    /// @return
+    ///     The number of ranges, starting at index zero, that were
+    ///     handled by the remote stub. Ranges that couldn't be read
+    ///     will have zero in \a bytes_read. Zero is returned if the
+    ///     packet isn't supported or the communication failed.
+    //------------------------------------------------------------------
+    size_t
+    ReadMemoryRanges (size_t num_ranges,
+                      const lldb::addr_t *addrs,
+                      const size_t *sizes,
+                      uint8_t *const *bufs,
+                      size_t *bytes_read,
+                      uint64_t max_bytes);
+
     bool
     GetAugmentedLibrariesSVR4ReadSupported ();
 
@@ -571,6 +639,9 @@ protected:
     lldb_private::LazyBool m_supports_qXfer_libraries_svr4_read;
     lldb_private::LazyBool m_supports_augmented_libraries_svr4_read;
     lldb_private::LazyBool m_supports_jThreadExtendedInfo;
+    lldb_private::LazyBool m_supports_qMultiMemRead;
+    lldb_private::LazyBool m_supports_jThreadsInfo;
+    lldb_private::LazyBool m_supports_conditional_breakpoints;
 
     bool
         m_supports_qProcessInfoPID:1,
@@ -617,6 +688,7 @@ protected:
     uint32_t m_gdb_server_version; // from reply to qGDBServerVersion, zero if qGDBServerVersion is not supported
     uint32_t m_default_packet_timeout;
     uint64_t m_max_packet_size;  // as returned by qSupported
+    std::vector<CompressionType> m_supported_compressions; // as returned by qSupported
     
     bool
     DecodeProcessInfoResponse (StringExtractorGDBRemote &response, 
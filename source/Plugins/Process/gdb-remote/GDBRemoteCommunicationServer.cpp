@@ -226,6 +226,14 @@ GDBRemoteCommunicationServer::GetPacketAndSendResponse (uint32_t timeout_usec,
             packet_result = Handle_QStartNoAckMode (packet);
             break;
 
+        case StringExtractorGDBRemote::eServerPacketType_qSupported:
+            packet_result = Handle_qSupported (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_QEnableCompression:
+            packet_result = Handle_QEnableCompression (packet);
+            break;
+
         case StringExtractorGDBRemote::eServerPacketType_qPlatform_mkdir:
             packet_result = Handle_qPlatform_mkdir (packet);
             break;
@@ -1272,6 +1280,52 @@ GDBRemoteCommunicationServer::Handle_QStartNoAckMode (StringExtractorGDBRemote &
     return packet_result;
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_qSupported (StringExtractorGDBRemote &packet)
+{
+    // List the codecs we can compress our packets with, best first
+    StreamString response;
+    const CompressionType compression_types[] = { CompressionType::ZlibDeflate, CompressionType::LZ4 };
+    const char *separator = "SupportedCompressions=";
+    for (size_t i = 0; i < sizeof(compression_types)/sizeof(compression_types[0]); ++i)
+    {
+        if (IsCompressionTypeAvailable (compression_types[i]))
+        {
+            response.Printf ("%s%s", separator, GetCompressionTypeAsCString (compression_types[i]));
+            separator = ",";
+        }
+    }
+    response.PutChar (';');
+    return SendPacketNoLock (response.GetData(), response.GetSize());
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_QEnableCompression (StringExtractorGDBRemote &packet)
+{
+    packet.SetFilePos(::strlen ("QEnableCompression:"));
+    CompressionType compression_type = CompressionType::None;
+    uint32_t min_size = 0;
+    std::string key;
+    std::string value;
+    while (packet.GetNameColonValue(key, value))
+    {
+        if (key.compare("type") == 0)
+            compression_type = GetCompressionTypeFromCString (value.c_str());
+        else if (key.compare("minsize") == 0)
+            min_size = Args::StringToUInt32 (value.c_str(), 0, 0);
+    }
+
+    if (!IsCompressionTypeAvailable (compression_type))
+        return SendErrorResponse (0x01);
+
+    // Send the response uncompressed so the client can switch over once it
+    // gets it, just like QStartNoAckMode does with acks.
+    PacketResult packet_result = SendOKResponse ();
+    m_send_compression_type = compression_type;
+    m_compression_min_size = min_size;
+    return packet_result;
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServer::Handle_qPlatform_mkdir (StringExtractorGDBRemote &packet)
 {
@@ -276,6 +276,12 @@ protected:
     PacketResult
     Handle_QStartNoAckMode (StringExtractorGDBRemote &packet);
 
+    PacketResult
+    Handle_qSupported (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_QEnableCompression (StringExtractorGDBRemote &packet);
+
     PacketResult
     Handle_QSetSTDIN (StringExtractorGDBRemote &packet);
 
@@ -28,6 +28,9 @@
 
 // Other libraries and framework includes
 
+#include "lldb/Breakpoint/Breakpoint.h"
+#include "lldb/Breakpoint/BreakpointLocation.h"
+#include "lldb/Breakpoint/BreakpointSite.h"
 #include "lldb/Breakpoint/Watchpoint.h"
 #include "lldb/Interpreter/Args.h"
 #include "lldb/Core/ArchSpec.h"
@@ -42,6 +45,7 @@
 #include "lldb/Core/StreamString.h"
 #include "lldb/Core/Timer.h"
 #include "lldb/Core/Value.h"
+#include "lldb/Expression/ConditionProgram.h"
 #include "lldb/Host/Symbols.h"
 #include "lldb/Host/TimeValue.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
@@ -65,6 +69,7 @@
 #include "Plugins/Process/Utility/StopInfoMachException.h"
 #include "Plugins/Platform/MacOSX/PlatformRemoteiOS.h"
 #include "Utility/StringExtractorGDBRemote.h"
+#include "GDBRemoteAgentExpression.h"
 #include "GDBRemoteRegisterContext.h"
 #include "ProcessGDBRemote.h"
 #include "ProcessGDBRemoteLog.h"
@@ -96,18 +101,40 @@ using namespace lldb_private;
 
 namespace {
 
+    enum PacketCompression
+    {
+        ePacketCompressionNone,
+        ePacketCompressionAny,
+        ePacketCompressionLZ4,
+        ePacketCompressionZlibDeflate
+    };
+
+    static OptionEnumValueElement
+    g_packet_compression_values[] =
+    {
+        { ePacketCompressionNone,        "none",         "Don't compress packets."},
+        { ePacketCompressionAny,         "any",          "Use the best codec that both lldb and the remote stub support."},
+        { ePacketCompressionLZ4,         "lz4",          "Compress packets with LZ4 (fast, less compression)."},
+        { ePacketCompressionZlibDeflate, "zlib-deflate", "Compress packets with zlib (slower, more compression)."},
+        { 0, NULL, NULL }
+    };
+
     static PropertyDefinition
     g_properties[] =
     {
         { "packet-timeout" , OptionValue::eTypeUInt64 , true , 1, NULL, NULL, "Specify the default packet timeout in seconds." },
         { "target-definition-file" , OptionValue::eTypeFileSpec , true, 0 , NULL, NULL, "The file that provides the description for remote target registers." },
+        { "packet-compression" , OptionValue::eTypeEnum , true, ePacketCompressionNone , NULL, g_packet_compression_values, "Ask the remote stub to compress the packets it sends, which helps over slow connections." },
+        { "packet-compression-min-size" , OptionValue::eTypeUInt64 , true, 384 , NULL, NULL, "Packets smaller than this many bytes are never compressed." },
         {  NULL            , OptionValue::eTypeInvalid, false, 0, NULL, NULL, NULL  }
     };
     
     enum
     {
         ePropertyPacketTimeout,
-        ePropertyTargetDefinitionFile
+        ePropertyTargetDefinitionFile,
+        ePropertyPacketCompression,
+        ePropertyPacketCompressionMinSize
     };
     
     class PluginProperties : public Properties
@@ -152,6 +179,20 @@ namespace {
             const uint32_t idx = ePropertyTargetDefinitionFile;
             return m_collection_sp->GetPropertyAtIndexAsFileSpec (NULL, idx);
         }
+
+        PacketCompression
+        GetPacketCompression () const
+        {
+            const uint32_t idx = ePropertyPacketCompression;
+            return (PacketCompression)m_collection_sp->GetPropertyAtIndexAsEnumeration (NULL, idx, g_properties[idx].default_uint_value);
+        }
+
+        uint64_t
+        GetPacketCompressionMinSize () const
+        {
+            const uint32_t idx = ePropertyPacketCompressionMinSize;
+            return m_collection_sp->GetPropertyAtIndexAsUInt64 (NULL, idx, g_properties[idx].default_uint_value);
+        }
     };
     
     typedef std::shared_ptr<PluginProperties> ProcessKDPPropertiesSP;
@@ -285,7 +326,11 @@ ProcessGDBRemote::ProcessGDBRemote(Target& target, Listener &listener) :
     m_waiting_for_attach (false),
     m_destroy_tried_resuming (false),
     m_command_sp (),
-    m_breakpoint_pc_offset (0)
+    m_breakpoint_pc_offset (0),
+    m_threads_info_sp (),
+    m_threads_info_stop_id (UINT32_MAX),
+    m_threads_info_tried (false),
+    m_bp_site_conditions ()
 {
     m_async_broadcaster.SetEventName (eBroadcastBitAsyncThreadShouldExit,   "async thread should exit");
     m_async_broadcaster.SetEventName (eBroadcastBitAsyncContinue,           "async thread continue");
@@ -956,6 +1001,7 @@ ProcessGDBRemote::ConnectToDebugserver (const char *connect_url)
     m_gdb_comm.GetHostInfo ();
     m_gdb_comm.GetVContSupported ('c');
     m_gdb_comm.GetVAttachOrWaitSupported();
+    EnablePacketCompression ();
     
     size_t num_cmds = GetExtraStartupCommands().GetArgumentCount();
     for (size_t idx = 0; idx < num_cmds; idx++)
@@ -966,6 +1012,47 @@ ProcessGDBRemote::ConnectToDebugserver (const char *connect_url)
     return error;
 }
 
+void
+ProcessGDBRemote::EnablePacketCompression ()
+{
+    typedef GDBRemoteCommunication::CompressionType CompressionType;
+
+    CompressionType compression_types[2];
+    size_t num_compression_types = 0;
+    switch (GetGlobalPluginProperties()->GetPacketCompression())
+    {
+    case ePacketCompressionNone:
+        return;
+    case ePacketCompressionAny:
+        // Prefer zlib for its ratio, but fall back to LZ4 which is always
+        // built in if either side doesn't have zlib.
+        compression_types[num_compression_types++] = CompressionType::ZlibDeflate;
+        compression_types[num_compression_types++] = CompressionType::LZ4;
+        break;
+    case ePacketCompressionLZ4:
+        compression_types[num_compression_types++] = CompressionType::LZ4;
+        break;
+    case ePacketCompressionZlibDeflate:
+        compression_types[num_compression_types++] = CompressionType::ZlibDeflate;
+        break;
+    }
+
+    const uint32_t min_size = (uint32_t)GetGlobalPluginProperties()->GetPacketCompressionMinSize();
+    Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_PROCESS));
+    for (size_t i = 0; i < num_compression_types; ++i)
+    {
+        if (m_gdb_comm.EnableCompression (compression_types[i], min_size))
+        {
+            if (log)
+                log->Printf ("ProcessGDBRemote::%s enabled %s packet compression", __FUNCTION__,
+                             GDBRemoteCommunication::GetCompressionTypeAsCString (compression_types[i]));
+            return;
+        }
+    }
+    if (log)
+        log->Printf ("ProcessGDBRemote::%s remote stub doesn't support the requested packet compression", __FUNCTION__);
+}
+
 void
 ProcessGDBRemote::DidLaunchOrAttach ()
 {
@@ -1172,6 +1259,9 @@ ProcessGDBRemote::DoResume ()
     if (log)
         log->Printf ("ProcessGDBRemote::Resume()");
     
+    // Conditions and ignore counts may have changed while we were stopped
+    UpdateBreakpointSiteConditions ();
+    
     Listener listener ("gdb-remote.resume-packet-sent");
     if (listener.StartListeningForEvents (&m_gdb_comm, GDBRemoteCommunication::eBroadcastBitRunPacketSent))
     {
@@ -1619,6 +1709,10 @@ ProcessGDBRemote::SetThreadStopInfo (StringExtractor& stop_packet)
                 {
                     reason.swap(value);
                 }
+                else if (name.compare("filteredhits") == 0)
+                {
+                    AddFilteredBreakpointHits (value);
+                }
                 else if (name.compare("description") == 0)
                 {
                     StringExtractor desc_extractor;
@@ -1815,11 +1909,27 @@ ProcessGDBRemote::SetThreadStopInfo (StringExtractor& stop_packet)
     return eStateInvalid;
 }
 
+void
+ProcessGDBRemote::AddFilteredBreakpointHits (const std::string &value)
+{
+    const size_t comma_pos = value.find(',');
+    if (comma_pos == std::string::npos)
+        return;
+    const lldb::addr_t bp_addr = Args::StringToUInt64 (value.substr(0, comma_pos).c_str(), LLDB_INVALID_ADDRESS, 16);
+    const uint32_t count = Args::StringToUInt32 (value.c_str() + comma_pos + 1, 0, 16);
+    lldb::BreakpointSiteSP bp_site_sp = GetBreakpointSiteList().FindByAddress(bp_addr);
+    if (bp_site_sp && count > 0)
+        bp_site_sp->BumpHitCounts (count);
+}
+
 void
 ProcessGDBRemote::RefreshStateAfterStop ()
 {
     Mutex::Locker locker(m_thread_list_real.GetMutex());
     m_thread_ids.clear();
+    // Any jThreadsInfo reply we have is from a previous stop
+    m_threads_info_sp.reset();
+    m_threads_info_tried = false;
     // Set the thread stop info. It might have a "threads" key whose value is
     // a list of all thread IDs in the current process, so m_thread_ids might
     // get set.
@@ -2191,6 +2301,46 @@ ProcessGDBRemote::DoReadMemory (addr_t addr, void *buf, size_t size, Error &erro
     return 0;
 }
 
+size_t
+ProcessGDBRemote::DoReadMemoryRanges (size_t num_ranges,
+                                      const addr_t *addrs,
+                                      const size_t *sizes,
+                                      uint8_t *const *bufs,
+                                      size_t *bytes_read,
+                                      Error &error)
+{
+    if (!m_gdb_comm.GetMultiMemReadSupported())
+        return 0;
+
+    GetMaxMemorySize ();
+    const size_t num_ranges_read = m_gdb_comm.ReadMemoryRanges (num_ranges,
+                                                                addrs,
+                                                                sizes,
+                                                                bufs,
+                                                                bytes_read,
+                                                                m_max_memory_size);
+    if (num_ranges_read == 0)
+        error.SetErrorString ("multiple range memory read failed");
+    else
+        error.Clear();
+    return num_ranges_read;
+}
+
+bool
+ProcessGDBRemote::CanReadMemoryRanges ()
+{
+    return m_gdb_comm.GetMultiMemReadSupported();
+}
+
+size_t
+ProcessGDBRemote::GetMaxMemoryReadSize ()
+{
+    // Every memory read is a round trip to the remote stub, so let the
+    // memory cache read ahead as much as fits in one packet.
+    GetMaxMemorySize ();
+    return m_max_memory_size;
+}
+
 size_t
 ProcessGDBRemote::DoWriteMemory (addr_t addr, const void *buf, size_t size, Error &error)
 {
@@ -2341,6 +2491,141 @@ ProcessGDBRemote::PutSTDIN (const char *src, size_t src_len, Error &error)
     return 0;
 }
 
+//----------------------------------------------------------------------
+// Describe everything the conditions sent for \a bp_site depend on, so
+// a change to any owner's condition or ignore count can be noticed.
+// Returns false if the site can't have conditions sent with it.
+//----------------------------------------------------------------------
+static bool
+GetBreakpointSiteConditionsKey (BreakpointSite *bp_site, std::string &key)
+{
+    key.clear();
+    const size_t num_owners = bp_site->GetNumberOfOwners();
+    if (num_owners == 0)
+        return false;
+
+    StreamString strm;
+    for (size_t idx = 0; idx < num_owners; ++idx)
+    {
+        BreakpointLocationSP loc_sp (bp_site->GetOwnerAtIndex (idx));
+        if (!loc_sp)
+            return false;
+        const char *condition_text = loc_sp->GetConditionText();
+        strm.Printf ("%i.%u:%u:%u:%s;",
+                     loc_sp->GetBreakpoint().GetID(),
+                     loc_sp->GetID(),
+                     loc_sp->GetIgnoreCount(),
+                     loc_sp->GetBreakpoint().GetIgnoreCount(),
+                     condition_text ? condition_text : "");
+    }
+    key.swap (strm.GetString());
+    return true;
+}
+
+// Insert a breakpoint with the agent expressions in \a conditions and
+// without them if the stub rejects the conditions.
+static bool
+SendBreakpointSitePacket (GDBRemoteCommunicationClient &gdb_comm,
+                          GDBStoppointType type,
+                          addr_t addr,
+                          size_t bp_op_size,
+                          const std::string &conditions)
+{
+    if (gdb_comm.SendGDBStoppointTypePacket (type, true, addr, bp_op_size, conditions.c_str()) == 0)
+        return true;
+    if (conditions.empty() || !gdb_comm.SupportsGDBStoppointPacket (type))
+        return false;
+    Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_BREAKPOINTS));
+    if (log)
+        log->Printf ("ProcessGDBRemote: stub rejected breakpoint conditions at 0x%" PRIx64 ", inserting an unconditional breakpoint", addr);
+    return gdb_comm.SendGDBStoppointTypePacket (type, true, addr, bp_op_size) == 0;
+}
+
+bool
+ProcessGDBRemote::CompileBreakpointSiteConditions (BreakpointSite *bp_site, std::string &conditions)
+{
+    conditions.clear();
+
+    ThreadSP thread_sp (GetThreadList().GetThreadAtIndex (0, false));
+    if (!thread_sp)
+        return false;
+
+    Address bp_addr;
+    if (!GetTarget().ResolveLoadAddress (bp_site->GetLoadAddress(), bp_addr))
+        return true;
+
+    // The stub reports the hits it swallows in the next stop reply and they
+    // are added to the hit counts then, but ignore counts are checked
+    // before the condition and need to see each hit as it happens. Only
+    // send conditions when all the owners would skip a false hit without
+    // any other side effect.
+    StreamString strm;
+    std::vector<uint8_t> bytecode;
+    const size_t num_owners = bp_site->GetNumberOfOwners();
+    for (size_t idx = 0; idx < num_owners; ++idx)
+    {
+        BreakpointLocationSP loc_sp (bp_site->GetOwnerAtIndex (idx));
+        if (!loc_sp || loc_sp->GetIgnoreCount() != 0 || loc_sp->GetBreakpoint().GetIgnoreCount() != 0)
+            return true;
+        const char *condition_text = loc_sp->GetConditionText();
+        if (condition_text == NULL || condition_text[0] == '\0')
+            return true;
+        ConditionProgram program (condition_text);
+        if (!GDBRemoteAgentExpression::Compile (program, *thread_sp, bp_addr, bytecode))
+            return true;
+
+        strm.Printf (";X%" PRIx64 ",", (uint64_t)bytecode.size());
+        for (size_t i = 0; i < bytecode.size(); ++i)
+            strm.PutHex8 (bytecode[i]);
+    }
+    conditions.swap (strm.GetString());
+    return true;
+}
+
+void
+ProcessGDBRemote::UpdateBreakpointSiteConditions ()
+{
+    if (m_bp_site_conditions.empty())
+        return;
+
+    Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_BREAKPOINTS));
+    BreakpointSiteList &bp_site_list = GetBreakpointSiteList();
+    std::string key;
+    std::string conditions;
+    for (BreakpointSiteConditionsMap::iterator pos = m_bp_site_conditions.begin(), end = m_bp_site_conditions.end(); pos != end; ++pos)
+    {
+        BreakpointSiteSP bp_site_sp (bp_site_list.FindByID (pos->first));
+        if (!bp_site_sp || !bp_site_sp->IsEnabled())
+            continue;
+        if (!GetBreakpointSiteConditionsKey (bp_site_sp.get(), key) || key == pos->second.key)
+            continue;
+        if (!CompileBreakpointSiteConditions (bp_site_sp.get(), conditions))
+            continue;
+        pos->second.key = key;
+        if (conditions == pos->second.conditions)
+            continue;
+
+        GDBStoppointType type = eBreakpointSoftware;
+        if (bp_site_sp->GetType() == BreakpointSite::eHardware || bp_site_sp->IsHardware())
+            type = eBreakpointHardware;
+        const addr_t addr = bp_site_sp->GetLoadAddress();
+        const size_t bp_op_size = GetSoftwareBreakpointTrapOpcode (bp_site_sp.get());
+
+        // Remove the breakpoint before inserting it again with the new
+        // conditions so stubs that reference count breakpoints stay
+        // balanced
+        if (m_gdb_comm.SendGDBStoppointTypePacket (type, false, addr, bp_op_size) != 0 ||
+            !SendBreakpointSitePacket (m_gdb_comm, type, addr, bp_op_size, conditions))
+        {
+            if (log)
+                log->Printf ("ProcessGDBRemote::UpdateBreakpointSiteConditions (site_id = %" PRIu64 ") addr = 0x%" PRIx64 " -- FAILED to update conditions", pos->first, addr);
+            pos->second.key.clear();
+            continue;
+        }
+        pos->second.conditions = conditions;
+    }
+}
+
 Error
 ProcessGDBRemote::EnableBreakpointSite (BreakpointSite *bp_site)
 {
@@ -2376,14 +2661,26 @@ ProcessGDBRemote::EnableBreakpointSite (BreakpointSite *bp_site)
     // attempt to set a software breakpoint. HardwareRequired() also queries a boolean variable which
     // indicates if the user specifically asked for hardware breakpoints.  If true then we will
     // skip over software breakpoints.
+    // Stubs that support conditional breakpoints can evaluate the
+    // conditions themselves and only report the hits where one is true.
+    const bool supports_conditions = m_gdb_comm.GetConditionalBreakpointsSupported();
+    BreakpointSiteConditions site_conditions;
+    if (supports_conditions && GetBreakpointSiteConditionsKey (bp_site, site_conditions.key))
+    {
+        if (!CompileBreakpointSiteConditions (bp_site, site_conditions.conditions))
+            site_conditions.key.clear();
+    }
+
     if (m_gdb_comm.SupportsGDBStoppointPacket(eBreakpointSoftware) && (!bp_site->HardwareRequired()))
     {
         // Try to send off a software breakpoint packet ($Z0)
-        if (m_gdb_comm.SendGDBStoppointTypePacket(eBreakpointSoftware, true, addr, bp_op_size) == 0)
+        if (SendBreakpointSitePacket (m_gdb_comm, eBreakpointSoftware, addr, bp_op_size, site_conditions.conditions))
         {
             // The breakpoint was placed successfully
             bp_site->SetEnabled(true);
             bp_site->SetType(BreakpointSite::eExternal);
+            if (supports_conditions)
+                m_bp_site_conditions[site_id] = site_conditions;
             return error;
         }
 
@@ -2412,11 +2709,13 @@ ProcessGDBRemote::EnableBreakpointSite (BreakpointSite *bp_site)
     if (m_gdb_comm.SupportsGDBStoppointPacket(eBreakpointHardware))
     {
         // Try to send off a hardware breakpoint packet ($Z1)
-        if (m_gdb_comm.SendGDBStoppointTypePacket(eBreakpointHardware, true, addr, bp_op_size) == 0)
+        if (SendBreakpointSitePacket (m_gdb_comm, eBreakpointHardware, addr, bp_op_size, site_conditions.conditions))
         {
             // The breakpoint was placed successfully
             bp_site->SetEnabled(true);
             bp_site->SetType(BreakpointSite::eHardware);
+            if (supports_conditions)
+                m_bp_site_conditions[site_id] = site_conditions;
             return error;
         }
 
@@ -2488,7 +2787,10 @@ ProcessGDBRemote::DisableBreakpointSite (BreakpointSite *bp_site)
             break;
         }
         if (error.Success())
+        {
             bp_site->SetEnabled(false);
+            m_bp_site_conditions.erase (site_id);
+        }
     }
     else
     {
@@ -2982,6 +3284,10 @@ ProcessGDBRemote::AsyncThread (void *arg)
                                                     extractor.GetHexByteString (desc_string);
                                                     desc_cstr = desc_string.c_str();
                                                 }
+                                                else if (desc_token == "filteredhits")
+                                                {
+                                                    process->AddFilteredBreakpointHits (desc_string);
+                                                }
                                             }
                                         }
                                         process->SetExitStatus(exit_status, desc_cstr);
@@ -3199,6 +3505,126 @@ ProcessGDBRemote::GetExtendedInfoForThread (lldb::tid_t tid)
     return object_sp;
 }
 
+StructuredData::ObjectSP
+ProcessGDBRemote::GetThreadsInfo ()
+{
+    const uint32_t stop_id = GetStopID();
+    // Only ask once per stop, even if the stub failed to give us a usable
+    // reply, so threads fall back to qThreadStopInfo without a wasted packet
+    // each.
+    if (m_threads_info_tried && m_threads_info_stop_id == stop_id)
+        return m_threads_info_sp;
+
+    m_threads_info_sp.reset();
+    m_threads_info_stop_id = stop_id;
+    m_threads_info_tried = true;
+    if (m_gdb_comm.GetThreadsInfoSupported())
+    {
+        StringExtractorGDBRemote response;
+        if (m_gdb_comm.SendPacketAndWaitForResponse("jThreadsInfo", response, false) == GDBRemoteCommunication::PacketResult::Success)
+        {
+            if (response.IsUnsupportedResponse())
+            {
+                m_gdb_comm.SetThreadsInfoSupported (false);
+            }
+            else if (response.IsNormalResponse())
+            {
+                // The packet has already had the 0x7d xor quoting stripped out at the
+                // GDBRemoteCommunication packet receive level.
+                m_threads_info_sp = StructuredData::ParseJSON (response.GetStringRef());
+                if (m_threads_info_sp && m_threads_info_sp->GetAsArray() == NULL)
+                    m_threads_info_sp.reset();
+            }
+        }
+    }
+    return m_threads_info_sp;
+}
+
+bool
+ProcessGDBRemote::GetThreadStopInfoFromThreadsInfo (lldb::tid_t tid, StringExtractor &stop_packet)
+{
+    StructuredData::ObjectSP threads_info_sp (GetThreadsInfo());
+    if (!threads_info_sp)
+        return false;
+
+    StructuredData::Array *threads = threads_info_sp->GetAsArray();
+    const size_t num_threads = threads->GetSize();
+    for (size_t i=0; i<num_threads; ++i)
+    {
+        StructuredData::ObjectSP thread_sp (threads->GetItemAtIndex(i));
+        StructuredData::Dictionary *thread_dict = thread_sp ? thread_sp->GetAsDictionary() : NULL;
+        if (thread_dict == NULL)
+            continue;
+        StructuredData::ObjectSP tid_sp (thread_dict->GetValueForKey("tid"));
+        if (!tid_sp || tid_sp->GetAsInteger() == NULL || tid_sp->GetAsInteger()->GetValue() != tid)
+            continue;
+
+        // The keys in each thread dictionary match the key/value pairs of
+        // a stop reply packet, so make one that SetThreadStopInfo() can use.
+        StreamString packet;
+        uint64_t signo = 0;
+        StructuredData::ObjectSP value_sp (thread_dict->GetValueForKey("signal"));
+        if (value_sp && value_sp->GetAsInteger())
+            signo = value_sp->GetAsInteger()->GetValue();
+        packet.Printf("T%2.2x", (uint8_t)signo);
+        packet.Printf("thread:%" PRIx64 ";", tid);
+
+        value_sp = thread_dict->GetValueForKey("name");
+        if (value_sp && value_sp->GetAsString() && !value_sp->GetAsString()->GetValue().empty())
+        {
+            packet.PutCString("hexname:");
+            packet.PutCStringAsRawHex8(value_sp->GetAsString()->GetValue().c_str());
+            packet.PutChar(';');
+        }
+
+        value_sp = thread_dict->GetValueForKey("qaddr");
+        if (value_sp && value_sp->GetAsInteger())
+            packet.Printf("qaddr:%" PRIx64 ";", value_sp->GetAsInteger()->GetValue());
+
+        value_sp = thread_dict->GetValueForKey("reason");
+        if (value_sp && value_sp->GetAsString())
+            packet.Printf("reason:%s;", value_sp->GetAsString()->GetValue().c_str());
+
+        value_sp = thread_dict->GetValueForKey("metype");
+        if (value_sp && value_sp->GetAsInteger())
+        {
+            packet.Printf("metype:%" PRIx64 ";", value_sp->GetAsInteger()->GetValue());
+            value_sp = thread_dict->GetValueForKey("medata");
+            StructuredData::Array *medata = value_sp ? value_sp->GetAsArray() : NULL;
+            if (medata)
+            {
+                for (size_t j=0; j<medata->GetSize(); ++j)
+                {
+                    StructuredData::ObjectSP data_sp (medata->GetItemAtIndex(j));
+                    if (data_sp && data_sp->GetAsInteger())
+                        packet.Printf("medata:%" PRIx64 ";", data_sp->GetAsInteger()->GetValue());
+                }
+            }
+        }
+
+        value_sp = thread_dict->GetValueForKey("registers");
+        StructuredData::Dictionary *registers = value_sp ? value_sp->GetAsDictionary() : NULL;
+        if (registers)
+        {
+            StructuredData::ObjectSP keys_sp (registers->GetKeys());
+            StructuredData::Array *keys = keys_sp->GetAsArray();
+            for (size_t j=0; j<keys->GetSize(); ++j)
+            {
+                const std::string &key = keys->GetItemAtIndex(j)->GetAsString()->GetValue();
+                const uint32_t reg = Args::StringToUInt32 (key.c_str(), UINT32_MAX, 10);
+                StructuredData::ObjectSP reg_value_sp (registers->GetValueForKey(key.c_str()));
+                if (reg != UINT32_MAX && reg_value_sp && reg_value_sp->GetAsString())
+                    packet.Printf("%2.2x:%s;", reg, reg_value_sp->GetAsString()->GetValue().c_str());
+            }
+        }
+
+        stop_packet.GetStringRef() = packet.GetString();
+        stop_packet.SetFilePos(0);
+        return true;
+    }
+    return false;
+}
+
 // Establish the largest memory read/write payloads we should use.
 // If the remote stub has a max packet size, stay under that size.
 // 
@@ -3304,6 +3730,46 @@ public:
     }
 };
 
+class CommandObjectProcessGDBRemotePacketCompressionStats : public CommandObjectParsed
+{
+private:
+    
+public:
+    CommandObjectProcessGDBRemotePacketCompressionStats(CommandInterpreter &interpreter) :
+    CommandObjectParsed (interpreter,
+                         "process plugin packet compression-stats",
+                         "Show how much packet compression has saved on this connection.",
+                         NULL)
+    {
+    }
+    
+    ~CommandObjectProcessGDBRemotePacketCompressionStats ()
+    {
+    }
+    
+    bool
+    DoExecute (Args& command, CommandReturnObject &result)
+    {
+        const size_t argc = command.GetArgumentCount();
+        if (argc == 0)
+        {
+            ProcessGDBRemote *process = (ProcessGDBRemote *)m_interpreter.GetExecutionContext().GetProcessPtr();
+            if (process)
+            {
+                process->GetGDBRemote().DumpCompressionStatistics(result.GetOutputStream());
+                result.SetStatus (eReturnStatusSuccessFinishResult);
+                return true;
+            }
+        }
+        else
+        {
+            result.AppendErrorWithFormat ("'%s' takes no arguments", m_cmd_name.c_str());
+        }
+        result.SetStatus (eReturnStatusFailed);
+        return false;
+    }
+};
+
 class CommandObjectProcessGDBRemotePacketXferSize : public CommandObjectParsed
 {
 private:
@@ -3477,6 +3943,7 @@ public:
         LoadSubCommand ("send", CommandObjectSP (new CommandObjectProcessGDBRemotePacketSend (interpreter)));
         LoadSubCommand ("monitor", CommandObjectSP (new CommandObjectProcessGDBRemotePacketMonitor (interpreter)));
         LoadSubCommand ("xfer-size", CommandObjectSP (new CommandObjectProcessGDBRemotePacketXferSize (interpreter)));
+        LoadSubCommand ("compression-stats", CommandObjectSP (new CommandObjectProcessGDBRemotePacketCompressionStats (interpreter)));
     }
     
     ~CommandObjectProcessGDBRemotePacket ()
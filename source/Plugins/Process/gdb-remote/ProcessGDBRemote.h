@@ -14,6 +14,8 @@
 
 // C++ Includes
 #include <list>
+#include <map>
+#include <string>
 #include <vector>
 
 // Other libraries and framework includes
@@ -167,6 +169,20 @@ public:
     virtual size_t
     DoReadMemory (lldb::addr_t addr, void *buf, size_t size, lldb_private::Error &error);
 
+    virtual size_t
+    DoReadMemoryRanges (size_t num_ranges,
+                        const lldb::addr_t *addrs,
+                        const size_t *sizes,
+                        uint8_t *const *bufs,
+                        size_t *bytes_read,
+                        lldb_private::Error &error);
+
+    virtual bool
+    CanReadMemoryRanges ();
+
+    virtual size_t
+    GetMaxMemoryReadSize ();
+
     virtual size_t
     DoWriteMemory (lldb::addr_t addr, const void *buf, size_t size, lldb_private::Error &error);
 
@@ -311,9 +327,64 @@ protected:
     lldb_private::StructuredData::ObjectSP
     GetExtendedInfoForThread (lldb::tid_t tid);
 
+    //------------------------------------------------------------------
+    /// Get the stop information for all threads using a single
+    /// jThreadsInfo packet. The reply is fetched once per stop and
+    /// then cached until the process stops again.
+    //------------------------------------------------------------------
+    lldb_private::StructuredData::ObjectSP
+    GetThreadsInfo ();
+
+    //------------------------------------------------------------------
+    /// Make a stop reply packet for thread \a tid out of the cached
+    /// jThreadsInfo reply so it can be handed to SetThreadStopInfo().
+    ///
+    /// @return
+    ///     True if the remote stub supports jThreadsInfo and \a tid was
+    ///     found in its reply, false otherwise.
+    //------------------------------------------------------------------
+    bool
+    GetThreadStopInfoFromThreadsInfo (lldb::tid_t tid, StringExtractor &stop_packet);
+
     void
     GetMaxMemorySize();
 
+    //------------------------------------------------------------------
+    /// Translate the conditions of all the owners of \a bp_site into
+    /// agent expressions for a stub that supports conditional
+    /// breakpoints.
+    ///
+    /// @param[out] conditions
+    ///     The ";X<len>,<hex bytes>" list to append to the Z packet, or
+    ///     an empty string if the stub must report every hit: when an
+    ///     owner has no condition, a condition that can't be translated
+    ///     or an ignore count that needs every hit to be counted.
+    ///
+    /// @return
+    ///     False if the conditions couldn't be looked at yet, in which
+    ///     case they are retried before the next resume.
+    //------------------------------------------------------------------
+    bool
+    CompileBreakpointSiteConditions (lldb_private::BreakpointSite *bp_site, std::string &conditions);
+
+    //------------------------------------------------------------------
+    /// Re-insert the enabled breakpoint sites whose conditions changed
+    /// since they were sent to the stub.
+    //------------------------------------------------------------------
+    void
+    UpdateBreakpointSiteConditions ();
+
+    //------------------------------------------------------------------
+    /// Add the hits the stub filtered out with breakpoint conditions to
+    /// the hit counts of the breakpoint site and its owners.
+    ///
+    /// @param[in] value
+    ///     The "<address>,<count>" value of a "filteredhits" key in a
+    ///     stop reply or exit packet, both in hex.
+    //------------------------------------------------------------------
+    void
+    AddFilteredBreakpointHits (const std::string &value);
+
     //------------------------------------------------------------------
     /// Broadcaster event bits definitions.
     //------------------------------------------------------------------
@@ -357,6 +428,16 @@ protected:
     bool m_destroy_tried_resuming;
     lldb::CommandObjectSP m_command_sp;
     int64_t m_breakpoint_pc_offset;
+    lldb_private::StructuredData::ObjectSP m_threads_info_sp; // The jThreadsInfo reply for m_threads_info_stop_id
+    uint32_t m_threads_info_stop_id;
+    bool m_threads_info_tried; // True if jThreadsInfo was sent for m_threads_info_stop_id, whether or not it succeeded
+    struct BreakpointSiteConditions
+    {
+        std::string key;        // The owners' conditions and ignore counts the agent expressions were made for
+        std::string conditions; // The agent expressions sent with the Z packet
+    };
+    typedef std::map<lldb::user_id_t, BreakpointSiteConditions> BreakpointSiteConditionsMap;
+    BreakpointSiteConditionsMap m_bp_site_conditions; // Breakpoint sites inserted with Z packets, by site ID
     
     bool
     StartAsyncThread ();
@@ -389,6 +470,11 @@ protected:
     lldb_private::Error
     ConnectToDebugserver (const char *host_port);
 
+    // Negotiate packet compression as requested by the
+    // "plugin.process.gdb-remote.packet-compression" setting.
+    void
+    EnablePacketCompression ();
+
     const char *
     GetDispatchQueueNameForThread (lldb::addr_t thread_dispatch_qaddr,
                                    std::string &dispatch_queue_name);
@@ -285,7 +285,10 @@ ThreadGDBRemote::CalculateStopInfo ()
     {
         StringExtractorGDBRemote stop_packet;
         ProcessGDBRemote *gdb_process = static_cast<ProcessGDBRemote *>(process_sp.get());
-        if (gdb_process->GetGDBRemote().GetThreadStopInfo(GetProtocolID(), stop_packet))
+        // Get the stop info for all threads at once if the remote stub
+        // supports it, otherwise ask for the stop info of this thread.
+        if (gdb_process->GetThreadStopInfoFromThreadsInfo(GetProtocolID(), stop_packet) ||
+            gdb_process->GetGDBRemote().GetThreadStopInfo(GetProtocolID(), stop_packet))
             return gdb_process->SetThreadStopInfo (stop_packet) == eStateStopped;
     }
     return false;
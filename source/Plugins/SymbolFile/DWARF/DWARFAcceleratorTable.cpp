@@ -0,0 +1,123 @@
+//===-- DWARFAcceleratorTable.cpp -------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DWARFAcceleratorTable.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#include "lldb/Core/ConstString.h"
+#include "lldb/Target/CPPLanguageRuntime.h"
+
+using namespace lldb_private;
+
+static bool
+IsIdentifierChar (char c)
+{
+    return isalnum(c) || c == '_' || c == '$';
+}
+
+// Returns true if \a name contains the "operator" keyword.
+static bool
+ContainsOperator (const char *name)
+{
+    static const char g_operator[] = "operator";
+    const size_t operator_len = sizeof(g_operator) - 1;
+    for (const char *pos = ::strstr (name, g_operator); pos; pos = ::strstr (pos + 1, g_operator))
+    {
+        if ((pos == name || !IsIdentifierChar(pos[-1])) && !IsIdentifierChar(pos[operator_len]))
+            return true;
+    }
+    return false;
+}
+
+bool
+DWARFAcceleratorTable::GetLookupName (const char *name, ConstString &lookup_name)
+{
+    if (name == NULL || name[0] == '\0')
+        return false;
+
+    // Objective C methods are indexed by selector and class name which
+    // the accelerator tables don't know about
+    if ((name[0] == '-' || name[0] == '+') && name[1] == '[')
+        return false;
+
+    if (CPPLanguageRuntime::IsCPPMangledName (name))
+    {
+        ConstString context;
+        bool has_qualifiers = false;
+        return CPPLanguageRuntime::GetContextAndBasenameFromMangledName (name, context, lookup_name, has_qualifiers);
+    }
+
+    if (ContainsOperator (name))
+        return false;
+
+    // The base name starts after the last "::" that isn't inside template
+    // arguments and ends at the start of the function arguments, if any.
+    static const char g_anonymous_namespace[] = "(anonymous namespace)";
+    const size_t anonymous_namespace_len = sizeof(g_anonymous_namespace) - 1;
+    const char *base_name_start = name;
+    const char *base_name_end = NULL;
+    uint32_t template_depth = 0;
+    uint32_t paren_depth = 0;
+    for (const char *pos = name; *pos && base_name_end == NULL; ++pos)
+    {
+        switch (*pos)
+        {
+        case '<':
+            ++template_depth;
+            break;
+
+        case '>':
+            if (template_depth == 0)
+                return false;
+            --template_depth;
+            break;
+
+        case '(':
+            if (template_depth == 0 && paren_depth == 0)
+            {
+                if (::strncmp (pos, g_anonymous_namespace, anonymous_namespace_len) == 0)
+                    pos += anonymous_namespace_len - 1;
+                else
+                    base_name_end = pos;
+            }
+            else
+                ++paren_depth;
+            break;
+
+        case ')':
+            if (paren_depth == 0)
+                return false;
+            --paren_depth;
+            break;
+
+        case ':':
+            if (pos[1] == ':' && template_depth == 0 && paren_depth == 0)
+            {
+                ++pos;
+                base_name_start = pos + 1;
+            }
+            break;
+        }
+    }
+
+    if (base_name_end == NULL)
+    {
+        if (template_depth != 0 || paren_depth != 0)
+            return false;
+        base_name_end = name + ::strlen (name);
+    }
+
+    if (base_name_end <= base_name_start)
+        return false;
+
+    lookup_name.SetCStringWithLength (base_name_start, base_name_end - base_name_start);
+    return true;
+}
@@ -0,0 +1,78 @@
+//===-- DWARFAcceleratorTable.h ---------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SymbolFileDWARF_DWARFAcceleratorTable_h_
+#define SymbolFileDWARF_DWARFAcceleratorTable_h_
+
+#include <vector>
+
+#include "lldb/lldb-private.h"
+#include "lldb/Core/dwarf.h"
+
+//----------------------------------------------------------------------
+// DWARFAcceleratorTable
+//
+// Base class for name lookup tables that aren't complete enough to be
+// used in place of the DWARF name indexes the way the Apple tables are
+// (see HashedNameToDIE.h), but that can tell which compile units
+// contain a DIE for a given name. SymbolFileDWARF uses them to index
+// only those compile units instead of every compile unit in the file.
+//
+// Lookups are done on the base name of functions, variables and types:
+// the name without any decl context, function arguments or qualifiers.
+// DWARFAcceleratorTable::GetLookupName() extracts it from the kinds of
+// names SymbolFileDWARF gets asked to find.
+//----------------------------------------------------------------------
+class DWARFAcceleratorTable
+{
+public:
+    virtual
+    ~DWARFAcceleratorTable()
+    {
+    }
+
+    virtual bool
+    IsValid () const = 0;
+
+    virtual const char *
+    GetSectionName () const = 0;
+
+    //------------------------------------------------------------------
+    // Append the .debug_info offsets of all compile units that have
+    // entries in this table. Compile units that aren't covered by the
+    // table must always be indexed.
+    //------------------------------------------------------------------
+    virtual void
+    GetCompileUnitOffsets (std::vector<dw_offset_t> &cu_offsets) = 0;
+
+    //------------------------------------------------------------------
+    // Append the .debug_info offsets of the compile units that contain
+    // a DIE whose base name is \a lookup_name. Offsets can be appended
+    // more than once.
+    //
+    // Returns false if this table can't answer the question, in which
+    // case all compile units need to be indexed.
+    //------------------------------------------------------------------
+    virtual bool
+    FindCompileUnitOffsets (const lldb_private::ConstString &lookup_name,
+                            std::vector<dw_offset_t> &cu_offsets) = 0;
+
+    //------------------------------------------------------------------
+    // Get the base name to look up in an accelerator table for \a name,
+    // which can be a base name, a qualified name, a demangled function
+    // name with arguments or a mangled C++ name.
+    //
+    // Returns false for names whose base name can't be found without
+    // parsing them properly (operators, Objective C methods, ...).
+    //------------------------------------------------------------------
+    static bool
+    GetLookupName (const char *name, lldb_private::ConstString &lookup_name);
+};
+
+#endif  // SymbolFileDWARF_DWARFAcceleratorTable_h_
@@ -27,6 +27,7 @@
 #include "NameToDIE.h"
 #include "SymbolFileDWARF.h"
 #include "SymbolFileDWARFDebugMap.h"
+#include "SymbolFileDWARFDwo.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -41,7 +42,12 @@ DWARFCompileUnit::DWARFCompileUnit(SymbolFileDWARF* dwarf2Data) :
     m_user_data     (NULL),
     m_die_array     (),
     m_func_aranges_ap (),
+    m_dwo_symfile_ap (),
     m_base_addr     (0),
+    m_addr_base     (0),
+    m_ranges_base   (0),
+    m_dwo_id        (0),
+    m_dwo_load_attempted (false),
     m_offset        (DW_INVALID_OFFSET),
     m_length        (0),
     m_version       (0),
@@ -53,6 +59,10 @@ DWARFCompileUnit::DWARFCompileUnit(SymbolFileDWARF* dwarf2Data) :
 {
 }
 
+DWARFCompileUnit::~DWARFCompileUnit()
+{
+}
+
 void
 DWARFCompileUnit::Clear()
 {
@@ -62,8 +72,13 @@ DWARFCompileUnit::Clear()
     m_abbrevs       = NULL;
     m_addr_size     = DWARFCompileUnit::GetDefaultAddressSize();
     m_base_addr     = 0;
+    m_addr_base     = 0;
+    m_ranges_base   = 0;
+    m_dwo_id        = 0;
+    m_dwo_load_attempted = false;
     m_die_array.clear();
     m_func_aranges_ap.reset();
+    m_dwo_symfile_ap.reset();
     m_user_data     = NULL;
     m_producer      = eProducerInvalid;
 }
@@ -182,12 +197,8 @@ DWARFCompileUnit::ExtractDIEsIfNeeded (bool cu_die_only)
         const bool null_die = die.IsNULL();
         if (depth == 0)
         {
-            uint64_t base_addr = die.GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_low_pc, LLDB_INVALID_ADDRESS);
-            if (base_addr == LLDB_INVALID_ADDRESS)
-                base_addr = die.GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_entry_pc, 0);
-            SetBaseAddress (base_addr);
             if (initial_die_array_size == 0)
-                AddDIE (die);
+                AddCompileUnitDIE (die);
             if (cu_die_only)
                 return 1;
         }
@@ -281,6 +292,73 @@ DWARFCompileUnit::ExtractDIEsIfNeeded (bool cu_die_only)
 }
 
 
+//----------------------------------------------------------------------
+// Add the compile unit DIE and read the attributes that apply to the
+// whole compile unit from it.
+//----------------------------------------------------------------------
+void
+DWARFCompileUnit::AddCompileUnitDIE (DWARFDebugInfoEntry& die)
+{
+    AddDIE (die);
+
+    // A compile unit in a .dwo file doesn't have addresses of its own,
+    // they come from the skeleton compile unit in the executable.
+    const DWARFCompileUnit *skeleton_cu = m_dwarf2Data->GetSkeletonCompileUnit();
+    if (skeleton_cu)
+    {
+        m_addr_base = skeleton_cu->GetAddrBase();
+        m_ranges_base = skeleton_cu->GetRangesBase();
+        SetBaseAddress (skeleton_cu->GetBaseAddress());
+        return;
+    }
+
+    uint64_t base_addr = die.GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_low_pc, LLDB_INVALID_ADDRESS);
+    if (base_addr == LLDB_INVALID_ADDRESS)
+        base_addr = die.GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_entry_pc, 0);
+    SetBaseAddress (base_addr);
+
+    // Split DWARF is only supported for DWARF in the executable itself
+    if (m_dwarf2Data->GetDebugMapSymfile() == NULL)
+    {
+        m_dwo_id = die.GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_GNU_dwo_id, 0);
+        m_addr_base = die.GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_GNU_addr_base, 0);
+        m_ranges_base = die.GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_GNU_ranges_base, 0);
+    }
+}
+
+SymbolFileDWARFDwo *
+DWARFCompileUnit::GetDwoSymbolFile ()
+{
+    if (!m_dwo_load_attempted)
+    {
+        m_dwo_load_attempted = true;
+        const DWARFDebugInfoEntry *cu_die = GetCompileUnitDIEOnly();
+        if (cu_die && m_dwo_id != 0)
+            m_dwo_symfile_ap.reset (m_dwarf2Data->CreateDwoSymbolFile (this, cu_die));
+    }
+    return m_dwo_symfile_ap.get();
+}
+
+dw_addr_t
+DWARFCompileUnit::ReadAddressAtIndex (uint32_t index) const
+{
+    const DWARFDataExtractor &debug_addr_data = m_dwarf2Data->get_debug_addr_data();
+    lldb::offset_t offset = m_addr_base + (lldb::offset_t)index * m_addr_size;
+    if (!debug_addr_data.ValidOffsetForDataOfSize (offset, m_addr_size))
+        return LLDB_INVALID_ADDRESS;
+    return debug_addr_data.GetMaxU64 (&offset, m_addr_size);
+}
+
+const char *
+DWARFCompileUnit::ReadStringAtIndex (uint32_t index) const
+{
+    const DWARFDataExtractor &debug_str_offsets_data = m_dwarf2Data->get_debug_str_offsets_data();
+    lldb::offset_t offset = (lldb::offset_t)index * 4;
+    if (!debug_str_offsets_data.ValidOffsetForDataOfSize (offset, 4))
+        return NULL;
+    return m_dwarf2Data->get_debug_str_data().PeekCStr (debug_str_offsets_data.GetU32 (&offset));
+}
+
 dw_offset_t
 DWARFCompileUnit::GetAbbrevOffset() const
 {
@@ -374,7 +452,10 @@ DWARFCompileUnit::BuildAddressRangeTable (SymbolFileDWARF* dwarf2Data,
     if (die)
     {
         DWARFDebugRanges::RangeList ranges;
-        const size_t num_ranges = die->GetAttributeAddressRanges(dwarf2Data, this, ranges, false);
+        // Skeleton compile units don't have any DIEs for functions, but
+        // their DW_AT_low_pc and DW_AT_high_pc cover the whole unit
+        const bool check_hi_lo_pc = IsSkeleton();
+        const size_t num_ranges = die->GetAttributeAddressRanges(dwarf2Data, this, ranges, check_hi_lo_pc);
         if (num_ranges > 0)
         {
             // This compile unit has DW_AT_ranges, assume this is correct if it
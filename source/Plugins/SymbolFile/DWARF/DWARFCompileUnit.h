@@ -14,6 +14,7 @@
 #include "SymbolFileDWARF.h"
 
 class NameToDIE;
+class SymbolFileDWARFDwo;
 
 class DWARFCompileUnit
 {
@@ -28,6 +29,7 @@ public:
     };
 
     DWARFCompileUnit(SymbolFileDWARF* dwarf2Data);
+    ~DWARFCompileUnit();
 
     bool        Extract(const lldb_private::DWARFDataExtractor &debug_info, lldb::offset_t *offset_ptr);
     size_t      ExtractDIEsIfNeeded (bool cu_die_only);
@@ -62,6 +64,54 @@ public:
         m_base_addr = base_addr;
     }
 
+    //------------------------------------------------------------------
+    // Split DWARF (-gsplit-dwarf) support
+    //
+    // A skeleton compile unit only has a compile unit DIE that names the
+    // .dwo file with the rest of the DWARF for the unit. The .dwo file
+    // is opened the first time GetDwoSymbolFile() is called.
+    //------------------------------------------------------------------
+    bool
+    IsSkeleton ()
+    {
+        ExtractDIEsIfNeeded (true);
+        return m_dwo_id != 0;
+    }
+
+    uint64_t
+    GetDwoId () const
+    {
+        return m_dwo_id;
+    }
+
+    dw_addr_t
+    GetAddrBase () const
+    {
+        return m_addr_base;
+    }
+
+    dw_offset_t
+    GetRangesBase () const
+    {
+        return m_ranges_base;
+    }
+
+    SymbolFileDWARFDwo *
+    GetDwoSymbolFile ();
+
+    // Returns the loaded .dwo symbol file without trying to load it
+    SymbolFileDWARFDwo *
+    GetLoadedDwoSymbolFile () const
+    {
+        return m_dwo_symfile_ap.get();
+    }
+
+    dw_addr_t
+    ReadAddressAtIndex (uint32_t index) const;
+
+    const char *
+    ReadStringAtIndex (uint32_t index) const;
+
     const DWARFDebugInfoEntry*
     GetCompileUnitDIEOnly()
     {
@@ -103,6 +153,19 @@ public:
         return m_die_array.size() > 1;
     }
 
+    // Returns true if DIE points into the DIE array of this compile unit.
+    bool
+    ContainsDIEPtr (const DWARFDebugInfoEntry *die) const
+    {
+        return !m_die_array.empty() && &m_die_array.front() <= die && die <= &m_die_array.back();
+    }
+
+    size_t
+    GetDIEArrayMemorySize () const
+    {
+        return m_die_array.capacity() * sizeof(DWARFDebugInfoEntry);
+    }
+
     DWARFDebugInfoEntry*
     GetDIEAtIndexUnchecked (uint32_t idx)
     {
@@ -189,7 +252,12 @@ protected:
     void *              m_user_data;
     DWARFDebugInfoEntry::collection m_die_array;    // The compile unit debug information entry item
     std::unique_ptr<DWARFDebugAranges> m_func_aranges_ap;   // A table similar to the .debug_aranges table, but this one points to the exact DW_TAG_subprogram DIEs
+    std::unique_ptr<SymbolFileDWARFDwo> m_dwo_symfile_ap;   // The .dwo file of a skeleton compile unit
     dw_addr_t           m_base_addr;
+    dw_addr_t           m_addr_base;        // DW_AT_GNU_addr_base, the start of this unit's addresses in .debug_addr
+    dw_offset_t         m_ranges_base;      // DW_AT_GNU_ranges_base, the start of this unit's .dwo ranges in .debug_ranges
+    uint64_t            m_dwo_id;           // DW_AT_GNU_dwo_id, zero if this isn't a skeleton compile unit
+    bool                m_dwo_load_attempted;
     dw_offset_t         m_offset;
     uint32_t            m_length;
     uint16_t            m_version;
@@ -201,6 +269,9 @@ protected:
     
     void
     ParseProducerInfo ();
+
+    void
+    AddCompileUnitDIE (DWARFDebugInfoEntry& die);
 private:
     DISALLOW_COPY_AND_ASSIGN (DWARFCompileUnit);
 };
@@ -0,0 +1,114 @@
+//===-- DWARFDebugCUIndex.cpp -----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DWARFDebugCUIndex.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+DWARFDebugCUIndex::DWARFDebugCUIndex (const DataExtractor &data) :
+    m_data (data),
+    m_section_count (0),
+    m_unit_count (0),
+    m_slot_count (0),
+    m_hash_table_offset (0),
+    m_index_table_offset (0),
+    m_section_kinds_offset (0),
+    m_offsets_offset (0),
+    m_sizes_offset (0)
+{
+    if (m_data.GetByteSize() < 4 * sizeof(uint32_t))
+        return;
+
+    lldb::offset_t offset = 0;
+    const uint32_t version = m_data.GetU32 (&offset);
+    // Version 1 packages list section indexes instead of contributions
+    // and aren't supported.
+    if (version != 2)
+        return;
+
+    const uint32_t section_count = m_data.GetU32 (&offset);
+    const uint32_t unit_count = m_data.GetU32 (&offset);
+    const uint32_t slot_count = m_data.GetU32 (&offset);
+    // The hash table size must be a power of two larger than the number
+    // of units for the probing below to terminate
+    if (slot_count == 0 || (slot_count & (slot_count - 1)) != 0 || unit_count >= slot_count)
+        return;
+
+    const lldb::offset_t hash_table_offset = offset;
+    const lldb::offset_t index_table_offset = hash_table_offset + 8 * (lldb::offset_t)slot_count;
+    const lldb::offset_t section_kinds_offset = index_table_offset + 4 * (lldb::offset_t)slot_count;
+    const lldb::offset_t offsets_offset = section_kinds_offset + 4 * (lldb::offset_t)section_count;
+    const lldb::offset_t sizes_offset = offsets_offset + 4 * (lldb::offset_t)unit_count * section_count;
+    const lldb::offset_t end_offset = sizes_offset + 4 * (lldb::offset_t)unit_count * section_count;
+    if (end_offset > m_data.GetByteSize())
+        return;
+
+    m_section_count = section_count;
+    m_unit_count = unit_count;
+    m_slot_count = slot_count;
+    m_hash_table_offset = hash_table_offset;
+    m_index_table_offset = index_table_offset;
+    m_section_kinds_offset = section_kinds_offset;
+    m_offsets_offset = offsets_offset;
+    m_sizes_offset = sizes_offset;
+}
+
+DWARFDebugCUIndex::~DWARFDebugCUIndex()
+{
+}
+
+uint32_t
+DWARFDebugCUIndex::FindRow (uint64_t dwo_id) const
+{
+    if (!IsValid())
+        return 0;
+
+    const uint32_t mask = m_slot_count - 1;
+    uint32_t slot = dwo_id & mask;
+    const uint32_t step = ((dwo_id >> 32) & mask) | 1;
+    for (uint32_t i = 0; i < m_slot_count; ++i)
+    {
+        lldb::offset_t hash_offset = m_hash_table_offset + 8 * (lldb::offset_t)slot;
+        const uint64_t slot_dwo_id = m_data.GetU64 (&hash_offset);
+        lldb::offset_t index_offset = m_index_table_offset + 4 * (lldb::offset_t)slot;
+        const uint32_t row = m_data.GetU32 (&index_offset);
+        if (row == 0)
+            return 0;
+        if (slot_dwo_id == dwo_id)
+            return row <= m_unit_count ? row : 0;
+        slot = (slot + step) & mask;
+    }
+    return 0;
+}
+
+bool
+DWARFDebugCUIndex::GetContribution (uint32_t row,
+                                    SectionKind section_kind,
+                                    dw_offset_t &offset,
+                                    dw_offset_t &size) const
+{
+    if (row == 0 || row > m_unit_count)
+        return false;
+
+    lldb::offset_t kind_offset = m_section_kinds_offset;
+    for (uint32_t column = 0; column < m_section_count; ++column)
+    {
+        if (m_data.GetU32 (&kind_offset) == (uint32_t)section_kind)
+        {
+            const lldb::offset_t cell = 4 * ((lldb::offset_t)(row - 1) * m_section_count + column);
+            lldb::offset_t cell_offset = m_offsets_offset + cell;
+            offset = m_data.GetU32 (&cell_offset);
+            cell_offset = m_sizes_offset + cell;
+            size = m_data.GetU32 (&cell_offset);
+            return true;
+        }
+    }
+    return false;
+}
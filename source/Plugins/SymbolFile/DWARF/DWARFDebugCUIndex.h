@@ -0,0 +1,91 @@
+//===-- DWARFDebugCUIndex.h -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SymbolFileDWARF_DWARFDebugCUIndex_h_
+#define SymbolFileDWARF_DWARFDebugCUIndex_h_
+
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/dwarf.h"
+
+//----------------------------------------------------------------------
+// DWARFDebugCUIndex
+//
+// Reads the .debug_cu_index section of a .dwp split DWARF package. A
+// package contains the DWARF of many .dwo files, and the index says
+// where the contributions of each compile unit are in the sections of
+// the package, keyed by the DW_AT_GNU_dwo_id of the compile unit.
+//
+// Section layout (version 2):
+//   uint32_t version (2)
+//   uint32_t section_count
+//   uint32_t unit_count
+//   uint32_t slot_count (a power of 2)
+//   uint64_t hash_table[slot_count] (dwo ids, zero for empty slots)
+//   uint32_t index_table[slot_count] (1 based rows, zero for empty slots)
+//   uint32_t section_kinds[section_count] (the DW_SECT_* of each column)
+//   uint32_t offsets[unit_count][section_count]
+//   uint32_t sizes[unit_count][section_count]
+//----------------------------------------------------------------------
+class DWARFDebugCUIndex
+{
+public:
+    // Section kinds (DW_SECT_*)
+    enum SectionKind
+    {
+        eSectionKindInfo = 1,
+        eSectionKindTypes = 2,
+        eSectionKindAbbrev = 3,
+        eSectionKindLine = 4,
+        eSectionKindLoc = 5,
+        eSectionKindStrOffsets = 6,
+        eSectionKindMacInfo = 7,
+        eSectionKindMacro = 8
+    };
+
+    DWARFDebugCUIndex (const lldb_private::DataExtractor &data);
+
+    ~DWARFDebugCUIndex();
+
+    bool
+    IsValid () const
+    {
+        return m_slot_count > 0;
+    }
+
+    //------------------------------------------------------------------
+    // Returns the 1 based row of the compile unit with \a dwo_id, or
+    // zero if the package doesn't contain it.
+    //------------------------------------------------------------------
+    uint32_t
+    FindRow (uint64_t dwo_id) const;
+
+    //------------------------------------------------------------------
+    // Get the offset and size of the contribution of the compile unit
+    // at \a row to the section of kind \a section_kind. Returns false
+    // if the compile unit doesn't have a contribution to the section.
+    //------------------------------------------------------------------
+    bool
+    GetContribution (uint32_t row,
+                     SectionKind section_kind,
+                     dw_offset_t &offset,
+                     dw_offset_t &size) const;
+
+protected:
+    lldb_private::DataExtractor m_data;
+    uint32_t m_section_count;
+    uint32_t m_unit_count;
+    uint32_t m_slot_count;
+    lldb::offset_t m_hash_table_offset;
+    lldb::offset_t m_index_table_offset;
+    lldb::offset_t m_section_kinds_offset;
+    lldb::offset_t m_offsets_offset;
+    lldb::offset_t m_sizes_offset;
+};
+
+#endif  // SymbolFileDWARF_DWARFDebugCUIndex_h_
@@ -34,6 +34,10 @@ using namespace lldb_private;
 using namespace std;
 extern int g_verbose;
 
+// Every DIE of every compile unit whose DIEs are extracted has one of
+// these, keep the bit packed layout from growing by accident.
+static_assert(sizeof(DWARFDebugInfoEntry) == 16, "DWARFDebugInfoEntry is expected to be 16 bytes");
+
 
 
 DWARFDebugInfoEntry::Attributes::Attributes() :
@@ -157,7 +161,7 @@ DWARFDebugInfoEntry::FastExtract
         {
             form = abbrevDecl->GetFormByIndexUnchecked(i);
 
-            const uint8_t fixed_skip_size = fixed_form_sizes [form];
+            const uint8_t fixed_skip_size = DWARFFormValue::GetFixedFormSize (fixed_form_sizes, form);
             if (fixed_skip_size)
                 offset += fixed_skip_size;
             else
@@ -229,6 +233,8 @@ DWARFDebugInfoEntry::FastExtract
                     case DW_FORM_sdata       :
                     case DW_FORM_udata       :
                     case DW_FORM_ref_udata   :
+                    case DW_FORM_GNU_addr_index:
+                    case DW_FORM_GNU_str_index:
                         debug_info_data.Skip_LEB128 (&offset);
                         break;
 
@@ -396,6 +402,8 @@ DWARFDebugInfoEntry::Extract
                             case DW_FORM_sdata       :
                             case DW_FORM_udata       :
                             case DW_FORM_ref_udata   :
+                            case DW_FORM_GNU_addr_index:
+                            case DW_FORM_GNU_str_index:
                                 debug_info_data.Skip_LEB128(&offset);
                                 break;
 
@@ -800,7 +808,7 @@ DWARFDebugInfoEntry::GetDIENamesAndRanges
 
                 case DW_AT_high_pc:
                     hi_pc = form_value.Unsigned();
-                    if (form_value.Form() != DW_FORM_addr)
+                    if (form_value.Form() != DW_FORM_addr && form_value.Form() != DW_FORM_GNU_addr_index)
                     {
                         if (lo_pc == LLDB_INVALID_ADDRESS)
                             do_offset = hi_pc != LLDB_INVALID_ADDRESS;
@@ -1281,7 +1289,7 @@ DWARFDebugInfoEntry::GetAttributes
             }
             else
             {
-                const uint8_t fixed_skip_size = fixed_form_sizes [form];
+                const uint8_t fixed_skip_size = DWARFFormValue::GetFixedFormSize (fixed_form_sizes, form);
                 if (fixed_skip_size)
                     offset += fixed_skip_size;
                 else
@@ -1449,7 +1457,7 @@ DWARFDebugInfoEntry::GetAttributeHighPC
     if (GetAttributeValue(dwarf2Data, cu, DW_AT_high_pc, form_value))
     {
         dw_addr_t hi_pc = form_value.Unsigned();
-        if (form_value.Form() != DW_FORM_addr)
+        if (form_value.Form() != DW_FORM_addr && form_value.Form() != DW_FORM_GNU_addr_index)
             hi_pc += lo_pc; // DWARF4 can specify the hi_pc as an <offset-from-lowpc>
         return hi_pc; 
     }
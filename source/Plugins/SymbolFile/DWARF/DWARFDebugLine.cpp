@@ -571,6 +571,54 @@ DWARFDebugLine::ParseSupportFiles (const lldb::ModuleSP &module_sp,
     return end_prologue_offset;
 }
 
+//----------------------------------------------------------------------
+// ParseSupportFileBasenames
+//
+// Get only the basenames of the files in the line table prologue at
+// "stmt_list". This doesn't build full paths or remap anything, so it
+// is cheap enough to do for every compile unit in a module.
+//----------------------------------------------------------------------
+bool
+DWARFDebugLine::ParseSupportFileBasenames (const DWARFDataExtractor& debug_line_data,
+                                           dw_offset_t stmt_list,
+                                           std::vector<ConstString> &basenames)
+{
+    if (!debug_line_data.ValidOffset(stmt_list))
+        return false;
+
+    lldb::offset_t offset = stmt_list;
+    // Skip the total length
+    (void)debug_line_data.GetDWARFInitialLength(&offset);
+    uint32_t version = debug_line_data.GetU16(&offset);
+    if (version < 2 || version > 3)
+      return false;
+
+    const dw_offset_t end_prologue_offset = debug_line_data.GetDWARFOffset(&offset) + offset;
+    // Skip instruction length, default is stmt, line base, line range and
+    // opcode base, and all opcode lengths
+    offset += 4;
+    const uint8_t opcode_base = debug_line_data.GetU8(&offset);
+    offset += opcode_base - 1;
+    // Skip the include directories
+    while (offset < end_prologue_offset)
+    {
+        const char *s = debug_line_data.GetCStr(&offset);
+        if (s == NULL || s[0] == '\0')
+            break;
+    }
+    while (offset < end_prologue_offset)
+    {
+        const char* path = debug_line_data.GetCStr( &offset );
+        if (path == NULL || path[0] == '\0')
+            break;
+        debug_line_data.Skip_LEB128(&offset); // Skip dir_idx
+        debug_line_data.Skip_LEB128(&offset); // Skip mod_time
+        debug_line_data.Skip_LEB128(&offset); // Skip length
+        basenames.push_back (FileSpec (path, false).GetFilename());
+    }
+    return true;
+}
+
 //----------------------------------------------------------------------
 // ParseStatementTable
 //
@@ -0,0 +1,273 @@
+//===-- DWARFDebugNames.cpp -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DWARFDebugNames.h"
+
+#include <string.h>
+
+#include "lldb/Core/ConstString.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+DWARFDebugNames::DWARFDebugNames (const DataExtractor &data,
+                                  const DataExtractor &debug_str_data) :
+    DWARFAcceleratorTable (),
+    m_data (data),
+    m_debug_str_data (debug_str_data),
+    m_name_indexes ()
+{
+    lldb::offset_t offset = 0;
+    while (m_data.ValidOffset (offset))
+    {
+        const lldb::offset_t name_index_offset = offset;
+        NameIndex name_index;
+        if (ParseNameIndex (&offset, name_index))
+            m_name_indexes.push_back (name_index);
+        if (offset <= name_index_offset)
+            break;
+    }
+}
+
+DWARFDebugNames::~DWARFDebugNames()
+{
+}
+
+bool
+DWARFDebugNames::IsValid () const
+{
+    return !m_name_indexes.empty();
+}
+
+uint32_t
+DWARFDebugNames::HashName (const char *name)
+{
+    // The DJB hash, as specified for .debug_names
+    uint32_t hash = 5381;
+    for (const uint8_t *s = (const uint8_t *)name; *s; ++s)
+        hash = hash * 33 + *s;
+    return hash;
+}
+
+//----------------------------------------------------------------------
+// Parse the header and abbreviations of the name index at *offset_ptr
+// and advance *offset_ptr to the next name index. Name indexes that
+// can't be used are skipped, the compile units they cover will be
+// indexed the slow way.
+//----------------------------------------------------------------------
+bool
+DWARFDebugNames::ParseNameIndex (lldb::offset_t *offset_ptr, NameIndex &name_index)
+{
+    const lldb::offset_t start_offset = *offset_ptr;
+    lldb::offset_t offset = start_offset;
+    const uint32_t unit_length = m_data.GetU32 (&offset);
+    // 64 bit DWARF isn't supported
+    if (offset == start_offset || unit_length == 0 || unit_length >= 0xfffffff0u)
+        return false;
+
+    const lldb::offset_t end_offset = offset + unit_length;
+    *offset_ptr = end_offset;
+    if (end_offset > m_data.GetByteSize())
+        return false;
+
+    const uint16_t version = m_data.GetU16 (&offset);
+    if (version != 5)
+        return false;
+    m_data.GetU16 (&offset); // padding
+
+    name_index.comp_unit_count = m_data.GetU32 (&offset);
+    const uint32_t local_type_unit_count = m_data.GetU32 (&offset);
+    const uint32_t foreign_type_unit_count = m_data.GetU32 (&offset);
+    name_index.bucket_count = m_data.GetU32 (&offset);
+    name_index.name_count = m_data.GetU32 (&offset);
+    const uint32_t abbrev_table_size = m_data.GetU32 (&offset);
+    const uint32_t augmentation_string_size = m_data.GetU32 (&offset);
+    // Some producers don't include the padding in the size
+    offset += (augmentation_string_size + 3) & ~3u;
+
+    name_index.cu_offsets_offset = offset;
+    offset += 4 * (lldb::offset_t)name_index.comp_unit_count;
+    offset += 4 * (lldb::offset_t)local_type_unit_count;
+    offset += 8 * (lldb::offset_t)foreign_type_unit_count;
+    name_index.buckets_offset = offset;
+    offset += 4 * (lldb::offset_t)name_index.bucket_count;
+    name_index.hashes_offset = offset;
+    if (name_index.bucket_count > 0)
+        offset += 4 * (lldb::offset_t)name_index.name_count;
+    name_index.string_offsets_offset = offset;
+    offset += 4 * (lldb::offset_t)name_index.name_count;
+    name_index.entry_offsets_offset = offset;
+    offset += 4 * (lldb::offset_t)name_index.name_count;
+    name_index.entry_pool_offset = offset + abbrev_table_size;
+    name_index.end_offset = end_offset;
+    if (name_index.comp_unit_count == 0 || name_index.entry_pool_offset > end_offset)
+        return false;
+
+    while (offset < name_index.entry_pool_offset)
+    {
+        const dw_uleb128_t abbrev_code = m_data.GetULEB128 (&offset);
+        if (abbrev_code == 0)
+            break;
+        m_data.GetULEB128 (&offset); // tag
+        AttributeList &attributes = name_index.abbrevs[abbrev_code];
+        while (offset < name_index.entry_pool_offset)
+        {
+            Attribute attribute;
+            attribute.index = m_data.GetULEB128 (&offset);
+            attribute.form = m_data.GetULEB128 (&offset);
+            if (attribute.index == 0 && attribute.form == 0)
+                break;
+            attributes.push_back (attribute);
+        }
+    }
+    return true;
+}
+
+bool
+DWARFDebugNames::ExtractAttributeValue (dw_uleb128_t form,
+                                        lldb::offset_t *offset_ptr,
+                                        uint64_t &value)
+{
+    switch (form)
+    {
+    case DW_FORM_flag_present:  value = 1; return true;
+    case DW_FORM_flag:
+    case DW_FORM_data1:
+    case DW_FORM_ref1:          value = m_data.GetU8 (offset_ptr); return true;
+    case DW_FORM_data2:
+    case DW_FORM_ref2:          value = m_data.GetU16 (offset_ptr); return true;
+    case DW_FORM_data4:
+    case DW_FORM_ref4:          value = m_data.GetU32 (offset_ptr); return true;
+    case DW_FORM_data8:
+    case DW_FORM_ref8:
+    case DW_FORM_ref_sig8:      value = m_data.GetU64 (offset_ptr); return true;
+    case DW_FORM_udata:
+    case DW_FORM_ref_udata:     value = m_data.GetULEB128 (offset_ptr); return true;
+    case DW_FORM_sdata:         value = m_data.GetSLEB128 (offset_ptr); return true;
+    default:
+        break;
+    }
+    return false;
+}
+
+//----------------------------------------------------------------------
+// Append the compile unit offsets of all entries for the name at
+// \a name_idx in \a name_index. Returns false if the entries can't be
+// parsed or don't say which compile unit they belong to.
+//----------------------------------------------------------------------
+bool
+DWARFDebugNames::AppendEntryCompileUnitOffsets (const NameIndex &name_index,
+                                                uint32_t name_idx,
+                                                std::vector<dw_offset_t> &cu_offsets)
+{
+    lldb::offset_t entry_offset_offset = name_index.entry_offsets_offset + 4 * (lldb::offset_t)name_idx;
+    lldb::offset_t offset = name_index.entry_pool_offset + m_data.GetU32 (&entry_offset_offset);
+    while (offset < name_index.end_offset)
+    {
+        const dw_uleb128_t abbrev_code = m_data.GetULEB128 (&offset);
+        if (abbrev_code == 0)
+            break;
+
+        AbbrevMap::const_iterator pos = name_index.abbrevs.find (abbrev_code);
+        if (pos == name_index.abbrevs.end())
+            return false;
+
+        uint64_t cu_idx = UINT64_MAX;
+        bool is_type_unit_entry = false;
+        const AttributeList &attributes = pos->second;
+        for (size_t i = 0; i < attributes.size(); ++i)
+        {
+            uint64_t value = 0;
+            if (!ExtractAttributeValue (attributes[i].form, &offset, value))
+                return false;
+            if (attributes[i].index == eIndexCompileUnit)
+                cu_idx = value;
+            else if (attributes[i].index == eIndexTypeUnit)
+                is_type_unit_entry = true;
+        }
+
+        // Type units aren't indexed by SymbolFileDWARF
+        if (is_type_unit_entry)
+            continue;
+
+        // Name indexes for a single compile unit can leave out the
+        // compile unit attribute
+        if (cu_idx == UINT64_MAX && name_index.comp_unit_count == 1)
+            cu_idx = 0;
+        if (cu_idx >= name_index.comp_unit_count)
+            return false;
+
+        lldb::offset_t cu_offset_offset = name_index.cu_offsets_offset + 4 * cu_idx;
+        cu_offsets.push_back (m_data.GetU32 (&cu_offset_offset));
+    }
+    return true;
+}
+
+void
+DWARFDebugNames::GetCompileUnitOffsets (std::vector<dw_offset_t> &cu_offsets)
+{
+    for (size_t i = 0; i < m_name_indexes.size(); ++i)
+    {
+        const NameIndex &name_index = m_name_indexes[i];
+        lldb::offset_t offset = name_index.cu_offsets_offset;
+        for (uint32_t cu_idx = 0; cu_idx < name_index.comp_unit_count; ++cu_idx)
+            cu_offsets.push_back (m_data.GetU32 (&offset));
+    }
+}
+
+bool
+DWARFDebugNames::FindCompileUnitOffsets (const ConstString &lookup_name,
+                                         std::vector<dw_offset_t> &cu_offsets)
+{
+    const char *name = lookup_name.GetCString();
+    if (name == NULL || !IsValid())
+        return false;
+
+    const uint32_t hash = HashName (name);
+    for (size_t i = 0; i < m_name_indexes.size(); ++i)
+    {
+        const NameIndex &name_index = m_name_indexes[i];
+        uint32_t name_idx = 0;
+        uint32_t name_end_idx = name_index.name_count;
+        if (name_index.bucket_count > 0)
+        {
+            const uint32_t bucket = hash % name_index.bucket_count;
+            lldb::offset_t bucket_offset = name_index.buckets_offset + 4 * (lldb::offset_t)bucket;
+            // Bucket entries are 1 based name indexes, zero means empty
+            name_idx = m_data.GetU32 (&bucket_offset);
+            if (name_idx == 0)
+                continue;
+            --name_idx;
+        }
+
+        for (; name_idx < name_end_idx; ++name_idx)
+        {
+            if (name_index.bucket_count > 0)
+            {
+                // Names in a bucket are contiguous and all hash to it
+                lldb::offset_t hash_offset = name_index.hashes_offset + 4 * (lldb::offset_t)name_idx;
+                const uint32_t name_hash = m_data.GetU32 (&hash_offset);
+                if (name_hash % name_index.bucket_count != hash % name_index.bucket_count)
+                    break;
+                if (name_hash != hash)
+                    continue;
+            }
+
+            lldb::offset_t string_offset_offset = name_index.string_offsets_offset + 4 * (lldb::offset_t)name_idx;
+            const char *entry_name = m_debug_str_data.PeekCStr (m_data.GetU32 (&string_offset_offset));
+            if (entry_name && ::strcmp (entry_name, name) == 0)
+            {
+                if (!AppendEntryCompileUnitOffsets (name_index, name_idx, cu_offsets))
+                    return false;
+                break;
+            }
+        }
+    }
+    return true;
+}
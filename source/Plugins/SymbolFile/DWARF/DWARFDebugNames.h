@@ -0,0 +1,130 @@
+//===-- DWARFDebugNames.h ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SymbolFileDWARF_DWARFDebugNames_h_
+#define SymbolFileDWARF_DWARFDebugNames_h_
+
+#include <map>
+
+#include "lldb/Core/DataExtractor.h"
+
+#include "DWARFAcceleratorTable.h"
+
+//----------------------------------------------------------------------
+// DWARFDebugNames
+//
+// Reads the DWARF5 .debug_names section. The section contains one or
+// more name indexes, each of which covers a list of compile units and
+// maps the DW_AT_name and DW_AT_linkage_name of the DIEs in them to
+// entries that say which compile unit the DIE is in.
+//
+// Name index layout (32 bit DWARF only):
+//   uint32_t unit_length
+//   uint16_t version (5)
+//   uint16_t padding
+//   uint32_t comp_unit_count
+//   uint32_t local_type_unit_count
+//   uint32_t foreign_type_unit_count
+//   uint32_t bucket_count
+//   uint32_t name_count
+//   uint32_t abbrev_table_size
+//   uint32_t augmentation_string_size
+//   char     augmentation_string[augmentation_string_size] (padded to 4)
+//   uint32_t cu_offsets[comp_unit_count]
+//   uint32_t local_tu_offsets[local_type_unit_count]
+//   uint64_t foreign_tu_signatures[foreign_type_unit_count]
+//   uint32_t buckets[bucket_count]
+//   uint32_t hashes[bucket_count ? name_count : 0]
+//   uint32_t string_offsets[name_count] (into .debug_str)
+//   uint32_t entry_offsets[name_count] (into the entry pool)
+//   uint8_t  abbrev_table[abbrev_table_size]
+//   uint8_t  entry_pool[]
+//----------------------------------------------------------------------
+class DWARFDebugNames : public DWARFAcceleratorTable
+{
+public:
+    DWARFDebugNames (const lldb_private::DataExtractor &data,
+                     const lldb_private::DataExtractor &debug_str_data);
+
+    virtual
+    ~DWARFDebugNames();
+
+    virtual bool
+    IsValid () const;
+
+    virtual const char *
+    GetSectionName () const
+    {
+        return ".debug_names";
+    }
+
+    virtual void
+    GetCompileUnitOffsets (std::vector<dw_offset_t> &cu_offsets);
+
+    virtual bool
+    FindCompileUnitOffsets (const lldb_private::ConstString &lookup_name,
+                            std::vector<dw_offset_t> &cu_offsets);
+
+    static uint32_t
+    HashName (const char *name);
+
+protected:
+    // Name index attributes (DW_IDX_*)
+    enum
+    {
+        eIndexCompileUnit = 1,
+        eIndexTypeUnit = 2,
+        eIndexDIEOffset = 3,
+        eIndexParent = 4,
+        eIndexTypeHash = 5
+    };
+
+    struct Attribute
+    {
+        dw_uleb128_t index;
+        dw_uleb128_t form;
+    };
+
+    typedef std::vector<Attribute> AttributeList;
+    typedef std::map<dw_uleb128_t, AttributeList> AbbrevMap;
+
+    struct NameIndex
+    {
+        uint32_t comp_unit_count;
+        uint32_t bucket_count;
+        uint32_t name_count;
+        lldb::offset_t cu_offsets_offset;
+        lldb::offset_t buckets_offset;
+        lldb::offset_t hashes_offset;
+        lldb::offset_t string_offsets_offset;
+        lldb::offset_t entry_offsets_offset;
+        lldb::offset_t entry_pool_offset;
+        lldb::offset_t end_offset;
+        AbbrevMap abbrevs;
+    };
+
+    bool
+    ParseNameIndex (lldb::offset_t *offset_ptr, NameIndex &name_index);
+
+    bool
+    AppendEntryCompileUnitOffsets (const NameIndex &name_index,
+                                   uint32_t name_idx,
+                                   std::vector<dw_offset_t> &cu_offsets);
+
+    bool
+    ExtractAttributeValue (dw_uleb128_t form,
+                           lldb::offset_t *offset_ptr,
+                           uint64_t &value);
+
+    lldb_private::DataExtractor m_data;
+    lldb_private::DataExtractor m_debug_str_data;
+    std::vector<NameIndex> m_name_indexes;
+};
+
+#endif  // SymbolFileDWARF_DWARFDebugNames_h_
@@ -164,6 +164,25 @@ DWARFFormValue::ExtractValue(const DWARFDataExtractor& data, lldb::offset_t* off
         case DW_FORM_sec_offset:    m_value.value.uval = data.GetU32(offset_ptr);                       break;
         case DW_FORM_flag_present:  m_value.value.uval = 1;                                             break;
         case DW_FORM_ref_sig8:      m_value.value.uval = data.GetU64(offset_ptr);                       break;
+
+        // Split DWARF forms are indexes into the .debug_addr and
+        // .debug_str_offsets tables, resolve them now so the value can be
+        // used like a DW_FORM_addr or DW_FORM_string value
+        case DW_FORM_GNU_addr_index:
+            {
+                const uint32_t addr_index = data.GetULEB128(offset_ptr);
+                m_value.value.uval = cu ? cu->ReadAddressAtIndex(addr_index) : LLDB_INVALID_ADDRESS;
+            }
+            break;
+        case DW_FORM_GNU_str_index:
+            {
+                const uint32_t str_index = data.GetULEB128(offset_ptr);
+                m_value.value.cstr = cu ? cu->ReadStringAtIndex(str_index) : NULL;
+                // Mark the string as inlined so AsCString() doesn't look
+                // it up in .debug_str again
+                m_value.data = (const uint8_t*)m_value.value.cstr;
+            }
+            break;
         default:
             return false;
             break;
@@ -258,6 +277,8 @@ DWARFFormValue::SkipValue(dw_form_t form, const DWARFDataExtractor& debug_info_d
     case DW_FORM_sdata:
     case DW_FORM_udata:
     case DW_FORM_ref_udata:
+    case DW_FORM_GNU_addr_index:
+    case DW_FORM_GNU_str_index:
         debug_info_data.Skip_LEB128(offset_ptr);
         return true;
 
@@ -287,7 +308,8 @@ DWARFFormValue::Dump(Stream &s, const DWARFDataExtractor* debug_str_data, const
 
     switch (m_form)
     {
-    case DW_FORM_addr:      s.Address(uvalue, sizeof (uint64_t)); break;
+    case DW_FORM_addr:
+    case DW_FORM_GNU_addr_index: s.Address(uvalue, sizeof (uint64_t)); break;
     case DW_FORM_flag:
     case DW_FORM_data1:     s.PutHex8(uvalue);     break;
     case DW_FORM_data2:     s.PutHex16(uvalue);        break;
@@ -295,7 +317,8 @@ DWARFFormValue::Dump(Stream &s, const DWARFDataExtractor* debug_str_data, const
     case DW_FORM_data4:     s.PutHex32(uvalue);        break;
     case DW_FORM_ref_sig8:
     case DW_FORM_data8:     s.PutHex64(uvalue);        break;
-    case DW_FORM_string:    s.QuotedCString(AsCString(NULL));          break;
+    case DW_FORM_string:
+    case DW_FORM_GNU_str_index: s.QuotedCString(AsCString(NULL));      break;
     case DW_FORM_exprloc:
     case DW_FORM_block:
     case DW_FORM_block1:
@@ -517,6 +540,7 @@ DWARFFormValue::Compare (const DWARFFormValue& a_value, const DWARFFormValue& b_
     case DW_FORM_sec_offset:
     case DW_FORM_flag_present:
     case DW_FORM_ref_sig8:
+    case DW_FORM_GNU_addr_index:
         {
             uint64_t a = a_value.Unsigned();
             uint64_t b = b_value.Unsigned();
@@ -540,6 +564,7 @@ DWARFFormValue::Compare (const DWARFFormValue& a_value, const DWARFFormValue& b_
 
     case DW_FORM_string:
     case DW_FORM_strp:
+    case DW_FORM_GNU_str_index:
         {
             const char *a_string = a_value.AsCString(debug_str_data_ptr);
             const char *b_string = b_value.AsCString(debug_str_data_ptr);
@@ -72,6 +72,12 @@ public:
     static bool         IsBlockForm(const dw_form_t form);
     static bool         IsDataForm(const dw_form_t form);
     static const uint8_t * GetFixedFormSizesForAddressSize (uint8_t addr_size);
+    static uint8_t      GetFixedFormSize (const uint8_t *fixed_form_sizes, dw_form_t form)
+                        {
+                            // The tables end at DW_FORM_ref_sig8, the split DWARF forms
+                            // come after it and don't have a fixed size
+                            return form <= DW_FORM_ref_sig8 ? fixed_form_sizes[form] : 0;
+                        }
     static int          Compare (const DWARFFormValue& a, const DWARFFormValue& b, const DWARFCompileUnit* a_cu, const DWARFCompileUnit* b_cu, const lldb_private::DWARFDataExtractor* debug_str_data_ptr);
 protected:
     dw_form_t   m_form;     // Form for this value
@@ -0,0 +1,142 @@
+//===-- DWARFGdbIndex.cpp ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DWARFGdbIndex.h"
+
+#include "lldb/Core/ConstString.h"
+#include "lldb/Core/Timer.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+DWARFGdbIndex::DWARFGdbIndex (const DataExtractor &data) :
+    DWARFAcceleratorTable (),
+    m_data (data),
+    m_version (0),
+    m_cu_list_offset (0),
+    m_cu_count (0),
+    m_symbol_table_offset (0),
+    m_symbol_count (0),
+    m_constant_pool_offset (0),
+    m_name_to_cu_vector (),
+    m_name_map_built (false)
+{
+    m_data.SetByteOrder (eByteOrderLittle);
+    ParseHeader ();
+}
+
+DWARFGdbIndex::~DWARFGdbIndex()
+{
+}
+
+void
+DWARFGdbIndex::ParseHeader ()
+{
+    if (m_data.GetByteSize() < 6 * sizeof(uint32_t))
+        return;
+
+    lldb::offset_t offset = 0;
+    const uint32_t version = m_data.GetU32 (&offset);
+    // Versions before 5 have a different symbol hash and versions after 8
+    // don't exist yet.
+    if (version < 5 || version > 8)
+        return;
+
+    const uint32_t cu_list_offset = m_data.GetU32 (&offset);
+    const uint32_t types_cu_list_offset = m_data.GetU32 (&offset);
+    m_data.GetU32 (&offset); // address_area_offset
+    const uint32_t symbol_table_offset = m_data.GetU32 (&offset);
+    const uint32_t constant_pool_offset = m_data.GetU32 (&offset);
+    if (cu_list_offset > types_cu_list_offset ||
+        symbol_table_offset > constant_pool_offset ||
+        constant_pool_offset > m_data.GetByteSize())
+        return;
+
+    m_version = version;
+    m_cu_list_offset = cu_list_offset;
+    m_cu_count = (types_cu_list_offset - cu_list_offset) / 16;
+    m_symbol_table_offset = symbol_table_offset;
+    m_symbol_count = (constant_pool_offset - symbol_table_offset) / 8;
+    m_constant_pool_offset = constant_pool_offset;
+}
+
+bool
+DWARFGdbIndex::IsValid () const
+{
+    return m_version != 0 && m_cu_count > 0;
+}
+
+void
+DWARFGdbIndex::GetCompileUnitOffsets (std::vector<dw_offset_t> &cu_offsets)
+{
+    lldb::offset_t offset = m_cu_list_offset;
+    for (uint32_t cu_idx = 0; cu_idx < m_cu_count; ++cu_idx)
+    {
+        const uint64_t cu_offset = m_data.GetU64 (&offset);
+        m_data.GetU64 (&offset); // cu_length
+        cu_offsets.push_back (cu_offset);
+    }
+}
+
+void
+DWARFGdbIndex::BuildNameMapIfNeeded ()
+{
+    if (m_name_map_built)
+        return;
+    m_name_map_built = true;
+
+    Timer scoped_timer (__PRETTY_FUNCTION__, "%s", __PRETTY_FUNCTION__);
+
+    lldb::offset_t offset = m_symbol_table_offset;
+    for (uint32_t i = 0; i < m_symbol_count; ++i)
+    {
+        const uint32_t name_offset = m_data.GetU32 (&offset);
+        const uint32_t cu_vector_offset = m_data.GetU32 (&offset);
+        if (name_offset == 0 && cu_vector_offset == 0)
+            continue;
+
+        lldb::offset_t name_data_offset = m_constant_pool_offset + name_offset;
+        const char *name = m_data.GetCStr (&name_data_offset);
+        ConstString lookup_name;
+        if (DWARFAcceleratorTable::GetLookupName (name, lookup_name))
+            m_name_to_cu_vector.Append (lookup_name.GetCString(), cu_vector_offset);
+    }
+    m_name_to_cu_vector.Sort ();
+    m_name_to_cu_vector.SizeToFit ();
+}
+
+bool
+DWARFGdbIndex::FindCompileUnitOffsets (const ConstString &lookup_name,
+                                       std::vector<dw_offset_t> &cu_offsets)
+{
+    if (!IsValid())
+        return false;
+
+    BuildNameMapIfNeeded ();
+
+    std::vector<uint32_t> cu_vector_offsets;
+    m_name_to_cu_vector.GetValues (lookup_name.GetCString(), cu_vector_offsets);
+    for (size_t i = 0; i < cu_vector_offsets.size(); ++i)
+    {
+        lldb::offset_t offset = m_constant_pool_offset + cu_vector_offsets[i];
+        const uint32_t count = m_data.GetU32 (&offset);
+        for (uint32_t j = 0; j < count && m_data.ValidOffset (offset); ++j)
+        {
+            const uint32_t cu_idx = m_data.GetU32 (&offset) & eCUIndexMask;
+            // Indexes past the end of the CU list are type units in
+            // .debug_types, which we don't index
+            if (cu_idx < m_cu_count)
+            {
+                lldb::offset_t cu_list_offset = m_cu_list_offset + cu_idx * 16;
+                cu_offsets.push_back (m_data.GetU64 (&cu_list_offset));
+            }
+        }
+    }
+    return true;
+}
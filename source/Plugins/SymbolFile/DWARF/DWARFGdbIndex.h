@@ -0,0 +1,93 @@
+//===-- DWARFGdbIndex.h -----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SymbolFileDWARF_DWARFGdbIndex_h_
+#define SymbolFileDWARF_DWARFGdbIndex_h_
+
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/UniqueCStringMap.h"
+
+#include "DWARFAcceleratorTable.h"
+
+//----------------------------------------------------------------------
+// DWARFGdbIndex
+//
+// Reads the .gdb_index section that linkers (--gdb-index) and the
+// gdb-add-index script add to ELF files. The section maps fully
+// qualified names to the compile units that define them. All values
+// are little endian.
+//
+// Section layout (versions 5 through 8):
+//   uint32_t version
+//   uint32_t cu_list_offset
+//   uint32_t types_cu_list_offset
+//   uint32_t address_area_offset
+//   uint32_t symbol_table_offset
+//   uint32_t constant_pool_offset
+//   CU list: (uint64_t cu_offset, uint64_t cu_length) pairs
+//   Types CU list, address area: not used
+//   Symbol table: hash table of (uint32_t name_offset,
+//                 uint32_t cu_vector_offset) slots, offsets are into
+//                 the constant pool and empty slots are all zeros
+//   Constant pool: CU vectors (uint32_t count followed by count
+//                  uint32_t values whose low 24 bits are a CU index)
+//                  and NULL terminated names
+//
+// The hash table is keyed on the fully qualified name, so it can't be
+// used to look up base names. A map from base names to symbol table
+// slots is built instead the first time a name is looked up.
+//----------------------------------------------------------------------
+class DWARFGdbIndex : public DWARFAcceleratorTable
+{
+public:
+    DWARFGdbIndex (const lldb_private::DataExtractor &data);
+
+    virtual
+    ~DWARFGdbIndex();
+
+    virtual bool
+    IsValid () const;
+
+    virtual const char *
+    GetSectionName () const
+    {
+        return ".gdb_index";
+    }
+
+    virtual void
+    GetCompileUnitOffsets (std::vector<dw_offset_t> &cu_offsets);
+
+    virtual bool
+    FindCompileUnitOffsets (const lldb_private::ConstString &lookup_name,
+                            std::vector<dw_offset_t> &cu_offsets);
+
+protected:
+    enum
+    {
+        eCUIndexMask = 0x00ffffffu  // CU vector values keep the symbol kind in the high bits
+    };
+
+    void
+    ParseHeader ();
+
+    void
+    BuildNameMapIfNeeded ();
+
+    lldb_private::DataExtractor m_data;
+    uint32_t m_version;
+    uint32_t m_cu_list_offset;
+    uint32_t m_cu_count;
+    uint32_t m_symbol_table_offset;
+    uint32_t m_symbol_count;
+    uint32_t m_constant_pool_offset;
+    lldb_private::UniqueCStringMap<uint32_t> m_name_to_cu_vector; // Base names to CU vector offsets
+    bool m_name_map_built;
+};
+
+#endif  // SymbolFileDWARF_DWARFGdbIndex_h_
@@ -0,0 +1,157 @@
+//===-- DWARFIndexCache.cpp -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DWARFIndexCache.h"
+
+#include <string.h>
+
+#include <map>
+
+#include "lldb/Core/ConstString.h"
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/Error.h"
+#include "lldb/Core/Log.h"
+#include "lldb/Core/ModuleCacheFile.h"
+#include "lldb/Core/StreamString.h"
+#include "lldb/Core/Timer.h"
+
+#include "LogChannelDWARF.h"
+#include "NameToDIE.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+static const uint32_t k_cache_magic = 0x58444e49;    // 'INDX'
+static const uint32_t k_cache_version = 1;
+static const char *k_cache_file_extension = ".dwarf-index";
+
+bool
+DWARFIndexCache::Load (const FileSpec &cache_dir,
+                       ObjectFile &objfile,
+                       NameToDIE **indexes,
+                       uint32_t num_indexes)
+{
+    ModuleCacheFile cache_file;
+    if (!cache_file.SetObjectFile (cache_dir, k_cache_file_extension, objfile) ||
+        !cache_file.GetFileSpec().Exists())
+        return false;
+
+    Timer scoped_timer (__PRETTY_FUNCTION__,
+                        "DWARFIndexCache::Load (%s)",
+                        cache_file.GetFileSpec().GetPath().c_str());
+
+    Log *log (LogChannelDWARF::GetLogIfAll (DWARF_LOG_LOOKUPS));
+
+    DataExtractor data;
+    lldb::offset_t offset = 0;
+    if (!cache_file.Read (k_cache_magic, k_cache_version, data, offset, log))
+        return false;
+    if (data.GetU32(&offset) != num_indexes)
+        return false;
+
+    const uint32_t strtab_size = data.GetU32(&offset);
+    const char *strtab = (const char *)data.GetData(&offset, strtab_size);
+    // The string table must end with a NULL terminator so none of the
+    // strings can run off its end.
+    if (strtab == NULL || strtab_size == 0 || strtab[strtab_size - 1] != '\0')
+        return false;
+
+    for (uint32_t i=0; i<num_indexes; ++i)
+    {
+        const uint32_t num_entries = data.GetU32(&offset);
+        if (!data.ValidOffsetForDataOfSize(offset, (uint64_t)num_entries * 8))
+            break;
+        for (uint32_t j=0; j<num_entries; ++j)
+        {
+            const uint32_t strtab_offset = data.GetU32(&offset);
+            const uint32_t die_offset = data.GetU32(&offset);
+            if (strtab_offset >= strtab_size)
+                break;
+            indexes[i]->Insert (ConstString(strtab + strtab_offset), die_offset);
+        }
+        indexes[i]->Finalize();
+    }
+
+    if (offset != data.GetByteSize())
+    {
+        // The file was truncated or corrupt, make sure we don't leave a
+        // partial index around.
+        for (uint32_t i=0; i<num_indexes; ++i)
+            *indexes[i] = NameToDIE();
+        return false;
+    }
+
+    if (log)
+        log->Printf ("DWARFIndexCache::Load loaded DWARF index from '%s'", cache_file.GetFileSpec().GetPath().c_str());
+    return true;
+}
+
+bool
+DWARFIndexCache::Save (const FileSpec &cache_dir,
+                       uint64_t max_cache_byte_size,
+                       ObjectFile &objfile,
+                       NameToDIE **indexes,
+                       uint32_t num_indexes)
+{
+    ModuleCacheFile cache_file;
+    if (!cache_file.SetObjectFile (cache_dir, k_cache_file_extension, objfile))
+        return false;
+
+    Timer scoped_timer (__PRETTY_FUNCTION__,
+                        "DWARFIndexCache::Save (%s)",
+                        cache_file.GetFileSpec().GetPath().c_str());
+
+    // Build a string table that contains each name once. All names are
+    // ConstString values so the pointers themselves are unique.
+    typedef std::map<const char *, uint32_t> StringOffsetMap;
+    StringOffsetMap string_offsets;
+    StreamString strtab (Stream::eBinary, 4, eByteOrderLittle);
+    StreamString entries (Stream::eBinary, 4, eByteOrderLittle);
+    for (uint32_t i=0; i<num_indexes; ++i)
+    {
+        StreamString index_entries (Stream::eBinary, 4, eByteOrderLittle);
+        uint32_t num_entries = 0;
+        indexes[i]->ForEach ([&](const char *name, uint32_t die_offset) -> bool
+        {
+            StringOffsetMap::iterator pos = string_offsets.find(name);
+            if (pos == string_offsets.end())
+            {
+                pos = string_offsets.insert(std::make_pair(name, (uint32_t)strtab.GetSize())).first;
+                strtab.PutRawBytes (name, ::strlen(name) + 1);
+            }
+            index_entries.PutHex32 (pos->second);
+            index_entries.PutHex32 (die_offset);
+            ++num_entries;
+            return true;
+        });
+        entries.PutHex32 (num_entries);
+        entries.PutRawBytes (index_entries.GetData(), index_entries.GetSize());
+    }
+
+    StreamString counts (Stream::eBinary, 4, eByteOrderLittle);
+    counts.PutHex32 (num_indexes);
+    counts.PutHex32 (strtab.GetSize());
+
+    const StreamString *parts[] = { &counts, &strtab, &entries };
+    Error error (cache_file.Write (k_cache_magic,
+                                   k_cache_version,
+                                   parts,
+                                   sizeof(parts)/sizeof(parts[0]),
+                                   max_cache_byte_size));
+    if (error.Fail())
+    {
+        Log *log (LogChannelDWARF::GetLogIfAll (DWARF_LOG_LOOKUPS));
+        if (log)
+            log->Printf ("DWARFIndexCache::Save failed to write '%s': %s",
+                         cache_file.GetFileSpec().GetPath().c_str(),
+                         error.AsCString());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,68 @@
+//===-- DWARFIndexCache.h ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SymbolFileDWARF_DWARFIndexCache_h_
+#define SymbolFileDWARF_DWARFIndexCache_h_
+
+#include "lldb/lldb-private.h"
+#include "lldb/Host/FileSpec.h"
+
+class NameToDIE;
+
+//----------------------------------------------------------------------
+// DWARFIndexCache
+//
+// Saves the name indexes that SymbolFileDWARF::Index() builds to a file
+// in a cache directory and loads them back in later debug sessions.
+//
+// The cache files are lldb_private::ModuleCacheFile files for the object
+// file that contains the DWARF. The data after the ModuleCacheFile header
+// is laid out as:
+//   uint32_t num_indexes
+//   uint32_t string_table_byte_size
+//   char     string_table[string_table_byte_size]
+//   num_indexes times:
+//     uint32_t num_entries
+//     num_entries times:
+//       uint32_t string_table_offset
+//       uint32_t die_offset
+//----------------------------------------------------------------------
+class DWARFIndexCache
+{
+public:
+    //------------------------------------------------------------------
+    /// Load the name indexes for \a objfile from \a cache_dir.
+    ///
+    /// @return
+    ///     True if a valid cache file was found and all of the entries
+    ///     in \a indexes were filled in, false otherwise. When false is
+    ///     returned \a indexes are left empty.
+    //------------------------------------------------------------------
+    static bool
+    Load (const lldb_private::FileSpec &cache_dir,
+          lldb_private::ObjectFile &objfile,
+          NameToDIE **indexes,
+          uint32_t num_indexes);
+
+    //------------------------------------------------------------------
+    /// Save the name indexes for \a objfile to \a cache_dir and then
+    /// trim the cache directory so the total size of all cache files
+    /// stays at or below \a max_cache_byte_size. Files that were
+    /// written least recently are removed first. A \a max_cache_byte_size of
+    /// zero means the cache size isn't limited.
+    //------------------------------------------------------------------
+    static bool
+    Save (const lldb_private::FileSpec &cache_dir,
+          uint64_t max_cache_byte_size,
+          lldb_private::ObjectFile &objfile,
+          NameToDIE **indexes,
+          uint32_t num_indexes);
+};
+
+#endif  // SymbolFileDWARF_DWARFIndexCache_h_
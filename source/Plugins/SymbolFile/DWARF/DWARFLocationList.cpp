@@ -9,7 +9,9 @@
 
 #include "DWARFLocationList.h"
 
+#include "lldb/Core/DataBufferHeap.h"
 #include "lldb/Core/Stream.h"
+#include "lldb/Core/StreamString.h"
 
 #include "DWARFCompileUnit.h"
 #include "DWARFDebugInfo.h"
@@ -92,3 +94,76 @@ DWARFLocationList::Size(const DWARFDataExtractor& debug_loc_data, lldb::offset_t
 
 
 
+
+bool
+DWARFLocationList::ConvertSplitDWARFLocationList (const DWARFCompileUnit* cu,
+                                                  const DWARFDataExtractor& debug_loc_data,
+                                                  lldb::offset_t offset,
+                                                  DataExtractor& location_list_data)
+{
+    location_list_data.Clear();
+    if (cu == NULL)
+        return false;
+
+    const uint32_t addr_size = cu->GetAddressByteSize();
+    const dw_addr_t cu_base_addr = cu->GetBaseAddress();
+    StreamString strm (Stream::eBinary, addr_size, debug_loc_data.GetByteOrder());
+    while (debug_loc_data.ValidOffset(offset))
+    {
+        const uint8_t entry_kind = debug_loc_data.GetU8(&offset);
+        if (entry_kind == eSplitEntryEndOfList)
+            break;
+
+        dw_addr_t start_addr = LLDB_INVALID_ADDRESS;
+        dw_addr_t end_addr = LLDB_INVALID_ADDRESS;
+        switch (entry_kind)
+        {
+        case eSplitEntryBaseAddress:
+            // Start and end addresses are absolute, so the base address
+            // isn't needed
+            debug_loc_data.Skip_LEB128(&offset);
+            continue;
+
+        case eSplitEntryStartEnd:
+            start_addr = cu->ReadAddressAtIndex (debug_loc_data.GetULEB128(&offset));
+            end_addr = cu->ReadAddressAtIndex (debug_loc_data.GetULEB128(&offset));
+            break;
+
+        case eSplitEntryStartLength:
+            start_addr = cu->ReadAddressAtIndex (debug_loc_data.GetULEB128(&offset));
+            end_addr = debug_loc_data.GetU32(&offset);
+            if (start_addr != LLDB_INVALID_ADDRESS)
+                end_addr += start_addr;
+            break;
+
+        default:
+            return false;
+        }
+
+        if (start_addr == LLDB_INVALID_ADDRESS || end_addr == LLDB_INVALID_ADDRESS || start_addr < cu_base_addr)
+            return false;
+
+        const uint16_t loc_length = debug_loc_data.GetU16(&offset);
+        const void *loc_bytes = debug_loc_data.PeekData(offset, loc_length);
+        if (loc_bytes == NULL)
+            return false;
+        offset += loc_length;
+
+        // An empty range at the compile unit base address would look
+        // like the end of the list
+        if (start_addr == end_addr)
+            continue;
+
+        strm.PutMaxHex64 (start_addr - cu_base_addr, addr_size);
+        strm.PutMaxHex64 (end_addr - cu_base_addr, addr_size);
+        strm.PutHex16 (loc_length);
+        strm.Write (loc_bytes, loc_length);
+    }
+    strm.PutMaxHex64 (0, addr_size);
+    strm.PutMaxHex64 (0, addr_size);
+
+    location_list_data.SetByteOrder (debug_loc_data.GetByteOrder());
+    location_list_data.SetAddressByteSize (addr_size);
+    location_list_data.SetData (lldb::DataBufferSP (new DataBufferHeap (strm.GetData(), strm.GetSize())));
+    return true;
+}
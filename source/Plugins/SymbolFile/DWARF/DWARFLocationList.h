@@ -15,6 +15,15 @@
 class DWARFLocationList
 {
 public:
+    // Split DWARF location list entry kinds
+    enum
+    {
+        eSplitEntryEndOfList = 0,   // No operands
+        eSplitEntryBaseAddress = 1, // ULEB128 address index
+        eSplitEntryStartEnd = 2,    // ULEB128 start and end address indexes
+        eSplitEntryStartLength = 3  // ULEB128 start address index, uint32_t length
+    };
+
     static dw_offset_t
     Dump (lldb_private::Stream &s,
           const DWARFCompileUnit* cu,
@@ -30,5 +39,17 @@ public:
     Size (const lldb_private::DWARFDataExtractor& debug_loc_data,
           lldb::offset_t offset);
 
+    //------------------------------------------------------------------
+    // Split DWARF (-gsplit-dwarf) location lists in .debug_loc.dwo use
+    // indexes into .debug_addr instead of addresses. Convert the list
+    // at \a offset into a regular location list relative to the base
+    // address of \a cu so DWARFExpression can evaluate it.
+    //------------------------------------------------------------------
+    static bool
+    ConvertSplitDWARFLocationList (const DWARFCompileUnit* cu,
+                                   const lldb_private::DWARFDataExtractor& debug_loc_data,
+                                   lldb::offset_t offset,
+                                   lldb_private::DataExtractor& location_list_data);
+
 };
 #endif  // SymbolFileDWARF_DWARFLocationList_h_
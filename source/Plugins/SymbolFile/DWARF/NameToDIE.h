@@ -24,7 +24,8 @@ class NameToDIE
 {
 public:
     NameToDIE () :   
-        m_map()
+        m_map(),
+        m_num_sorted (0)
     {
     }
     
@@ -38,9 +39,26 @@ public:
     void
     Insert (const lldb_private::ConstString& name, uint32_t die_offset);
 
+    void
+    Append (const NameToDIE& other);
+
     void
     Finalize();
 
+    //------------------------------------------------------------------
+    // Sort the names inserted since the last call to Finalize() or
+    // FinalizeAppended() and merge them into the ones sorted then.
+    //------------------------------------------------------------------
+    void
+    FinalizeAppended();
+
+    void
+    Clear ()
+    {
+        m_map.Clear();
+        m_num_sorted = 0;
+    }
+
     size_t
     Find (const lldb_private::ConstString &name, 
           DIEArray &info_array) const;
@@ -59,6 +77,7 @@ public:
 
 protected:
     lldb_private::UniqueCStringMap<uint32_t> m_map;
+    size_t m_num_sorted; // The number of entries at the start of m_map that are sorted
 
 };
 
@@ -26,6 +26,7 @@
 
 #include "llvm/Support/Casting.h"
 
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/RegularExpression.h"
@@ -38,6 +39,8 @@
 
 #include "lldb/Host/Host.h"
 
+#include "lldb/Interpreter/OptionValueProperties.h"
+
 #include "lldb/Symbol/Block.h"
 #include "lldb/Symbol/ClangExternalASTSourceCallbacks.h"
 #include "lldb/Symbol/CompileUnit.h"
@@ -49,21 +52,29 @@
 #include "lldb/Target/ObjCLanguageRuntime.h"
 #include "lldb/Target/CPPLanguageRuntime.h"
 
+#include "lldb/Utility/TaskPool.h"
+
 #include "DWARFCompileUnit.h"
 #include "DWARFDebugAbbrev.h"
 #include "DWARFDebugAranges.h"
+#include "DWARFDebugCUIndex.h"
 #include "DWARFDebugInfo.h"
 #include "DWARFDebugInfoEntry.h"
 #include "DWARFDebugLine.h"
+#include "DWARFDebugNames.h"
 #include "DWARFDebugPubnames.h"
 #include "DWARFDebugRanges.h"
 #include "DWARFDeclContext.h"
 #include "DWARFDIECollection.h"
 #include "DWARFFormValue.h"
+#include "DWARFGdbIndex.h"
+#include "DWARFIndexCache.h"
 #include "DWARFLocationList.h"
 #include "LogChannelDWARF.h"
 #include "SymbolFileDWARFDebugMap.h"
+#include "SymbolFileDWARFDwo.h"
 
+#include <algorithm>
 #include <map>
 
 //#define ENABLE_DEBUG_PRINTF // COMMENT OUT THIS LINE PRIOR TO CHECKIN
@@ -190,13 +201,101 @@ protected:
 };
 #endif
 
+namespace {
+
+    PropertyDefinition
+    g_properties[] =
+    {
+        { "index-cache-path"        , OptionValue::eTypeFileSpec , true , 0   , NULL, NULL, "A directory in which the DWARF name indexes of modules are cached between debug sessions. Modules without a UUID are never cached. Leave empty to disable the cache." },
+        { "index-cache-max-size"    , OptionValue::eTypeUInt64   , true , 2048, NULL, NULL, "The maximum total size in megabytes of all files in the DWARF name index cache directory. The least recently written files are removed when the cache grows beyond this size. Zero means the cache size is unlimited." },
+        { "use-name-index-sections" , OptionValue::eTypeBoolean  , true , true, NULL, NULL, "If true, use the .debug_names or .gdb_index section of modules that have one to index only the compile units that contain the names being looked up. If false, all compile units are indexed the first time a name is looked up." },
+        {  NULL                     , OptionValue::eTypeInvalid  , false, 0   , NULL, NULL, NULL }
+    };
+
+    enum
+    {
+        ePropertyIndexCachePath,
+        ePropertyIndexCacheMaxSize,
+        ePropertyUseNameIndexSections
+    };
+
+    class PluginProperties : public Properties
+    {
+    public:
+        static ConstString
+        GetSettingName ()
+        {
+            return SymbolFileDWARF::GetPluginNameStatic();
+        }
+
+        PluginProperties() :
+            Properties ()
+        {
+            m_collection_sp.reset (new OptionValueProperties(GetSettingName()));
+            m_collection_sp->Initialize(g_properties);
+        }
+
+        virtual
+        ~PluginProperties()
+        {
+        }
+
+        FileSpec
+        GetIndexCachePath () const
+        {
+            const uint32_t idx = ePropertyIndexCachePath;
+            return m_collection_sp->GetPropertyAtIndexAsFileSpec (NULL, idx);
+        }
+
+        uint64_t
+        GetIndexCacheMaxByteSize () const
+        {
+            const uint32_t idx = ePropertyIndexCacheMaxSize;
+            return m_collection_sp->GetPropertyAtIndexAsUInt64 (NULL, idx, g_properties[idx].default_uint_value) * 1024 * 1024;
+        }
+
+        bool
+        GetUseNameIndexSections () const
+        {
+            const uint32_t idx = ePropertyUseNameIndexSections;
+            return m_collection_sp->GetPropertyAtIndexAsBoolean (NULL, idx, g_properties[idx].default_uint_value != 0);
+        }
+    };
+
+    typedef std::shared_ptr<PluginProperties> SymbolFileDWARFPropertiesSP;
+
+    static const SymbolFileDWARFPropertiesSP &
+    GetGlobalPluginProperties()
+    {
+        static SymbolFileDWARFPropertiesSP g_settings_sp;
+        if (!g_settings_sp)
+            g_settings_sp.reset (new PluginProperties ());
+        return g_settings_sp;
+    }
+
+} // anonymous namespace end
+
 void
 SymbolFileDWARF::Initialize()
 {
     LogChannelDWARF::Initialize();
     PluginManager::RegisterPlugin (GetPluginNameStatic(),
                                    GetPluginDescriptionStatic(),
-                                   CreateInstance);
+                                   CreateInstance,
+                                   DebuggerInitialize);
+}
+
+void
+SymbolFileDWARF::DebuggerInitialize (Debugger &debugger)
+{
+    if (!PluginManager::GetSettingForSymbolFilePlugin(debugger, PluginProperties::GetSettingName()))
+    {
+        const bool is_global_setting = true;
+        PluginManager::CreateSettingForSymbolFilePlugin (debugger,
+                                                         GetGlobalPluginProperties()->GetValueProperties(),
+                                                         ConstString ("Properties for the dwarf symbol-file plug-in."),
+                                                         is_global_setting);
+    }
 }
 
 void
@@ -314,6 +413,10 @@ SymbolFileDWARF::GetTypes (SymbolContextScope *sc_scope,
 
     if (comp_unit)
     {
+        SymbolFileDWARFDwo *dwo_symfile = GetDwoSymbolFileForCompileUnit (comp_unit);
+        if (dwo_symfile)
+            return dwo_symfile->GetTypes (sc_scope, type_mask, type_list);
+
         dwarf_cu = GetDWARFCompileUnit(comp_unit);
         if (dwarf_cu == 0)
             return 0;
@@ -344,6 +447,22 @@ SymbolFileDWARF::GetTypes (SymbolContextScope *sc_scope,
                 }
             }
         }
+
+        std::vector<SymbolFileDWARFDwo *> dwo_symfiles;
+        GetDwoSymbolFiles (NULL, false, dwo_symfiles);
+        for (size_t i = 0; i < dwo_symfiles.size(); ++i)
+        {
+            dwarf_cu = dwo_symfiles[i]->GetCompileUnit();
+            if (dwarf_cu)
+            {
+                dwo_symfiles[i]->GetTypes (dwarf_cu,
+                                           dwarf_cu->DIE(),
+                                           0,
+                                           UINT32_MAX,
+                                           type_mask,
+                                           type_set);
+            }
+        }
     }
 //    if (m_using_apple_tables)
 //    {
@@ -473,6 +592,8 @@ SymbolFileDWARF::SymbolFileDWARF(ObjectFile* objfile) :
     m_apple_types_ap (),
     m_apple_namespaces_ap (),
     m_apple_objc_ap (),
+    m_name_accelerator_ap (),
+    m_indexed_cus (),
     m_function_basename_index(),
     m_function_fullname_index(),
     m_function_method_index(),
@@ -482,10 +603,14 @@ SymbolFileDWARF::SymbolFileDWARF(ObjectFile* objfile) :
     m_type_index(),
     m_namespace_index(),
     m_indexed (false),
+    m_indexed_uncovered_cus (false),
     m_is_external_ast_source (false),
     m_using_apple_tables (false),
     m_supports_DW_AT_APPLE_objc_complete_type (eLazyBoolCalculate),
     m_ranges(),
+    m_dwp_obj_file_sp (),
+    m_dwp_cu_index_ap (),
+    m_dwp_looked_up (false),
     m_unique_ast_type_map ()
 {
 }
@@ -515,6 +640,111 @@ SymbolFileDWARF::GetUniqueDWARFASTTypeMap ()
     return m_unique_ast_type_map;
 }
 
+//----------------------------------------------------------------------
+// Drop the DIE arrays of the compile units that no cached type,
+// variable or decl context points into. They are extracted again the
+// next time one of their DIEs is looked up by offset. The caller must
+// hold the module mutex so that no lookup is holding on to a DIE
+// pointer while we do this.
+//----------------------------------------------------------------------
+size_t
+SymbolFileDWARF::ReleaseUnusedMemory ()
+{
+    DWARFDebugInfo* debug_info = DebugInfo();
+    if (debug_info == NULL)
+        return 0;
+
+    // The .dwo files of split DWARF compile units have their own DIEs
+    size_t bytes_released = 0;
+    std::vector<SymbolFileDWARFDwo *> dwo_symfiles;
+    GetDwoSymbolFiles (NULL, true, dwo_symfiles);
+    for (size_t i = 0; i < dwo_symfiles.size(); ++i)
+        bytes_released += dwo_symfiles[i]->ReleaseUnusedMemory ();
+
+    // Sort the compile units whose DIEs are extracted by the address of
+    // their DIE array so we can find the compile unit a DIE pointer
+    // points into.
+    typedef std::pair<const DWARFDebugInfoEntry *, uint32_t> DIEArrayAndCUIndex;
+    std::vector<DIEArrayAndCUIndex> die_arrays;
+    const uint32_t num_compile_units = debug_info->GetNumCompileUnits();
+    for (uint32_t cu_idx = 0; cu_idx < num_compile_units; ++cu_idx)
+    {
+        DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
+        if (dwarf_cu->HasDIEsParsed())
+            die_arrays.push_back (DIEArrayAndCUIndex (dwarf_cu->GetDIEAtIndexUnchecked(0), cu_idx));
+    }
+    if (die_arrays.empty())
+        return bytes_released;
+    std::sort (die_arrays.begin(), die_arrays.end());
+
+    std::vector<const DWARFDebugInfoEntry *> used_dies;
+    for (DIEToTypePtr::const_iterator pos = m_die_to_type.begin(); pos != m_die_to_type.end(); ++pos)
+        used_dies.push_back (pos->first);
+    for (DIEToVariableSP::const_iterator pos = m_die_to_variable_sp.begin(); pos != m_die_to_variable_sp.end(); ++pos)
+        used_dies.push_back (pos->first);
+    for (DIEToDeclContextMap::const_iterator pos = m_die_to_decl_ctx.begin(); pos != m_die_to_decl_ctx.end(); ++pos)
+        used_dies.push_back (pos->first);
+    for (DeclContextToDIEMap::const_iterator pos = m_decl_ctx_to_die.begin(); pos != m_decl_ctx_to_die.end(); ++pos)
+        used_dies.insert (used_dies.end(), pos->second.begin(), pos->second.end());
+    for (DIEToClangType::const_iterator pos = m_forward_decl_die_to_clang_type.begin(); pos != m_forward_decl_die_to_clang_type.end(); ++pos)
+        used_dies.push_back (pos->first);
+    for (ClangTypeToDIE::const_iterator pos = m_forward_decl_clang_type_to_die.begin(); pos != m_forward_decl_clang_type_to_die.end(); ++pos)
+        used_dies.push_back (pos->second);
+    GetUniqueDWARFASTTypeMap().AppendDIEs (this, used_dies);
+
+    std::vector<bool> cu_in_use (num_compile_units, false);
+    std::vector<const DWARFDebugInfoEntry *>::const_iterator die_pos, die_end = used_dies.end();
+    for (die_pos = used_dies.begin(); die_pos != die_end; ++die_pos)
+    {
+        std::vector<DIEArrayAndCUIndex>::const_iterator pos = std::upper_bound (die_arrays.begin(),
+                                                                                 die_arrays.end(),
+                                                                                 DIEArrayAndCUIndex (*die_pos, UINT32_MAX));
+        if (pos == die_arrays.begin())
+            continue;
+        --pos;
+        if (debug_info->GetCompileUnitAtIndex(pos->second)->ContainsDIEPtr (*die_pos))
+            cu_in_use[pos->second] = true;
+    }
+
+    uint32_t num_cleared = 0;
+    std::vector<DIEArrayAndCUIndex>::const_iterator pos, end = die_arrays.end();
+    for (pos = die_arrays.begin(); pos != end; ++pos)
+    {
+        if (cu_in_use[pos->second])
+            continue;
+        DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(pos->second);
+        bytes_released += dwarf_cu->GetDIEArrayMemorySize();
+        dwarf_cu->ClearDIEs (true);
+        ++num_cleared;
+    }
+
+    Log *log (LogChannelDWARF::GetLogIfAll (DWARF_LOG_DEBUG_INFO));
+    if (log)
+    {
+        GetObjectFile()->GetModule()->LogMessage (log,
+                                                  "SymbolFileDWARF::ReleaseUnusedMemory () cleared the DIEs of %u of %u compile units, %" PRIu64 " bytes",
+                                                  num_cleared,
+                                                  (uint32_t)die_arrays.size(),
+                                                  (uint64_t)bytes_released);
+    }
+    return bytes_released;
+}
+
+//----------------------------------------------------------------------
+// ReleaseUnusedMemory() clears DIE arrays while it holds the module
+// mutex. Lookups that come through the SymbolVendor already hold it,
+// but clang's external AST source callbacks and lldb_private::Type call
+// straight into this plug-in, so those entry points lock it with this
+// before they touch any DIEs.
+//----------------------------------------------------------------------
+void
+SymbolFileDWARF::LockModuleMutex (Mutex::Locker &locker)
+{
+    ModuleSP module_sp (m_obj_file->GetModule());
+    if (module_sp)
+        locker.Lock (module_sp->GetMutex());
+}
+
 ClangASTContext &       
 SymbolFileDWARF::GetClangASTContext ()
 {
@@ -590,6 +820,31 @@ SymbolFileDWARF::InitializeObject()
         else
             m_apple_objc_ap.reset();
     }
+
+    // The Apple tables are complete and replace the indexes we build.
+    // Without them, .debug_names or .gdb_index can still tell us which
+    // compile units need to be indexed to find a name.
+    if (!m_using_apple_tables && GetGlobalPluginProperties()->GetUseNameIndexSections())
+    {
+        get_debug_names_data();
+        if (m_data_debug_names.GetByteSize() > 0)
+        {
+            m_name_accelerator_ap.reset (new DWARFDebugNames (m_data_debug_names, get_debug_str_data()));
+            if (!m_name_accelerator_ap->IsValid())
+                m_name_accelerator_ap.reset();
+        }
+
+        if (!m_name_accelerator_ap.get())
+        {
+            get_gdb_index_data();
+            if (m_data_gdb_index.GetByteSize() > 0)
+            {
+                m_name_accelerator_ap.reset (new DWARFGdbIndex (m_data_gdb_index));
+                if (!m_name_accelerator_ap->IsValid())
+                    m_name_accelerator_ap.reset();
+            }
+        }
+    }
 }
 
 bool
@@ -704,28 +959,34 @@ SymbolFileDWARF::GetCachedSectionData (uint32_t got_flag, SectionType sect_type,
 {
     if (m_flags.IsClear (got_flag))
     {
-        ModuleSP module_sp (m_obj_file->GetModule());
         m_flags.Set (got_flag);
-        const SectionList *section_list = module_sp->GetSectionList();
-        if (section_list)
+        LoadSectionData (sect_type, data);
+    }
+    return data;
+}
+
+void
+SymbolFileDWARF::LoadSectionData (SectionType sect_type, DWARFDataExtractor &data)
+{
+    ModuleSP module_sp (m_obj_file->GetModule());
+    const SectionList *section_list = module_sp->GetSectionList();
+    if (section_list)
+    {
+        SectionSP section_sp (section_list->FindSectionByType(sect_type, true));
+        if (section_sp)
         {
-            SectionSP section_sp (section_list->FindSectionByType(sect_type, true));
-            if (section_sp)
+            // See if we memory mapped the DWARF segment?
+            if (m_dwarf_data.GetByteSize())
             {
-                // See if we memory mapped the DWARF segment?
-                if (m_dwarf_data.GetByteSize())
-                {
-                    data.SetData(m_dwarf_data, section_sp->GetOffset (), section_sp->GetFileSize());
-                }
-                else
-                {
-                    if (m_obj_file->ReadSectionData (section_sp.get(), data) == 0)
-                        data.Clear();
-                }
+                data.SetData(m_dwarf_data, section_sp->GetOffset (), section_sp->GetFileSize());
+            }
+            else
+            {
+                if (m_obj_file->ReadSectionData (section_sp.get(), data) == 0)
+                    data.Clear();
             }
         }
     }
-    return data;
 }
 
 const DWARFDataExtractor&
@@ -800,6 +1061,30 @@ SymbolFileDWARF::get_apple_objc_data()
     return GetCachedSectionData (flagsGotAppleObjCData, eSectionTypeDWARFAppleObjC, m_data_apple_objc);
 }
 
+const DWARFDataExtractor&
+SymbolFileDWARF::get_debug_names_data()
+{
+    return GetCachedSectionData (flagsGotDebugNamesData, eSectionTypeDWARFDebugNames, m_data_debug_names);
+}
+
+const DWARFDataExtractor&
+SymbolFileDWARF::get_gdb_index_data()
+{
+    return GetCachedSectionData (flagsGotGdbIndexData, eSectionTypeDWARFGdbIndex, m_data_gdb_index);
+}
+
+const DWARFDataExtractor&
+SymbolFileDWARF::get_debug_addr_data()
+{
+    return GetCachedSectionData (flagsGotDebugAddrData, eSectionTypeDWARFDebugAddr, m_data_debug_addr);
+}
+
+const DWARFDataExtractor&
+SymbolFileDWARF::get_debug_str_offsets_data()
+{
+    return GetCachedSectionData (flagsGotDebugStrOffsetsData, eSectionTypeDWARFDebugStrOffsets, m_data_debug_str_offsets);
+}
+
 
 DWARFDebugAbbrev*
 SymbolFileDWARF::DebugAbbrev()
@@ -874,6 +1159,264 @@ SymbolFileDWARF::GetDWARFCompileUnit(lldb_private::CompileUnit *comp_unit)
     return NULL;
 }
 
+//----------------------------------------------------------------------
+// Split DWARF (-gsplit-dwarf)
+//
+// The compile units in the executable are only skeletons that say
+// where the DIEs are: in a .dwo file named by DW_AT_GNU_dwo_name, or in
+// a .dwp package next to the executable that contains the .dwo files of
+// many compile units. Each .dwo file gets its own SymbolFileDWARFDwo,
+// which is created the first time the DIEs of its compile unit are
+// needed. Its user ID is the index of the skeleton compile unit plus
+// one in the high 32 bits, like the .o files of a debug map.
+//----------------------------------------------------------------------
+SymbolFileDWARFDwo *
+SymbolFileDWARF::CreateDwoSymbolFile (DWARFCompileUnit *skeleton_cu,
+                                      const DWARFDebugInfoEntry *cu_die)
+{
+    ModuleSP module_sp (m_obj_file->GetModule());
+    DWARFDebugInfo* debug_info = DebugInfo();
+    if (!module_sp || debug_info == NULL)
+        return NULL;
+
+    uint32_t cu_idx = DW_INVALID_INDEX;
+    debug_info->GetCompileUnit (skeleton_cu->GetOffset(), &cu_idx);
+    if (cu_idx == DW_INVALID_INDEX)
+        return NULL;
+
+    const char *dwo_name = cu_die->GetAttributeValueAsString (this, skeleton_cu, DW_AT_GNU_dwo_name, NULL);
+    FileSpec dwo_file;
+    ObjectFileSP dwo_obj_file_sp;
+    const DWARFDebugCUIndex *dwp_cu_index = GetDwpCompileUnitIndex();
+    uint32_t dwp_row = 0;
+    if (dwp_cu_index)
+    {
+        dwp_row = dwp_cu_index->FindRow (skeleton_cu->GetDwoId());
+        if (dwp_row)
+        {
+            dwo_obj_file_sp = m_dwp_obj_file_sp;
+            dwo_file = m_dwp_obj_file_sp->GetFileSpec();
+        }
+        else
+            dwp_cu_index = NULL;
+    }
+
+    if (!dwo_obj_file_sp && dwo_name && dwo_name[0])
+    {
+        // Relative .dwo paths are relative to the compilation directory
+        std::string dwo_path (dwo_name);
+        const char *comp_dir = cu_die->GetAttributeValueAsString (this, skeleton_cu, DW_AT_comp_dir, NULL);
+        if (dwo_name[0] != '/' && comp_dir && comp_dir[0])
+        {
+            dwo_path = comp_dir;
+            if (*dwo_path.rbegin() != '/')
+                dwo_path += '/';
+            dwo_path += dwo_name;
+        }
+        std::string remapped_path;
+        if (module_sp->RemapSourceFile (dwo_path.c_str(), remapped_path))
+            dwo_path.swap (remapped_path);
+        dwo_file.SetFile (dwo_path.c_str(), false);
+
+        // The build directory may be gone, try next to the executable
+        if (!dwo_file.Exists())
+        {
+            FileSpec exe_relative_file (m_obj_file->GetFileSpec().CopyByRemovingLastPathComponent());
+            exe_relative_file.AppendPathComponent (FileSpec (dwo_name, false).GetFilename().GetCString());
+            if (exe_relative_file.Exists())
+                dwo_file = exe_relative_file;
+        }
+
+        if (dwo_file.Exists())
+        {
+            DataBufferSP data_sp;
+            lldb::offset_t data_offset = 0;
+            dwo_obj_file_sp = ObjectFile::FindPlugin (module_sp,
+                                                      &dwo_file,
+                                                      0,
+                                                      dwo_file.GetByteSize(),
+                                                      data_sp,
+                                                      data_offset);
+        }
+    }
+
+    if (!dwo_obj_file_sp)
+    {
+        module_sp->ReportWarning ("unable to find the split DWARF file '%s' for the compile unit at 0x%8.8x, no debug information is available for it",
+                                  dwo_name ? dwo_name : "<unknown>",
+                                  skeleton_cu->GetOffset());
+        return NULL;
+    }
+
+    Log *log (LogChannelDWARF::GetLogIfAll (DWARF_LOG_DEBUG_INFO));
+    if (log)
+    {
+        module_sp->LogMessage (log,
+                               "SymbolFileDWARF::CreateDwoSymbolFile () loading '%s' for the compile unit at 0x%8.8x (dwo_id = 0x%16.16" PRIx64 ")",
+                               dwo_file.GetPath().c_str(),
+                               skeleton_cu->GetOffset(),
+                               skeleton_cu->GetDwoId());
+    }
+
+    SymbolFileDWARFDwo *dwo_symfile = new SymbolFileDWARFDwo (dwo_obj_file_sp, skeleton_cu, dwp_cu_index, dwp_row);
+    dwo_symfile->SetID (((lldb::user_id_t)(cu_idx + 1)) << 32);
+    return dwo_symfile;
+}
+
+//----------------------------------------------------------------------
+// Open the .dwp package next to the executable the first time a .dwo
+// file is needed.
+//----------------------------------------------------------------------
+DWARFDebugCUIndex *
+SymbolFileDWARF::GetDwpCompileUnitIndex ()
+{
+    if (m_dwp_looked_up)
+        return m_dwp_cu_index_ap.get();
+    m_dwp_looked_up = true;
+
+    ModuleSP module_sp (m_obj_file->GetModule());
+    if (!module_sp)
+        return NULL;
+
+    std::string dwp_path (m_obj_file->GetFileSpec().GetPath());
+    dwp_path += ".dwp";
+    FileSpec dwp_file (dwp_path.c_str(), false);
+    if (!dwp_file.Exists())
+        return NULL;
+
+    DataBufferSP data_sp;
+    lldb::offset_t data_offset = 0;
+    ObjectFileSP dwp_obj_file_sp (ObjectFile::FindPlugin (module_sp,
+                                                          &dwp_file,
+                                                          0,
+                                                          dwp_file.GetByteSize(),
+                                                          data_sp,
+                                                          data_offset));
+    if (!dwp_obj_file_sp)
+        return NULL;
+
+    const SectionList *section_list = dwp_obj_file_sp->GetSectionList (false);
+    SectionSP section_sp;
+    if (section_list)
+        section_sp = section_list->FindSectionByType (eSectionTypeDWARFDebugCUIndex, true);
+    DataExtractor cu_index_data;
+    if (!section_sp || dwp_obj_file_sp->ReadSectionData (section_sp.get(), cu_index_data) == 0)
+    {
+        module_sp->ReportWarning ("'%s' has no .debug_cu_index section, ignoring it", dwp_path.c_str());
+        return NULL;
+    }
+
+    m_dwp_cu_index_ap.reset (new DWARFDebugCUIndex (cu_index_data));
+    if (!m_dwp_cu_index_ap->IsValid())
+    {
+        module_sp->ReportWarning ("'%s' has an unsupported .debug_cu_index section, ignoring it", dwp_path.c_str());
+        m_dwp_cu_index_ap.reset();
+        return NULL;
+    }
+    m_dwp_obj_file_sp = dwp_obj_file_sp;
+    return m_dwp_cu_index_ap.get();
+}
+
+SymbolFileDWARFDwo *
+SymbolFileDWARF::GetDwoSymbolFileForCompileUnit (CompileUnit *comp_unit)
+{
+    if (GetDebugMapSymfile () || comp_unit == NULL)
+        return NULL;
+    DWARFCompileUnit *dwarf_cu = GetDWARFCompileUnit (comp_unit);
+    if (dwarf_cu)
+        return dwarf_cu->GetDwoSymbolFile();
+    return NULL;
+}
+
+SymbolFileDWARFDwo *
+SymbolFileDWARF::GetDwoSymbolFileForUserID (lldb::user_id_t uid)
+{
+    // Only the symbol file of the executable hands out .dwo user IDs
+    const uint32_t dwo_idx = (uint32_t)(uid >> 32);
+    if (dwo_idx == 0 || GetID() != 0 || GetDebugMapSymfile ())
+        return NULL;
+    DWARFDebugInfo* debug_info = DebugInfo();
+    if (debug_info && dwo_idx <= debug_info->GetNumCompileUnits())
+        return debug_info->GetCompileUnitAtIndex (dwo_idx - 1)->GetDwoSymbolFile();
+    return NULL;
+}
+
+//----------------------------------------------------------------------
+// Get the .dwo symbol files that may contain DIEs named \a name, or all
+// of them if \a name is NULL. When \a loaded_only is true only the .dwo
+// files that are already open are returned. Otherwise the accelerator
+// tables of the executable are used to open as few of them as possible.
+// Like SymbolFileDWARF::IndexForName(), only pass a name for types,
+// namespaces and global variables, which those tables list completely.
+//----------------------------------------------------------------------
+void
+SymbolFileDWARF::GetDwoSymbolFiles (const ConstString *name,
+                                    bool loaded_only,
+                                    std::vector<SymbolFileDWARFDwo *> &dwo_symfiles)
+{
+    if (GetSkeletonCompileUnit() || GetDebugMapSymfile ())
+        return;
+    DWARFDebugInfo* debug_info = DebugInfo();
+    if (debug_info == NULL)
+        return;
+
+    const uint32_t num_compile_units = GetNumCompileUnits();
+    if (loaded_only)
+    {
+        for (uint32_t cu_idx = 0; cu_idx < num_compile_units; ++cu_idx)
+        {
+            SymbolFileDWARFDwo *dwo_symfile = debug_info->GetCompileUnitAtIndex(cu_idx)->GetLoadedDwoSymbolFile();
+            if (dwo_symfile)
+                dwo_symfiles.push_back (dwo_symfile);
+        }
+        return;
+    }
+
+    ConstString lookup_name;
+    std::vector<dw_offset_t> cu_offsets;
+    if (name && m_name_accelerator_ap.get() &&
+        DWARFAcceleratorTable::GetLookupName (name->GetCString(), lookup_name) &&
+        m_name_accelerator_ap->FindCompileUnitOffsets (lookup_name, cu_offsets) &&
+        !cu_offsets.empty())
+    {
+        // Compile units that the table doesn't know about can contain
+        // any name
+        std::vector<dw_offset_t> covered_cu_offsets;
+        m_name_accelerator_ap->GetCompileUnitOffsets (covered_cu_offsets);
+        std::sort (covered_cu_offsets.begin(), covered_cu_offsets.end());
+        for (uint32_t cu_idx = 0; cu_idx < num_compile_units; ++cu_idx)
+        {
+            const dw_offset_t cu_offset = debug_info->GetCompileUnitAtIndex(cu_idx)->GetOffset();
+            if (!std::binary_search (covered_cu_offsets.begin(), covered_cu_offsets.end(), cu_offset))
+                cu_offsets.push_back (cu_offset);
+        }
+        std::sort (cu_offsets.begin(), cu_offsets.end());
+        cu_offsets.erase (std::unique (cu_offsets.begin(), cu_offsets.end()), cu_offsets.end());
+        for (size_t i = 0; i < cu_offsets.size(); ++i)
+        {
+            DWARFCompileUnit *dwarf_cu = debug_info->GetCompileUnit (cu_offsets[i]).get();
+            if (dwarf_cu && dwarf_cu->IsSkeleton())
+            {
+                SymbolFileDWARFDwo *dwo_symfile = dwarf_cu->GetDwoSymbolFile();
+                if (dwo_symfile)
+                    dwo_symfiles.push_back (dwo_symfile);
+            }
+        }
+        return;
+    }
+
+    for (uint32_t cu_idx = 0; cu_idx < num_compile_units; ++cu_idx)
+    {
+        DWARFCompileUnit *dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
+        if (dwarf_cu->IsSkeleton())
+        {
+            SymbolFileDWARFDwo *dwo_symfile = dwarf_cu->GetDwoSymbolFile();
+            if (dwo_symfile)
+                dwo_symfiles.push_back (dwo_symfile);
+        }
+    }
+}
+
 
 DWARFDebugRanges*
 SymbolFileDWARF::DebugRanges()
@@ -929,6 +1472,22 @@ SymbolFileDWARF::ParseCompileUnit (DWARFCompileUnit* dwarf_cu, uint32_t cu_idx)
                         const char * cu_die_name = cu_die->GetName(this, dwarf_cu);
                         const char * cu_comp_dir = cu_die->GetAttributeValueAsString(this, dwarf_cu, DW_AT_comp_dir, NULL);
                         LanguageType cu_language = (LanguageType)cu_die->GetAttributeValueAsUnsigned(this, dwarf_cu, DW_AT_language, 0);
+                        if (cu_die_name == NULL || cu_language == eLanguageTypeUnknown)
+                        {
+                            // Skeleton compile units usually leave the name
+                            // and language to the compile unit in the .dwo
+                            // file. This only reads its compile unit DIE.
+                            SymbolFileDWARFDwo *dwo_symfile = dwarf_cu->GetDwoSymbolFile();
+                            DWARFCompileUnit *dwo_cu = dwo_symfile ? dwo_symfile->GetCompileUnit() : NULL;
+                            const DWARFDebugInfoEntry *dwo_cu_die = dwo_cu ? dwo_cu->GetCompileUnitDIEOnly() : NULL;
+                            if (dwo_cu_die)
+                            {
+                                if (cu_die_name == NULL)
+                                    cu_die_name = dwo_cu_die->GetName(dwo_symfile, dwo_cu);
+                                if (cu_language == eLanguageTypeUnknown)
+                                    cu_language = (LanguageType)dwo_cu_die->GetAttributeValueAsUnsigned(dwo_symfile, dwo_cu, DW_AT_language, 0);
+                            }
+                        }
                         if (cu_die_name)
                         {
                             std::string ramapped_file;
@@ -1131,6 +1690,9 @@ SymbolFileDWARF::ParseCompileUnitLanguage (const SymbolContext& sc)
             if (language)
                 return (lldb::LanguageType)language;
         }
+        SymbolFileDWARFDwo *dwo_symfile = dwarf_cu->GetDwoSymbolFile();
+        if (dwo_symfile)
+            return dwo_symfile->ParseCompileUnitLanguage (sc);
     }
     return eLanguageTypeUnknown;
 }
@@ -1139,6 +1701,10 @@ size_t
 SymbolFileDWARF::ParseCompileUnitFunctions(const SymbolContext &sc)
 {
     assert (sc.comp_unit);
+    SymbolFileDWARFDwo *dwo_symfile = GetDwoSymbolFileForCompileUnit (sc.comp_unit);
+    if (dwo_symfile)
+        return dwo_symfile->ParseCompileUnitFunctions (sc);
+
     size_t functions_added = 0;
     DWARFCompileUnit* dwarf_cu = GetDWARFCompileUnit(sc.comp_unit);
     if (dwarf_cu)
@@ -1184,6 +1750,32 @@ SymbolFileDWARF::ParseCompileUnitSupportFiles (const SymbolContext& sc, FileSpec
     return false;
 }
 
+bool
+SymbolFileDWARF::GetCompileUnitSourceFileBasenames (uint32_t cu_idx, std::vector<ConstString> &basenames)
+{
+    DWARFDebugInfo* info = DebugInfo();
+    if (info == NULL)
+        return false;
+
+    DWARFCompileUnit* dwarf_cu = info->GetCompileUnitAtIndex(cu_idx);
+    if (dwarf_cu == NULL)
+        return false;
+
+    const DWARFDebugInfoEntry * cu_die = dwarf_cu->GetCompileUnitDIEOnly();
+    if (cu_die == NULL)
+        return false;
+
+    const char * cu_name = cu_die->GetAttributeValueAsString(this, dwarf_cu, DW_AT_name, NULL);
+    if (cu_name && cu_name[0])
+        basenames.push_back (FileSpec (cu_name, false).GetFilename());
+
+    // A compile unit without a line table has no other files
+    dw_offset_t stmt_list = cu_die->GetAttributeValueAsUnsigned(this, dwarf_cu, DW_AT_stmt_list, DW_INVALID_OFFSET);
+    if (stmt_list == DW_INVALID_OFFSET)
+        return true;
+    return DWARFDebugLine::ParseSupportFileBasenames (get_debug_line_data(), stmt_list, basenames);
+}
+
 struct ParseDWARFLineTableCallbackInfo
 {
     LineTable* line_table;
@@ -2259,6 +2851,12 @@ SymbolFileDWARF::ParseChildMembers
 clang::DeclContext*
 SymbolFileDWARF::GetClangDeclContextContainingTypeUID (lldb::user_id_t type_uid)
 {
+    Mutex::Locker locker;
+    LockModuleMutex (locker);
+    SymbolFileDWARFDwo *dwo_symfile = GetDwoSymbolFileForUserID (type_uid);
+    if (dwo_symfile)
+        return dwo_symfile->GetClangDeclContextContainingTypeUID (type_uid);
+
     DWARFDebugInfo* debug_info = DebugInfo();
     if (debug_info && UserIDMatches(type_uid))
     {
@@ -2273,6 +2871,12 @@ SymbolFileDWARF::GetClangDeclContextContainingTypeUID (lldb::user_id_t type_uid)
 clang::DeclContext*
 SymbolFileDWARF::GetClangDeclContextForTypeUID (const lldb_private::SymbolContext &sc, lldb::user_id_t type_uid)
 {
+    Mutex::Locker locker;
+    LockModuleMutex (locker);
+    SymbolFileDWARFDwo *dwo_symfile = GetDwoSymbolFileForUserID (type_uid);
+    if (dwo_symfile)
+        return dwo_symfile->GetClangDeclContextForTypeUID (sc, type_uid);
+
     if (UserIDMatches(type_uid))
         return GetClangDeclContextForDIEOffset (sc, type_uid);
     return NULL;
@@ -2281,6 +2885,12 @@ SymbolFileDWARF::GetClangDeclContextForTypeUID (const lldb_private::SymbolContex
 Type*
 SymbolFileDWARF::ResolveTypeUID (lldb::user_id_t type_uid)
 {
+    Mutex::Locker locker;
+    LockModuleMutex (locker);
+    SymbolFileDWARFDwo *dwo_symfile = GetDwoSymbolFileForUserID (type_uid);
+    if (dwo_symfile)
+        return dwo_symfile->ResolveTypeUID (type_uid);
+
     if (UserIDMatches(type_uid))
     {
         DWARFDebugInfo* debug_info = DebugInfo();
@@ -2369,11 +2979,25 @@ SymbolFileDWARF::HasForwardDeclForClangType (const ClangASTType &clang_type)
 bool
 SymbolFileDWARF::ResolveClangOpaqueTypeDefinition (ClangASTType &clang_type)
 {
+    // Clang's external AST source and lldb_private::Type get here
+    // without going through the SymbolVendor
+    Mutex::Locker locker;
+    LockModuleMutex (locker);
     // We have a struct/union/class/enum that needs to be fully resolved.
     ClangASTType clang_type_no_qualifiers = clang_type.RemoveFastQualifiers();
     const DWARFDebugInfoEntry* die = m_forward_decl_clang_type_to_die.lookup (clang_type_no_qualifiers.GetOpaqueQualType());
     if (die == NULL)
     {
+        // Types from .dwo files share our clang AST, so the external AST
+        // source asks us to complete them
+        std::vector<SymbolFileDWARFDwo *> dwo_symfiles;
+        GetDwoSymbolFiles (NULL, true, dwo_symfiles);
+        for (size_t i = 0; i < dwo_symfiles.size(); ++i)
+        {
+            if (dwo_symfiles[i]->HasForwardDeclForClangType (clang_type))
+                return dwo_symfiles[i]->ResolveClangOpaqueTypeDefinition (clang_type);
+        }
+
         // We have already resolved this type...
         return true;
     }
@@ -2779,22 +3403,33 @@ SymbolFileDWARF::ResolveSymbolContext (const Address& so_addr, uint32_t resolve_
                         bool force_check_line_table = false;
                         if (resolve_scope & (eSymbolContextFunction | eSymbolContextBlock))
                         {
+                            // The function and block DIEs of a skeleton compile
+                            // unit are in its .dwo file
+                            SymbolFileDWARF *die_symfile = this;
+                            DWARFCompileUnit *die_cu = dwarf_cu;
+                            SymbolFileDWARFDwo *dwo_symfile = dwarf_cu->GetDwoSymbolFile();
+                            if (dwo_symfile && dwo_symfile->GetCompileUnit())
+                            {
+                                die_symfile = dwo_symfile;
+                                die_cu = dwo_symfile->GetCompileUnit();
+                            }
+
                             DWARFDebugInfoEntry *function_die = NULL;
                             DWARFDebugInfoEntry *block_die = NULL;
                             if (resolve_scope & eSymbolContextBlock)
                             {
-                                dwarf_cu->LookupAddress(file_vm_addr, &function_die, &block_die);
+                                die_cu->LookupAddress(file_vm_addr, &function_die, &block_die);
                             }
                             else
                             {
-                                dwarf_cu->LookupAddress(file_vm_addr, &function_die, NULL);
+                                die_cu->LookupAddress(file_vm_addr, &function_die, NULL);
                             }
 
                             if (function_die != NULL)
                             {
-                                sc.function = sc.comp_unit->FindFunctionByUID (MakeUserID(function_die->GetOffset())).get();
+                                sc.function = sc.comp_unit->FindFunctionByUID (die_symfile->MakeUserID(function_die->GetOffset())).get();
                                 if (sc.function == NULL)
-                                    sc.function = ParseCompileUnitFunction(sc, dwarf_cu, function_die);
+                                    sc.function = die_symfile->ParseCompileUnitFunction(sc, die_cu, function_die);
                             }
                             else
                             {
@@ -2816,9 +3451,9 @@ SymbolFileDWARF::ResolveSymbolContext (const Address& so_addr, uint32_t resolve_
                                     Block& block = sc.function->GetBlock (true);
 
                                     if (block_die != NULL)
-                                        sc.block = block.FindBlockByID (MakeUserID(block_die->GetOffset()));
+                                        sc.block = block.FindBlockByID (die_symfile->MakeUserID(block_die->GetOffset()));
                                     else
-                                        sc.block = block.FindBlockByID (MakeUserID(function_die->GetOffset()));
+                                        sc.block = block.FindBlockByID (die_symfile->MakeUserID(function_die->GetOffset()));
                                     if (sc.block)
                                         resolved |= eSymbolContextBlock;
                                 }
@@ -2920,6 +3555,20 @@ SymbolFileDWARF::ResolveSymbolContext(const FileSpec& file_spec, uint32_t line,
 
                                 if (file_idx != UINT32_MAX)
                                 {
+                                    // The function and block DIEs of a skeleton
+                                    // compile unit are in its .dwo file
+                                    SymbolFileDWARF *die_symfile = this;
+                                    DWARFCompileUnit *die_cu = dwarf_cu;
+                                    if (resolve_scope & (eSymbolContextFunction | eSymbolContextBlock))
+                                    {
+                                        SymbolFileDWARFDwo *dwo_symfile = dwarf_cu->GetDwoSymbolFile();
+                                        if (dwo_symfile && dwo_symfile->GetCompileUnit())
+                                        {
+                                            die_symfile = dwo_symfile;
+                                            die_cu = dwo_symfile->GetCompileUnit();
+                                        }
+                                    }
+
                                     uint32_t found_line;
                                     uint32_t line_idx = line_table->FindLineEntryIndexByFileIndex (0, file_idx, line, false, &sc.line_entry);
                                     found_line = sc.line_entry.line;
@@ -2935,13 +3584,13 @@ SymbolFileDWARF::ResolveSymbolContext(const FileSpec& file_spec, uint32_t line,
                                             {
                                                 DWARFDebugInfoEntry *function_die = NULL;
                                                 DWARFDebugInfoEntry *block_die = NULL;
-                                                dwarf_cu->LookupAddress(file_vm_addr, &function_die, resolve_scope & eSymbolContextBlock ? &block_die : NULL);
+                                                die_cu->LookupAddress(file_vm_addr, &function_die, resolve_scope & eSymbolContextBlock ? &block_die : NULL);
 
                                                 if (function_die != NULL)
                                                 {
-                                                    sc.function = sc.comp_unit->FindFunctionByUID (MakeUserID(function_die->GetOffset())).get();
+                                                    sc.function = sc.comp_unit->FindFunctionByUID (die_symfile->MakeUserID(function_die->GetOffset())).get();
                                                     if (sc.function == NULL)
-                                                        sc.function = ParseCompileUnitFunction(sc, dwarf_cu, function_die);
+                                                        sc.function = die_symfile->ParseCompileUnitFunction(sc, die_cu, function_die);
                                                 }
 
                                                 if (sc.function != NULL)
@@ -2949,9 +3598,9 @@ SymbolFileDWARF::ResolveSymbolContext(const FileSpec& file_spec, uint32_t line,
                                                     Block& block = sc.function->GetBlock (true);
 
                                                     if (block_die != NULL)
-                                                        sc.block = block.FindBlockByID (MakeUserID(block_die->GetOffset()));
+                                                        sc.block = block.FindBlockByID (die_symfile->MakeUserID(block_die->GetOffset()));
                                                     else
-                                                        sc.block = block.FindBlockByID (MakeUserID(function_die->GetOffset()));
+                                                        sc.block = block.FindBlockByID (die_symfile->MakeUserID(function_die->GetOffset()));
                                                 }
                                             }
                                         }
@@ -2995,41 +3644,136 @@ SymbolFileDWARF::Index ()
                         "SymbolFileDWARF::Index (%s)",
                         GetObjectFile()->GetFileSpec().GetFilename().AsCString());
 
+    NameToDIE *indexes[] =
+    {
+        &m_function_basename_index,
+        &m_function_fullname_index,
+        &m_function_method_index,
+        &m_function_selector_index,
+        &m_objc_class_selectors_index,
+        &m_global_index,
+        &m_type_index,
+        &m_namespace_index
+    };
+    const uint32_t num_indexes = sizeof(indexes)/sizeof(indexes[0]);
+
+    // Start over if some compile units were already indexed to look up
+    // names found in .debug_names or .gdb_index.
+    if (!m_indexed_cus.empty())
+    {
+        for (uint32_t i = 0; i < num_indexes; ++i)
+            indexes[i]->Clear();
+        m_indexed_cus.clear();
+    }
+
+    // The cache is keyed on the UUID of the object file, which all the
+    // compile units in a .dwp package share
+    FileSpec index_cache_path;
+    if (GetSkeletonCompileUnit() == NULL)
+        index_cache_path = GetGlobalPluginProperties()->GetIndexCachePath();
+    if (index_cache_path)
+    {
+        if (DWARFIndexCache::Load (index_cache_path, *GetObjectFile(), indexes, num_indexes))
+            return;
+    }
+
     DWARFDebugInfo* debug_info = DebugInfo();
     if (debug_info)
     {
-        uint32_t cu_idx = 0;
         const uint32_t num_compile_units = GetNumCompileUnits();
-        for (cu_idx = 0; cu_idx < num_compile_units; ++cu_idx)
+
+        // The compile units are indexed on multiple threads below. Make sure
+        // everything that is lazily created and shared between compile units
+        // exists before any worker threads get started.
+        get_debug_info_data();
+        get_debug_str_data();
+        DebugAbbrev();
+
+        // Extract the DIEs for all compile units first. Indexing a compile
+        // unit can follow a DW_AT_specification into another compile unit,
+        // so all DIEs must be in place before indexing starts.
+        std::vector<uint8_t> clear_cu_dies (num_compile_units, false);
+        TaskPool::MapOverIndexes (0, num_compile_units, [debug_info, &clear_cu_dies](uint32_t cu_idx)
         {
             DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
+            if (dwarf_cu && dwarf_cu->ExtractDIEsIfNeeded (false) > 1)
+                clear_cu_dies[cu_idx] = true;
+        });
+
+        // Index each compile unit into its own set of maps so no locking is
+        // needed while indexing.
+        std::vector<NameToDIE> function_basename_index (num_compile_units);
+        std::vector<NameToDIE> function_fullname_index (num_compile_units);
+        std::vector<NameToDIE> function_method_index (num_compile_units);
+        std::vector<NameToDIE> function_selector_index (num_compile_units);
+        std::vector<NameToDIE> objc_class_selectors_index (num_compile_units);
+        std::vector<NameToDIE> global_index (num_compile_units);
+        std::vector<NameToDIE> type_index (num_compile_units);
+        std::vector<NameToDIE> namespace_index (num_compile_units);
+
+        TaskPool::MapOverIndexes (0, num_compile_units, [&](uint32_t cu_idx)
+        {
+            DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
+            if (dwarf_cu)
+            {
+                dwarf_cu->Index (cu_idx,
+                                 function_basename_index[cu_idx],
+                                 function_fullname_index[cu_idx],
+                                 function_method_index[cu_idx],
+                                 function_selector_index[cu_idx],
+                                 objc_class_selectors_index[cu_idx],
+                                 global_index[cu_idx],
+                                 type_index[cu_idx],
+                                 namespace_index[cu_idx]);
+            }
+        });
 
-            bool clear_dies = dwarf_cu->ExtractDIEsIfNeeded (false) > 1;
-
-            dwarf_cu->Index (cu_idx,
-                             m_function_basename_index,
-                             m_function_fullname_index,
-                             m_function_method_index,
-                             m_function_selector_index,
-                             m_objc_class_selectors_index,
-                             m_global_index, 
-                             m_type_index,
-                             m_namespace_index);
-            
-            // Keep memory down by clearing DIEs if this generate function
-            // caused them to be parsed
-            if (clear_dies)
-                dwarf_cu->ClearDIEs (true);
+        // Keep memory down by clearing DIEs for any compile units that
+        // weren't already parsed before we started indexing
+        uint32_t cu_idx;
+        for (cu_idx = 0; cu_idx < num_compile_units; ++cu_idx)
+        {
+            if (clear_cu_dies[cu_idx])
+                debug_info->GetCompileUnitAtIndex(cu_idx)->ClearDIEs (true);
+        }
+
+        // Merge the per compile unit maps in compile unit order so the final
+        // maps don't depend on how the work was scheduled. Each of the final
+        // maps is independent so they get merged and sorted concurrently.
+        struct IndexToMerge
+        {
+            NameToDIE *index;
+            std::vector<NameToDIE> *cu_indexes;
+        };
+        IndexToMerge indexes_to_merge[] =
+        {
+            { &m_function_basename_index,       &function_basename_index    },
+            { &m_function_fullname_index,       &function_fullname_index    },
+            { &m_function_method_index,         &function_method_index      },
+            { &m_function_selector_index,       &function_selector_index    },
+            { &m_objc_class_selectors_index,    &objc_class_selectors_index },
+            { &m_global_index,                  &global_index               },
+            { &m_type_index,                    &type_index                 },
+            { &m_namespace_index,               &namespace_index            }
+        };
+        const uint32_t num_indexes_to_merge = sizeof(indexes_to_merge)/sizeof(indexes_to_merge[0]);
+        TaskPool::MapOverIndexes (0, num_indexes_to_merge, [&indexes_to_merge](uint32_t merge_idx)
+        {
+            NameToDIE &index = *indexes_to_merge[merge_idx].index;
+            std::vector<NameToDIE> &cu_indexes = *indexes_to_merge[merge_idx].cu_indexes;
+            for (size_t i=0; i<cu_indexes.size(); ++i)
+                index.Append (cu_indexes[i]);
+            index.Finalize();
+        });
+
+        if (index_cache_path)
+        {
+            DWARFIndexCache::Save (index_cache_path,
+                                   GetGlobalPluginProperties()->GetIndexCacheMaxByteSize(),
+                                   *GetObjectFile(),
+                                   indexes,
+                                   num_indexes);
         }
-        
-        m_function_basename_index.Finalize();
-        m_function_fullname_index.Finalize();
-        m_function_method_index.Finalize();
-        m_function_selector_index.Finalize();
-        m_objc_class_selectors_index.Finalize();
-        m_global_index.Finalize(); 
-        m_type_index.Finalize();
-        m_namespace_index.Finalize();
 
 #if defined (ENABLE_DEBUG_PRINTF)
         StreamFile s(stdout, false);
@@ -3047,6 +3791,167 @@ SymbolFileDWARF::Index ()
     }
 }
 
+//----------------------------------------------------------------------
+// Make sure the indexes contain all DIEs named \a name, indexing as few
+// compile units as possible.
+//
+// When the module has a .debug_names or .gdb_index section, only the
+// compile units it lists for the base name of \a name and those it
+// doesn't cover at all get indexed. Whole compile units are indexed
+// with DWARFCompileUnit::Index() so lookups find exactly the same DIEs
+// that they would after a full Index().
+//
+// Only use this for types, namespaces and global variables, which the
+// tables list in every compile unit that defines them. A function
+// that is only inlined into a compile unit isn't listed for it, so
+// function lookups must use Index(). The tables also leave out function
+// local statics, so everything is indexed if the table has no entry for
+// the name, and lookups that still find nothing call
+// IndexAllIfPartial() and try again.
+//----------------------------------------------------------------------
+void
+SymbolFileDWARF::IndexForName (const ConstString &name)
+{
+    if (m_indexed)
+        return;
+
+    ConstString lookup_name;
+    std::vector<dw_offset_t> cu_offsets;
+    if (m_name_accelerator_ap.get() == NULL ||
+        !DWARFAcceleratorTable::GetLookupName (name.GetCString(), lookup_name) ||
+        !m_name_accelerator_ap->FindCompileUnitOffsets (lookup_name, cu_offsets) ||
+        cu_offsets.empty())
+    {
+        Index ();
+        return;
+    }
+
+    Log *log (LogChannelDWARF::GetLogIfAll (DWARF_LOG_LOOKUPS));
+    if (log)
+    {
+        GetObjectFile()->GetModule()->LogMessage (log,
+                                                  "SymbolFileDWARF::IndexForName (name=\"%s\") %s lists %" PRIu64 " compile units for \"%s\"",
+                                                  name.GetCString(),
+                                                  m_name_accelerator_ap->GetSectionName(),
+                                                  (uint64_t)cu_offsets.size(),
+                                                  lookup_name.GetCString());
+    }
+
+    if (!m_indexed_uncovered_cus)
+    {
+        // Compile units that the table doesn't know about can contain
+        // any name.
+        m_indexed_uncovered_cus = true;
+        DWARFDebugInfo* debug_info = DebugInfo();
+        if (debug_info)
+        {
+            std::vector<dw_offset_t> covered_cu_offsets;
+            m_name_accelerator_ap->GetCompileUnitOffsets (covered_cu_offsets);
+            std::sort (covered_cu_offsets.begin(), covered_cu_offsets.end());
+            const uint32_t num_compile_units = GetNumCompileUnits();
+            for (uint32_t cu_idx = 0; cu_idx < num_compile_units; ++cu_idx)
+            {
+                const dw_offset_t cu_offset = debug_info->GetCompileUnitAtIndex(cu_idx)->GetOffset();
+                if (!std::binary_search (covered_cu_offsets.begin(), covered_cu_offsets.end(), cu_offset))
+                    cu_offsets.push_back (cu_offset);
+            }
+        }
+    }
+
+    IndexCompileUnits (cu_offsets);
+}
+
+//----------------------------------------------------------------------
+// Index all compile units if IndexForName() only indexed some of them.
+// Returns true if it did, in which case a lookup that found nothing
+// should be tried again.
+//----------------------------------------------------------------------
+bool
+SymbolFileDWARF::IndexAllIfPartial ()
+{
+    if (m_indexed || m_indexed_cus.empty())
+        return false;
+    Log *log (LogChannelDWARF::GetLogIfAll (DWARF_LOG_LOOKUPS));
+    if (log)
+        GetObjectFile()->GetModule()->LogMessage (log, "SymbolFileDWARF::IndexAllIfPartial () a lookup found nothing, indexing all compile units");
+    Index ();
+    return true;
+}
+
+//----------------------------------------------------------------------
+// Add the names in the compile units at \a cu_offsets that haven't been
+// indexed yet to the indexes.
+//----------------------------------------------------------------------
+void
+SymbolFileDWARF::IndexCompileUnits (std::vector<dw_offset_t> &cu_offsets)
+{
+    if (m_indexed)
+        return;
+
+    DWARFDebugInfo* debug_info = DebugInfo();
+    if (debug_info == NULL)
+        return;
+
+    const uint32_t num_compile_units = GetNumCompileUnits();
+    if (m_indexed_cus.empty())
+        m_indexed_cus.resize (num_compile_units, false);
+
+    std::sort (cu_offsets.begin(), cu_offsets.end());
+    cu_offsets.erase (std::unique (cu_offsets.begin(), cu_offsets.end()), cu_offsets.end());
+
+    Log *log (LogChannelDWARF::GetLogIfAll (DWARF_LOG_LOOKUPS));
+    bool indexed_any = false;
+    for (size_t i = 0; i < cu_offsets.size(); ++i)
+    {
+        uint32_t cu_idx = DW_INVALID_INDEX;
+        DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnit (cu_offsets[i], &cu_idx).get();
+        if (dwarf_cu == NULL || cu_idx >= num_compile_units || m_indexed_cus[cu_idx])
+            continue;
+
+        if (log)
+        {
+            GetObjectFile()->GetModule()->LogMessage (log,
+                                                      "SymbolFileDWARF::IndexCompileUnits () indexing compile unit at 0x%8.8x",
+                                                      dwarf_cu->GetOffset());
+        }
+
+        Timer scoped_timer (__PRETTY_FUNCTION__,
+                            "SymbolFileDWARF::IndexCompileUnits (%s) compile unit at 0x%8.8x",
+                            GetObjectFile()->GetFileSpec().GetFilename().AsCString(),
+                            dwarf_cu->GetOffset());
+
+        m_indexed_cus[cu_idx] = true;
+        indexed_any = true;
+
+        const bool clear_dies = dwarf_cu->ExtractDIEsIfNeeded (false) > 1;
+        dwarf_cu->Index (cu_idx,
+                         m_function_basename_index,
+                         m_function_fullname_index,
+                         m_function_method_index,
+                         m_function_selector_index,
+                         m_objc_class_selectors_index,
+                         m_global_index,
+                         m_type_index,
+                         m_namespace_index);
+        if (clear_dies)
+            dwarf_cu->ClearDIEs (true);
+    }
+
+    // Only sort the names of the new compile units, the indexes already
+    // hold the sorted names of the ones indexed before
+    if (indexed_any)
+    {
+        m_function_basename_index.FinalizeAppended();
+        m_function_fullname_index.FinalizeAppended();
+        m_function_method_index.FinalizeAppended();
+        m_function_selector_index.FinalizeAppended();
+        m_objc_class_selectors_index.FinalizeAppended();
+        m_global_index.FinalizeAppended();
+        m_type_index.FinalizeAppended();
+        m_namespace_index.FinalizeAppended();
+    }
+}
+
 bool
 SymbolFileDWARF::NamespaceDeclMatchesThisSymbolFile (const ClangNamespaceDecl *namespace_decl)
 {
@@ -3170,9 +4075,11 @@ SymbolFileDWARF::FindGlobalVariables (const ConstString &name, const lldb_privat
     {
         // Index the DWARF if we haven't already
         if (!m_indexed)
-            Index ();
+            IndexForName (name);
 
         m_global_index.Find (name, die_offsets);
+        if (die_offsets.empty() && IndexAllIfPartial ())
+            m_global_index.Find (name, die_offsets);
     }
 
     const size_t num_die_matches = die_offsets.size();
@@ -3228,6 +4135,12 @@ SymbolFileDWARF::FindGlobalVariables (const ConstString &name, const lldb_privat
         }
     }
 
+    // Global variables of split DWARF compile units are in their .dwo files
+    std::vector<SymbolFileDWARFDwo *> dwo_symfiles;
+    GetDwoSymbolFiles (&name, false, dwo_symfiles);
+    for (size_t i = 0; i < dwo_symfiles.size() && variables.GetSize() - original_size < max_matches; ++i)
+        dwo_symfiles[i]->FindGlobalVariables (name, namespace_decl, true, max_matches - (variables.GetSize() - original_size), variables);
+
     // Return the number of variable that were appended to the list
     const uint32_t num_matches = variables.GetSize() - original_size;
     if (log && num_matches > 0)
@@ -3322,6 +4235,11 @@ SymbolFileDWARF::FindGlobalVariables(const RegularExpression& regex, bool append
         }
     }
 
+    std::vector<SymbolFileDWARFDwo *> dwo_symfiles;
+    GetDwoSymbolFiles (NULL, false, dwo_symfiles);
+    for (size_t i = 0; i < dwo_symfiles.size() && variables.GetSize() - original_size < max_matches; ++i)
+        dwo_symfiles[i]->FindGlobalVariables (regex, true, max_matches - (variables.GetSize() - original_size), variables);
+
     // Return the number of variable that were appended to the list
     return variables.GetSize() - original_size;
 }
@@ -3774,7 +4692,9 @@ SymbolFileDWARF::FindFunctions (const ConstString &name,
     else
     {
 
-        // Index the DWARF if we haven't already
+        // Index the DWARF if we haven't already. The name index sections
+        // don't list inlined copies of functions or ObjC selectors, so
+        // function lookups always need a full index.
         if (!m_indexed)
             Index ();
 
@@ -3875,6 +4795,14 @@ SymbolFileDWARF::FindFunctions (const ConstString &name,
         
     }
 
+    // Functions of split DWARF compile units are in their .dwo files. The
+    // name index sections don't list inlined copies of functions, so all
+    // of them must be searched.
+    std::vector<SymbolFileDWARFDwo *> dwo_symfiles;
+    GetDwoSymbolFiles (NULL, false, dwo_symfiles);
+    for (size_t i = 0; i < dwo_symfiles.size(); ++i)
+        dwo_symfiles[i]->FindFunctions (name, namespace_decl, name_type_mask, include_inlines, true, sc_list);
+
     // Return the number of variable that were appended to the list
     const uint32_t num_matches = sc_list.GetSize() - original_size;
     
@@ -3932,6 +4860,11 @@ SymbolFileDWARF::FindFunctions(const RegularExpression& regex, bool include_inli
         FindFunctions (regex, m_function_fullname_index, sc_list);
     }
 
+    std::vector<SymbolFileDWARFDwo *> dwo_symfiles;
+    GetDwoSymbolFiles (NULL, false, dwo_symfiles);
+    for (size_t i = 0; i < dwo_symfiles.size(); ++i)
+        dwo_symfiles[i]->FindFunctions (regex, include_inlines, true, sc_list);
+
     // Return the number of variable that were appended to the list
     return sc_list.GetSize() - original_size;
 }
@@ -3986,16 +4919,25 @@ SymbolFileDWARF::FindTypes (const SymbolContext& sc,
     else
     {
         if (!m_indexed)
-            Index ();
+            IndexForName (name);
 
         m_type_index.Find (name, die_offsets);
+        if (die_offsets.empty() && IndexAllIfPartial ())
+            m_type_index.Find (name, die_offsets);
     }
 
+    const uint32_t initial_types_size = types.GetSize();
+
+    // Types of split DWARF compile units are in their .dwo files
+    std::vector<SymbolFileDWARFDwo *> dwo_symfiles;
+    GetDwoSymbolFiles (&name, false, dwo_symfiles);
+    for (size_t i = 0; i < dwo_symfiles.size() && types.GetSize() < max_matches; ++i)
+        dwo_symfiles[i]->FindTypes (sc, name, namespace_decl, true, max_matches, types);
+
     const size_t num_die_matches = die_offsets.size();
 
     if (num_die_matches)
     {
-        const uint32_t initial_types_size = types.GetSize();
         DWARFCompileUnit* dwarf_cu = NULL;
         const DWARFDebugInfoEntry* die = NULL;
         DWARFDebugInfo* debug_info = DebugInfo();
@@ -4052,7 +4994,7 @@ SymbolFileDWARF::FindTypes (const SymbolContext& sc,
         }
         return num_matches;
     }
-    return 0;
+    return types.GetSize() - initial_types_size;
 }
 
 
@@ -4092,9 +5034,11 @@ SymbolFileDWARF::FindNamespace (const SymbolContext& sc,
         else
         {
             if (!m_indexed)
-                Index ();
+                IndexForName (name);
 
             m_namespace_index.Find (name, die_offsets);
+            if (die_offsets.empty() && IndexAllIfPartial ())
+                m_namespace_index.Find (name, die_offsets);
         }
         
         DWARFCompileUnit* dwarf_cu = NULL;
@@ -4132,6 +5076,15 @@ SymbolFileDWARF::FindNamespace (const SymbolContext& sc,
 
             }
         }
+
+        // Namespaces of split DWARF compile units are in their .dwo files
+        if (!namespace_decl.GetNamespaceDecl())
+        {
+            std::vector<SymbolFileDWARFDwo *> dwo_symfiles;
+            GetDwoSymbolFiles (&name, false, dwo_symfiles);
+            for (size_t i = 0; i < dwo_symfiles.size() && !namespace_decl.GetNamespaceDecl(); ++i)
+                namespace_decl = dwo_symfiles[i]->FindNamespace (sc, name, parent_namespace_decl);
+        }
     }
     if (log && namespace_decl.GetNamespaceDecl())
     {
@@ -4842,9 +5795,11 @@ SymbolFileDWARF::FindCompleteObjCDefinitionTypeForDIE (const DWARFDebugInfoEntry
     else
     {
         if (!m_indexed)
-            Index ();
+            IndexForName (type_name);
         
         m_type_index.Find (type_name, die_offsets);
+        if (die_offsets.empty() && IndexAllIfPartial ())
+            m_type_index.Find (type_name, die_offsets);
     }
     
     const size_t num_matches = die_offsets.size();
@@ -5085,9 +6040,11 @@ SymbolFileDWARF::FindDefinitionTypeForDIE (DWARFCompileUnit* cu,
     else
     {
         if (!m_indexed)
-            Index ();
+            IndexForName (type_name);
         
         m_type_index.Find (type_name, die_offsets);
+        if (die_offsets.empty() && IndexAllIfPartial ())
+            m_type_index.Find (type_name, die_offsets);
     }
     
     const size_t num_matches = die_offsets.size();
@@ -5204,6 +6161,25 @@ SymbolFileDWARF::FindDefinitionTypeForDIE (DWARFCompileUnit* cu,
     return type_sp;
 }
 
+TypeSP
+SymbolFileDWARF::FindDefinitionTypeInDwoSymbolFiles (const DWARFDeclContext &dwarf_decl_ctx,
+                                                     SymbolFileDWARF *skip_symfile)
+{
+    TypeSP type_sp;
+    if (dwarf_decl_ctx.GetSize() == 0)
+        return type_sp;
+
+    const ConstString type_name(dwarf_decl_ctx[0].name);
+    std::vector<SymbolFileDWARFDwo *> dwo_symfiles;
+    GetDwoSymbolFiles (type_name ? &type_name : NULL, false, dwo_symfiles);
+    for (size_t i = 0; i < dwo_symfiles.size() && !type_sp; ++i)
+    {
+        if (dwo_symfiles[i] != skip_symfile)
+            type_sp = dwo_symfiles[i]->FindDefinitionTypeForDWARFDeclContext (dwarf_decl_ctx);
+    }
+    return type_sp;
+}
+
 TypeSP
 SymbolFileDWARF::FindDefinitionTypeForDWARFDeclContext (const DWARFDeclContext &dwarf_decl_ctx)
 {
@@ -5257,9 +6233,11 @@ SymbolFileDWARF::FindDefinitionTypeForDWARFDeclContext (const DWARFDeclContext &
             else
             {
                 if (!m_indexed)
-                    Index ();
+                    IndexForName (type_name);
                 
                 m_type_index.Find (type_name, die_offsets);
+                if (die_offsets.empty() && IndexAllIfPartial ())
+                    m_type_index.Find (type_name, die_offsets);
             }
             
             const size_t num_matches = die_offsets.size();
@@ -6154,6 +7132,13 @@ SymbolFileDWARF::ParseType (const SymbolContext& sc, DWARFCompileUnit* dwarf_cu,
                             type_sp = m_debug_map_symfile->FindDefinitionTypeForDWARFDeclContext (die_decl_ctx);
                         }
 
+                        if (!type_sp && GetSkeletonCompileUnit ())
+                        {
+                            // Look in the .dwo files of the other split
+                            // DWARF compile units
+                            type_sp = GetSkeletonCompileUnit ()->GetSymbolFileDWARF()->FindDefinitionTypeInDwoSymbolFiles (die_decl_ctx, this);
+                        }
+
                         if (type_sp)
                         {
                             if (log)
@@ -7145,6 +8130,10 @@ size_t
 SymbolFileDWARF::ParseFunctionBlocks (const SymbolContext &sc)
 {
     assert(sc.comp_unit && sc.function);
+    SymbolFileDWARFDwo *dwo_symfile = GetDwoSymbolFileForCompileUnit (sc.comp_unit);
+    if (dwo_symfile)
+        return dwo_symfile->ParseFunctionBlocks (sc);
+
     size_t functions_added = 0;
     DWARFCompileUnit* dwarf_cu = GetDWARFCompileUnit(sc.comp_unit);
     if (dwarf_cu)
@@ -7166,6 +8155,10 @@ SymbolFileDWARF::ParseTypes (const SymbolContext &sc)
 {
     // At least a compile unit must be valid
     assert(sc.comp_unit);
+    SymbolFileDWARFDwo *dwo_symfile = GetDwoSymbolFileForCompileUnit (sc.comp_unit);
+    if (dwo_symfile)
+        return dwo_symfile->ParseTypes (sc);
+
     size_t types_added = 0;
     DWARFCompileUnit* dwarf_cu = GetDWARFCompileUnit(sc.comp_unit);
     if (dwarf_cu)
@@ -7197,6 +8190,10 @@ SymbolFileDWARF::ParseVariablesForContext (const SymbolContext& sc)
 {
     if (sc.comp_unit != NULL)
     {
+        SymbolFileDWARFDwo *dwo_symfile = GetDwoSymbolFileForCompileUnit (sc.comp_unit);
+        if (dwo_symfile)
+            return dwo_symfile->ParseVariablesForContext (sc);
+
         DWARFDebugInfo* info = DebugInfo();
         if (info == NULL)
             return 0;
@@ -7222,7 +8219,7 @@ SymbolFileDWARF::ParseVariablesForContext (const SymbolContext& sc)
         }
         else if (sc.comp_unit)
         {
-            DWARFCompileUnit* dwarf_cu = info->GetCompileUnit(sc.comp_unit->GetID()).get();
+            DWARFCompileUnit* dwarf_cu = GetDWARFCompileUnit(sc.comp_unit);
 
             if (dwarf_cu == NULL)
                 return 0;
@@ -7254,9 +8251,19 @@ SymbolFileDWARF::ParseVariablesForContext (const SymbolContext& sc)
                 else
                 {
                     // Index if we already haven't to make sure the compile units
-                    // get indexed and make their global DIE index list
+                    // get indexed and make their global DIE index list. Only
+                    // this compile unit is needed when names are being
+                    // indexed one compile unit at a time.
                     if (!m_indexed)
-                        Index ();
+                    {
+                        if (m_name_accelerator_ap.get())
+                        {
+                            std::vector<dw_offset_t> cu_offsets (1, dwarf_cu->GetOffset());
+                            IndexCompileUnits (cu_offsets);
+                        }
+                        else
+                            Index ();
+                    }
 
                     m_global_index.FindAllEntriesForCompileUnit (dwarf_cu->GetOffset(), 
                                                                  dwarf_cu->GetNextCompileUnitOffset(), 
@@ -7383,6 +8390,18 @@ SymbolFileDWARF::ParseVariableDIE
                                     uint32_t data_length = fixed_form_sizes[form_value.Form()];
                                     location.CopyOpcodeData(module, debug_info_data, data_offset, data_length);
                                 }
+                                else if (form_value.Form() == DW_FORM_GNU_str_index)
+                                {
+                                    // The string is in .debug_str of the .dwo file
+                                    const DWARFDataExtractor& debug_str_data = get_debug_str_data();
+                                    const char *str = form_value.AsCString(&debug_str_data);
+                                    if (str)
+                                    {
+                                        uint32_t string_offset = str - (const char *)debug_str_data.GetDataStart();
+                                        uint32_t string_length = strlen(str) + 1;
+                                        location.CopyOpcodeData(module, debug_str_data, string_offset, string_length);
+                                    }
+                                }
                                 else
                                 {
                                     const char *str = form_value.AsCString(&debug_info_data);
@@ -7404,6 +8423,24 @@ SymbolFileDWARF::ParseVariableDIE
                                 uint32_t block_offset = form_value.BlockData() - debug_info_data.GetDataStart();
                                 uint32_t block_length = form_value.Unsigned();
                                 location.CopyOpcodeData(module, get_debug_info_data(), block_offset, block_length);
+
+                                // Addresses in .dwo files are indexes into
+                                // .debug_addr of the executable
+                                if (GetSkeletonCompileUnit())
+                                    location.Resolve_DW_OP_GNU_addr_index (get_debug_addr_data(), dwarf_cu->GetAddrBase());
+                            }
+                            else if (GetSkeletonCompileUnit())
+                            {
+                                DataExtractor location_list_data;
+                                if (DWARFLocationList::ConvertSplitDWARFLocationList (dwarf_cu,
+                                                                                      get_debug_loc_data(),
+                                                                                      form_value.Unsigned(),
+                                                                                      location_list_data))
+                                {
+                                    location.SetOpcodeData(module, location_list_data, 0, location_list_data.GetByteSize());
+                                    assert (func_low_pc != LLDB_INVALID_ADDRESS);
+                                    location.SetLocationListSlide (func_low_pc - dwarf_cu->GetBaseAddress());
+                                }
                             }
                             else
                             {
@@ -7871,6 +8908,14 @@ SymbolFileDWARF::SearchDeclContext (const clang::DeclContext *decl_context,
                                     const char *name, 
                                     llvm::SmallVectorImpl <clang::NamedDecl *> *results)
 {    
+    // FindExternalVisibleDeclsByName() calls this straight from clang
+    Mutex::Locker locker;
+    LockModuleMutex (locker);
+    std::vector<SymbolFileDWARFDwo *> dwo_symfiles;
+    GetDwoSymbolFiles (NULL, true, dwo_symfiles);
+    for (size_t i = 0; i < dwo_symfiles.size(); ++i)
+        dwo_symfiles[i]->SearchDeclContext (decl_context, name, results);
+
     DeclContextToDIEMap::iterator iter = m_decl_ctx_to_die.find(decl_context);
     
     if (iter == m_decl_ctx_to_die.end())
@@ -7898,9 +8943,11 @@ SymbolFileDWARF::SearchDeclContext (const clang::DeclContext *decl_context,
         else
         {
             if (!m_indexed)
-                Index ();
+                IndexForName (ConstString(name));
             
             m_type_index.Find (ConstString(name), die_offsets);
+            if (die_offsets.empty() && IndexAllIfPartial ())
+                m_type_index.Find (ConstString(name), die_offsets);
         }
         
         const size_t num_matches = die_offsets.size();
@@ -7977,6 +9024,9 @@ SymbolFileDWARF::LayoutRecordType (const clang::RecordDecl *record_decl,
                                    llvm::DenseMap <const clang::CXXRecordDecl *, clang::CharUnits> &base_offsets,
                                    llvm::DenseMap <const clang::CXXRecordDecl *, clang::CharUnits> &vbase_offsets)
 {
+    // Clang asks for the layout without going through the SymbolVendor
+    Mutex::Locker locker;
+    LockModuleMutex (locker);
     Log *log (LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO));
     RecordDeclToLayoutMap::iterator pos = m_record_decl_to_layout_map.find (record_decl);
     bool success = false;
@@ -7997,6 +9047,12 @@ SymbolFileDWARF::LayoutRecordType (const clang::RecordDecl *record_decl,
         bit_size = 0;
         alignment = 0;
         field_offsets.clear();
+
+        // The record may have been laid out by a .dwo file
+        std::vector<SymbolFileDWARFDwo *> dwo_symfiles;
+        GetDwoSymbolFiles (NULL, true, dwo_symfiles);
+        for (size_t i = 0; !success && i < dwo_symfiles.size(); ++i)
+            success = dwo_symfiles[i]->LayoutRecordType (record_decl, bit_size, alignment, field_offsets, base_offsets, vbase_offsets);
     }
     
     if (log)
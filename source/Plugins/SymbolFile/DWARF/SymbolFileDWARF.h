@@ -46,10 +46,12 @@
 //----------------------------------------------------------------------
 class DebugMapModule;
 class DWARFAbbreviationDeclaration;
+class DWARFAcceleratorTable;
 class DWARFAbbreviationDeclarationSet;
 class DWARFileUnit;
 class DWARFDebugAbbrev;
 class DWARFDebugAranges;
+class DWARFDebugCUIndex;
 class DWARFDebugInfo;
 class DWARFDebugInfoEntry;
 class DWARFDebugLine;
@@ -59,6 +61,7 @@ class DWARFDeclContext;
 class DWARFDIECollection;
 class DWARFFormValue;
 class SymbolFileDWARFDebugMap;
+class SymbolFileDWARFDwo;
 
 class SymbolFileDWARF : public lldb_private::SymbolFile, public lldb_private::UserID
 {
@@ -66,6 +69,7 @@ public:
     friend class SymbolFileDWARFDebugMap;
     friend class DebugMapModule;
     friend class DWARFCompileUnit;
+    friend class SymbolFileDWARFDwo;
     //------------------------------------------------------------------
     // Static Functions
     //------------------------------------------------------------------
@@ -75,6 +79,9 @@ public:
     static void
     Terminate();
 
+    static void
+    DebuggerInitialize (lldb_private::Debugger &debugger);
+
     static lldb_private::ConstString
     GetPluginNameStatic();
 
@@ -102,6 +109,7 @@ public:
     virtual size_t          ParseCompileUnitFunctions (const lldb_private::SymbolContext& sc);
     virtual bool            ParseCompileUnitLineTable (const lldb_private::SymbolContext& sc);
     virtual bool            ParseCompileUnitSupportFiles (const lldb_private::SymbolContext& sc, lldb_private::FileSpecList& support_files);
+    virtual bool            GetCompileUnitSourceFileBasenames (uint32_t cu_idx, std::vector<lldb_private::ConstString> &basenames);
     virtual size_t          ParseFunctionBlocks (const lldb_private::SymbolContext& sc);
     virtual size_t          ParseTypes (const lldb_private::SymbolContext& sc);
     virtual size_t          ParseVariablesForContext (const lldb_private::SymbolContext& sc);
@@ -134,6 +142,8 @@ public:
                            const lldb_private::ConstString &name, 
                            const lldb_private::ClangNamespaceDecl *parent_namespace_decl);
 
+    virtual size_t          ReleaseUnusedMemory ();
+
 
     //------------------------------------------------------------------
     // ClangASTContext callbacks for external source lookups.
@@ -211,6 +221,10 @@ public:
     const lldb_private::DWARFDataExtractor&     get_apple_types_data ();
     const lldb_private::DWARFDataExtractor&     get_apple_namespaces_data ();
     const lldb_private::DWARFDataExtractor&     get_apple_objc_data ();
+    const lldb_private::DWARFDataExtractor&     get_debug_names_data ();
+    const lldb_private::DWARFDataExtractor&     get_gdb_index_data ();
+    const lldb_private::DWARFDataExtractor&     get_debug_addr_data ();
+    const lldb_private::DWARFDataExtractor&     get_debug_str_offsets_data ();
 
 
     DWARFDebugAbbrev*       DebugAbbrev();
@@ -227,6 +241,26 @@ public:
                           lldb::SectionType sect_type, 
                           lldb_private::DWARFDataExtractor &data);
 
+    virtual void
+    LoadSectionData (lldb::SectionType sect_type,
+                     lldb_private::DWARFDataExtractor &data);
+
+    //------------------------------------------------------------------
+    // Split DWARF (-gsplit-dwarf) support
+    //------------------------------------------------------------------
+
+    // Returns the skeleton compile unit in the executable if this is
+    // the symbol file of a .dwo file, NULL otherwise
+    virtual DWARFCompileUnit *
+    GetSkeletonCompileUnit ()
+    {
+        return NULL;
+    }
+
+    SymbolFileDWARFDwo *
+    CreateDwoSymbolFile (DWARFCompileUnit *skeleton_cu,
+                         const DWARFDebugInfoEntry *cu_die);
+
     static bool
     SupportedVersion(uint16_t version);
 
@@ -295,7 +329,11 @@ protected:
         flagsGotAppleNamesData      = (1 << 11),
         flagsGotAppleTypesData      = (1 << 12),
         flagsGotAppleNamespacesData = (1 << 13),
-        flagsGotAppleObjCData       = (1 << 14)
+        flagsGotAppleObjCData       = (1 << 14),
+        flagsGotDebugNamesData      = (1 << 15),
+        flagsGotGdbIndexData        = (1 << 16),
+        flagsGotDebugAddrData       = (1 << 17),
+        flagsGotDebugStrOffsetsData = (1 << 18)
     };
     
     bool                    NamespaceDeclMatchesThisSymbolFile (const lldb_private::ClangNamespaceDecl *namespace_decl);
@@ -305,8 +343,15 @@ protected:
                                               const DWARFDebugInfoEntry* die);
 
     DISALLOW_COPY_AND_ASSIGN (SymbolFileDWARF);
-    lldb::CompUnitSP        ParseCompileUnit (DWARFCompileUnit* dwarf_cu, uint32_t cu_idx);
-    DWARFCompileUnit*       GetDWARFCompileUnit(lldb_private::CompileUnit *comp_unit);
+    virtual lldb::CompUnitSP ParseCompileUnit (DWARFCompileUnit* dwarf_cu, uint32_t cu_idx);
+    virtual DWARFCompileUnit* GetDWARFCompileUnit(lldb_private::CompileUnit *comp_unit);
+    SymbolFileDWARFDwo *    GetDwoSymbolFileForCompileUnit (lldb_private::CompileUnit *comp_unit);
+    SymbolFileDWARFDwo *    GetDwoSymbolFileForUserID (lldb::user_id_t uid);
+    void                    GetDwoSymbolFiles (const lldb_private::ConstString *name,
+                                               bool loaded_only,
+                                               std::vector<SymbolFileDWARFDwo *> &dwo_symfiles);
+    DWARFDebugCUIndex *     GetDwpCompileUnitIndex ();
+    void                    LockModuleMutex (lldb_private::Mutex::Locker &locker);
     DWARFCompileUnit*       GetNextUnparsedDWARFCompileUnit(DWARFCompileUnit* prev_cu);
     lldb_private::CompileUnit*      GetCompUnitForDWARFCompUnit(DWARFCompileUnit* dwarf_cu, uint32_t cu_idx = UINT32_MAX);
     bool                    GetFunction (DWARFCompileUnit* dwarf_cu, const DWARFDebugInfoEntry* func_die, lldb_private::SymbolContext& sc);
@@ -429,6 +474,10 @@ protected:
     lldb::TypeSP            FindDefinitionTypeForDWARFDeclContext (
                                 const DWARFDeclContext &die_decl_ctx);
 
+    lldb::TypeSP            FindDefinitionTypeInDwoSymbolFiles (
+                                const DWARFDeclContext &die_decl_ctx,
+                                SymbolFileDWARF *skip_symfile);
+
     lldb::TypeSP            FindCompleteObjCDefinitionTypeForDIE (
                                 const DWARFDebugInfoEntry *die, 
                                 const lldb_private::ConstString &type_name,
@@ -449,6 +498,11 @@ protected:
     uint32_t                FindTypes(std::vector<dw_offset_t> die_offsets, uint32_t max_matches, lldb_private::TypeList& types);
 
     void                    Index();
+
+    void                    IndexForName (const lldb_private::ConstString &name);
+    bool                    IndexAllIfPartial ();
+
+    void                    IndexCompileUnits (std::vector<dw_offset_t> &cu_offsets);
     
     void                    DumpIndexes();
 
@@ -474,7 +528,7 @@ protected:
     clang::NamespaceDecl *
     ResolveNamespaceDIE (DWARFCompileUnit *curr_cu, const DWARFDebugInfoEntry *die);
     
-    UniqueDWARFASTTypeMap &
+    virtual UniqueDWARFASTTypeMap &
     GetUniqueDWARFASTTypeMap ();
 
     void                    LinkDeclContextToDIE (clang::DeclContext *decl_ctx,
@@ -579,6 +633,10 @@ protected:
     lldb_private::DWARFDataExtractor      m_data_apple_types;
     lldb_private::DWARFDataExtractor      m_data_apple_namespaces;
     lldb_private::DWARFDataExtractor      m_data_apple_objc;
+    lldb_private::DWARFDataExtractor      m_data_debug_names;
+    lldb_private::DWARFDataExtractor      m_data_gdb_index;
+    lldb_private::DWARFDataExtractor      m_data_debug_addr;
+    lldb_private::DWARFDataExtractor      m_data_debug_str_offsets;
 
     // The unique pointer items below are generated on demand if and when someone accesses
     // them through a non const version of this class.
@@ -589,6 +647,8 @@ protected:
     std::unique_ptr<DWARFMappedHash::MemoryTable> m_apple_types_ap;
     std::unique_ptr<DWARFMappedHash::MemoryTable> m_apple_namespaces_ap;
     std::unique_ptr<DWARFMappedHash::MemoryTable> m_apple_objc_ap;
+    std::unique_ptr<DWARFAcceleratorTable> m_name_accelerator_ap;  // .debug_names or .gdb_index, only used without Apple tables
+    std::vector<bool>                   m_indexed_cus;              // Compile units whose names are in the indexes below when m_indexed is false
     NameToDIE                           m_function_basename_index;  // All concrete functions
     NameToDIE                           m_function_fullname_index;  // All concrete functions
     NameToDIE                           m_function_method_index;    // All inlined functions
@@ -598,11 +658,15 @@ protected:
     NameToDIE                           m_type_index;               // All type DIE offsets
     NameToDIE                           m_namespace_index;          // All type DIE offsets
     bool                                m_indexed:1,
+                                        m_indexed_uncovered_cus:1,
                                         m_is_external_ast_source:1,
                                         m_using_apple_tables:1;
     lldb_private::LazyBool              m_supports_DW_AT_APPLE_objc_complete_type;
 
     std::unique_ptr<DWARFDebugRanges>     m_ranges;
+    lldb::ObjectFileSP                  m_dwp_obj_file_sp;          // The .dwp package next to the executable, if any
+    std::unique_ptr<DWARFDebugCUIndex>  m_dwp_cu_index_ap;          // The .debug_cu_index of the .dwp package
+    bool                                m_dwp_looked_up;
     UniqueDWARFASTTypeMap m_unique_ast_type_map;
     typedef llvm::SmallPtrSet<const DWARFDebugInfoEntry *, 4> DIEPointerSet;
     typedef llvm::DenseMap<const DWARFDebugInfoEntry *, clang::DeclContext *> DIEToDeclContextMap;
@@ -1172,6 +1172,25 @@ SymbolFileDWARFDebugMap::GetTypes (SymbolContextScope *sc_scope,
     return type_list.GetSize() - initial_size;
 }
 
+size_t
+SymbolFileDWARFDebugMap::ReleaseUnusedMemory ()
+{
+    // Only look at the .o files that have already been loaded, there is
+    // nothing to release in the others.
+    size_t bytes_released = 0;
+    const size_t num_oso_idxs = m_compile_unit_infos.size();
+    for (size_t oso_idx = 0; oso_idx < num_oso_idxs; ++oso_idx)
+    {
+        CompileUnitInfo &comp_unit_info = m_compile_unit_infos[oso_idx];
+        if (comp_unit_info.oso_sp && comp_unit_info.oso_sp->module_sp)
+        {
+            const bool mandatory = true;
+            bytes_released += comp_unit_info.oso_sp->module_sp->ReleaseUnusedMemory (mandatory);
+        }
+    }
+    return bytes_released;
+}
+
 
 TypeSP
 SymbolFileDWARFDebugMap::FindDefinitionTypeForDWARFDeclContext (const DWARFDeclContext &die_decl_ctx)
@@ -92,6 +92,7 @@ public:
     virtual size_t          GetTypes (lldb_private::SymbolContextScope *sc_scope,
                                       uint32_t type_mask,
                                       lldb_private::TypeList &type_list);
+    virtual size_t          ReleaseUnusedMemory ();
 
 
     //------------------------------------------------------------------
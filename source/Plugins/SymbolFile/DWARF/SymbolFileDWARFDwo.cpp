@@ -0,0 +1,152 @@
+//===-- SymbolFileDWARFDwo.cpp ----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "SymbolFileDWARFDwo.h"
+
+#include "lldb/Core/Section.h"
+#include "lldb/Symbol/CompileUnit.h"
+#include "lldb/Symbol/ObjectFile.h"
+
+#include "DWARFCompileUnit.h"
+#include "DWARFDebugCUIndex.h"
+#include "DWARFDebugInfo.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+SymbolFileDWARFDwo::SymbolFileDWARFDwo (const ObjectFileSP &objfile_sp,
+                                        DWARFCompileUnit *skeleton_cu,
+                                        const DWARFDebugCUIndex *dwp_cu_index,
+                                        uint32_t dwp_row) :
+    SymbolFileDWARF (objfile_sp.get()),
+    m_obj_file_sp (objfile_sp),
+    m_skeleton_cu (skeleton_cu),
+    m_dwp_cu_index (dwp_cu_index),
+    m_dwp_row (dwp_row)
+{
+}
+
+SymbolFileDWARFDwo::~SymbolFileDWARFDwo()
+{
+}
+
+SymbolFileDWARF *
+SymbolFileDWARFDwo::GetBaseSymbolFile ()
+{
+    return m_skeleton_cu->GetSymbolFileDWARF();
+}
+
+void
+SymbolFileDWARFDwo::LoadSectionData (SectionType sect_type, DWARFDataExtractor &data)
+{
+    SymbolFileDWARF *base_dwarf = GetBaseSymbolFile();
+    switch (sect_type)
+    {
+    case eSectionTypeDWARFDebugAddr:
+        // The address table is in the executable, m_addr_base of the
+        // compile unit says where its addresses start
+        data = base_dwarf->get_debug_addr_data();
+        return;
+
+    case eSectionTypeDWARFDebugRanges:
+        {
+            // So are the ranges, but DW_AT_ranges values in the .dwo
+            // file are relative to the DW_AT_GNU_ranges_base of the
+            // skeleton compile unit
+            const DWARFDataExtractor &debug_ranges_data = base_dwarf->get_debug_ranges_data();
+            const dw_offset_t ranges_base = m_skeleton_cu->GetRangesBase();
+            if (ranges_base < debug_ranges_data.GetByteSize())
+                data.SetData (debug_ranges_data, ranges_base, debug_ranges_data.GetByteSize() - ranges_base);
+        }
+        return;
+
+    default:
+        break;
+    }
+
+    // Don't add the sections of the .dwo file to the module, they would
+    // replace the sections of the executable
+    const SectionList *section_list = m_obj_file->GetSectionList (false);
+    if (section_list == NULL)
+        return;
+
+    SectionSP section_sp (section_list->FindSectionByType (sect_type, true));
+    if (!section_sp || m_obj_file->ReadSectionData (section_sp.get(), data) == 0)
+    {
+        data.Clear();
+        return;
+    }
+
+    if (m_dwp_cu_index == NULL)
+        return;
+
+    // Only use the part of the .dwp package section that belongs to
+    // this compile unit. Strings are shared by all compile units.
+    DWARFDebugCUIndex::SectionKind section_kind;
+    switch (sect_type)
+    {
+    case eSectionTypeDWARFDebugInfo:        section_kind = DWARFDebugCUIndex::eSectionKindInfo; break;
+    case eSectionTypeDWARFDebugAbbrev:      section_kind = DWARFDebugCUIndex::eSectionKindAbbrev; break;
+    case eSectionTypeDWARFDebugLine:        section_kind = DWARFDebugCUIndex::eSectionKindLine; break;
+    case eSectionTypeDWARFDebugLoc:         section_kind = DWARFDebugCUIndex::eSectionKindLoc; break;
+    case eSectionTypeDWARFDebugStrOffsets:  section_kind = DWARFDebugCUIndex::eSectionKindStrOffsets; break;
+    default:
+        return;
+    }
+
+    dw_offset_t contribution_offset = 0;
+    dw_offset_t contribution_size = 0;
+    if (m_dwp_cu_index->GetContribution (m_dwp_row, section_kind, contribution_offset, contribution_size) &&
+        data.ValidOffsetForDataOfSize (contribution_offset, contribution_size))
+    {
+        DWARFDataExtractor section_data (data);
+        data.SetData (section_data, contribution_offset, contribution_size);
+    }
+    else
+    {
+        data.Clear();
+    }
+}
+
+DWARFCompileUnit *
+SymbolFileDWARFDwo::GetCompileUnit ()
+{
+    DWARFDebugInfo* debug_info = DebugInfo();
+    if (debug_info)
+        return debug_info->GetCompileUnitAtIndex (0);
+    return NULL;
+}
+
+CompUnitSP
+SymbolFileDWARFDwo::ParseCompileUnit (DWARFCompileUnit* dwarf_cu, uint32_t cu_idx)
+{
+    // The lldb_private::CompileUnit belongs to the skeleton compile unit
+    CompUnitSP cu_sp (GetBaseSymbolFile()->ParseCompileUnit (m_skeleton_cu, UINT32_MAX));
+    if (cu_sp && dwarf_cu)
+        dwarf_cu->SetUserData (cu_sp.get());
+    return cu_sp;
+}
+
+DWARFCompileUnit *
+SymbolFileDWARFDwo::GetDWARFCompileUnit (CompileUnit *comp_unit)
+{
+    return GetCompileUnit();
+}
+
+ClangASTContext &
+SymbolFileDWARFDwo::GetClangASTContext ()
+{
+    return GetBaseSymbolFile()->GetClangASTContext();
+}
+
+UniqueDWARFASTTypeMap &
+SymbolFileDWARFDwo::GetUniqueDWARFASTTypeMap ()
+{
+    return GetBaseSymbolFile()->GetUniqueDWARFASTTypeMap();
+}
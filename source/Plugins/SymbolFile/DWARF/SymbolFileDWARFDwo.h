@@ -0,0 +1,83 @@
+//===-- SymbolFileDWARFDwo.h ------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SymbolFileDWARF_SymbolFileDWARFDwo_h_
+#define SymbolFileDWARF_SymbolFileDWARFDwo_h_
+
+#include "SymbolFileDWARF.h"
+
+//----------------------------------------------------------------------
+// SymbolFileDWARFDwo
+//
+// The DWARF of one split DWARF (-gsplit-dwarf) compile unit, read from
+// a .dwo file or from the contributions of the compile unit to a .dwp
+// package. The object file is opened for the module of the executable
+// so addresses resolve against the sections of the executable. The
+// address table (.debug_addr) and ranges (.debug_ranges) stay in the
+// executable and are read through the symbol file of the skeleton
+// compile unit, which also owns the AST that types are added to.
+//----------------------------------------------------------------------
+class SymbolFileDWARFDwo : public SymbolFileDWARF
+{
+public:
+    friend class SymbolFileDWARF;
+
+    //------------------------------------------------------------------
+    // \a dwp_cu_index and \a dwp_row say where the sections of the
+    // compile unit are when \a objfile_sp is a .dwp package, they are
+    // NULL and zero for a .dwo file.
+    //------------------------------------------------------------------
+    SymbolFileDWARFDwo (const lldb::ObjectFileSP &objfile_sp,
+                        DWARFCompileUnit *skeleton_cu,
+                        const DWARFDebugCUIndex *dwp_cu_index,
+                        uint32_t dwp_row);
+
+    virtual
+    ~SymbolFileDWARFDwo();
+
+    virtual DWARFCompileUnit *
+    GetSkeletonCompileUnit ()
+    {
+        return m_skeleton_cu;
+    }
+
+    // The only compile unit in the .dwo file
+    DWARFCompileUnit *
+    GetCompileUnit ();
+
+    virtual lldb_private::ClangASTContext &
+    GetClangASTContext ();
+
+    virtual void
+    LoadSectionData (lldb::SectionType sect_type,
+                     lldb_private::DWARFDataExtractor &data);
+
+protected:
+    virtual lldb::CompUnitSP
+    ParseCompileUnit (DWARFCompileUnit* dwarf_cu, uint32_t cu_idx);
+
+    virtual DWARFCompileUnit *
+    GetDWARFCompileUnit (lldb_private::CompileUnit *comp_unit);
+
+    virtual UniqueDWARFASTTypeMap &
+    GetUniqueDWARFASTTypeMap ();
+
+    SymbolFileDWARF *
+    GetBaseSymbolFile ();
+
+    lldb::ObjectFileSP m_obj_file_sp;   // Keeps the .dwo or .dwp object file alive
+    DWARFCompileUnit *m_skeleton_cu;
+    const DWARFDebugCUIndex *m_dwp_cu_index;
+    uint32_t m_dwp_row;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN (SymbolFileDWARFDwo);
+};
+
+#endif  // SymbolFileDWARF_SymbolFileDWARFDwo_h_
@@ -123,6 +123,18 @@ public:
           const lldb_private::Declaration &decl,
           const int32_t byte_size,
           UniqueDWARFASTType &entry) const;
+
+    void
+    AppendDIEs (const SymbolFileDWARF *symfile,
+                std::vector<const DWARFDebugInfoEntry *> &dies) const
+    {
+        collection::const_iterator pos, end = m_collection.end();
+        for (pos = m_collection.begin(); pos != end; ++pos)
+        {
+            if (pos->m_symfile == symfile)
+                dies.push_back (pos->m_die);
+        }
+    }
     
 protected:
     typedef std::vector<UniqueDWARFASTType> collection;
@@ -166,6 +178,16 @@ public:
         return false;
     }
 
+    // Append the DIEs of all the types that SYMFILE added to DIES.
+    void
+    AppendDIEs (const SymbolFileDWARF *symfile,
+                std::vector<const DWARFDebugInfoEntry *> &dies) const
+    {
+        collection::const_iterator pos, end = m_collection.end();
+        for (pos = m_collection.begin(); pos != end; ++pos)
+            pos->second.AppendDIEs (symfile, dies);
+    }
+
 protected:
     // A unique name string should be used
     typedef llvm::DenseMap<const char *, UniqueDWARFASTTypeList> collection;
@@ -153,6 +153,10 @@ SymbolVendorELF::CreateInstance (const lldb::ModuleSP &module_sp, lldb_private::
                         eSectionTypeDWARFDebugPubNames,
                         eSectionTypeDWARFDebugPubTypes,
                         eSectionTypeDWARFDebugRanges,
+                        eSectionTypeDWARFDebugNames,
+                        eSectionTypeDWARFGdbIndex,
+                        eSectionTypeDWARFDebugAddr,
+                        eSectionTypeDWARFDebugStrOffsets,
                         eSectionTypeELFSymbolTable,
                     };
                     for (size_t idx = 0; idx < sizeof(g_sections) / sizeof(g_sections[0]); ++idx)
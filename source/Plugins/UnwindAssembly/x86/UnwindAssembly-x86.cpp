@@ -16,6 +16,7 @@
 #include "lldb/Core/Error.h"
 #include "lldb/Core/ArchSpec.h"
 #include "lldb/Core/PluginManager.h"
+#include "lldb/Host/Mutex.h"
 #include "lldb/Symbol/UnwindPlan.h"
 #include "lldb/Target/ExecutionContext.h"
 #include "lldb/Target/Process.h"
@@ -201,6 +202,10 @@ AssemblyParse_x86::AssemblyParse_x86 (const ExecutionContext &exe_ctx, int cpu,
     if (m_func_bounds.GetByteSize() == 0)
         m_func_bounds.SetByteSize(512);
 
+    // The register maps are shared by everyone unwinding on any thread
+    static Mutex g_register_map_mutex;
+    Mutex::Locker locker (g_register_map_mutex);
+
     Thread *thread = m_exe_ctx.GetThreadPtr();
     if (thread && *initialized_flag == 0)
     {
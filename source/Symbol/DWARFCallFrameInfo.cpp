@@ -321,12 +321,12 @@ DWARFCallFrameInfo::GetFDEIndex ()
     if (m_section_sp.get() == nullptr || m_section_sp->IsEncrypted())
         return;
     
-    if (m_fde_index_initialized)
-        return;
-    
+    // Several threads can unwind at once, only look at m_fde_index_initialized
+    // with the lock held so that a thread that sees it set also sees all of
+    // m_fde_index and m_cie_map.
     Mutex::Locker locker(m_fde_index_mutex);
-    
-    if (m_fde_index_initialized) // if two threads hit the locker
+
+    if (m_fde_index_initialized)
         return;
 
     Timer scoped_timer (__PRETTY_FUNCTION__, "%s - %s", __PRETTY_FUNCTION__, m_objfile.GetFileSpec().GetFilename().AsCString(""));
@@ -17,6 +17,7 @@
 #include "lldb/Target/ABI.h"
 #include "lldb/Target/ExecutionContext.h"
 #include "lldb/Target/Process.h"
+#include "lldb/Target/RegisterContext.h"
 #include "lldb/Target/Thread.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/UnwindAssembly.h"
@@ -81,12 +82,23 @@ FuncUnwinders::GetUnwindPlanAtCallSite (int current_offset)
             if (current_offset != -1)
                 current_pc.SetOffset (current_pc.GetOffset() + current_offset);
 
-            DWARFCallFrameInfo *eh_frame = m_unwind_table.GetEHFrameInfo();
-            if (eh_frame)
+            UnwindPlanCache &plan_cache = m_unwind_table.GetUnwindPlanCache();
+            UnwindPlanSP cached_plan_sp (plan_cache.FindUnwindPlan (m_range, UnwindPlanCache::ePlanKindCallSite));
+            if (cached_plan_sp && cached_plan_sp->PlanValidAtAddress (current_pc))
             {
-                m_unwind_plan_call_site_sp.reset (new UnwindPlan (lldb::eRegisterKindGeneric));
-                if (!eh_frame->GetUnwindPlan (current_pc, *m_unwind_plan_call_site_sp))
-                    m_unwind_plan_call_site_sp.reset();
+                m_unwind_plan_call_site_sp = cached_plan_sp;
+            }
+            else
+            {
+                DWARFCallFrameInfo *eh_frame = m_unwind_table.GetEHFrameInfo();
+                if (eh_frame)
+                {
+                    m_unwind_plan_call_site_sp.reset (new UnwindPlan (lldb::eRegisterKindGeneric));
+                    if (eh_frame->GetUnwindPlan (current_pc, *m_unwind_plan_call_site_sp))
+                        plan_cache.AddUnwindPlan (m_range, UnwindPlanCache::ePlanKindCallSite, m_unwind_plan_call_site_sp);
+                    else
+                        m_unwind_plan_call_site_sp.reset();
+                }
             }
         }
     }
@@ -111,11 +123,19 @@ FuncUnwinders::GetUnwindPlanAtNonCallSite (Thread& thread)
     Mutex::Locker locker (m_mutex);
     if (m_tried_unwind_at_non_call_site == false && m_unwind_plan_non_call_site_sp.get() == nullptr)
     {
-        UnwindAssemblySP assembly_profiler_sp (GetUnwindAssemblyProfiler());
+        m_tried_unwind_at_non_call_site = true;
+        // Profiling the assembly means emulating every instruction in the
+        // function, use the plan from an earlier session if we have one.
+        m_unwind_plan_non_call_site_sp = m_unwind_table.GetUnwindPlanCache().FindUnwindPlan (m_range, UnwindPlanCache::ePlanKindNonCallSite);
+        UnwindAssemblySP assembly_profiler_sp;
+        if (!m_unwind_plan_non_call_site_sp)
+            assembly_profiler_sp = GetUnwindAssemblyProfiler();
         if (assembly_profiler_sp)
         {
             m_unwind_plan_non_call_site_sp.reset (new UnwindPlan (lldb::eRegisterKindGeneric));
-            if (!assembly_profiler_sp->GetNonCallSiteUnwindPlanFromAssembly (m_range, thread, *m_unwind_plan_non_call_site_sp))
+            if (assembly_profiler_sp->GetNonCallSiteUnwindPlanFromAssembly (m_range, thread, *m_unwind_plan_non_call_site_sp))
+                AddUnwindPlanToCache (thread, UnwindPlanCache::ePlanKindNonCallSite, m_unwind_plan_non_call_site_sp);
+            else
                 m_unwind_plan_non_call_site_sp.reset();
         }
     }
@@ -141,11 +161,16 @@ FuncUnwinders::GetUnwindPlanFastUnwind (Thread& thread)
     if (m_tried_unwind_fast == false && m_unwind_plan_fast_sp.get() == nullptr)
     {
         m_tried_unwind_fast = true;
-        UnwindAssemblySP assembly_profiler_sp (GetUnwindAssemblyProfiler());
+        m_unwind_plan_fast_sp = m_unwind_table.GetUnwindPlanCache().FindUnwindPlan (m_range, UnwindPlanCache::ePlanKindFast);
+        UnwindAssemblySP assembly_profiler_sp;
+        if (!m_unwind_plan_fast_sp)
+            assembly_profiler_sp = GetUnwindAssemblyProfiler();
         if (assembly_profiler_sp)
         {
             m_unwind_plan_fast_sp.reset (new UnwindPlan (lldb::eRegisterKindGeneric));
-            if (!assembly_profiler_sp->GetFastUnwindPlan (m_range, thread, *m_unwind_plan_fast_sp))
+            if (assembly_profiler_sp->GetFastUnwindPlan (m_range, thread, *m_unwind_plan_fast_sp))
+                AddUnwindPlanToCache (thread, UnwindPlanCache::ePlanKindFast, m_unwind_plan_fast_sp);
+            else
                 m_unwind_plan_fast_sp.reset();
         }
     }
@@ -228,6 +253,7 @@ FuncUnwinders::GetUnwindPlanArchitectureDefaultAtFunctionEntry (Thread& thread)
 Address&
 FuncUnwinders::GetFirstNonPrologueInsn (Target& target)
 {
+    Mutex::Locker locker (m_mutex);
     if (m_first_non_prologue_insn.IsValid())
         return m_first_non_prologue_insn;
     ExecutionContext exe_ctx (target.shared_from_this(), false);
@@ -248,9 +274,12 @@ void
 FuncUnwinders::InvalidateNonCallSiteUnwindPlan (lldb_private::Thread& thread)
 {
     UnwindPlanSP arch_default = GetUnwindPlanArchitectureDefault (thread);
+    Mutex::Locker locker (m_mutex);
     if (arch_default && m_tried_unwind_at_call_site)
     {
         m_unwind_plan_call_site_sp = arch_default;
+        // Don't hand the plan we just gave up on to the next session.
+        m_unwind_table.GetUnwindPlanCache().RemoveUnwindPlan (m_range, UnwindPlanCache::ePlanKindCallSite);
     }
 }
 
@@ -265,3 +294,23 @@ FuncUnwinders::GetUnwindAssemblyProfiler ()
     }
     return assembly_profiler_sp;
 }
+
+// The assembly profilers number registers in the eRegisterKindLLDB scheme,
+// which depends on the register context that is in use and can't be saved
+// for another session, so cache a copy in the eh_frame numbering instead.
+void
+FuncUnwinders::AddUnwindPlanToCache (Thread& thread, UnwindPlanCache::PlanKind kind, const UnwindPlanSP &unwind_plan_sp)
+{
+    UnwindPlanSP cache_plan_sp (unwind_plan_sp);
+    if (unwind_plan_sp->GetRegisterKind() == eRegisterKindLLDB)
+    {
+        RegisterContextSP reg_ctx_sp (thread.GetRegisterContext());
+        if (reg_ctx_sp)
+        {
+            UnwindPlanSP converted_plan_sp (UnwindPlanCache::ConvertRegisterKind (*unwind_plan_sp, *reg_ctx_sp, eRegisterKindGCC));
+            if (converted_plan_sp)
+                cache_plan_sp = converted_plan_sp;
+        }
+    }
+    m_unwind_table.GetUnwindPlanCache().AddUnwindPlan (m_range, kind, cache_plan_sp);
+}
@@ -369,6 +369,11 @@ ObjectFile::GetAddressClass (addr_t file_addr)
                     case eSectionTypeDWARFAppleTypes:
                     case eSectionTypeDWARFAppleNamespaces:
                     case eSectionTypeDWARFAppleObjC:
+                    case eSectionTypeDWARFDebugNames:
+                    case eSectionTypeDWARFGdbIndex:
+                    case eSectionTypeDWARFDebugAddr:
+                    case eSectionTypeDWARFDebugStrOffsets:
+                    case eSectionTypeDWARFDebugCUIndex:
                         return eAddressClassDebug;
                     case eSectionTypeEHFrame:
                         return eAddressClassRuntime;
@@ -599,15 +604,23 @@ ObjectFile::ClearSymtab ()
 }
 
 SectionList *
-ObjectFile::GetSectionList()
+ObjectFile::GetSectionList(bool update_module_section_list)
 {
     if (m_sections_ap.get() == nullptr)
     {
-        ModuleSP module_sp(GetModule());
-        if (module_sp)
+        if (update_module_section_list)
         {
-            lldb_private::Mutex::Locker locker(module_sp->GetMutex());
-            CreateSections(*module_sp->GetUnifiedSectionList());
+            ModuleSP module_sp(GetModule());
+            if (module_sp)
+            {
+                lldb_private::Mutex::Locker locker(module_sp->GetMutex());
+                CreateSections(*module_sp->GetUnifiedSectionList());
+            }
+        }
+        else
+        {
+            SectionList unified_section_list;
+            CreateSections(unified_section_list);
         }
     }
     return m_sections_ap.get();
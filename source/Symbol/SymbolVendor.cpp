@@ -360,6 +360,19 @@ SymbolVendor::GetTypes (SymbolContextScope *sc_scope,
     return 0;
 }
 
+size_t
+SymbolVendor::ReleaseUnusedMemory ()
+{
+    ModuleSP module_sp(GetModule());
+    if (module_sp)
+    {
+        lldb_private::Mutex::Locker locker(module_sp->GetMutex());
+        if (m_sym_file_ap.get())
+            return m_sym_file_ap->ReleaseUnusedMemory ();
+    }
+    return 0;
+}
+
 ClangNamespaceDecl
 SymbolVendor::FindNamespace(const SymbolContext& sc, const ConstString &name, const ClangNamespaceDecl *parent_namespace_decl)
 {
@@ -7,7 +7,11 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <string.h>
+
+#include <algorithm>
 #include <map>
+#include <set>
 
 #include "lldb/Core/Module.h"
 #include "lldb/Core/RegularExpression.h"
@@ -18,6 +22,8 @@
 #include "lldb/Symbol/Symtab.h"
 #include "lldb/Target/CPPLanguageRuntime.h"
 #include "lldb/Target/ObjCLanguageRuntime.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Utility/TaskPool.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -31,7 +37,8 @@ Symtab::Symtab(ObjectFile *objfile) :
     m_name_to_index (),
     m_mutex (Mutex::eMutexTypeRecursive),
     m_file_addr_to_index_computed (false),
-    m_name_indexes_computed (false)
+    m_name_indexes_computed (false),
+    m_demangled_names_pending (false)
 {
 }
 
@@ -67,6 +74,7 @@ Symtab::AddSymbol(const Symbol& symbol)
     m_symbols.push_back(symbol);
     m_file_addr_to_index_computed = false;
     m_name_indexes_computed = false;
+    m_demangled_names_pending = false;
     return symbol_idx;
 }
 
@@ -246,6 +254,156 @@ Symtab::SymbolAtIndex(size_t idx) const
     return nullptr;
 }
 
+namespace {
+
+//----------------------------------------------------------------------
+// The name index entries for one contiguous range of symbols. Each
+// chunk is filled in on its own worker thread by
+// Symtab::InitNameIndexes() and the chunks are merged when all of them
+// are done.
+//----------------------------------------------------------------------
+struct NameIndexChunk
+{
+    typedef Symtab::NameToIndexMap NameToIndexMap;
+
+    // A C++ function with a decl context that wasn't yet known to be a
+    // class. These can only be classified once all chunks are done.
+    struct ContextEntry
+    {
+        NameToIndexMap::Entry entry;
+        // Comes from ConstString::GetCString()
+        const char *context;
+    };
+
+    NameToIndexMap name_to_index;
+    NameToIndexMap basename_to_index;
+    NameToIndexMap method_to_index;
+    NameToIndexMap selector_to_index;
+    // The "const char *" in "class_contexts" must come from a ConstString::GetCString()
+    std::set<const char *> class_contexts;
+    std::vector<ContextEntry> context_entries;
+};
+
+} // anonymous namespace
+
+// Split NUM_SYMBOLS symbols into chunks that are handed out to
+// TaskPool workers. Use a few more chunks than workers so that chunks
+// full of C++ symbols don't leave the other workers idle, but don't
+// bother splitting up small symbol tables.
+static size_t
+GetSymbolChunkSize (size_t num_symbols, size_t &num_chunks)
+{
+    const size_t k_min_symbols_per_chunk = 4096;
+    const size_t max_num_chunks = (num_symbols + k_min_symbols_per_chunk - 1) / k_min_symbols_per_chunk;
+    num_chunks = std::min<size_t> (TaskPool::GetNumWorkers() * 4, max_num_chunks);
+    if (num_chunks == 0)
+        num_chunks = 1;
+    return (num_symbols + num_chunks - 1) / num_chunks;
+}
+
+static void
+IndexSymbolNames (const Symbol &symbol, uint32_t symbol_idx, bool lazy_demangling, NameIndexChunk &chunk)
+{
+    // Don't let trampolines get into the lookup by name map
+    // If we ever need the trampoline symbols to be searchable by name
+    // we can remove this and then possibly add a new bool to any of the
+    // Symtab functions that lookup symbols by name to indicate if they
+    // want trampolines.
+    if (symbol.IsTrampoline())
+        return;
+
+    Symtab::NameToIndexMap::Entry entry;
+    entry.value = symbol_idx;
+
+    const Mangled &mangled = symbol.GetMangled();
+    entry.cstring = mangled.GetMangledName().GetCString();
+    if (entry.cstring && entry.cstring[0])
+    {
+        chunk.name_to_index.Append (entry);
+
+        const SymbolType symbol_type = symbol.GetType();
+        if (symbol_type == eSymbolTypeCode || symbol_type == eSymbolTypeResolver)
+        {
+            if (entry.cstring[0] == '_' && entry.cstring[1] == 'Z' &&
+                (entry.cstring[2] != 'T' && // avoid virtual table, VTT structure, typeinfo structure, and typeinfo name
+                 entry.cstring[2] != 'G' && // avoid guard variables
+                 entry.cstring[2] != 'Z'))  // named local entities (if we eventually handle eSymbolTypeData, we will want this back)
+            {
+                ConstString basename;
+                ConstString context;
+                bool has_qualifiers = false;
+                // Most mangled names are simple enough that we can pull the
+                // basename and context right out of them, which is much cheaper
+                // than demangling.
+                if (!lazy_demangling ||
+                    !CPPLanguageRuntime::GetContextAndBasenameFromMangledName (entry.cstring, context, basename, has_qualifiers))
+                {
+                    CPPLanguageRuntime::MethodName cxx_method (mangled.GetDemangledName());
+                    basename.SetString (cxx_method.GetBasename());
+                    context.SetString (cxx_method.GetContext());
+                    has_qualifiers = !cxx_method.GetQualifiers().empty();
+                }
+                entry.cstring = basename.GetCString();
+                if (entry.cstring && entry.cstring[0])
+                {
+                    // ConstString objects permanently store the string in the pool so calling
+                    // GetCString() on the value gets us a const char * that will never go away
+                    const char *const_context = context.GetCString();
+
+                    if (entry.cstring[0] == '~' || has_qualifiers)
+                    {
+                        // The first character of the demangled basename is '~' which
+                        // means we have a class destructor. We can use this information
+                        // to help us know what is a class and what isn't.
+                        chunk.class_contexts.insert(const_context);
+                        chunk.method_to_index.Append (entry);
+                    }
+                    else if (const_context && const_context[0])
+                    {
+                        // We don't know if this is a function basename or a method
+                        // until all symbols have been seen, so remember the context
+                        // and classify the entry once all chunks are done.
+                        NameIndexChunk::ContextEntry context_entry;
+                        context_entry.entry = entry;
+                        context_entry.context = const_context;
+                        chunk.context_entries.push_back (context_entry);
+                    }
+                    else
+                    {
+                        // No context for this function so this has to be a basename
+                        chunk.basename_to_index.Append(entry);
+                    }
+                }
+            }
+        }
+    }
+
+    // When demangling lazily, the demangled names of mangled symbols are
+    // added by Symtab::IndexDemangledNames() when someone looks them up.
+    if (lazy_demangling && mangled.GetMangledName())
+        return;
+
+    entry.cstring = mangled.GetDemangledName().GetCString();
+    if (entry.cstring && entry.cstring[0])
+        chunk.name_to_index.Append (entry);
+
+    // If the demangled name turns out to be an ObjC name, and
+    // is a category name, add the version without categories to the index too.
+    ObjCLanguageRuntime::MethodName objc_method (entry.cstring, true);
+    if (objc_method.IsValid(true))
+    {
+        entry.cstring = objc_method.GetSelector().GetCString();
+        chunk.selector_to_index.Append (entry);
+
+        ConstString objc_method_no_category (objc_method.GetFullNameWithoutCategory(true));
+        if (objc_method_no_category)
+        {
+            entry.cstring = objc_method_no_category.GetCString();
+            chunk.name_to_index.Append (entry);
+        }
+    }
+}
+
 //----------------------------------------------------------------------
 // InitNameIndexes
 //----------------------------------------------------------------------
@@ -257,189 +415,134 @@ Symtab::InitNameIndexes()
     {
         m_name_indexes_computed = true;
         Timer scoped_timer (__PRETTY_FUNCTION__, "%s", __PRETTY_FUNCTION__);
-        // Create the name index vector to be able to quickly search by name
         const size_t num_symbols = m_symbols.size();
-#if 1
-        m_name_to_index.Reserve (num_symbols);
-#else
-        // TODO: benchmark this to see if we save any memory. Otherwise we
-        // will always keep the memory reserved in the vector unless we pull
-        // some STL swap magic and then recopy...
-        uint32_t actual_count = 0;
-        for (const_iterator pos = m_symbols.begin(), end = m_symbols.end();
-             pos != end; 
-             ++pos)
-        {
-            const Mangled &mangled = pos->GetMangled();
-            if (mangled.GetMangledName())
-                ++actual_count;
-            
-            if (mangled.GetDemangledName())
-                ++actual_count;
-        }
+        const bool lazy_demangling = Target::GetGlobalProperties()->GetLazyDemangling();
+        m_demangled_names_pending = lazy_demangling;
 
-        m_name_to_index.Reserve (actual_count);
-#endif
+        // Demangling is by far the most expensive part of building the
+        // name indexes, so split the symbols up into chunks and index
+        // each chunk on a worker thread.
+        size_t num_chunks = 0;
+        const size_t chunk_size = GetSymbolChunkSize (num_symbols, num_chunks);
 
-        NameToIndexMap::Entry entry;
-
-        // The "const char *" in "class_contexts" must come from a ConstString::GetCString()
+        std::vector<NameIndexChunk> chunks (num_chunks);
+        TaskPool::MapOverIndexes (0, num_chunks, [&](uint32_t chunk_idx)
+        {
+            NameIndexChunk &chunk = chunks[chunk_idx];
+            const size_t begin = chunk_idx * chunk_size;
+            const size_t end = std::min<size_t> (begin + chunk_size, num_symbols);
+            chunk.name_to_index.Reserve (end > begin ? end - begin : 0);
+            for (size_t i=begin; i<end; ++i)
+                IndexSymbolNames (m_symbols[i], i, lazy_demangling, chunk);
+        });
+
+        // A decl context is a class if any chunk found a destructor or
+        // a qualified method in it.
         std::set<const char *> class_contexts;
-        UniqueCStringMap<uint32_t> mangled_name_to_index;
-        std::vector<const char *> symbol_contexts(num_symbols, nullptr);
+        for (size_t i=0; i<num_chunks; ++i)
+            class_contexts.insert (chunks[i].class_contexts.begin(), chunks[i].class_contexts.end());
 
-        for (entry.value = 0; entry.value<num_symbols; ++entry.value)
+        TaskPool::MapOverIndexes (0, num_chunks, [&](uint32_t chunk_idx)
         {
-            const Symbol *symbol = &m_symbols[entry.value];
-
-            // Don't let trampolines get into the lookup by name map
-            // If we ever need the trampoline symbols to be searchable by name
-            // we can remove this and then possibly add a new bool to any of the
-            // Symtab functions that lookup symbols by name to indicate if they
-            // want trampolines.
-            if (symbol->IsTrampoline())
-                continue;
-
-            const Mangled &mangled = symbol->GetMangled();
-            entry.cstring = mangled.GetMangledName().GetCString();
-            if (entry.cstring && entry.cstring[0])
+            NameIndexChunk &chunk = chunks[chunk_idx];
+            for (size_t i=0; i<chunk.context_entries.size(); ++i)
             {
-                m_name_to_index.Append (entry);
-                
-                const SymbolType symbol_type = symbol->GetType();
-                if (symbol_type == eSymbolTypeCode || symbol_type == eSymbolTypeResolver)
+                const NameIndexChunk::ContextEntry &context_entry = chunk.context_entries[i];
+                if (class_contexts.find(context_entry.context) != class_contexts.end())
                 {
-                    if (entry.cstring[0] == '_' && entry.cstring[1] == 'Z' &&
-                        (entry.cstring[2] != 'T' && // avoid virtual table, VTT structure, typeinfo structure, and typeinfo name
-                         entry.cstring[2] != 'G' && // avoid guard variables
-                         entry.cstring[2] != 'Z'))  // named local entities (if we eventually handle eSymbolTypeData, we will want this back)
-                    {
-                        CPPLanguageRuntime::MethodName cxx_method (mangled.GetDemangledName());
-                        entry.cstring = ConstString(cxx_method.GetBasename()).GetCString();
-                        if (entry.cstring && entry.cstring[0])
-                        {
-                            // ConstString objects permanently store the string in the pool so calling
-                            // GetCString() on the value gets us a const char * that will never go away
-                            const char *const_context = ConstString(cxx_method.GetContext()).GetCString();
-
-                            if (entry.cstring[0] == '~' || !cxx_method.GetQualifiers().empty())
-                            {
-                                // The first character of the demangled basename is '~' which
-                                // means we have a class destructor. We can use this information
-                                // to help us know what is a class and what isn't.
-                                if (class_contexts.find(const_context) == class_contexts.end())
-                                    class_contexts.insert(const_context);
-                                m_method_to_index.Append (entry);
-                            }
-                            else
-                            {
-                                if (const_context && const_context[0])
-                                {
-                                    if (class_contexts.find(const_context) != class_contexts.end())
-                                    {
-                                        // The current decl context is in our "class_contexts" which means
-                                        // this is a method on a class
-                                        m_method_to_index.Append (entry);
-                                    }
-                                    else
-                                    {
-                                        // We don't know if this is a function basename or a method,
-                                        // so put it into a temporary collection so once we are done
-                                        // we can look in class_contexts to see if each entry is a class
-                                        // or just a function and will put any remaining items into
-                                        // m_method_to_index or m_basename_to_index as needed
-                                        mangled_name_to_index.Append (entry);
-                                        symbol_contexts[entry.value] = const_context;
-                                    }
-                                }
-                                else
-                                {
-                                    // No context for this function so this has to be a basename
-                                    m_basename_to_index.Append(entry);
-                                }
-                            }
-                        }
-                    }
+                    // The decl context is in our "class_contexts" which means
+                    // this is a method on a class
+                    chunk.method_to_index.Append (context_entry.entry);
                 }
-            }
-            
-            entry.cstring = mangled.GetDemangledName().GetCString();
-            if (entry.cstring && entry.cstring[0])
-                m_name_to_index.Append (entry);
-                
-            // If the demangled name turns out to be an ObjC name, and
-            // is a category name, add the version without categories to the index too.
-            ObjCLanguageRuntime::MethodName objc_method (entry.cstring, true);
-            if (objc_method.IsValid(true))
-            {
-                entry.cstring = objc_method.GetSelector().GetCString();
-                m_selector_to_index.Append (entry);
-                
-                ConstString objc_method_no_category (objc_method.GetFullNameWithoutCategory(true));
-                if (objc_method_no_category)
+                else
                 {
-                    entry.cstring = objc_method_no_category.GetCString();
-                    m_name_to_index.Append (entry);
+                    // If we got here, we have something that had a context (was inside a namespace or class)
+                    // yet we don't know if the entry
+                    chunk.method_to_index.Append (context_entry.entry);
+                    chunk.basename_to_index.Append (context_entry.entry);
                 }
             }
-                                                        
-        }
-        
-        size_t count;
-        if (!mangled_name_to_index.IsEmpty())
+        });
+
+        // Merge the chunks into the final maps in symbol order and sort
+        // them, one map per worker.
+        NameToIndexMap *maps[] = { &m_name_to_index, &m_basename_to_index, &m_method_to_index, &m_selector_to_index };
+        NameToIndexMap NameIndexChunk::*chunk_maps[] = { &NameIndexChunk::name_to_index,
+                                                         &NameIndexChunk::basename_to_index,
+                                                         &NameIndexChunk::method_to_index,
+                                                         &NameIndexChunk::selector_to_index };
+        TaskPool::MapOverIndexes (0, sizeof(maps)/sizeof(maps[0]), [&](uint32_t map_idx)
         {
-            count = mangled_name_to_index.GetSize();
-            for (size_t i=0; i<count; ++i)
+            NameToIndexMap &map = *maps[map_idx];
+            size_t num_entries = 0;
+            for (size_t i=0; i<num_chunks; ++i)
+                num_entries += (chunks[i].*chunk_maps[map_idx]).GetSize();
+            map.Reserve (num_entries);
+            for (size_t i=0; i<num_chunks; ++i)
             {
-                if (mangled_name_to_index.GetValueAtIndex(i, entry.value))
-                {
-                    entry.cstring = mangled_name_to_index.GetCStringAtIndex(i);
-                    if (symbol_contexts[entry.value] && class_contexts.find(symbol_contexts[entry.value]) != class_contexts.end())
-                    {
-                        m_method_to_index.Append (entry);
-                    }
-                    else
-                    {
-                        // If we got here, we have something that had a context (was inside a namespace or class)
-                        // yet we don't know if the entry
-                        m_method_to_index.Append (entry);
-                        m_basename_to_index.Append (entry);
-                    }
-                }
+                NameToIndexMap &chunk_map = chunks[i].*chunk_maps[map_idx];
+                map.Append (chunk_map);
+                chunk_map.Clear();
             }
-        }
-        m_name_to_index.Sort();
-        m_name_to_index.SizeToFit();
-        m_selector_to_index.Sort();
-        m_selector_to_index.SizeToFit();
-        m_basename_to_index.Sort();
-        m_basename_to_index.SizeToFit();
-        m_method_to_index.Sort();
-        m_method_to_index.SizeToFit();
-    
-//        static StreamFile a ("/tmp/a.txt");
-//
-//        count = m_basename_to_index.GetSize();
-//        if (count)
-//        {
-//            for (size_t i=0; i<count; ++i)
-//            {
-//                if (m_basename_to_index.GetValueAtIndex(i, entry.value))
-//                    a.Printf ("%s BASENAME\n", m_symbols[entry.value].GetMangled().GetName().GetCString());
-//            }
-//        }
-//        count = m_method_to_index.GetSize();
-//        if (count)
-//        {
-//            for (size_t i=0; i<count; ++i)
-//            {
-//                if (m_method_to_index.GetValueAtIndex(i, entry.value))
-//                    a.Printf ("%s METHOD\n", m_symbols[entry.value].GetMangled().GetName().GetCString());
-//            }
-//        }
+            map.Sort();
+            map.SizeToFit();
+        });
     }
 }
 
+//----------------------------------------------------------------------
+// IndexDemangledNames
+//
+// Adds the demangled names of all mangled symbols to m_name_to_index
+// when InitNameIndexes() left them out because of lazy demangling.
+//----------------------------------------------------------------------
+void
+Symtab::IndexDemangledNames()
+{
+    // Protected function, no need to lock mutex...
+    if (!m_demangled_names_pending)
+        return;
+    m_demangled_names_pending = false;
+
+    Timer scoped_timer (__PRETTY_FUNCTION__, "%s", __PRETTY_FUNCTION__);
+    const size_t num_symbols = m_symbols.size();
+    size_t num_chunks = 0;
+    const size_t chunk_size = GetSymbolChunkSize (num_symbols, num_chunks);
+
+    std::vector<NameToIndexMap> chunk_maps (num_chunks);
+    TaskPool::MapOverIndexes (0, num_chunks, [&](uint32_t chunk_idx)
+    {
+        const size_t begin = chunk_idx * chunk_size;
+        const size_t end = std::min<size_t> (begin + chunk_size, num_symbols);
+        for (size_t i=begin; i<end; ++i)
+        {
+            const Symbol &symbol = m_symbols[i];
+            if (symbol.IsTrampoline())
+                continue;
+            const Mangled &mangled = symbol.GetMangled();
+            if (!mangled.GetMangledName())
+                continue;
+            const char *demangled_cstr = mangled.GetDemangledName().GetCString();
+            if (demangled_cstr && demangled_cstr[0])
+                chunk_maps[chunk_idx].Append (demangled_cstr, i);
+        }
+    });
+
+    for (size_t i=0; i<num_chunks; ++i)
+        m_name_to_index.Append (chunk_maps[i]);
+    m_name_to_index.Sort();
+    m_name_to_index.SizeToFit();
+}
+
+// Returns true if NAME could be the demangled name of an Itanium C++
+// mangled symbol. Those always contain a parameter list, a decl context
+// or template arguments, or are special names like "vtable for Foo".
+static bool
+NameMayBeDemangledCPPName (const char *name)
+{
+    return name != NULL && ::strpbrk (name, "(:< ") != NULL;
+}
+
 void
 Symtab::AppendSymbolNamesToMap (const IndexCollection &indexes,
                                 bool add_demangled,
@@ -637,6 +740,8 @@ Symtab::AppendSymbolIndexesWithName (const ConstString& symbol_name, std::vector
         const char *symbol_cstr = symbol_name.GetCString();
         if (!m_name_indexes_computed)
             InitNameIndexes();
+        if (m_demangled_names_pending && NameMayBeDemangledCPPName (symbol_cstr))
+            IndexDemangledNames();
 
         return m_name_to_index.GetValues (symbol_cstr, indexes);
     }
@@ -656,6 +761,8 @@ Symtab::AppendSymbolIndexesWithName (const ConstString& symbol_name, Debug symbo
             InitNameIndexes();
 
         const char *symbol_cstr = symbol_name.GetCString();
+        if (m_demangled_names_pending && NameMayBeDemangledCPPName (symbol_cstr))
+            IndexDemangledNames();
         
         std::vector<uint32_t> all_name_indexes;
         const size_t name_match_count = m_name_to_index.GetValues (symbol_cstr, all_name_indexes);
@@ -214,6 +214,15 @@ UnwindPlan::Row::SetRegisterInfo (uint32_t reg_num, const UnwindPlan::Row::Regis
     m_register_locations[reg_num] = register_location;
 }
 
+size_t
+UnwindPlan::Row::GetRegisterNumbers (std::vector<uint32_t> &reg_nums) const
+{
+    const size_t old_size = reg_nums.size();
+    for (collection::const_iterator pos = m_register_locations.begin(); pos != m_register_locations.end(); ++pos)
+        reg_nums.push_back (pos->first);
+    return reg_nums.size() - old_size;
+}
+
 bool
 UnwindPlan::Row::SetRegisterLocationToAtCFAPlusOffset (uint32_t reg_num, int32_t offset, bool can_replace)
 {
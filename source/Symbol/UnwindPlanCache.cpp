@@ -0,0 +1,442 @@
+//===-- UnwindPlanCache.cpp -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Symbol/UnwindPlanCache.h"
+
+// C Includes
+#include <string.h>
+
+// C++ Includes
+#include <algorithm>
+#include <string>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Core/AddressRange.h"
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/Error.h"
+#include "lldb/Core/Log.h"
+#include "lldb/Core/Section.h"
+#include "lldb/Core/StreamString.h"
+#include "lldb/Core/Timer.h"
+#include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Symbol/UnwindPlan.h"
+#include "lldb/Target/RegisterContext.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+// The data after the ModuleCacheFile header is laid out as:
+//   uint32_t num_entries
+//   num_entries times:
+//     uint64_t function file address
+//     uint64_t function byte size
+//     uint32_t PlanKind
+//     UnwindPlan (see UnwindPlanCache::WriteUnwindPlan)
+static const uint32_t k_cache_magic = 0x504e5755;    // 'UWNP'
+static const uint32_t k_cache_version = 1;
+static const char *k_cache_file_extension = ".unwind-plans";
+// Appended to the source name of plans read from a cache file, so that
+// "image show-unwind" tells them apart from plans computed this session.
+static const char *k_cached_plan_source_suffix = " (from the unwind plan cache)";
+
+// Smallest number of bytes each record in the cache file can take, used to
+// reject counts that can't possibly fit in the remaining data.
+static const uint64_t k_min_entry_size = 8 + 8 + 4;
+static const uint64_t k_min_row_size = 8 + 4 + 4 + 4;
+static const uint64_t k_min_register_size = 4 + 1 + 4;
+
+UnwindPlanCache::UnwindPlanCache (ObjectFile &objfile) :
+    m_object_file (objfile),
+    m_mutex (Mutex::eMutexTypeRecursive),
+    m_entries (),
+    m_cache_file (),
+    m_dirty (false)
+{
+}
+
+UnwindPlanCache::~UnwindPlanCache ()
+{
+}
+
+bool
+UnwindPlanCache::Load (const FileSpec &cache_dir)
+{
+    Mutex::Locker locker (m_mutex);
+
+    if (!m_cache_file.SetObjectFile (cache_dir, k_cache_file_extension, m_object_file) ||
+        !m_cache_file.GetFileSpec().Exists())
+        return false;
+
+    Timer scoped_timer (__PRETTY_FUNCTION__,
+                        "UnwindPlanCache::Load (%s)",
+                        m_cache_file.GetFileSpec().GetPath().c_str());
+
+    Log *log (GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
+
+    DataExtractor data;
+    lldb::offset_t offset = 0;
+    if (!m_cache_file.Read (k_cache_magic, k_cache_version, data, offset, log))
+        return false;
+
+    const uint32_t num_entries = data.GetU32 (&offset);
+    if (!data.ValidOffsetForDataOfSize (offset, num_entries * k_min_entry_size))
+        return false;
+
+    collection entries;
+    entries.reserve (num_entries);
+    for (uint32_t i = 0; i < num_entries; ++i)
+    {
+        Entry entry;
+        entry.func_file_addr = data.GetU64 (&offset);
+        entry.func_byte_size = data.GetU64 (&offset);
+        const uint32_t kind = data.GetU32 (&offset);
+        if (kind >= kNumPlanKinds)
+            return false;
+        entry.kind = (PlanKind)kind;
+        entry.plan_sp.reset (new UnwindPlan (eRegisterKindGeneric));
+        if (!ReadUnwindPlan (data, &offset, *entry.plan_sp))
+        {
+            if (log)
+                log->Printf ("UnwindPlanCache::Load ignoring '%s', entry %u is corrupt", m_cache_file.GetFileSpec().GetPath().c_str(), i);
+            return false;
+        }
+        entries.push_back (entry);
+    }
+
+    // Plans computed before the cache file was read take precedence over
+    // the ones from the file.
+    entries.insert (entries.end(), m_entries.begin(), m_entries.end());
+    std::stable_sort (entries.begin(), entries.end());
+    m_entries.clear();
+    for (iterator pos = entries.begin(); pos != entries.end(); ++pos)
+    {
+        if (!m_entries.empty() && !(m_entries.back() < *pos))
+            m_entries.back() = *pos;
+        else
+            m_entries.push_back (*pos);
+    }
+
+    if (log)
+        log->Printf ("UnwindPlanCache::Load loaded %u unwind plans from '%s'", num_entries, m_cache_file.GetFileSpec().GetPath().c_str());
+    return true;
+}
+
+bool
+UnwindPlanCache::Save (uint64_t max_cache_byte_size)
+{
+    Mutex::Locker locker (m_mutex);
+
+    if (!m_dirty || !m_cache_file.IsValid())
+        return false;
+
+    Timer scoped_timer (__PRETTY_FUNCTION__,
+                        "UnwindPlanCache::Save (%s)",
+                        m_cache_file.GetFileSpec().GetPath().c_str());
+
+    uint32_t num_entries = 0;
+    StreamString entries (Stream::eBinary, 4, eByteOrderLittle);
+    for (iterator pos = m_entries.begin(); pos != m_entries.end(); ++pos)
+    {
+        if (!CanSaveUnwindPlan (*pos->plan_sp))
+            continue;
+        entries.PutHex64 (pos->func_file_addr);
+        entries.PutHex64 (pos->func_byte_size);
+        entries.PutHex32 (pos->kind);
+        WriteUnwindPlan (entries, *pos->plan_sp);
+        ++num_entries;
+    }
+
+    StreamString count (Stream::eBinary, 4, eByteOrderLittle);
+    count.PutHex32 (num_entries);
+
+    const StreamString *parts[] = { &count, &entries };
+    Error error (m_cache_file.Write (k_cache_magic,
+                                     k_cache_version,
+                                     parts,
+                                     sizeof(parts)/sizeof(parts[0]),
+                                     max_cache_byte_size));
+
+    Log *log (GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
+    if (error.Fail())
+    {
+        if (log)
+            log->Printf ("UnwindPlanCache::Save failed to write '%s': %s",
+                         m_cache_file.GetFileSpec().GetPath().c_str(),
+                         error.AsCString());
+        return false;
+    }
+
+    if (log)
+        log->Printf ("UnwindPlanCache::Save wrote %u unwind plans to '%s'",
+                     num_entries,
+                     m_cache_file.GetFileSpec().GetPath().c_str());
+    m_dirty = false;
+    return true;
+}
+
+UnwindPlanSP
+UnwindPlanCache::FindUnwindPlan (const AddressRange &func_range, PlanKind kind)
+{
+    Mutex::Locker locker (m_mutex);
+
+    Entry search_entry;
+    search_entry.func_file_addr = func_range.GetBaseAddress().GetFileAddress();
+    search_entry.func_byte_size = func_range.GetByteSize();
+    search_entry.kind = kind;
+    if (search_entry.func_file_addr == LLDB_INVALID_ADDRESS)
+        return UnwindPlanSP();
+
+    iterator pos = std::lower_bound (m_entries.begin(), m_entries.end(), search_entry);
+    if (pos != m_entries.end() &&
+        pos->func_file_addr == search_entry.func_file_addr &&
+        pos->kind == kind &&
+        pos->func_byte_size == search_entry.func_byte_size)
+        return pos->plan_sp;
+    return UnwindPlanSP();
+}
+
+void
+UnwindPlanCache::AddUnwindPlan (const AddressRange &func_range, PlanKind kind, const UnwindPlanSP &plan_sp)
+{
+    if (!plan_sp)
+        return;
+
+    Mutex::Locker locker (m_mutex);
+
+    Entry entry;
+    entry.func_file_addr = func_range.GetBaseAddress().GetFileAddress();
+    entry.func_byte_size = func_range.GetByteSize();
+    entry.kind = kind;
+    entry.plan_sp = plan_sp;
+    if (entry.func_file_addr == LLDB_INVALID_ADDRESS)
+        return;
+
+    iterator pos = std::lower_bound (m_entries.begin(), m_entries.end(), entry);
+    if (pos != m_entries.end() && !(entry < *pos))
+        *pos = entry;
+    else
+        m_entries.insert (pos, entry);
+
+    if (CanSaveUnwindPlan (*plan_sp))
+        m_dirty = true;
+}
+
+void
+UnwindPlanCache::RemoveUnwindPlan (const AddressRange &func_range, PlanKind kind)
+{
+    Mutex::Locker locker (m_mutex);
+
+    Entry search_entry;
+    search_entry.func_file_addr = func_range.GetBaseAddress().GetFileAddress();
+    search_entry.func_byte_size = func_range.GetByteSize();
+    search_entry.kind = kind;
+    if (search_entry.func_file_addr == LLDB_INVALID_ADDRESS)
+        return;
+
+    iterator pos = std::lower_bound (m_entries.begin(), m_entries.end(), search_entry);
+    if (pos != m_entries.end() && !(search_entry < *pos))
+    {
+        if (CanSaveUnwindPlan (*pos->plan_sp))
+            m_dirty = true;
+        m_entries.erase (pos);
+    }
+}
+
+size_t
+UnwindPlanCache::GetSize ()
+{
+    Mutex::Locker locker (m_mutex);
+    return m_entries.size();
+}
+
+UnwindPlanSP
+UnwindPlanCache::ConvertRegisterKind (const UnwindPlan &plan, RegisterContext &reg_ctx, RegisterKind kind)
+{
+    const RegisterKind plan_kind = plan.GetRegisterKind();
+
+    UnwindPlanSP converted_sp (new UnwindPlan (kind));
+    converted_sp->SetPlanValidAddressRange (plan.GetAddressRange());
+    converted_sp->SetSourceName (plan.GetSourceName().AsCString(""));
+    converted_sp->SetSourcedFromCompiler (plan.GetSourcedFromCompiler());
+    converted_sp->SetUnwindPlanValidAtAllInstructions (plan.GetUnwindPlanValidAtAllInstructions());
+
+    uint32_t return_addr_reg = const_cast<UnwindPlan &>(plan).GetReturnAddressRegister();
+    if (return_addr_reg != LLDB_INVALID_REGNUM)
+    {
+        if (!reg_ctx.ConvertBetweenRegisterKinds (plan_kind, return_addr_reg, kind, return_addr_reg))
+            return UnwindPlanSP();
+        converted_sp->SetReturnAddressRegister (return_addr_reg);
+    }
+
+    std::vector<uint32_t> reg_nums;
+    const int num_rows = plan.GetRowCount();
+    for (int row_idx = 0; row_idx < num_rows; ++row_idx)
+    {
+        const UnwindPlan::RowSP row_sp (plan.GetRowAtIndex (row_idx));
+        UnwindPlan::RowSP new_row_sp (new UnwindPlan::Row);
+        new_row_sp->SetOffset (row_sp->GetOffset());
+        new_row_sp->SetCFAOffset (row_sp->GetCFAOffset());
+
+        uint32_t cfa_reg = row_sp->GetCFARegister();
+        if (cfa_reg != LLDB_INVALID_REGNUM && !reg_ctx.ConvertBetweenRegisterKinds (plan_kind, cfa_reg, kind, cfa_reg))
+            return UnwindPlanSP();
+        new_row_sp->SetCFARegister (cfa_reg);
+
+        reg_nums.clear();
+        row_sp->GetRegisterNumbers (reg_nums);
+        for (size_t i = 0; i < reg_nums.size(); ++i)
+        {
+            UnwindPlan::Row::RegisterLocation reg_loc;
+            row_sp->GetRegisterInfo (reg_nums[i], reg_loc);
+
+            uint32_t reg_num;
+            if (!reg_ctx.ConvertBetweenRegisterKinds (plan_kind, reg_nums[i], kind, reg_num))
+                return UnwindPlanSP();
+
+            uint32_t other_reg_num = reg_loc.GetRegisterNumber();
+            if (other_reg_num != LLDB_INVALID_REGNUM)
+            {
+                if (!reg_ctx.ConvertBetweenRegisterKinds (plan_kind, other_reg_num, kind, other_reg_num))
+                    return UnwindPlanSP();
+                reg_loc.SetInRegister (other_reg_num);
+            }
+            new_row_sp->SetRegisterInfo (reg_num, reg_loc);
+        }
+        converted_sp->AppendRow (new_row_sp);
+    }
+    return converted_sp;
+}
+
+bool
+UnwindPlanCache::CanSaveUnwindPlan (const UnwindPlan &plan)
+{
+    if (plan.GetRegisterKind() == eRegisterKindLLDB)
+        return false;
+
+    std::vector<uint32_t> reg_nums;
+    const int num_rows = plan.GetRowCount();
+    for (int row_idx = 0; row_idx < num_rows; ++row_idx)
+    {
+        const UnwindPlan::RowSP row_sp (plan.GetRowAtIndex (row_idx));
+        reg_nums.clear();
+        row_sp->GetRegisterNumbers (reg_nums);
+        for (size_t i = 0; i < reg_nums.size(); ++i)
+        {
+            UnwindPlan::Row::RegisterLocation reg_loc;
+            row_sp->GetRegisterInfo (reg_nums[i], reg_loc);
+            if (reg_loc.IsAtDWARFExpression() || reg_loc.IsDWARFExpression())
+                return false;
+        }
+    }
+    return true;
+}
+
+bool
+UnwindPlanCache::ReadUnwindPlan (const DataExtractor &data, lldb::offset_t *offset_ptr, UnwindPlan &plan)
+{
+    plan.SetRegisterKind ((RegisterKind)data.GetU32 (offset_ptr));
+    plan.SetReturnAddressRegister (data.GetU32 (offset_ptr));
+    plan.SetSourcedFromCompiler ((LazyBool)(int8_t)data.GetU8 (offset_ptr));
+    plan.SetUnwindPlanValidAtAllInstructions ((LazyBool)(int8_t)data.GetU8 (offset_ptr));
+    const char *source_name = data.GetCStr (offset_ptr);
+    if (source_name == NULL)
+        return false;
+    std::string plan_source (source_name);
+    const size_t suffix_len = ::strlen (k_cached_plan_source_suffix);
+    if (plan_source.size() < suffix_len ||
+        plan_source.compare (plan_source.size() - suffix_len, suffix_len, k_cached_plan_source_suffix) != 0)
+        plan_source.append (k_cached_plan_source_suffix);
+    plan.SetSourceName (plan_source.c_str());
+
+    const addr_t range_file_addr = data.GetU64 (offset_ptr);
+    const addr_t range_byte_size = data.GetU64 (offset_ptr);
+    if (range_file_addr != LLDB_INVALID_ADDRESS)
+    {
+        Address range_base;
+        if (range_base.ResolveAddressUsingFileSections (range_file_addr, m_object_file.GetSectionList()))
+            plan.SetPlanValidAddressRange (AddressRange (range_base, range_byte_size));
+    }
+
+    const uint32_t num_rows = data.GetU32 (offset_ptr);
+    if (!data.ValidOffsetForDataOfSize (*offset_ptr, num_rows * k_min_row_size))
+        return false;
+    for (uint32_t row_idx = 0; row_idx < num_rows; ++row_idx)
+    {
+        UnwindPlan::RowSP row_sp (new UnwindPlan::Row);
+        row_sp->SetOffset (data.GetU64 (offset_ptr));
+        row_sp->SetCFARegister (data.GetU32 (offset_ptr));
+        row_sp->SetCFAOffset ((int32_t)data.GetU32 (offset_ptr));
+
+        const uint32_t num_regs = data.GetU32 (offset_ptr);
+        if (!data.ValidOffsetForDataOfSize (*offset_ptr, num_regs * k_min_register_size))
+            return false;
+        for (uint32_t i = 0; i < num_regs; ++i)
+        {
+            const uint32_t reg_num = data.GetU32 (offset_ptr);
+            const uint8_t type = data.GetU8 (offset_ptr);
+            const uint32_t value = data.GetU32 (offset_ptr);
+            UnwindPlan::Row::RegisterLocation reg_loc;
+            switch (type)
+            {
+                case UnwindPlan::Row::RegisterLocation::unspecified:     reg_loc.SetUnspecified(); break;
+                case UnwindPlan::Row::RegisterLocation::undefined:       reg_loc.SetUndefined(); break;
+                case UnwindPlan::Row::RegisterLocation::same:            reg_loc.SetSame(); break;
+                case UnwindPlan::Row::RegisterLocation::atCFAPlusOffset: reg_loc.SetAtCFAPlusOffset ((int32_t)value); break;
+                case UnwindPlan::Row::RegisterLocation::isCFAPlusOffset: reg_loc.SetIsCFAPlusOffset ((int32_t)value); break;
+                case UnwindPlan::Row::RegisterLocation::inOtherRegister: reg_loc.SetInRegister (value); break;
+                default:
+                    return false;
+            }
+            row_sp->SetRegisterInfo (reg_num, reg_loc);
+        }
+        plan.AppendRow (row_sp);
+    }
+    return true;
+}
+
+void
+UnwindPlanCache::WriteUnwindPlan (Stream &strm, const UnwindPlan &plan)
+{
+    strm.PutHex32 (plan.GetRegisterKind());
+    strm.PutHex32 (const_cast<UnwindPlan &>(plan).GetReturnAddressRegister());
+    strm.PutHex8 ((uint8_t)plan.GetSourcedFromCompiler());
+    strm.PutHex8 ((uint8_t)plan.GetUnwindPlanValidAtAllInstructions());
+    strm.PutCString (plan.GetSourceName().AsCString(""));
+
+    const AddressRange &range = plan.GetAddressRange();
+    strm.PutHex64 (range.GetBaseAddress().GetFileAddress());
+    strm.PutHex64 (range.GetByteSize());
+
+    std::vector<uint32_t> reg_nums;
+    const int num_rows = plan.GetRowCount();
+    strm.PutHex32 (num_rows);
+    for (int row_idx = 0; row_idx < num_rows; ++row_idx)
+    {
+        const UnwindPlan::RowSP row_sp (plan.GetRowAtIndex (row_idx));
+        strm.PutHex64 (row_sp->GetOffset());
+        strm.PutHex32 (row_sp->GetCFARegister());
+        strm.PutHex32 ((uint32_t)row_sp->GetCFAOffset());
+
+        reg_nums.clear();
+        row_sp->GetRegisterNumbers (reg_nums);
+        strm.PutHex32 (reg_nums.size());
+        for (size_t i = 0; i < reg_nums.size(); ++i)
+        {
+            UnwindPlan::Row::RegisterLocation reg_loc;
+            row_sp->GetRegisterInfo (reg_nums[i], reg_loc);
+            strm.PutHex32 (reg_nums[i]);
+            strm.PutHex8 (reg_loc.GetLocationType());
+            if (reg_loc.IsInOtherRegister())
+                strm.PutHex32 (reg_loc.GetRegisterNumber());
+            else
+                strm.PutHex32 ((uint32_t)reg_loc.GetOffset());
+        }
+    }
+}
@@ -17,6 +17,7 @@
 #include "lldb/Symbol/FuncUnwinders.h"
 #include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Symbol/DWARFCallFrameInfo.h"
+#include "lldb/Target/Target.h"
 
 // There is one UnwindTable object per ObjectFile.
 // It contains a list of Unwind objects -- one per function, populated lazily -- for the ObjectFile.
@@ -30,7 +31,8 @@ UnwindTable::UnwindTable (ObjectFile& objfile) :
     m_unwinds (),
     m_initialized (false),
     m_mutex (),
-    m_eh_frame (nullptr)
+    m_eh_frame (nullptr),
+    m_plan_cache (objfile)
 {
 }
 
@@ -40,12 +42,11 @@ UnwindTable::UnwindTable (ObjectFile& objfile) :
 void
 UnwindTable::Initialize ()
 {
-    if (m_initialized)
-        return;
-
+    // Always take the lock, several threads can be unwinding at once and
+    // m_eh_frame must be set before they see m_initialized.
     Mutex::Locker locker(m_mutex);
 
-    if (m_initialized) // check again once we've acquired the lock
+    if (m_initialized)
         return;
 
     SectionList* sl = m_object_file.GetSectionList ();
@@ -57,6 +58,10 @@ UnwindTable::Initialize ()
             m_eh_frame = new DWARFCallFrameInfo(m_object_file, sect, eRegisterKindGCC, true);
         }
     }
+
+    FileSpec cache_dir (Target::GetDefaultUnwindPlanCachePath());
+    if (cache_dir)
+        m_plan_cache.Load (cache_dir);
     
     m_initialized = true;
 }
@@ -159,3 +164,18 @@ UnwindTable::GetArchitecture (lldb_private::ArchSpec &arch)
 {
     return m_object_file.GetArchitecture (arch);
 }
+
+UnwindPlanCache &
+UnwindTable::GetUnwindPlanCache ()
+{
+    Initialize();
+    return m_plan_cache;
+}
+
+bool
+UnwindTable::SaveUnwindPlanCache (uint64_t max_cache_byte_size)
+{
+    if (!m_initialized)
+        return false;
+    return m_plan_cache.Save (max_cache_byte_size);
+}
@@ -9,6 +9,7 @@
 
 #include "lldb/Target/CPPLanguageRuntime.h"
 
+#include <ctype.h>
 #include <string.h>
 
 #include "lldb/Core/PluginManager.h"
@@ -216,6 +217,137 @@ CPPLanguageRuntime::StripNamespacesFromVariableName (const char *name, const cha
     }
 }
 
+// Parse a <source-name> ("3foo") at the start of S into NAME and
+// advance S past it.
+static bool
+ParseMangledSourceName (llvm::StringRef &s, llvm::StringRef &name)
+{
+    size_t len = 0;
+    size_t pos = 0;
+    while (pos < s.size() && isdigit(s[pos]))
+        len = len * 10 + (s[pos++] - '0');
+    if (pos == 0 || len == 0 || pos + len > s.size())
+        return false;
+    name = s.substr(pos, len);
+    // Anonymous namespaces demangle to "(anonymous namespace)"
+    if (name.startswith("_GLOBAL__N"))
+        return false;
+    s = s.substr(pos + len);
+    return true;
+}
+
+bool
+CPPLanguageRuntime::GetContextAndBasenameFromMangledName (const char *mangled_name,
+                                                          ConstString &context,
+                                                          ConstString &basename,
+                                                          bool &has_qualifiers)
+{
+    if (!IsCPPMangledName(mangled_name))
+        return false;
+
+    llvm::StringRef s (mangled_name + 2);
+    // Clone suffixes like ".cold" show up as " [clone .cold]" at the end
+    // of the demangled name, which MethodName sees as qualifiers.
+    if (s.find('.') != llvm::StringRef::npos)
+        return false;
+
+    // Internal linkage doesn't show up in the demangled name
+    if (s.startswith("L"))
+        s = s.drop_front(1);
+
+    std::vector<llvm::StringRef> components;
+    llvm::StringRef name;
+    bool is_destructor = false;
+    has_qualifiers = false;
+
+    if (s.startswith("N"))
+    {
+        // <nested-name> ::= N [<CV-qualifiers>] [<ref-qualifier>] <prefix> <unqualified-name> E
+        s = s.drop_front(1);
+        while (!s.empty() && (s[0] == 'r' || s[0] == 'V' || s[0] == 'K'))
+        {
+            has_qualifiers = true;
+            s = s.drop_front(1);
+        }
+        if (s.startswith("R") || s.startswith("O"))
+        {
+            has_qualifiers = true;
+            s = s.drop_front(1);
+        }
+        if (s.startswith("St"))
+        {
+            components.push_back(llvm::StringRef("std"));
+            s = s.drop_front(2);
+        }
+        while (!s.startswith("E"))
+        {
+            if (s.empty())
+                return false;
+            if (isdigit(s[0]))
+            {
+                if (!ParseMangledSourceName (s, name))
+                    return false;
+                components.push_back(name);
+            }
+            else if (s.size() >= 2 && !components.empty() &&
+                     ((s[0] == 'C' && s[1] >= '1' && s[1] <= '3') ||
+                      (s[0] == 'D' && s[1] >= '0' && s[1] <= '2')))
+            {
+                // Constructors and destructors are named after their class
+                is_destructor = s[0] == 'D';
+                components.push_back(components.back());
+                s = s.drop_front(2);
+                if (!s.startswith("E"))
+                    return false;
+            }
+            else
+            {
+                // Templates, operators, substitutions, ABI tags, ...
+                return false;
+            }
+        }
+        s = s.drop_front(1);
+        if (components.size() < 2)
+            return false;
+    }
+    else
+    {
+        // <unscoped-name> ::= [St] <unqualified-name>
+        if (s.startswith("St"))
+        {
+            components.push_back(llvm::StringRef("std"));
+            s = s.drop_front(2);
+        }
+        if (s.empty() || !isdigit(s[0]) || !ParseMangledSourceName (s, name))
+            return false;
+        components.push_back(name);
+        // Template arguments or ABI tags
+        if (s.startswith("I") || s.startswith("B"))
+            return false;
+    }
+
+    // A function name is followed by its parameter types. Anything else
+    // is a data symbol, which MethodName can't parse either.
+    if (s.empty())
+        return false;
+
+    std::string context_str;
+    for (size_t i=0; i+1<components.size(); ++i)
+    {
+        if (i > 0)
+            context_str.append("::");
+        context_str.append(components[i].data(), components[i].size());
+    }
+    std::string basename_str;
+    if (is_destructor)
+        basename_str.append(1, '~');
+    basename_str.append(components.back().data(), components.back().size());
+
+    context.SetCString(context_str.c_str());
+    basename.SetCString(basename_str.c_str());
+    return true;
+}
+
 uint32_t
 CPPLanguageRuntime::FindEquivalentNames(ConstString type_name, std::vector<ConstString>& equivalents)
 {
@@ -11,6 +11,7 @@
 // C Includes
 #include <inttypes.h>
 // C++ Includes
+#include <algorithm>
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Core/DataBufferHeap.h"
@@ -21,6 +22,48 @@
 using namespace lldb;
 using namespace lldb_private;
 
+namespace {
+
+//----------------------------------------------------------------------
+// A cache line that shares the buffer that several cache lines were read
+// into with a single process memory read.
+//----------------------------------------------------------------------
+class CacheLineBuffer : public DataBuffer
+{
+public:
+    CacheLineBuffer (const DataBufferSP &data_sp, size_t offset, size_t byte_size) :
+        m_data_sp (data_sp),
+        m_offset (offset),
+        m_byte_size (byte_size)
+    {
+    }
+
+    virtual uint8_t *
+    GetBytes ()
+    {
+        return m_data_sp->GetBytes() + m_offset;
+    }
+
+    virtual const uint8_t *
+    GetBytes () const
+    {
+        return m_data_sp->GetBytes() + m_offset;
+    }
+
+    virtual lldb::offset_t
+    GetByteSize () const
+    {
+        return m_byte_size;
+    }
+
+private:
+    DataBufferSP m_data_sp;
+    size_t m_offset;
+    size_t m_byte_size;
+};
+
+} // anonymous namespace
+
 //----------------------------------------------------------------------
 // MemoryCache constructor
 //----------------------------------------------------------------------
@@ -29,7 +72,12 @@ MemoryCache::MemoryCache(Process &process) :
     m_cache_line_byte_size (512),
     m_mutex (Mutex::eMutexTypeRecursive),
     m_cache (),
-    m_invalid_ranges ()
+    m_invalid_ranges (),
+    m_stats (),
+    m_last_miss_addr (LLDB_INVALID_ADDRESS),
+    m_last_miss_stride (0),
+    m_next_read_addr (LLDB_INVALID_ADDRESS),
+    m_read_ahead_line_count (1)
 {
 }
 
@@ -47,6 +95,24 @@ MemoryCache::Clear(bool clear_invalid_ranges)
     m_cache.clear();
     if (clear_invalid_ranges)
         m_invalid_ranges.Clear();
+    m_last_miss_addr = LLDB_INVALID_ADDRESS;
+    m_last_miss_stride = 0;
+    m_next_read_addr = LLDB_INVALID_ADDRESS;
+    m_read_ahead_line_count = 1;
+}
+
+void
+MemoryCache::GetStatistics (Statistics &stats) const
+{
+    Mutex::Locker locker (m_mutex);
+    stats = m_stats;
+}
+
+void
+MemoryCache::ResetStatistics ()
+{
+    Mutex::Locker locker (m_mutex);
+    m_stats = Statistics();
 }
 
 void
@@ -130,6 +196,10 @@ MemoryCache::Read (addr_t addr,
     // it in the cache.
     if (dst && dst_len > m_cache_line_byte_size)
     {
+        {
+            Mutex::Locker locker (m_mutex);
+            ++m_stats.num_uncached_reads;
+        }
         return m_process.ReadMemoryFromInferior (addr, dst, dst_len, error);
     }
 
@@ -140,7 +210,20 @@ MemoryCache::Read (addr_t addr,
         addr_t curr_addr = addr - (addr % cache_line_byte_size);
         addr_t cache_offset = addr - curr_addr;
         Mutex::Locker locker (m_mutex);
+        bool line_was_read = false;
         
+        // If the read straddles two cache lines, try to get both of them
+        // from the process with a single request if it can do that.
+        const addr_t last_addr = addr + dst_len - 1;
+        const addr_t last_cache_line_addr = last_addr - (last_addr % cache_line_byte_size);
+        if (last_cache_line_addr > curr_addr && m_process.CanReadMemoryRanges())
+        {
+            std::vector<addr_t> line_addrs;
+            line_addrs.push_back (curr_addr);
+            line_addrs.push_back (last_cache_line_addr);
+            FetchCacheLines (line_addrs);
+        }
+
         while (bytes_left > 0)
         {
             if (m_invalid_ranges.FindEntryThatContains(curr_addr))
@@ -154,7 +237,16 @@ MemoryCache::Read (addr_t addr,
             
             if (pos != end)
             {
-                size_t curr_read_size = cache_line_byte_size - cache_offset;
+                // The line we just read from the process isn't a hit
+                if (!line_was_read)
+                    ++m_stats.num_line_hits;
+                line_was_read = false;
+
+                // The line might have been only partially readable
+                const size_t line_byte_size = pos->second->GetByteSize();
+                if (cache_offset >= line_byte_size)
+                    return dst_len - bytes_left;
+                size_t curr_read_size = line_byte_size - cache_offset;
                 if (curr_read_size > bytes_left)
                     curr_read_size = bytes_left;
                 
@@ -164,6 +256,9 @@ MemoryCache::Read (addr_t addr,
                 curr_addr += curr_read_size + cache_offset;
                 cache_offset = 0;
                 
+                if (bytes_left > 0 && line_byte_size != cache_line_byte_size)
+                    return dst_len - bytes_left;
+
                 if (bytes_left > 0)
                 {
                     // Get sequential cache page hits
@@ -174,6 +269,7 @@ MemoryCache::Read (addr_t addr,
                         if (pos->first != curr_addr)
                             break;
                         
+                        ++m_stats.num_line_hits;
                         curr_read_size = pos->second->GetByteSize();
                         if (curr_read_size > bytes_left)
                             curr_read_size = bytes_left;
@@ -197,17 +293,10 @@ MemoryCache::Read (addr_t addr,
             if (bytes_left > 0)
             {
                 assert ((curr_addr % cache_line_byte_size) == 0);
-                std::unique_ptr<DataBufferHeap> data_buffer_heap_ap(new DataBufferHeap (cache_line_byte_size, 0));
-                size_t process_bytes_read = m_process.ReadMemoryFromInferior (curr_addr, 
-                                                                              data_buffer_heap_ap->GetBytes(), 
-                                                                              data_buffer_heap_ap->GetByteSize(), 
-                                                                              error);
-                if (process_bytes_read == 0)
+                ++m_stats.num_line_misses;
+                if (ReadCacheLines (curr_addr, CalculateLinesToRead (curr_addr), error) == 0)
                     return dst_len - bytes_left;
-                
-                if (process_bytes_read != cache_line_byte_size)
-                    data_buffer_heap_ap->SetByteSize (process_bytes_read);
-                m_cache[curr_addr] = DataBufferSP (data_buffer_heap_ap.release());
+                line_was_read = true;
                 // We have read data and put it into the cache, continue through the
                 // loop again to get the data out of the cache...
             }
@@ -219,6 +308,185 @@ MemoryCache::Read (addr_t addr,
 
 
 
+void
+MemoryCache::Prefetch (const addr_t *addrs, size_t num_addrs)
+{
+    if (addrs == NULL || num_addrs == 0)
+        return;
+
+    const uint32_t cache_line_byte_size = m_cache_line_byte_size;
+    std::vector<addr_t> line_addrs;
+    line_addrs.reserve (num_addrs);
+    for (size_t i=0; i<num_addrs; ++i)
+    {
+        if (addrs[i] != LLDB_INVALID_ADDRESS && addrs[i] != 0)
+            line_addrs.push_back (addrs[i] - (addrs[i] % cache_line_byte_size));
+    }
+
+    Mutex::Locker locker (m_mutex);
+    FetchCacheLines (line_addrs);
+}
+
+void
+MemoryCache::FetchCacheLines (std::vector<addr_t> &line_addrs)
+{
+    // Only fetch the lines we don't already have, and don't bother with
+    // lines that are known to be unreadable.
+    std::sort (line_addrs.begin(), line_addrs.end());
+    line_addrs.erase (std::unique (line_addrs.begin(), line_addrs.end()), line_addrs.end());
+    std::vector<addr_t> missing_addrs;
+    for (size_t i=0; i<line_addrs.size(); ++i)
+    {
+        if (m_cache.find (line_addrs[i]) == m_cache.end() &&
+            m_invalid_ranges.FindEntryThatContains (line_addrs[i]) == NULL)
+            missing_addrs.push_back (line_addrs[i]);
+    }
+
+    // A single cache line is read just as quickly by MemoryCache::Read().
+    const size_t num_lines = missing_addrs.size();
+    if (num_lines < 2)
+        return;
+
+    const uint32_t cache_line_byte_size = m_cache_line_byte_size;
+    std::vector<DataBufferHeap *> buffers (num_lines);
+    std::vector<uint8_t *> bufs (num_lines);
+    std::vector<size_t> sizes (num_lines, cache_line_byte_size);
+    std::vector<size_t> bytes_read (num_lines, 0);
+    for (size_t i=0; i<num_lines; ++i)
+    {
+        buffers[i] = new DataBufferHeap (cache_line_byte_size, 0);
+        bufs[i] = buffers[i]->GetBytes();
+    }
+
+    Error error;
+    ++m_stats.num_process_reads;
+    const size_t num_lines_read = m_process.ReadMemoryRangesFromInferior (num_lines,
+                                                                          &missing_addrs[0],
+                                                                          &sizes[0],
+                                                                          &bufs[0],
+                                                                          &bytes_read[0],
+                                                                          false,
+                                                                          error);
+    for (size_t i=0; i<num_lines; ++i)
+    {
+        std::unique_ptr<DataBufferHeap> data_buffer_heap_ap (buffers[i]);
+        if (i >= num_lines_read || bytes_read[i] == 0)
+            continue;
+        ++m_stats.num_prefetched_lines;
+        m_stats.num_process_bytes_read += bytes_read[i];
+        if (bytes_read[i] != cache_line_byte_size)
+            data_buffer_heap_ap->SetByteSize (bytes_read[i]);
+        m_cache[missing_addrs[i]] = DataBufferSP (data_buffer_heap_ap.release());
+    }
+}
+
+uint32_t
+MemoryCache::CalculateLinesToRead (addr_t line_addr)
+{
+    // Read ahead at most as much as the process lets us read in one go.
+    const uint32_t cache_line_byte_size = m_cache_line_byte_size;
+    const size_t max_read_size = m_process.GetMemoryReadAheadSize();
+    const uint32_t max_num_lines = max_read_size > cache_line_byte_size ? max_read_size / cache_line_byte_size : 1;
+
+    // Memory is being walked forward if this miss comes right after the
+    // lines we read last time, or within the distance of one read-ahead
+    // window from them, or if it is the same distance from the last miss
+    // as the last miss was from the one before.
+    bool walking_forward = false;
+    addr_t stride = 0;
+    if (m_last_miss_addr != LLDB_INVALID_ADDRESS && line_addr > m_last_miss_addr)
+    {
+        stride = line_addr - m_last_miss_addr;
+        if (m_next_read_addr != LLDB_INVALID_ADDRESS && line_addr >= m_next_read_addr &&
+            line_addr - m_next_read_addr < (addr_t)m_read_ahead_line_count * cache_line_byte_size)
+            walking_forward = true;
+        else if (stride == m_last_miss_stride)
+            walking_forward = true;
+    }
+    m_last_miss_addr = line_addr;
+    m_last_miss_stride = stride;
+
+    // Reading ahead doesn't help if the stride is so large that most of
+    // the data we read would be skipped.
+    if (walking_forward && stride <= max_read_size / 2)
+    {
+        m_read_ahead_line_count *= 2;
+        if (m_read_ahead_line_count > max_num_lines)
+            m_read_ahead_line_count = max_num_lines;
+    }
+    else
+    {
+        m_read_ahead_line_count = 1;
+    }
+    return m_read_ahead_line_count;
+}
+
+size_t
+MemoryCache::ReadCacheLines (addr_t line_addr, uint32_t num_lines, Error &error)
+{
+    const uint32_t cache_line_byte_size = m_cache_line_byte_size;
+
+    // Stop the read at the first line that we already have, that is known
+    // to be unreadable, or that would wrap around the address space.
+    for (uint32_t i=1; i<num_lines; ++i)
+    {
+        const addr_t next_line_addr = line_addr + (addr_t)i * cache_line_byte_size;
+        if (next_line_addr < line_addr ||
+            m_cache.find (next_line_addr) != m_cache.end() ||
+            m_invalid_ranges.FindEntryThatContains (next_line_addr))
+        {
+            num_lines = i;
+            break;
+        }
+    }
+
+    // Read straight into the buffer that will back the cache lines.
+    DataBufferHeap *data_buffer = new DataBufferHeap (num_lines * cache_line_byte_size, 0);
+    DataBufferSP data_buffer_sp (data_buffer);
+    ++m_stats.num_process_reads;
+    size_t process_bytes_read = m_process.ReadMemoryFromInferior (line_addr,
+                                                                  data_buffer->GetBytes(),
+                                                                  data_buffer->GetByteSize(),
+                                                                  error);
+    if (process_bytes_read == 0 && num_lines > 1)
+    {
+        // Some of the read-ahead lines might not be readable and the
+        // process might not support partial reads, so try again with just
+        // the line that is needed.
+        num_lines = 1;
+        m_read_ahead_line_count = 1;
+        error.Clear();
+        ++m_stats.num_process_reads;
+        process_bytes_read = m_process.ReadMemoryFromInferior (line_addr,
+                                                               data_buffer->GetBytes(),
+                                                               cache_line_byte_size,
+                                                               error);
+    }
+    if (process_bytes_read == 0)
+        return 0;
+
+    m_stats.num_process_bytes_read += process_bytes_read;
+    m_next_read_addr = line_addr + (addr_t)num_lines * cache_line_byte_size;
+
+    if (process_bytes_read <= cache_line_byte_size)
+    {
+        // A single line owns the whole buffer.
+        data_buffer->SetByteSize (process_bytes_read);
+        m_cache[line_addr] = data_buffer_sp;
+        return process_bytes_read;
+    }
+
+    // Each cache line refers to its part of the buffer.
+    for (size_t offset = 0; offset < process_bytes_read; offset += cache_line_byte_size)
+    {
+        const size_t line_byte_size = std::min<size_t> (cache_line_byte_size, process_bytes_read - offset);
+        if (offset > 0)
+            ++m_stats.num_read_ahead_lines;
+        m_cache[line_addr + offset] = DataBufferSP (new CacheLineBuffer (data_buffer_sp, offset, line_byte_size));
+    }
+    return process_bytes_read;
+}
+
 AllocatedBlock::AllocatedBlock (lldb::addr_t addr, 
                                 uint32_t byte_size, 
                                 uint32_t permissions,
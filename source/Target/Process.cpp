@@ -111,6 +111,8 @@ g_properties[] =
     { "python-os-plugin-path", OptionValue::eTypeFileSpec, false, true, NULL, NULL, "A path to a python OS plug-in module file that contains a OperatingSystemPlugIn class." },
     { "stop-on-sharedlibrary-events" , OptionValue::eTypeBoolean, true, false, NULL, NULL, "If true, stop when a shared library is loaded or unloaded." },
     { "detach-keeps-stopped" , OptionValue::eTypeBoolean, true, false, NULL, NULL, "If true, detach will attempt to keep the process stopped." },
+    { "memory-cache-read-ahead-size", OptionValue::eTypeUInt64, false, 0, NULL, NULL, "The largest number of bytes the memory cache reads from the process at once when it sees memory being read sequentially. "
+                                                                                                       "Zero uses the largest read the process plugin can do efficiently, which disables reading ahead for plug-ins that don't have one. The process plugin's limit is never exceeded." },
     {  NULL                  , OptionValue::eTypeInvalid, false, 0, NULL, NULL, NULL  }
 };
 
@@ -121,7 +123,8 @@ enum {
     ePropertyUnwindOnErrorInExpressions,
     ePropertyPythonOSPluginPath,
     ePropertyStopOnSharedLibraryEvents,
-    ePropertyDetachKeepsStopped
+    ePropertyDetachKeepsStopped,
+    ePropertyMemoryCacheReadAheadSize
 };
 
 ProcessProperties::ProcessProperties (bool is_global) :
@@ -238,6 +241,13 @@ ProcessProperties::SetDetachKeepsStopped (bool stop)
     m_collection_sp->SetPropertyAtIndexAsBoolean(NULL, idx, stop);
 }
 
+uint64_t
+ProcessProperties::GetMemoryCacheReadAheadSize () const
+{
+    const uint32_t idx = ePropertyMemoryCacheReadAheadSize;
+    return m_collection_sp->GetPropertyAtIndexAsUInt64(NULL, idx, g_properties[idx].default_uint_value);
+}
+
 void
 ProcessInstanceInfo::Dump (Stream &s, Platform *platform) const
 {
@@ -2666,6 +2676,67 @@ Process::ReadMemoryFromInferior (addr_t addr, void *buf, size_t size, Error &err
     return bytes_read;
 }
 
+size_t
+Process::ReadMemoryRangesFromInferior (size_t num_ranges,
+                                       const addr_t *addrs,
+                                       const size_t *sizes,
+                                       uint8_t *const *bufs,
+                                       size_t *bytes_read,
+                                       bool allow_fallback,
+                                       Error &error)
+{
+    size_t num_ranges_read = 0;
+    while (num_ranges_read < num_ranges)
+    {
+        const size_t curr_ranges_read = DoReadMemoryRanges (num_ranges - num_ranges_read,
+                                                            addrs + num_ranges_read,
+                                                            sizes + num_ranges_read,
+                                                            bufs + num_ranges_read,
+                                                            bytes_read + num_ranges_read,
+                                                            error);
+        if (curr_ranges_read == 0)
+            break;
+        num_ranges_read += curr_ranges_read;
+    }
+
+    // Replace any software breakpoint opcodes that fall into the ranges
+    // back into the buffers before we return
+    for (size_t i=0; i<num_ranges_read; ++i)
+    {
+        if (bytes_read[i] > 0)
+            RemoveBreakpointOpcodesFromBuffer (addrs[i], bytes_read[i], bufs[i]);
+    }
+
+    if (allow_fallback)
+    {
+        for (; num_ranges_read < num_ranges; ++num_ranges_read)
+        {
+            bytes_read[num_ranges_read] = ReadMemoryFromInferior (addrs[num_ranges_read],
+                                                                  bufs[num_ranges_read],
+                                                                  sizes[num_ranges_read],
+                                                                  error);
+        }
+    }
+    return num_ranges_read;
+}
+
+void
+Process::PrefetchMemory (const addr_t *addrs, size_t num_addrs)
+{
+    if (num_addrs > 1 && !GetDisableMemoryCache() && CanReadMemoryRanges())
+        m_memory_cache.Prefetch (addrs, num_addrs);
+}
+
+size_t
+Process::GetMemoryReadAheadSize ()
+{
+    const size_t max_read_size = GetMaxMemoryReadSize();
+    const uint64_t read_ahead_size = GetMemoryCacheReadAheadSize();
+    if (read_ahead_size > 0 && (max_read_size == 0 || read_ahead_size < max_read_size))
+        return read_ahead_size;
+    return max_read_size;
+}
+
 uint64_t
 Process::ReadUnsignedIntegerFromMemory (lldb::addr_t vm_addr, size_t integer_byte_size, uint64_t fail_value, Error &error)
 {
@@ -31,6 +31,7 @@
 #include "lldb/Target/RegisterContext.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
+#include "lldb/Target/Unwind.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -239,6 +240,19 @@ StackFrame::SetSymbolContextScope (SymbolContextScope *symbol_scope)
     m_id.SetSymbolContextScope (symbol_scope);
 }
 
+const char *
+StackFrame::GetUnwindMethod ()
+{
+    ThreadSP thread_sp (GetThread());
+    if (thread_sp)
+    {
+        Unwind *unwinder = thread_sp->GetUnwinder();
+        if (unwinder)
+            return unwinder->GetUnwindMethodAtIndex (GetConcreteFrameIndex());
+    }
+    return NULL;
+}
+
 const Address&
 StackFrame::GetFrameCodeAddress()
 {
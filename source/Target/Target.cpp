@@ -43,6 +43,7 @@
 #include "lldb/Interpreter/Property.h"
 #include "lldb/lldb-private-log.h"
 #include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Symbol/UnwindTable.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/SectionLoadList.h"
 #include "lldb/Target/StackFrame.h"
@@ -83,6 +84,8 @@ Target::Target(Debugger &debugger, const ArchSpec &target_arch, const lldb::Plat
     m_scratch_ast_source_ap (),
     m_ast_importer_ap (),
     m_persistent_variables (),
+    m_user_expression_cache (),
+    m_user_expression_cache_mutex (Mutex::eMutexTypeNormal),
     m_source_manager_ap(),
     m_stop_hooks (),
     m_stop_hook_next_id (0),
@@ -162,6 +165,8 @@ Target::DeleteCurrentProcess ()
     if (m_process_sp.get())
     {
         m_section_load_history.Clear();
+        // The cached expressions refer to memory in this process
+        ClearUserExpressionCache();
         if (m_process_sp->IsAlive())
             m_process_sp->Destroy();
         
@@ -205,6 +210,7 @@ Target::Destroy()
     m_search_filter_sp.reset();
     m_image_search_paths.Clear(notify);
     m_persistent_variables.Clear();
+    ClearUserExpressionCache();
     m_stop_hooks.clear();
     m_stop_hook_next_id = 0;
     m_suppress_stop_hooks = false;
@@ -1176,6 +1182,7 @@ Target::ModulesDidLoad (ModuleList &module_list)
 {
     if (m_valid && module_list.GetSize())
     {
+        ClearUserExpressionCache();
         m_breakpoint_list.UpdateBreakpoints (module_list, true, false);
         if (m_process_sp)
         {
@@ -1191,6 +1198,7 @@ Target::SymbolsDidLoad (ModuleList &module_list)
 {
     if (m_valid && module_list.GetSize())
     {
+        ClearUserExpressionCache();
         if (m_process_sp)
         {
             LanguageRuntime* runtime = m_process_sp->GetLanguageRuntime(lldb::eLanguageTypeObjC);
@@ -1209,8 +1217,22 @@ Target::SymbolsDidLoad (ModuleList &module_list)
 void
 Target::ModulesDidUnload (ModuleList &module_list, bool delete_locations)
 {
+    // Modules can outlive the target in the shared module list, so write out
+    // the unwind plans computed during this session as soon as the modules
+    // leave the target, including when the target is destroyed.
+    const uint64_t max_unwind_plan_cache_byte_size = GetDefaultUnwindPlanCacheMaxByteSize();
+    const size_t num_modules = module_list.GetSize();
+    for (size_t i = 0; i < num_modules; ++i)
+    {
+        ModuleSP module_sp (module_list.GetModuleAtIndex(i));
+        ObjectFile *objfile = module_sp ? module_sp->GetObjectFile() : NULL;
+        if (objfile)
+            objfile->GetUnwindTable().SaveUnwindPlanCache (max_unwind_plan_cache_byte_size);
+    }
+
     if (m_valid && module_list.GetSize())
     {
+        ClearUserExpressionCache();
         m_breakpoint_list.UpdateBreakpoints (module_list, false, delete_locations);
         // TODO: make event data that packages up the module_list
         BroadcastEvent (eBroadcastBitModulesUnloaded, NULL);
@@ -1820,6 +1842,24 @@ Target::GetDefaultDebugFileSearchPaths ()
     return FileSpecList();
 }
 
+FileSpec
+Target::GetDefaultUnwindPlanCachePath ()
+{
+    TargetPropertiesSP properties_sp(Target::GetGlobalProperties());
+    if (properties_sp)
+        return properties_sp->GetUnwindPlanCachePath();
+    return FileSpec();
+}
+
+uint64_t
+Target::GetDefaultUnwindPlanCacheMaxByteSize ()
+{
+    TargetPropertiesSP properties_sp(Target::GetGlobalProperties());
+    if (properties_sp)
+        return properties_sp->GetUnwindPlanCacheMaxByteSize();
+    return 0;
+}
+
 ArchSpec
 Target::GetDefaultArchitecture ()
 {
@@ -1920,6 +1960,72 @@ Target::EvaluateExpression
     return execution_results;
 }
 
+// The expression cache is bounded so that evaluating lots of different
+// expressions (e.g. in a script) doesn't keep all their JITed code and
+// ASTs around.
+static const size_t g_max_cached_user_expressions = 64;
+
+std::shared_ptr<ClangUserExpression>
+Target::GetCachedUserExpression (const std::string &key)
+{
+    Mutex::Locker locker (m_user_expression_cache_mutex);
+    UserExpressionCache::iterator pos = m_user_expression_cache.find (key);
+    if (pos != m_user_expression_cache.end())
+        return pos->second;
+    return std::shared_ptr<ClangUserExpression>();
+}
+
+void
+Target::CacheUserExpression (const std::string &key,
+                             const std::shared_ptr<ClangUserExpression> &user_expression_sp)
+{
+    // Destroy the evicted expressions outside the lock, see
+    // ClearUserExpressionCache()
+    UserExpressionCache evicted_user_expressions;
+    std::shared_ptr<ClangUserExpression> replaced_user_expression_sp;
+    {
+        Mutex::Locker locker (m_user_expression_cache_mutex);
+        UserExpressionCache::iterator pos = m_user_expression_cache.find (key);
+        if (pos != m_user_expression_cache.end())
+        {
+            replaced_user_expression_sp.swap (pos->second);
+            pos->second = user_expression_sp;
+        }
+        else
+        {
+            if (m_user_expression_cache.size() >= g_max_cached_user_expressions)
+                evicted_user_expressions.swap (m_user_expression_cache);
+            m_user_expression_cache[key] = user_expression_sp;
+        }
+    }
+}
+
+void
+Target::RemoveCachedUserExpression (const std::string &key)
+{
+    std::shared_ptr<ClangUserExpression> user_expression_sp;
+    {
+        Mutex::Locker locker (m_user_expression_cache_mutex);
+        UserExpressionCache::iterator pos = m_user_expression_cache.find (key);
+        if (pos == m_user_expression_cache.end())
+            return;
+        user_expression_sp.swap (pos->second);
+        m_user_expression_cache.erase (pos);
+    }
+}
+
+void
+Target::ClearUserExpressionCache ()
+{
+    // Destroy the expressions outside the lock, tearing down their JITed
+    // code may need to talk to the process
+    UserExpressionCache user_expression_cache;
+    {
+        Mutex::Locker locker (m_user_expression_cache_mutex);
+        user_expression_cache.swap (m_user_expression_cache);
+    }
+}
+
 lldb::addr_t
 Target::GetCallableLoadAddress (lldb::addr_t load_addr, AddressClass addr_class) const
 {
@@ -2666,6 +2772,11 @@ g_properties[] =
         "'minimal' is the fastest setting and will load section data with no symbols, but should rarely be used as stack frames in these memory regions will be inaccurate and not provide any context (fastest). " },
     { "display-expression-in-crashlogs"    , OptionValue::eTypeBoolean   , false, false,                      NULL, NULL, "Expressions that crash will show up in crash logs if the host system supports executable specific crash log strings and this setting is set to true." },
     { "trap-handler-names"                 , OptionValue::eTypeArray     , true,  OptionValue::eTypeString,   NULL, NULL, "A list of trap handler function names, e.g. a common Unix user process one is _sigtramp." },
+    { "lazy-demangling"                    , OptionValue::eTypeBoolean   , false, false,                      NULL, NULL, "Index C++ symbols by the basename and context that can be read straight from their mangled names, and only demangle symbol names when they are displayed or looked up by their demangled name. "
+        "This makes loading modules with many C++ symbols faster. Symbol tables that were already indexed are not affected when this setting changes." },
+    { "unwind-plan-cache-path"             , OptionValue::eTypeFileSpec  , false, 0,                          NULL, NULL, "A directory in which the unwind plans computed for each module are saved, keyed by the module UUID, so that later debug sessions can reuse them instead of profiling the function assembly again. "
+        "Unwind plans are not saved when this setting is empty." },
+    { "unwind-plan-cache-max-size"         , OptionValue::eTypeUInt64    , false, 2048,                       NULL, NULL, "The maximum total size in megabytes of all files in the unwind plan cache directory. The least recently written files are removed when the cache grows beyond this size. Zero means the cache size is unlimited." },
     { NULL                                 , OptionValue::eTypeInvalid   , false, 0                         , NULL, NULL, NULL }
 };
 enum
@@ -2700,7 +2811,10 @@ enum
     ePropertyLoadScriptFromSymbolFile,
     ePropertyMemoryModuleLoadLevel,
     ePropertyDisplayExpressionsInCrashlogs,
-    ePropertyTrapHandlerNames
+    ePropertyTrapHandlerNames,
+    ePropertyLazyDemangling,
+    ePropertyUnwindPlanCachePath,
+    ePropertyUnwindPlanCacheMaxSize
 };
 
 
@@ -3100,6 +3214,27 @@ TargetProperties::GetDisplayExpressionsInCrashlogs () const
     return m_collection_sp->GetPropertyAtIndexAsBoolean (NULL, idx, g_properties[idx].default_uint_value != 0);
 }
 
+bool
+TargetProperties::GetLazyDemangling () const
+{
+    const uint32_t idx = ePropertyLazyDemangling;
+    return m_collection_sp->GetPropertyAtIndexAsBoolean (NULL, idx, g_properties[idx].default_uint_value != 0);
+}
+
+FileSpec
+TargetProperties::GetUnwindPlanCachePath () const
+{
+    const uint32_t idx = ePropertyUnwindPlanCachePath;
+    return m_collection_sp->GetPropertyAtIndexAsFileSpec(NULL, idx);
+}
+
+uint64_t
+TargetProperties::GetUnwindPlanCacheMaxByteSize () const
+{
+    const uint32_t idx = ePropertyUnwindPlanCacheMaxSize;
+    return m_collection_sp->GetPropertyAtIndexAsUInt64 (NULL, idx, g_properties[idx].default_uint_value) * 1024 * 1024;
+}
+
 LoadScriptFromSymFile
 TargetProperties::GetLoadScriptFromSymbolFile () const
 {
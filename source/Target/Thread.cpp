@@ -68,6 +68,8 @@ g_properties[] =
     { "step-avoid-regexp",  OptionValue::eTypeRegex  , true , REG_EXTENDED, "^std::", NULL, "A regular expression defining functions step-in won't stop in." },
     { "step-avoid-libraries",  OptionValue::eTypeFileSpecList  , true , REG_EXTENDED, NULL, NULL, "A list of libraries that source stepping won't stop in." },
     { "trace-thread",       OptionValue::eTypeBoolean, false, false, NULL, NULL, "If true, this thread will single-step and log execution." },
+    { "frame-pointer-unwind", OptionValue::eTypeBoolean, false, false, NULL, NULL, "If true, backtraces follow the frame pointer chain and only build the full unwind plan of a function when the chain "
+                                                                                    "looks invalid. This is much faster, but registers other than the pc, sp and fp may not be available in frames that are unwound this way." },
     {  NULL               , OptionValue::eTypeInvalid, false, 0    , NULL, NULL, NULL  }
 };
 
@@ -76,7 +78,8 @@ enum {
     ePropertyStepOutAvoidsNoDebug,
     ePropertyStepAvoidRegex,
     ePropertyStepAvoidLibraries,
-    ePropertyEnableThreadTrace
+    ePropertyEnableThreadTrace,
+    ePropertyFramePointerUnwind
 };
 
 
@@ -157,6 +160,13 @@ ThreadProperties::GetTraceEnabledState() const
     return m_collection_sp->GetPropertyAtIndexAsBoolean (NULL, idx, g_properties[idx].default_uint_value != 0);
 }
 
+bool
+ThreadProperties::GetFramePointerUnwind() const
+{
+    const uint32_t idx = ePropertyFramePointerUnwind;
+    return m_collection_sp->GetPropertyAtIndexAsBoolean (NULL, idx, g_properties[idx].default_uint_value != 0);
+}
+
 bool
 ThreadProperties::GetStepInAvoidsNoDebug() const
 {
@@ -0,0 +1,161 @@
+//===-- LZ4Block.cpp --------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Utility/LZ4Block.h"
+
+// C Includes
+#include <string.h>
+
+// C++ Includes
+#include <algorithm>
+#include <vector>
+
+// Other libraries and framework includes
+// Project includes
+
+static const size_t k_lz4_min_match = 4;
+static const size_t k_lz4_last_literals = 5;    // The last 5 bytes are always literals
+static const size_t k_lz4_match_find_limit = 12;// No match can start within the last 12 bytes
+static const uint32_t k_lz4_hash_log = 12;
+
+static inline uint32_t
+ReadLZ4Sequence (const uint8_t *p)
+{
+    uint32_t value;
+    ::memcpy (&value, p, sizeof(value));
+    return value;
+}
+
+static void
+PutLZ4Length (std::string &dst, size_t length)
+{
+    while (length >= 255)
+    {
+        dst.push_back ((char)255);
+        length -= 255;
+    }
+    dst.push_back ((char)length);
+}
+
+static void
+PutLZ4Sequence (std::string &dst,
+                const uint8_t *literals,
+                size_t literal_length,
+                size_t match_offset,
+                size_t match_length)
+{
+    const size_t token_match_length = match_length ? match_length - k_lz4_min_match : 0;
+    uint8_t token = (uint8_t)(std::min<size_t>(literal_length, 15) << 4);
+    if (match_length)
+        token |= (uint8_t)std::min<size_t>(token_match_length, 15);
+    dst.push_back ((char)token);
+    if (literal_length >= 15)
+        PutLZ4Length (dst, literal_length - 15);
+    dst.append ((const char *)literals, literal_length);
+    if (match_length)
+    {
+        dst.push_back ((char)(match_offset & 0xff));
+        dst.push_back ((char)(match_offset >> 8));
+        if (token_match_length >= 15)
+            PutLZ4Length (dst, token_match_length - 15);
+    }
+}
+
+static bool
+GetLZ4Length (const uint8_t *src, size_t src_len, size_t &pos, size_t &length)
+{
+    while (pos < src_len)
+    {
+        const uint8_t byte = src[pos++];
+        length += byte;
+        if (byte != 255)
+            return true;
+    }
+    return false;
+}
+
+void
+LZ4Block::Compress (const uint8_t *src, size_t src_len, std::string &dst)
+{
+    size_t anchor = 0;
+    if (src_len > k_lz4_match_find_limit)
+    {
+        // Remember the last position each 4 byte sequence was seen at
+        std::vector<uint32_t> hash_table (1u << k_lz4_hash_log, UINT32_MAX);
+        const size_t match_find_end = src_len - k_lz4_match_find_limit;
+        const size_t match_end = src_len - k_lz4_last_literals;
+        size_t pos = 0;
+        while (pos < match_find_end)
+        {
+            const uint32_t sequence = ReadLZ4Sequence (src + pos);
+            const uint32_t hash = (sequence * 2654435761u) >> (32 - k_lz4_hash_log);
+            const uint32_t ref = hash_table[hash];
+            hash_table[hash] = (uint32_t)pos;
+            if (ref != UINT32_MAX && pos - ref <= 0xffff && ReadLZ4Sequence (src + ref) == sequence)
+            {
+                size_t match_length = k_lz4_min_match;
+                while (pos + match_length < match_end && src[ref + match_length] == src[pos + match_length])
+                    ++match_length;
+                PutLZ4Sequence (dst, src + anchor, pos - anchor, pos - ref, match_length);
+                pos += match_length;
+                anchor = pos;
+            }
+            else
+            {
+                ++pos;
+            }
+        }
+    }
+    // The block always ends with a sequence that only has literals
+    PutLZ4Sequence (dst, src + anchor, src_len - anchor, 0, 0);
+}
+
+bool
+LZ4Block::Decompress (const uint8_t *src, size_t src_len, size_t decompressed_size, std::string &dst)
+{
+    dst.clear();
+    dst.reserve (decompressed_size);
+    size_t pos = 0;
+    while (pos < src_len)
+    {
+        const uint8_t token = src[pos++];
+        size_t literal_length = token >> 4;
+        if (literal_length == 15 && !GetLZ4Length (src, src_len, pos, literal_length))
+            return false;
+        if (literal_length > src_len - pos || dst.size() + literal_length > decompressed_size)
+            return false;
+        dst.append ((const char *)src + pos, literal_length);
+        pos += literal_length;
+
+        // The last sequence has no match
+        if (pos == src_len)
+            break;
+
+        if (src_len - pos < 2)
+            return false;
+        const size_t match_offset = src[pos] | (src[pos + 1] << 8);
+        pos += 2;
+        if (match_offset == 0 || match_offset > dst.size())
+            return false;
+        size_t match_length = token & 0xf;
+        if (match_length == 15 && !GetLZ4Length (src, src_len, pos, match_length))
+            return false;
+        match_length += k_lz4_min_match;
+        if (dst.size() + match_length > decompressed_size)
+            return false;
+        // Matches can overlap the bytes they produce, so copy one byte at a time
+        const size_t match_pos = dst.size() - match_offset;
+        for (size_t i = 0; i < match_length; ++i)
+        {
+            const char ch = dst[match_pos + i];
+            dst.push_back (ch);
+        }
+    }
+    return dst.size() == decompressed_size;
+}
@@ -0,0 +1,41 @@
+//===-- LZ4Block.h ----------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef utility_LZ4Block_h_
+#define utility_LZ4Block_h_
+
+// C Includes
+#include <stddef.h>
+#include <stdint.h>
+
+// C++ Includes
+#include <string>
+
+// Other libraries and framework includes
+// Project includes
+
+//----------------------------------------------------------------------
+// A small LZ4 block format codec. It has no dependencies so that both
+// lldb and debugserver can use it to compress gdb-remote packets, and
+// both ends of a connection always have a codec in common.
+//----------------------------------------------------------------------
+namespace LZ4Block
+{
+    // Append the compressed form of SRC to DST.
+    void
+    Compress (const uint8_t *src, size_t src_len, std::string &dst);
+
+    // Replace the contents of DST with the decompressed form of SRC.
+    // Returns false if SRC is malformed or doesn't decompress to exactly
+    // DECOMPRESSED_SIZE bytes.
+    bool
+    Decompress (const uint8_t *src, size_t src_len, size_t decompressed_size, std::string &dst);
+}
+
+#endif  // utility_LZ4Block_h_
@@ -59,6 +59,7 @@ public:
         eServerPacketType_qSpeedTest,
         eServerPacketType_qUserName,
         eServerPacketType_qGetWorkingDir,
+        eServerPacketType_qSupported,
         eServerPacketType_QEnvironment,
         eServerPacketType_QLaunchArch,
         eServerPacketType_QSetDisableASLR,
@@ -68,6 +69,7 @@ public:
         eServerPacketType_QSetSTDERR,
         eServerPacketType_QSetWorkingDir,
         eServerPacketType_QStartNoAckMode,
+        eServerPacketType_QEnableCompression,
         eServerPacketType_qPlatform_shell,
         eServerPacketType_qPlatform_mkdir,
         eServerPacketType_qPlatform_chmod,
@@ -101,6 +103,7 @@ public:
         eServerPacketType_qGDBServerVersion,
         eServerPacketType_qMemoryRegionInfo,
         eServerPacketType_qMemoryRegionInfoSupported,
+        eServerPacketType_qMultiMemRead,
         eServerPacketType_qProcessInfo,
         eServerPacketType_qRcmd,
         eServerPacketType_qRegisterInfo,
@@ -0,0 +1,115 @@
+//===-- TaskPool.cpp --------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/TaskPool.h"
+
+#include <atomic>
+#include <vector>
+
+#include "lldb/Host/Host.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+static std::atomic<uint32_t> g_max_num_workers(0);
+
+namespace {
+
+struct MapOverIndexesInfo
+{
+    MapOverIndexesInfo (uint32_t begin,
+                        uint32_t end,
+                        const TaskPool::IndexCallback &callback) :
+        next_idx (begin),
+        end_idx (end),
+        callback (callback)
+    {
+    }
+
+    std::atomic<uint32_t> next_idx;
+    const uint32_t end_idx;
+    const TaskPool::IndexCallback &callback;
+};
+
+} // anonymous namespace
+
+static void
+RunWorker (MapOverIndexesInfo &info)
+{
+    while (true)
+    {
+        const uint32_t idx = info.next_idx.fetch_add(1);
+        if (idx >= info.end_idx)
+            break;
+        info.callback(idx);
+    }
+}
+
+static thread_result_t
+WorkerThread (void *arg)
+{
+    RunWorker (*static_cast<MapOverIndexesInfo *>(arg));
+    return thread_result_t();
+}
+
+uint32_t
+TaskPool::GetNumWorkers ()
+{
+    uint32_t num_workers = Host::GetNumberCPUS();
+    if (num_workers == 0)
+        num_workers = 1;
+    const uint32_t max_num_workers = g_max_num_workers;
+    if (max_num_workers > 0 && max_num_workers < num_workers)
+        num_workers = max_num_workers;
+    return num_workers;
+}
+
+void
+TaskPool::SetMaxNumWorkers (uint32_t max_num_workers)
+{
+    g_max_num_workers = max_num_workers;
+}
+
+void
+TaskPool::MapOverIndexes (uint32_t begin,
+                          uint32_t end,
+                          const IndexCallback &callback)
+{
+    if (begin >= end)
+        return;
+
+    MapOverIndexesInfo info (begin, end, callback);
+
+    // The calling thread is one of the workers, so only spawn threads
+    // for the remaining ones.
+    uint32_t num_threads = GetNumWorkers();
+    if (num_threads > end - begin)
+        num_threads = end - begin;
+    --num_threads;
+
+    std::vector<thread_t> threads;
+    threads.reserve(num_threads);
+    for (uint32_t i=0; i<num_threads; ++i)
+    {
+        thread_t thread = Host::ThreadCreate ("<lldb.utility.task-pool.worker>",
+                                              WorkerThread,
+                                              &info,
+                                              NULL);
+        // If we can't create a thread, the remaining work will just
+        // get done by the threads we already have.
+        if (!IS_VALID_LLDB_HOST_THREAD(thread))
+            break;
+        threads.push_back(thread);
+    }
+
+    RunWorker (info);
+
+    for (size_t i=0; i<threads.size(); ++i)
+        Host::ThreadJoin (threads[i], NULL, NULL);
+}
@@ -398,6 +398,11 @@ lldb_private::GetSectionTypeAsCString (SectionType sect_type)
     case eSectionTypeDWARFAppleNamespaces: return "apple-namespaces";
     case eSectionTypeDWARFAppleObjC: return "apple-objc";
     case eSectionTypeEHFrame: return "eh-frame";
+    case eSectionTypeDWARFDebugNames: return "dwarf-names";
+    case eSectionTypeDWARFGdbIndex: return "gdb-index";
+    case eSectionTypeDWARFDebugAddr: return "dwarf-addr";
+    case eSectionTypeDWARFDebugStrOffsets: return "dwarf-str-offsets";
+    case eSectionTypeDWARFDebugCUIndex: return "dwarf-cu-index";
     case eSectionTypeOther: return "regular";
     }
     return "unknown";
@@ -0,0 +1,74 @@
+"""
+Test that evaluating the same expression again in the same context reuses
+the parsed expression but still reads the current values.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class CachedExpressionsTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.log_file = os.path.join(os.getcwd(), "cached-expressions.log")
+        if os.path.exists(self.log_file):
+            os.remove(self.log_file)
+        def cleanup():
+            self.runCmd("log disable lldb expr", check=False)
+            if os.path.exists(self.log_file):
+                os.remove(self.log_file)
+        self.addTearDownHook(cleanup)
+
+    def test_cached_expressions(self):
+        """Test that expressions are reused and see the current values of variables."""
+        self.buildDefault()
+
+        self.runCmd("file a.out", CURRENT_EXECUTABLE_SET)
+
+        lldbutil.run_break_set_by_source_regexp (self, "Set breakpoint here")
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        self.runCmd("log enable -f %s lldb expr" % self.log_file)
+
+        self.expect("expression i * 10 + total",
+            substrs = ["(int)", "= 0"])
+
+        self.runCmd("continue")
+
+        self.expect("expression i * 10 + total",
+            substrs = ["(int)", "= 10"])
+
+        # Change a variable the expression reads in the same frame
+        self.runCmd("expression total = 5")
+
+        self.expect("expression i * 10 + total",
+            substrs = ["(int)", "= 15"])
+
+        self.runCmd("continue")
+
+        self.expect("expression i * 10 + total",
+            substrs = ["(int)", "= 26"])
+
+        self.runCmd("log disable lldb expr")
+
+        # Every stop is at the same PC, so the expression was parsed the
+        # first time and reused after that.
+        with open(self.log_file, "r") as f:
+            log = f.read()
+        self.assertTrue(log.count("Parsing expression i * 10 + total ==") == 1,
+                        "The expression was parsed once")
+        self.assertTrue(log.count("Reusing parsed expression i * 10 + total ==") == 3,
+                        "The parsed expression was reused")
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -45,6 +45,10 @@ class BreakpointLocationsTestCase(TestBase):
             patterns = ["where = a.out`func_inlined .+unresolved, hit count = 0",
                         "where = a.out`main .+\[inlined\].+unresolved, hit count = 0"])
 
+        # The verbose listing should report how long the searches took.
+        self.expect("breakpoint list -v", "Breakpoint resolve time shown",
+            patterns = ["Resolve time: [0-9]+\.[0-9]{3} ms in [0-9]+ searches\."])
+
         # The 'breakpoint disable 3.*' command should fail gracefully.
         self.expect("breakpoint disable 3.*",
                     "Disabling an invalid breakpoint should fail gracefully",
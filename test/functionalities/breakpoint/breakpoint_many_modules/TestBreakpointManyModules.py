@@ -0,0 +1,104 @@
+"""
+Test that breakpoints resolved while a process loads many shared libraries at
+once get the same locations as breakpoints set after the libraries are loaded.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class BreakpointManyModulesTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_with_dsym(self):
+        """Test that locations found when modules load match a search of the loaded modules."""
+        self.buildDsym()
+        self.many_modules_test()
+
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test that locations found when modules load match a search of the loaded modules."""
+        self.buildDwarf()
+        self.many_modules_test()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.line = line_number('common.h', '// Set break point at this line.')
+
+    def create_breakpoints(self, target):
+        """Create a name, a file and line, and a source regex breakpoint."""
+        by_name = target.BreakpointCreateByName("shared_helper")
+        by_line = target.BreakpointCreateByLocation("common.h", self.line)
+        by_regex = target.BreakpointCreateBySourceRegex("return shared_helper", lldb.SBFileSpec("a.c"))
+        return [by_name, by_line, by_regex]
+
+    def locations(self, breakpoint):
+        """Return (location ID, load address, module, has a site) for each location, in order."""
+        result = []
+        for i in range(breakpoint.GetNumLocations()):
+            location = breakpoint.GetLocationAtIndex(i)
+            address = location.GetAddress()
+            result.append((location.GetID(),
+                           location.GetLoadAddress(),
+                           address.GetModule().GetFileSpec().GetFilename(),
+                           location.IsResolved()))
+        return result
+
+    def many_modules_test(self):
+        """Test that locations found when modules load match a search of the loaded modules."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        # These are resolved by Breakpoint::ModulesDidLoad() as the libraries
+        # come in, one search task per module for the name and file and line
+        # resolvers, and serially for the source regex resolver.
+        loaded = self.create_breakpoints(target)
+
+        # Let the loader find the libraries next to a.out.
+        library_path = os.getcwd()
+        if self.dylibPath in os.environ:
+            library_path = os.environ[self.dylibPath] + ":" + library_path
+        process = target.LaunchSimple(None, [self.dylibPath + "=" + library_path],
+                                      self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        threads = lldbutil.get_threads_stopped_at_breakpoint(process, loaded[0])
+        self.assertTrue(len(threads) == 1, "Stopped at shared_helper in main")
+
+        # These search the modules that are already loaded, one at a time.
+        searched = self.create_breakpoints(target)
+
+        # One copy of shared_helper in a.out and one in each library, and
+        # the source regex only matches a.c.
+        expected_libraries = [["a", "b", "c", "d"], ["a", "b", "c", "d"], ["a"]]
+        expected_counts = [5, 5, 1]
+
+        for before, after, libraries, count in zip(loaded, searched, expected_libraries, expected_counts):
+            before_locations = self.locations(before)
+            after_locations = self.locations(after)
+            if self.TraceOn():
+                print "Loaded:  ", before_locations
+                print "Searched:", after_locations
+            self.assertTrue(len(before_locations) == count,
+                            "Breakpoint %d has %d locations" % (before.GetID(), count))
+            modules = set(location[2] for location in before_locations)
+            for lib in libraries:
+                self.assertTrue(any(name.startswith("libmanymodules_" + lib) for name in modules),
+                                "Breakpoint %d has a location in library %s" % (before.GetID(), lib))
+            # Same IDs, in the same order, at the same addresses, with sites.
+            self.assertTrue(before_locations == after_locations,
+                            "Breakpoint %d and %d have the same locations" % (before.GetID(), after.GetID()))
+            for location in before_locations:
+                self.assertTrue(location[3], "Location %d has a breakpoint site" % location[0])
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
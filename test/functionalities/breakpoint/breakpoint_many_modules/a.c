@@ -0,0 +1,7 @@
+#include "common.h"
+
+int
+a_function (int value)
+{
+    return shared_helper (value) + 1;
+}
@@ -0,0 +1,7 @@
+// Every library gets its own copy of shared_helper(), so a breakpoint on it
+// has one location per module.
+static int
+shared_helper (int value)
+{
+    return value * 2; // Set break point at this line.
+}
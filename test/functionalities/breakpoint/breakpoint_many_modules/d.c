@@ -0,0 +1,7 @@
+#include "common.h"
+
+int
+d_function (int value)
+{
+    return shared_helper (value) + 1;
+}
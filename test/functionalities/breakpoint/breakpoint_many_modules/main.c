@@ -0,0 +1,19 @@
+#include <stdio.h>
+#include "common.h"
+
+extern int a_function (int value);
+extern int b_function (int value);
+extern int c_function (int value);
+extern int d_function (int value);
+
+int
+main (int argc, char const *argv[])
+{
+    int total = shared_helper (argc);
+    total += a_function (1);
+    total += b_function (2);
+    total += c_function (3);
+    total += d_function (4);
+    printf ("total = %d\n", total);
+    return 0;
+}
@@ -0,0 +1,109 @@
+"""
+Test breakpoint conditions that are simple enough to be evaluated without
+the expression parser.
+"""
+
+import os, time
+import unittest2
+import lldb, lldbutil
+from lldbtest import *
+
+class BreakpointSimpleConditionsTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_simple_conditions_with_dsym(self):
+        """Test member access, short circuiting and constants in simple breakpoint conditions."""
+        self.buildDsym()
+        self.simple_conditions()
+
+    @dwarf_test
+    def test_simple_conditions_with_dwarf(self):
+        """Test member access, short circuiting and constants in simple breakpoint conditions."""
+        self.buildDwarf()
+        self.simple_conditions()
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_mixed_sign_conditions_with_dsym(self):
+        """Test that char, short and bool values compare against negative constants as ints."""
+        self.buildDsym()
+        self.mixed_sign_conditions()
+
+    @dwarf_test
+    def test_mixed_sign_conditions_with_dwarf(self):
+        """Test that char, short and bool values compare against negative constants as ints."""
+        self.buildDwarf()
+        self.mixed_sign_conditions()
+
+    def simple_conditions(self):
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        # 't' is NULL on every other hit, so this relies on '&&' short
+        # circuiting the way it does in C.
+        lldbutil.run_break_set_by_source_regexp (self, "Set breakpoint here",
+            extra_options="-c 't && t->state == 3 && (i > 1 || t->flags != 0u)'")
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        self.expect("frame variable i", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['(int) i = 1'])
+
+        self.runCmd("continue")
+
+        self.expect("frame variable i", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['(int) i = 2'])
+
+        # A condition that isn't simple still works through the expression
+        # parser.
+        self.runCmd("breakpoint modify -c '(t ? t->state : 0) + i == 5' 1")
+
+        self.runCmd("continue")
+
+        self.expect("frame variable i", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['(int) i = 3'])
+
+        self.runCmd("continue")
+
+        self.expect("process status", PROCESS_EXITED,
+            patterns = ['Process .* exited'])
+
+    def mixed_sign_conditions(self):
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        # In C an unsigned char, unsigned short or bool is promoted to int,
+        # so all of these are true on the first call.
+        lldbutil.run_break_set_by_source_regexp (self, "Set mixed sign breakpoint here",
+            extra_options="-c 'uc > -1 && us > -1 && b > -1 && -1 < uc'")
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        self.expect("frame variable i", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['(int) i = 0'])
+
+        # Promoted values still compare as their own value.
+        self.runCmd("breakpoint modify -c 'b == 1 && sc <= -3 && uc >= 203 && us != -1' 1")
+
+        self.runCmd("continue")
+
+        self.expect("frame variable i", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['(int) i = 3'])
+
+        # None of these are true once the values are promoted, so a new
+        # run never stops.
+        self.runCmd("process kill")
+        self.runCmd("breakpoint modify -c 'uc < -1 || us <= -1 || b < -1' 1")
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        self.expect("process status", PROCESS_EXITED,
+            patterns = ['Process .* exited'])
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
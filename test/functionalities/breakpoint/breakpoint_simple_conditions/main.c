@@ -0,0 +1,45 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdbool.h>
+#include <stdio.h>
+
+struct task
+{
+    int state;
+    unsigned int flags;
+};
+
+static int
+process (int i, struct task *t)
+{
+    return t ? t->state + i : i; // Set breakpoint here
+}
+
+static int
+classify (int i, unsigned char uc, unsigned short us, bool b, signed char sc)
+{
+    return i + uc + us + b + sc; // Set mixed sign breakpoint here
+}
+
+int main (int argc, char const *argv[])
+{
+    struct task tasks[4] = { { 1, 0 }, { 3, 1 }, { 3, 0 }, { 2, 4 } };
+    int total = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        // Every other call passes a NULL task
+        total += process (i, NULL);
+        total += process (i, &tasks[i]);
+    }
+    // Values narrower than int are promoted to int before comparisons
+    for (int i = 0; i < 4; ++i)
+        total += classify (i, 200 + i, 60000 + i, i & 1, -i);
+    printf("total = %d\n", total);
+    return 0;
+}
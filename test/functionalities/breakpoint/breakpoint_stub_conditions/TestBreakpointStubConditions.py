@@ -0,0 +1,97 @@
+"""
+Test breakpoint conditions that are evaluated by the remote stub.
+"""
+
+import os, re, time
+import unittest2
+import lldb, lldbutil
+from lldbtest import *
+
+class BreakpointStubConditionsTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    # Only debugserver evaluates breakpoint conditions in this tree.
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_stub_conditions_with_dsym(self):
+        """Test that the stub filters out hits where a local, member or argument condition is false."""
+        self.buildDsym()
+        self.stub_conditions()
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dwarf_test
+    def test_stub_conditions_with_dwarf(self):
+        """Test that the stub filters out hits where a local, member or argument condition is false."""
+        self.buildDwarf()
+        self.stub_conditions()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.line = line_number('main.c', '// Set breakpoint here')
+
+    def stub_conditions(self):
+        exe = os.path.join(os.getcwd(), "a.out")
+
+        # A local, a member through a pointer argument, and an argument.
+        # At -O0 the locals and arguments are relative to a frame base
+        # that is either a register or the CFA.
+        for (condition, i) in [('limit == 12', 6),
+                               ('t->state == 15', 5),
+                               ('i == 7', 7)]:
+            self.stub_condition(exe, condition, i)
+
+    def stub_condition(self, exe, condition, i):
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        log_file = os.path.join(os.getcwd(), "stub-conditions.log")
+        if os.path.exists(log_file):
+            os.remove(log_file)
+        self.runCmd("log enable -f %s gdb-remote packets" % log_file)
+        self.addTearDownHook(lambda: self.runCmd("log disable gdb-remote packets"))
+
+        bkpt_id = lldbutil.run_break_set_by_file_and_line (self, "main.c", self.line,
+            extra_options="-c '%s'" % condition, num_expected_locations=1, loc_exact=True)
+        bkpt = target.FindBreakpointByID(bkpt_id)
+
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        # The first stop is the first hit where the condition is true.
+        threads = lldbutil.get_threads_stopped_at_breakpoint(process, bkpt)
+        self.assertEqual(len(threads), 1, "Condition '%s' didn't stop at the breakpoint" % condition)
+        frame = threads[0].GetFrameAtIndex(0)
+        self.assertEqual(frame.FindVariable("i").GetValueAsSigned(), i)
+
+        # The inferior really ran through the earlier calls, and they
+        # count as hits just like they would if lldb evaluated the
+        # condition.
+        self.assertEqual(target.FindFirstGlobalVariable("g_calls").GetValueAsSigned(), i + 1)
+        self.assertEqual(bkpt.GetHitCount(), i + 1,
+                         "Hits where '%s' is false weren't counted" % condition)
+
+        # The condition went to the stub with the breakpoint, and the stub
+        # reported the hits it filtered out in the stop reply instead of
+        # stopping for each of them.
+        self.runCmd("log disable gdb-remote packets")
+        with open(log_file) as f:
+            log = f.read()
+        self.assertTrue(re.search(r"\$Z[01],[0-9a-fA-F]+,[0-9a-fA-F]+;X[0-9a-fA-F]+,", log),
+                        "Condition '%s' wasn't sent to the stub" % condition)
+        self.assertTrue(re.search(r"filteredhits:[0-9a-fA-F]+,%x;" % i, log),
+                        "The hits where '%s' is false weren't reported" % condition)
+
+        # There are no other true hits, but every call was a hit.
+        process.Continue()
+        self.assertEqual(process.GetState(), lldb.eStateExited, PROCESS_EXITED)
+        self.assertEqual(bkpt.GetHitCount(), 10)
+
+        self.dbg.DeleteTarget(target)
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
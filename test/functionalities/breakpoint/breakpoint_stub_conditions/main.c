@@ -0,0 +1,40 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+struct task
+{
+    int state;
+    unsigned int flags;
+};
+
+int g_calls = 0;
+
+static int
+process (int i, struct task *t)
+{
+    int limit = i * 2;
+    ++g_calls;
+    return t->state + limit; // Set breakpoint here
+}
+
+int main (int argc, char const *argv[])
+{
+    struct task tasks[10];
+    int total = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        tasks[i].state = i * 3;
+        tasks[i].flags = i;
+    }
+    for (int i = 0; i < 10; ++i)
+        total += process (i, &tasks[i]);
+    printf("total = %d\n", total);
+    return 0;
+}
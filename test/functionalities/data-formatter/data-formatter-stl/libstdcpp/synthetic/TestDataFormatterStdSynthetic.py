@@ -0,0 +1,106 @@
+"""
+Test the libstdc++ std::vector, std::list and std::map synthetic children
+providers with and without a process, and with a map that isn't
+constructed yet.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class StdSyntheticDataFormatterTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_with_dsym_and_run_command(self):
+        """Test the libstdc++ container synthetic children."""
+        self.buildDsym()
+        self.data_formatter_commands()
+
+    @dwarf_test
+    def test_with_dwarf_and_run_command(self):
+        """Test the libstdc++ container synthetic children."""
+        self.buildDwarf()
+        self.data_formatter_commands()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break at.
+        self.line = line_number('main.cpp', '// Set break point at this line.')
+
+    def data_formatter_commands(self):
+        """Test the libstdc++ container synthetic children."""
+        self.runCmd("file a.out", CURRENT_EXECUTABLE_SET)
+
+        # This is the function to remove the custom formats in order to have a
+        # clean slate for the next test case.
+        def cleanup():
+            self.runCmd('type summary clear', check=False)
+            self.runCmd("settings set target.max-children-count 256", check=False)
+
+        # Execute the cleanup function during test case tear down.
+        self.addTearDownHook(cleanup)
+
+        self.runCmd("type summary add -x \"^std::(vector|list|map)<\" --summary-string \"${svar%#} items\" -e")
+
+        # Without a process the statics are read from the object file.
+        for name in ["g_vector", "g_list", "g_map"]:
+            self.expect("target variable " + name,
+                substrs = [name + ' = 0 items'])
+
+        lldbutil.run_break_set_by_file_and_line (self, "main.cpp", self.line, num_expected_locations=1, loc_exact=True)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # The stop reason of the thread should be breakpoint.
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped',
+                       'stop reason = breakpoint'])
+
+        self.expect('frame variable v',
+            substrs = ['5 items',
+                       '[0] = 0',
+                       '[4] = 40'])
+
+        self.expect('frame variable l',
+            substrs = ['5 items',
+                       '[0] = 0',
+                       '[4] = 400'])
+
+        self.expect('frame variable m',
+            substrs = ['5 items',
+                       'first = 0',
+                       'second = 0',
+                       'first = 4',
+                       'second = 4000'])
+
+        self.expect('frame variable m[2]',
+            substrs = ['first = 2',
+                       'second = 2000'])
+
+        # A map that hasn't been constructed has no children.
+        self.expect('frame variable *uninitialized',
+            substrs = ['0 items'])
+
+        # A node count that a map under construction could have is capped,
+        # and walking the tree stops at its end.
+        self.runCmd("settings set target.max-children-count 10")
+        self.runCmd("expression -- m._M_t._M_impl._M_node_count = 100000")
+        self.expect('frame variable m',
+            substrs = ['10 items',
+                       '[4] = ',
+                       'second = 4000'])
+
+        self.expect("target variable g_map",
+            substrs = ['g_map = 0 items'])
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,34 @@
+#include <list>
+#include <map>
+#include <string.h>
+#include <vector>
+
+typedef std::map<int, int> intint_map;
+
+std::vector<int> g_vector;
+std::list<int> g_list;
+intint_map g_map;
+
+int main()
+{
+    // Memory that looks like a map that hasn't been constructed yet
+    union
+    {
+        char bytes[sizeof(intint_map)];
+        void *align;
+    } garbage;
+    memset (garbage.bytes, 0xab, sizeof(garbage.bytes));
+    intint_map *uninitialized = reinterpret_cast<intint_map *>(garbage.bytes);
+
+    std::vector<int> v;
+    std::list<int> l;
+    intint_map m;
+    for (int i = 0; i < 5; ++i)
+    {
+        v.push_back (i * 10);
+        l.push_back (i * 100);
+        m[i] = i * 1000;
+    }
+    size_t total = v.size() + l.size() + m.size() + (uninitialized != NULL);
+    return total == 0; // Set break point at this line.
+}
@@ -0,0 +1,92 @@
+"""
+Test that the DWARF name index gets written to the
+plugin.symbol-file.dwarf.index-cache-path directory.
+"""
+
+import os, time
+import glob
+import shutil
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class DWARFIndexCacheTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @skipIfDarwin # Apple accelerator tables are used instead of the DWARF index
+    @dwarf_test
+    def test_index_cache_with_dwarf(self):
+        """Test that the DWARF index is written to the cache directory."""
+        self.buildDwarf()
+        self.index_cache()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.cache_dir = os.path.join(os.getcwd(), "dwarf-index-cache")
+        if os.path.exists(self.cache_dir):
+            shutil.rmtree(self.cache_dir)
+        def cleanup():
+            self.runCmd("settings clear plugin.symbol-file.dwarf.index-cache-path", check=False)
+            if os.path.exists(self.cache_dir):
+                shutil.rmtree(self.cache_dir)
+        self.addTearDownHook(cleanup)
+
+    def set_breakpoint_in_new_target(self):
+        """Create a target for a.out and set a breakpoint by name, returning the DWARF lookups log."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        log_file = os.path.join(os.getcwd(), "dwarf-index-cache.log")
+        if os.path.exists(log_file):
+            os.remove(log_file)
+        self.runCmd("log enable -f %s dwarf lookups" % log_file)
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+        lldbutil.run_break_set_by_symbol (self, "cached_function", num_expected_locations=1)
+        self.runCmd("log disable dwarf")
+        # Drop the module too, so that the next target has to index it
+        # again or read the cache.
+        self.runCmd("target delete --clean")
+        with open(log_file) as f:
+            return f.read()
+
+    def index_cache(self):
+        """Set breakpoints by name with the index cache enabled."""
+        self.runCmd("settings set plugin.symbol-file.dwarf.index-cache-path " + self.cache_dir)
+        self.addTearDownHook(lambda: self.runCmd("log disable dwarf"))
+        exe = os.path.join(os.getcwd(), "a.out")
+
+        log = self.set_breakpoint_in_new_target()
+        self.assertTrue(log.find("DWARFIndexCache::Load loaded") == -1, "The first session indexed the DWARF")
+        cache_files = glob.glob(os.path.join(self.cache_dir, "*.dwarf-index"))
+        self.assertTrue(len(cache_files) == 1, "Exactly one DWARF index cache file was written")
+        self.assertTrue(os.path.getsize(cache_files[0]) > 0, "The DWARF index cache file isn't empty")
+
+        # A second session reads the index from the cache.
+        log = self.set_breakpoint_in_new_target()
+        self.assertTrue(log.find("DWARFIndexCache::Load loaded") != -1, "The second session read the cached index")
+
+        # Touching the binary makes the cache stale, the DWARF is indexed
+        # again and the cache rewritten.
+        mod_time = os.path.getmtime(exe) + 10
+        os.utime(exe, (mod_time, mod_time))
+        log = self.set_breakpoint_in_new_target()
+        self.assertTrue(log.find("changed since it was written") != -1, "The cache was ignored after touching a.out")
+        self.assertTrue(log.find("DWARFIndexCache::Load loaded") == -1, "The stale cache wasn't used")
+        log = self.set_breakpoint_in_new_target()
+        self.assertTrue(log.find("DWARFIndexCache::Load loaded") != -1, "The cache was rewritten for the touched a.out")
+
+        # So does changing its size, even with the same modification time
+        # and UUID.
+        with open(exe, "ab") as f:
+            f.write("\0" * 16)
+        os.utime(exe, (mod_time, mod_time))
+        log = self.set_breakpoint_in_new_target()
+        self.assertTrue(log.find("changed since it was written") != -1, "The cache was ignored after a.out grew")
+        self.assertTrue(log.find("DWARFIndexCache::Load loaded") == -1, "The stale cache wasn't used")
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,24 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+int g_counter = 0;
+
+int
+cached_function (int value)
+{
+    g_counter += value;
+    return g_counter;
+}
+
+int main (int argc, char const *argv[])
+{
+    printf("%d\n", cached_function(argc)); // Set break point at this line.
+    return 0;
+}
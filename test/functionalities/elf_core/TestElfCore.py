@@ -0,0 +1,70 @@
+"""
+Test reading threads and memory from an ELF core file, and that only the
+parts of the core file that memory is read from get mapped in.
+"""
+
+import os, re
+import unittest2
+import lldb
+from lldbtest import *
+
+class ElfCoreTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def test_elf_core(self):
+        """Test a core file of a static x86_64 Linux program, see make-core.sh."""
+        self.elf_core_memory_reads()
+
+    def elf_core_memory_reads(self):
+        """Read the threads and memory of the core file."""
+        exe = os.path.join(os.getcwd(), "linux-x86_64.out")
+        core = os.path.join(os.getcwd(), "linux-x86_64.core")
+
+        log_file = os.path.join(os.getcwd(), "elf-core-mmap.log")
+        if os.path.exists(log_file):
+            os.remove(log_file)
+        self.runCmd("log enable -f %s lldb mmap" % log_file)
+        self.addTearDownHook(lambda: self.runCmd("log disable lldb"))
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        process = target.LoadCore(core)
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        self.expect("thread backtrace", substrs = ['stop reason = signal SIGSEGV',
+                                                   'crash_here', 'fill_pattern', '_start'])
+
+        # g_pattern is three pages of the core file, read all of them at once.
+        pattern = target.FindFirstGlobalVariable("g_pattern")
+        self.assertTrue(pattern.IsValid())
+        pattern_size = 3 * 4096
+        error = lldb.SBError()
+        data = process.ReadMemory(pattern.GetLoadAddress(), pattern_size, error)
+        self.assertTrue(error.Success(), "Failed to read g_pattern: %s" % error.GetCString())
+        self.assertEqual(len(data), pattern_size)
+        for i in range(pattern_size):
+            if ord(data[i]) != (i * 7) & 0xff:
+                self.fail("g_pattern[%u] is 0x%2.2x" % (i, ord(data[i])))
+        self.expect("memory read --size 1 --format x --count 4 `&g_pattern[4094]`",
+                    substrs = ['0xf2 0xf9 0x00 0x07'])
+
+        self.runCmd("log disable lldb")
+        with open(log_file) as f:
+            log = f.read()
+
+        # The core object file only maps the headers and notes, so the only
+        # mapping that covers all of this small core is the window memory
+        # was read through.
+        core_size = os.path.getsize(core)
+        core_mappings = re.findall(r'MemoryMapFromFileSpec\(file="%s", offset=0x([0-9a-f]+), length=0x([0-9a-f]+)' % re.escape(core), log)
+        self.assertTrue(len(core_mappings) > 0, "The core file wasn't mapped")
+        whole_file_mappings = [m for m in core_mappings if int(m[1], 16) >= core_size]
+        self.assertEqual(len(whole_file_mappings), 1, "The whole core file was mapped more than once: %s" % core_mappings)
+        self.assertTrue(re.search(r"mapped 0x[0-9a-f]+ bytes of the core file at offset 0x0", log))
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,26 @@
+// Built without libc by make-core.sh, so that the core file it leaves
+// behind stays small.
+
+// Three pages, so reads can cross page boundaries.
+unsigned char g_pattern[3 * 4096];
+
+static void __attribute__((noinline))
+crash_here (unsigned char *pattern)
+{
+    *(volatile int *)0 = pattern[0];
+}
+
+static void __attribute__((noinline))
+fill_pattern (void)
+{
+    unsigned int i;
+    for (i = 0; i < sizeof(g_pattern); ++i)
+        g_pattern[i] = (unsigned char)(i * 7);
+    crash_here (g_pattern);
+}
+
+void
+_start (void)
+{
+    fill_pattern ();
+}
@@ -0,0 +1,14 @@
+#! /bin/sh
+
+# Rebuilds linux-x86_64.out and linux-x86_64.core, which
+# TestElfCore.py reads. The kernel must write core files to "core" in
+# the current directory:
+#   echo core > /proc/sys/kernel/core_pattern
+
+set -e -x
+
+rm -f core core.*
+${CC:-cc} -g -O0 -static -nostdlib -fno-pie -no-pie -o linux-x86_64.out main.c
+ulimit -c unlimited
+./linux-x86_64.out || true
+mv core* linux-x86_64.core
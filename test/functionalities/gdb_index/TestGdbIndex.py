@@ -0,0 +1,76 @@
+"""
+Test that functions, types and variables can be found in an ELF file
+that has a .gdb_index section.
+"""
+
+import os, re, time
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class GdbIndexTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @skipIfDarwin
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test name lookups in a module with a .gdb_index section."""
+        self.buildDwarf()
+        self.gdb_index_lookups()
+
+    def gdb_index_lookups(self):
+        """Look up names through the .gdb_index section."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        self.expect("image dump sections a.out", substrs = ['gdb-index'])
+
+        # "pair" is only in main.c, so looking it up first must only index
+        # that compile unit.
+        log_file = os.path.join(os.getcwd(), "gdb-index-lookups.log")
+        if os.path.exists(log_file):
+            os.remove(log_file)
+        self.runCmd("log enable -f %s dwarf lookups" % log_file)
+        self.addTearDownHook(lambda: self.runCmd("log disable dwarf"))
+        self.expect("image lookup -t pair", substrs = ['name = "pair"'])
+        self.runCmd("log disable dwarf")
+        with open(log_file) as f:
+            log = f.read()
+        self.assertTrue(re.search(r'IndexForName \(name="pair"\) \.gdb_index lists 1 compile units', log), "pair wasn't looked up in .gdb_index")
+        self.assertEqual(len(re.findall(r"indexing compile unit at", log)), 1, "Compile units that don't define pair were indexed")
+        self.assertTrue(log.find("indexing all compile units") == -1)
+
+        # .gdb_index doesn't list function local statics, they must be
+        # found by indexing everything.
+        self.expect("target variable s_list_sum_calls", VARIABLES_DISPLAYED_CORRECTLY,
+                    substrs = ['s_list_sum_calls = 0'])
+
+        # Start over with a module that hasn't indexed anything. .gdb_index
+        # doesn't have to list inline functions in compile units that only
+        # have inlined copies, so function lookups must index everything
+        # and find the out of line copy in list.c and the inlined one in
+        # main.c.
+        self.runCmd("target delete --clean")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+        lldbutil.run_break_set_by_symbol (self, "node_value", num_expected_locations=2)
+        self.runCmd("breakpoint disable 1")
+
+        self.expect("image lookup -t node", substrs = ['name = "node"'])
+        self.expect("image lookup -t pair", substrs = ['name = "pair"'])
+        self.expect("target variable g_list_count g_pair", VARIABLES_DISPLAYED_CORRECTLY,
+                    substrs = ['g_list_count = 0', 'first = 10', 'second = 20'])
+        lldbutil.run_break_set_by_symbol (self, "list_sum", num_expected_locations=1)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        self.expect("frame variable *list", VARIABLES_DISPLAYED_CORRECTLY,
+                    substrs = ['value = 1'])
+        self.expect("expression -- list->next->next->value + g_pair.second", substrs = ['= 23'])
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
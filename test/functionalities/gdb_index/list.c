@@ -0,0 +1,18 @@
+#include "list.h"
+
+int g_list_count = 0;
+
+extern int node_value (struct node *n);
+
+int
+list_sum (struct node *list)
+{
+    // A function local static, which .gdb_index doesn't list
+    static int s_list_sum_calls = 0;
+    ++s_list_sum_calls;
+    int sum = 0;
+    for (; list; list = list->next)
+        sum += list->value;
+    ++g_list_count;
+    return sum;
+}
@@ -0,0 +1,17 @@
+struct node
+{
+    int value;
+    struct node *next;
+};
+
+extern int g_list_count;
+
+int list_sum (struct node *list);
+
+// An external inline function: list.c has the out of line copy, main.c
+// only has inlined ones.
+inline __attribute__((always_inline)) int
+node_value (struct node *n)
+{
+    return n->value;
+}
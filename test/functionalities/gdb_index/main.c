@@ -0,0 +1,20 @@
+#include <stdio.h>
+#include "list.h"
+
+struct pair
+{
+    int first;
+    int second;
+};
+
+static struct pair g_pair = { 10, 20 };
+
+int
+main (int argc, char const *argv[])
+{
+    struct node c = { 3, NULL };
+    struct node b = { 2, &c };
+    struct node a = { 1, &b };
+    printf ("sum = %d\n", list_sum (&a) + g_pair.first + node_value (&c));
+    return 0;
+}
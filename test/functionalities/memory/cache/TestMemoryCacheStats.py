@@ -0,0 +1,94 @@
+"""
+Test the 'memory cache-stats' command.
+"""
+
+import os, time
+import re
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class MemoryCacheStatsTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_memory_cache_stats_with_dsym(self):
+        """Test that sequential small reads are served from the memory cache."""
+        self.buildDsym()
+        self.memory_cache_stats()
+
+    @dwarf_test
+    def test_memory_cache_stats_with_dwarf(self):
+        """Test that sequential small reads are served from the memory cache."""
+        self.buildDwarf()
+        self.memory_cache_stats()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside main().
+        self.line = line_number('main.cpp', '// Set break point at this line.')
+
+    def get_stat(self, name):
+        self.runCmd("memory cache-stats")
+        match = re.search(r"^\s*%s:\s+(\d+)" % name, self.res.GetOutput(), re.MULTILINE)
+        self.assertTrue(match, "'memory cache-stats' shows '%s'" % name)
+        return int(match.group(1))
+
+    def memory_cache_stats(self):
+        """Read a buffer in small pieces and check the cache counters."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        lldbutil.run_break_set_by_file_and_line (self, "main.cpp", self.line, num_expected_locations=1, loc_exact=True)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # The stop reason of the thread should be breakpoint.
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped', 'stop reason = breakpoint'])
+
+        process = self.dbg.GetSelectedTarget().GetProcess()
+        buffer_addr = self.dbg.GetSelectedTarget().FindFirstGlobalVariable("g_buffer").GetLoadAddress()
+        self.assertTrue(buffer_addr != lldb.LLDB_INVALID_ADDRESS)
+
+        # Local processes don't read ahead unless asked to, so give the cache
+        # a read-ahead size that any process plugin can handle.
+        self.runCmd("settings set target.process.memory-cache-read-ahead-size 4096")
+        self.addTearDownHook(lambda: self.runCmd("settings clear target.process.memory-cache-read-ahead-size", check=False))
+        read_ahead_size = self.get_stat("max read-ahead size")
+        self.assertTrue(read_ahead_size > 0 and read_ahead_size <= 4096, "The cache reads ahead")
+
+        self.runCmd("memory cache-stats --reset")
+        self.assertTrue(self.get_stat("cache line hits") == 0, "Statistics were reset")
+
+        # Read the whole buffer sequentially, 16 bytes at a time.
+        chunk_size = 16
+        buffer_size = 16 * 1024
+        for offset in range(0, buffer_size, chunk_size):
+            error = lldb.SBError()
+            data = process.ReadMemory(buffer_addr + offset, chunk_size, error)
+            self.assertTrue(error.Success(), "Read memory at offset %u" % offset)
+            self.assertTrue(ord(data[0]) == offset % 256)
+
+        num_reads = buffer_size / chunk_size
+        hits = self.get_stat("cache line hits")
+        misses = self.get_stat("cache line misses")
+        self.assertTrue(hits + misses >= num_reads, "Every read used the cache")
+        self.assertTrue(misses < num_reads / 4, "Most reads were cache hits")
+
+        # Sequential misses read several cache lines at once, so it takes
+        # fewer process reads than there are lines in the buffer.
+        line_size = self.get_stat("cache line size")
+        num_lines = buffer_size / line_size
+        self.assertTrue(self.get_stat("lines read ahead") > 0, "Cache lines were read ahead")
+        self.assertTrue(self.get_stat("process reads") < num_lines, "Reading ahead saved process reads")
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
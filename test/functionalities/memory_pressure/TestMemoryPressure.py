@@ -0,0 +1,89 @@
+"""
+Test that debug information released by SBDebugger.MemoryPressureDetected()
+is parsed again when it is needed.
+"""
+
+import os, re, time
+import sys
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class MemoryPressureTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_with_dsym(self):
+        """Test debug info lookups after memory pressure."""
+        self.buildDsym()
+        self.memory_pressure()
+
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test debug info lookups after memory pressure."""
+        self.buildDwarf()
+        self.memory_pressure()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.line = line_number('shapes.c', '// Set break point at this line.')
+
+    def released_bytes(self):
+        """Release unused debug info and return the number of DIE array bytes the DWARF log says were freed."""
+        log_file = os.path.join(os.getcwd(), "memory-pressure-dwarf.log")
+        if os.path.exists(log_file):
+            os.remove(log_file)
+        self.runCmd("log enable -f %s dwarf info" % log_file)
+        lldb.SBDebugger.MemoryPressureDetected()
+        self.runCmd("log disable dwarf")
+        with open(log_file) as f:
+            log = f.read()
+        # There is one message per symbol file, and a debug map has one
+        # symbol file per .o file.
+        matches = re.findall(r"cleared the DIEs of (\d+) of (\d+) compile units, (\d+) bytes", log)
+        self.assertTrue(len(matches) > 0, "ReleaseUnusedMemory () didn't run")
+        return sum([int(num_bytes) for (num_cleared, num_parsed, num_bytes) in matches])
+
+    def memory_pressure(self):
+        """Look up types, variables and functions after releasing debug info."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+        self.addTearDownHook(lambda: self.runCmd("log disable dwarf"))
+        lldbutil.run_break_set_by_file_and_line (self, "shapes.c", self.line, num_expected_locations=1, loc_exact=True)
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        self.expect("frame variable *r", VARIABLES_DISPLAYED_CORRECTLY,
+                    substrs = ['origin = (x = 1, y = 2)', 'size = (x = 3, y = 4)'])
+
+        # Looking up main by name extracts the DIEs of main.c, but only
+        # builds a Function, which refers to its DIE by offset. Nothing
+        # points into main.c, so its DIEs can go away. The types already
+        # parsed from shapes.c must survive.
+        self.expect("image lookup -n main", substrs = ['main.c'])
+        self.assertTrue(self.released_bytes() > 0, "No DIEs were released")
+
+        self.expect("frame variable *r", VARIABLES_DISPLAYED_CORRECTLY,
+                    substrs = ['origin = (x = 1, y = 2)', 'size = (x = 3, y = 4)'])
+        self.expect("up", substrs = ['main'])
+        self.expect("frame variable r", VARIABLES_DISPLAYED_CORRECTLY,
+                    substrs = ['origin = (x = 1, y = 2)'])
+        self.expect("target variable g_counter", VARIABLES_DISPLAYED_CORRECTLY,
+                    substrs = ['name = 0x', '"areas"', 'count = 0'])
+
+        # Release again now that variables and types of both compile units
+        # are in use, which must not break any of the lookups below.
+        self.released_bytes()
+
+        self.expect("expression -- r.size.x * r.size.y + g_counter.count", substrs = ['= 12'])
+        self.expect("image lookup -t counter", substrs = ['name = "counter"'])
+        lldbutil.run_break_set_by_symbol (self, "area", num_expected_locations=1)
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,19 @@
+#include <stdio.h>
+#include "shapes.h"
+
+struct counter
+{
+    const char *name;
+    int count;
+};
+
+struct counter g_counter = { "areas", 0 };
+
+int
+main (int argc, char const *argv[])
+{
+    struct rect r = { { 1, 2 }, { 3, 4 } };
+    g_counter.count += area (&r);
+    printf ("%s = %d\n", g_counter.name, g_counter.count);
+    return 0;
+}
@@ -0,0 +1,7 @@
+#include "shapes.h"
+
+int
+area (struct rect *r)
+{
+    return r->size.x * r->size.y; // Set break point at this line.
+}
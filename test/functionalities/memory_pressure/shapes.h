@@ -0,0 +1,13 @@
+struct point
+{
+    int x;
+    int y;
+};
+
+struct rect
+{
+    struct point origin;
+    struct point size;
+};
+
+int area (struct rect *r);
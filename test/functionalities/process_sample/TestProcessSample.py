@@ -0,0 +1,70 @@
+"""
+Test the 'process sample' command.
+"""
+
+import os, time
+import sys
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class ProcessSampleTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_with_dsym(self):
+        """Test sampling a running process."""
+        self.buildDsym()
+        self.process_sample()
+
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test sampling a running process."""
+        self.buildDwarf()
+        self.process_sample()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.line = line_number('main.c', '// Set break point at this line.')
+
+    def process_sample(self):
+        """Sample a process that spins in one function."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+        lldbutil.run_break_set_by_file_and_line (self, "main.c", self.line, num_expected_locations=1, loc_exact=True)
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        process = self.dbg.GetSelectedTarget().GetProcess()
+        self.assertTrue(process.GetState() == lldb.eStateStopped)
+
+        self.expect("process sample --count 10 --interval 1",
+                    substrs = ['10 samples of process',
+                               'thread #1',
+                               '10 a.out`main',
+                               'a.out`spin'])
+
+        # The process was stopped when the sampling started, so it is left
+        # stopped in spin.
+        self.assertTrue(process.GetState() == lldb.eStateStopped)
+
+        # Every sample has the same stack, so there is a single folded line.
+        self.expect("process sample --count 5 --interval 1 --folded",
+                    patterns = [r'(?m)^thread #1: tid = 0x[0-9a-f]+;(.+;)?a\.out`main;a\.out`spin 5$'])
+
+        # Sampling into a file only reports the summary.
+        outfile = os.path.join(os.getcwd(), "samples.folded")
+        self.addTearDownHook(lambda: os.remove(outfile) if os.path.exists(outfile) else None)
+        self.expect("process sample --count 5 --interval 1 --folded --outfile " + outfile,
+                    substrs = ["Wrote the samples to '%s'." % outfile])
+        with open(outfile) as f:
+            self.assertTrue("a.out`main;a.out`spin 5" in f.read())
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,27 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+volatile unsigned long g_counter = 0;
+
+void
+spin (void)
+{
+    // Never returns, so every sample taken after this point has spin on
+    // the stack of the main thread.
+    while (1)
+        g_counter++;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    g_counter = 1; // Set break point at this line.
+    spin ();
+    return 0;
+}
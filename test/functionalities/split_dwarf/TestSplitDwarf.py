@@ -0,0 +1,90 @@
+"""
+Test that functions, types and variables can be found in an ELF file
+built with -gsplit-dwarf, whose DWARF is in .dwo files or in a .dwp
+package, and that name lookups only open the .dwo files they need.
+"""
+
+import os, re, time
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class SplitDwarfTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @skipIfDarwin
+    @dwarf_test
+    def test_dwo_with_dwarf(self):
+        """Test name lookups and variables in a module that uses .dwo files."""
+        self.buildDwarf()
+        self.split_dwarf_lookups("main.dwo")
+
+    @skipIfDarwin
+    @dwarf_test
+    def test_dwp_with_dwarf(self):
+        """Test name lookups and variables in a module that uses a .dwp package."""
+        self.buildDwarf(dictionary={'MAKE_DWP': 'YES'})
+        self.assertFalse(os.path.exists(os.path.join(os.getcwd(), "list.dwo")), "The .dwo files were packed into a.out.dwp")
+        self.split_dwarf_lookups("a.out.dwp")
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.line = line_number('loclist.c', '// Set break point at this line.')
+
+    def split_dwarf_lookups(self, dwo_name):
+        """Look up names in the .dwo files of the skeleton compile units."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        # pair is only in main.c, so finding it must only open the DWARF
+        # of that compile unit, from main.dwo or from its part of the
+        # .debug_cu_index of a.out.dwp.
+        log_file = os.path.join(os.getcwd(), "split-dwarf-info.log")
+        if os.path.exists(log_file):
+            os.remove(log_file)
+        self.runCmd("log enable -f %s dwarf info" % log_file)
+        self.addTearDownHook(lambda: self.runCmd("log disable dwarf"))
+        self.expect("image lookup -t pair", substrs = ['name = "pair"'])
+        self.runCmd("log disable dwarf")
+        with open(log_file) as f:
+            log = f.read()
+        loaded = re.findall(r"CreateDwoSymbolFile \(\) loading '([^']*)'", log)
+        self.assertEqual(len(loaded), 1, "Only one compile unit's DWARF was loaded: %s" % loaded)
+        self.assertEqual(os.path.basename(loaded[0]), dwo_name)
+
+        # The name tables only list node_value for list.c, which has the
+        # out of line copy, but main.c has an inlined one too.
+        lldbutil.run_break_set_by_symbol (self, "node_value", num_expected_locations=2)
+        self.runCmd("breakpoint disable 1")
+
+        self.expect("image lookup -t node", substrs = ['name = "node"'])
+        self.expect("image lookup -t pair", substrs = ['name = "pair"'])
+        self.expect("target variable g_list_count g_pair", VARIABLES_DISPLAYED_CORRECTLY,
+                    substrs = ['g_list_count = 0', 'first = 10', 'second = 20'])
+        lldbutil.run_break_set_by_file_and_line (self, "loclist.c", self.line, num_expected_locations=1)
+        lldbutil.run_break_set_by_symbol (self, "list_sum", num_expected_locations=1)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # loclist_scale is optimized, scaled has a .debug_loc.dwo location
+        # list whose addresses are indexes into .debug_addr.
+        self.expect("frame info", substrs = ['loclist_scale'])
+        self.expect("frame variable value scaled", VARIABLES_DISPLAYED_CORRECTLY,
+                    substrs = ['value = 7', 'scaled = 21'])
+
+        self.runCmd("continue")
+
+        # The compile unit name comes from the .dwo file.
+        self.expect("frame info", substrs = ['list.c'])
+        self.expect("frame variable *list", VARIABLES_DISPLAYED_CORRECTLY,
+                    substrs = ['value = 1'])
+        self.expect("expression -- list->next->next->value + g_pair.second", substrs = ['= 23'])
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
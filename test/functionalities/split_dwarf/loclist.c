@@ -0,0 +1,18 @@
+// Built with optimization so that the variables below have location
+// lists, which split DWARF puts in .debug_loc.dwo.
+volatile int g_loclist_sink;
+
+__attribute__((noinline)) int
+loclist_scale (int value)
+{
+    int scaled = value * 3;
+    g_loclist_sink = scaled; // Set break point at this line.
+    scaled += g_loclist_sink;
+    return scaled + value;
+}
+
+__attribute__((constructor)) static void
+loclist_init (void)
+{
+    g_loclist_sink = loclist_scale (g_loclist_sink + 7);
+}
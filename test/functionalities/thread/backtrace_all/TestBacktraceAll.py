@@ -0,0 +1,93 @@
+"""
+Test that "thread backtrace all", which unwinds the threads in parallel,
+prints the same backtraces as unwinding each thread on its own.
+"""
+
+import os, re, time
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class BacktraceAllTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_with_dsym(self):
+        """Test that "thread backtrace all" matches the backtrace of each thread."""
+        self.buildDsym(dictionary=self.getBuildFlags())
+        self.backtrace_all_test()
+
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test that "thread backtrace all" matches the backtrace of each thread."""
+        self.buildDwarf(dictionary=self.getBuildFlags())
+        self.backtrace_all_test()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number for our breakpoint.
+        self.breakpoint = line_number('main.cpp', '// Set breakpoint here')
+
+    def split_backtraces(self, output):
+        """Split the output of "thread backtrace" into one block of lines per thread."""
+        backtraces = []
+        for line in output.splitlines():
+            if not line.strip():
+                continue
+            if re.match(r"^[* ] thread #", line):
+                backtraces.append([])
+            if backtraces:
+                backtraces[-1].append(line.rstrip())
+        return backtraces
+
+    def backtrace_all_test(self):
+        """Test that "thread backtrace all" matches the backtrace of each thread."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        lldbutil.run_break_set_by_file_and_line (self, "main.cpp", self.breakpoint, num_expected_locations=1)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # The stop reason of the thread should be breakpoint.
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped',
+                       'stop reason = breakpoint'])
+
+        process = self.dbg.GetSelectedTarget().GetProcess()
+        num_threads = process.GetNumThreads()
+        # The main thread and the eight threads waiting at the bottom of
+        # their stacks.
+        self.assertTrue(num_threads >= 9, "All the threads are running")
+
+        self.runCmd("thread backtrace all")
+        all_backtraces = self.split_backtraces(self.res.GetOutput())
+
+        each_backtrace = []
+        for i in range(num_threads):
+            thread = process.GetThreadAtIndex(i)
+            self.runCmd("thread backtrace %d" % thread.GetIndexID())
+            backtraces = self.split_backtraces(self.res.GetOutput())
+            self.assertTrue(len(backtraces) == 1, "One backtrace for thread %d" % thread.GetIndexID())
+            each_backtrace.extend(backtraces)
+
+        self.assertTrue(len(all_backtraces) == num_threads, "\"thread backtrace all\" printed every thread")
+        for all_lines, each_lines in zip(all_backtraces, each_backtrace):
+            if self.TraceOn():
+                print "\n".join(all_lines)
+                print "\n".join(each_lines)
+            self.assertTrue(all_lines == each_lines, "Same backtrace for %s" % each_lines[0])
+
+        # The deepest thread went through recurse nine times.
+        recurse_frames = [len([line for line in lines if "recurse" in line]) for lines in all_backtraces]
+        self.assertTrue(max(recurse_frames) == 9, "The deepest stack was unwound all the way")
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
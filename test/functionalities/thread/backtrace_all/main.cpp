@@ -0,0 +1,62 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// This test creates threads whose stacks all have a different depth, so that
+// "thread backtrace all" unwinds several threads through the same functions
+// at the same time.
+
+#include <pthread.h>
+#include <atomic>
+
+#define NUM_THREADS 8
+
+// The number of threads that reached the bottom of their stack.
+std::atomic_int g_threads_ready;
+
+// Set once the breakpoint has been passed, to let the threads exit.
+std::atomic_int g_done;
+
+static int
+recurse (int depth)
+{
+    if (depth == 0)
+    {
+        ++g_threads_ready;
+        while (g_done == 0)
+            ;
+        return 0;
+    }
+    return recurse (depth - 1) + 1;
+}
+
+void *
+thread_func (void *input)
+{
+    return (void *)(long)recurse ((int)(long)input);
+}
+
+int main ()
+{
+    pthread_t threads[NUM_THREADS];
+    g_threads_ready = 0;
+    g_done = 0;
+
+    for (long i = 0; i < NUM_THREADS; ++i)
+        pthread_create (&threads[i], NULL, thread_func, (void *)(i + 1));
+
+    while (g_threads_ready < NUM_THREADS)
+        ;
+
+    g_done = 1; // Set breakpoint here
+
+    for (int i = 0; i < NUM_THREADS; ++i)
+        pthread_join (threads[i], NULL);
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+"""
+Test that the thread.frame-pointer-unwind setting unwinds by following the
+frame pointer chain, and that each frame reports how it was unwound.
+"""
+
+import os, time
+import sys
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class FramePointerUnwindTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_with_dsym(self):
+        """Test frame pointer unwinding."""
+        self.buildDsym()
+        self.frame_pointer_unwind()
+
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test frame pointer unwinding."""
+        self.buildDwarf()
+        self.frame_pointer_unwind()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.line = line_number('main.c', '// Set break point at this line.')
+        def cleanup():
+            self.runCmd("settings clear target.process.thread.frame-pointer-unwind", check=False)
+            self.runCmd("settings clear frame-format", check=False)
+        self.addTearDownHook(cleanup)
+
+    def frame_pointer_unwind(self):
+        """Backtrace a stack of functions that keep a frame pointer."""
+        self.runCmd("settings set target.process.thread.frame-pointer-unwind true")
+        self.runCmd("settings set frame-format 'frame #${frame.index}: ${function.name} (${frame.unwind-method})\\n'")
+
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+        lldbutil.run_break_set_by_file_and_line (self, "main.c", self.line, num_expected_locations=1, loc_exact=True)
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        thread = self.dbg.GetSelectedTarget().GetProcess().GetSelectedThread()
+        self.assertTrue(thread.GetNumFrames() >= 4)
+        function_names = [thread.GetFrameAtIndex(i).GetFunctionName() for i in range(4)]
+        self.assertEquals(function_names, ['level_three', 'level_two', 'level_one', 'main'])
+
+        # Frame 0 always uses the unwind plans, the functions above it all
+        # keep a frame pointer.
+        self.expect("thread backtrace", substrs = ['level_three (unwind plan)',
+                                                   'level_two (frame pointer)',
+                                                   'level_one (frame pointer)'])
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
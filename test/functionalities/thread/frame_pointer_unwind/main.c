@@ -0,0 +1,36 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+int g_depth = 0;
+
+int
+level_three (int value)
+{
+    g_depth = value; // Set break point at this line.
+    return g_depth;
+}
+
+int
+level_two (int value)
+{
+    return level_three (value + 1) + 1;
+}
+
+int
+level_one (int value)
+{
+    return level_two (value + 1) + 1;
+}
+
+int main (int argc, char const *argv[])
+{
+    printf("%d\n", level_one(argc));
+    return 0;
+}
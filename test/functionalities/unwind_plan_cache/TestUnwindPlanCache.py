@@ -0,0 +1,89 @@
+"""
+Test that the unwind plans computed while backtracing get written to the
+target.unwind-plan-cache-path directory and are used by the next target.
+"""
+
+import os, time
+import glob
+import shutil
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class UnwindPlanCacheTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @skipIfDarwin # The Makefile links with --build-id to give a.out a UUID
+    @dwarf_test
+    def test_unwind_plan_cache_with_dwarf(self):
+        """Test that unwind plans are written to the cache directory."""
+        self.buildDwarf()
+        self.unwind_plan_cache()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.line = line_number('main.c', '// Set break point at this line.')
+        self.cache_dir = os.path.join(os.getcwd(), "unwind-plan-cache")
+        if os.path.exists(self.cache_dir):
+            shutil.rmtree(self.cache_dir)
+        def cleanup():
+            self.runCmd("settings clear target.unwind-plan-cache-path", check=False)
+            self.runCmd("settings clear target.unwind-plan-cache-max-size", check=False)
+            if os.path.exists(self.cache_dir):
+                shutil.rmtree(self.cache_dir)
+        self.addTearDownHook(cleanup)
+
+    def backtrace_inner(self, from_cache):
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+        lldbutil.run_break_set_by_file_and_line (self, "main.c", self.line, num_expected_locations=1, loc_exact=True)
+        self.runCmd("run", RUN_SUCCEEDED)
+        self.expect("thread backtrace", substrs = ['inner', 'outer', 'main'])
+        # Plans read from a cache file say so in their source name.
+        self.runCmd("image show-unwind -n inner")
+        output = self.res.GetOutput()
+        self.assertTrue("Asynchronous (not restricted to call-sites) UnwindPlan" in output,
+                        "inner has an assembly profiled unwind plan")
+        if from_cache:
+            self.assertTrue("from the unwind plan cache" in output,
+                            "The unwind plans for inner came from the cache")
+        else:
+            self.assertFalse("from the unwind plan cache" in output,
+                             "The unwind plans for inner were computed in this session")
+        self.runCmd("process kill")
+        self.runCmd("target delete")
+
+    def unwind_plan_cache(self):
+        """Backtrace from a nested function with the unwind plan cache enabled."""
+        self.runCmd("settings set target.unwind-plan-cache-path " + self.cache_dir)
+
+        self.backtrace_inner(False)
+        cache_file = os.path.join(self.cache_dir, "*.unwind-plans")
+        cache_files = glob.glob(cache_file)
+        self.assertTrue(len(cache_files) > 0, "Unwind plan cache files were written")
+
+        # The second session gets the same backtrace from the cached plans.
+        self.backtrace_inner(True)
+
+        # Writing the cache removes the least recently written files once
+        # the cache directory grows beyond target.unwind-plan-cache-max-size.
+        stale_file = os.path.join(self.cache_dir, "stale.unwind-plans")
+        with open(stale_file, "wb") as f:
+            f.write("\0" * (1024 * 1024))
+        old_time = time.time() - 3600
+        os.utime(stale_file, (old_time, old_time))
+        for f in cache_files:
+            os.remove(f)
+        self.runCmd("settings set target.unwind-plan-cache-max-size 1")
+        self.backtrace_inner(False)
+        self.assertFalse(os.path.exists(stale_file), "The oldest cache file was removed")
+        self.assertTrue(len(glob.glob(cache_file)) > 0, "The new cache file was kept")
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,30 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+int g_counter = 0;
+
+int
+inner (int value)
+{
+    g_counter += value; // Set break point at this line.
+    return g_counter;
+}
+
+int
+outer (int value)
+{
+    return inner (value + 1) + 1;
+}
+
+int main (int argc, char const *argv[])
+{
+    printf("%d\n", outer(argc));
+    return 0;
+}
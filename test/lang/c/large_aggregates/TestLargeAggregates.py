@@ -0,0 +1,124 @@
+"""
+Test that large aggregates are read with a single memory read when printing
+them, and that their members show the right values.
+"""
+
+import os, time
+import re
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class LargeAggregatesTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_with_dsym(self):
+        """Test 'frame variable' on arrays of structures."""
+        self.buildDsym()
+        self.large_aggregates()
+
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test 'frame variable' on arrays of structures."""
+        self.buildDwarf()
+        self.large_aggregates()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line numbers to break inside main().
+        self.line = line_number('main.c', '// Set break point at this line.')
+        self.line_after_change = line_number('main.c', '// Stop here after changing a member.')
+
+    def get_stat(self, name):
+        self.runCmd("memory cache-stats")
+        match = re.search(r"^\s*%s:\s+(\d+)" % name, self.res.GetOutput(), re.MULTILINE)
+        self.assertTrue(match, "'memory cache-stats' shows '%s'" % name)
+        return int(match.group(1))
+
+    def get_num_memory_reads(self):
+        """Return the number of reads the memory cache sent to the process."""
+        return self.get_stat("process reads") + self.get_stat("uncached reads")
+
+    def large_aggregates(self):
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        lldbutil.run_break_set_by_file_and_line (self, "main.c", self.line, num_expected_locations=1, loc_exact=True)
+        lldbutil.run_break_set_by_file_and_line (self, "main.c", self.line_after_change, num_expected_locations=1, loc_exact=True)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # The stop reason of the thread should be breakpoint.
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped',
+                       'stop reason = breakpoint'])
+
+        # Both arrays are larger than a cache line, so reading either of
+        # them at once takes a single read that bypasses the memory cache.
+        frame = self.dbg.GetSelectedTarget().GetProcess().GetSelectedThread().GetSelectedFrame()
+        line_size = self.get_stat("cache line size")
+        self.assertTrue(frame.FindVariable("local_points").GetByteSize() > line_size,
+                        "local_points is larger than a cache line")
+
+        self.runCmd("memory cache-stats --reset")
+        self.expect("frame variable local_points", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['[0] = ',
+                       'x = 100',
+                       'y = 200',
+                       "tag = 'A'",
+                       'x = 107',
+                       'y = 207',
+                       "tag = 'H'",
+                       '[63] = ',
+                       'x = 163'])
+        self.assertTrue(self.get_num_memory_reads() == 1,
+                        "local_points was read with a single memory read")
+
+        # Only the first children are printed, the others must not show up.
+        self.runCmd("settings set target.max-children-count 300")
+        self.runCmd("memory cache-stats --reset")
+        self.expect("frame variable g_points", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['[299] = ',
+                       'x = 299',
+                       'y = -299',
+                       '...'])
+        self.assertTrue(self.get_num_memory_reads() == 1,
+                        "g_points was read with a single memory read")
+        self.expect("frame variable g_points", VARIABLES_DISPLAYED_CORRECTLY, matching=False,
+            substrs = ['[300]'])
+
+        # Following a pointer reads the pointee, not the prefetched array.
+        self.expect("frame variable -P 1 local_points[2].next", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['x = 2',
+                       'y = -2',
+                       "tag = 'c'"])
+
+        # The values must be read again once the process ran.
+        self.runCmd("continue")
+        self.expect("frame variable local_points[3]", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['x = 42',
+                       'y = 203'])
+        self.expect("frame variable local_points", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['x = 42'])
+
+        # And when they are changed from the debugger.
+        self.runCmd("expression local_points[4].y = 7")
+        self.expect("frame variable local_points", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['x = 104',
+                       'y = 7'])
+
+    def tearDown(self):
+        self.runCmd("settings clear target.max-children-count", check=False)
+        # Call super's tearDown().
+        TestBase.tearDown(self)
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,42 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+struct point
+{
+    int x;
+    short y;
+    char tag;
+    struct point *next;
+};
+
+struct point g_points[1000];
+
+int main (int argc, char const *argv[])
+{
+    struct point local_points[64];
+    int i;
+    for (i = 0; i < 1000; ++i)
+    {
+        g_points[i].x = i;
+        g_points[i].y = -i;
+        g_points[i].tag = 'a' + (i % 26);
+        g_points[i].next = (i + 1 < 1000) ? &g_points[i + 1] : 0;
+    }
+    for (i = 0; i < 64; ++i)
+    {
+        local_points[i].x = 100 + i;
+        local_points[i].y = 200 + i;
+        local_points[i].tag = 'A' + (i % 26);
+        local_points[i].next = &g_points[i];
+    }
+    printf ("%d\n", local_points[7].x); // Set break point at this line.
+    local_points[3].x = 42;
+    return g_points[999].x - local_points[3].x; // Stop here after changing a member.
+}
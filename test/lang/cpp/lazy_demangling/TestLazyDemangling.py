@@ -0,0 +1,67 @@
+"""
+Test that C++ symbols can be found by their basename, mangled name and
+demangled name when target.lazy-demangling is enabled.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class LazyDemanglingTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_with_dsym(self):
+        """Test symbol lookups with lazy demangling."""
+        self.buildDsym()
+        self.lazy_demangling()
+
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test symbol lookups with lazy demangling."""
+        self.buildDwarf()
+        self.lazy_demangling()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.addTearDownHook(lambda: self.runCmd("settings clear target.lazy-demangling", check=False))
+
+    def lazy_demangling(self):
+        """Look up C++ symbols in a symbol table that was indexed without demangling."""
+        self.runCmd("settings set target.lazy-demangling true")
+
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        module = target.FindModule(target.GetExecutable())
+        self.assertTrue(module, VALID_MODULE)
+
+        # Look up by basename first so the name indexes are built before
+        # any demangled name is asked for.
+        functions = module.FindFunctions("bar", lldb.eFunctionNameTypeBase | lldb.eFunctionNameTypeMethod)
+        self.assertTrue(functions.GetSize() >= 1, "Found ns::Foo::bar by basename")
+
+        symbols = module.FindSymbols("free_function")
+        self.assertTrue(symbols.GetSize() == 0, "Symbols aren't found by their basename alone")
+
+        symbols = module.FindSymbols("ns::free_function(int)")
+        self.assertTrue(symbols.GetSize() == 1, "Found ns::free_function(int) by its demangled name")
+        mangled_name = symbols.GetContextAtIndex(0).GetSymbol().GetMangledName()
+        self.assertTrue(mangled_name, "ns::free_function(int) has a mangled name")
+
+        symbols = module.FindSymbols(mangled_name)
+        self.assertTrue(symbols.GetSize() == 1, "Found ns::free_function(int) by its mangled name")
+
+        symbols = module.FindSymbols("ns::Foo::bar(int) const")
+        self.assertTrue(symbols.GetSize() == 1, "Found ns::Foo::bar(int) const by its demangled name")
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
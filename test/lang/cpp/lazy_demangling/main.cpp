@@ -0,0 +1,41 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+namespace ns {
+
+class Foo
+{
+public:
+    Foo () : m_value (0) {}
+    ~Foo () {}
+
+    int
+    bar (int value) const
+    {
+        return m_value + value;
+    }
+
+private:
+    int m_value;
+};
+
+int
+free_function (int value)
+{
+    return value * 2;
+}
+
+} // namespace ns
+
+int
+main (int argc, char const *argv[])
+{
+    ns::Foo foo;
+    return foo.bar (argc) + ns::free_function (argc);
+}
@@ -0,0 +1,89 @@
+"""
+Test that large memory reads and writes on Linux are done in bulk rather
+than one ptrace call per word.
+"""
+
+import os
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class LinuxBulkMemoryTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    @dwarf_test
+    def test_bulk_memory_with_dwarf(self):
+        """Test that a large buffer is read and written with one bulk transfer."""
+        self.buildDwarf()
+        self.bulk_memory()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.line = line_number('main.cpp', '// Set break point at this line.')
+        self.log_file = os.path.join(os.getcwd(), "bulk-memory.log")
+        if os.path.exists(self.log_file):
+            os.remove(self.log_file)
+        def cleanup():
+            self.runCmd("log disable linux memory", check=False)
+            if os.path.exists(self.log_file):
+                os.remove(self.log_file)
+        self.addTearDownHook(cleanup)
+
+    def bulk_memory(self):
+        """Read and write a 64KB buffer and check the transfers in the log."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        lldbutil.run_break_set_by_file_and_line (self, "main.cpp", self.line, num_expected_locations=1, loc_exact=True)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # The stop reason of the thread should be breakpoint.
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped', 'stop reason = breakpoint'])
+
+        target = self.dbg.GetSelectedTarget()
+        process = target.GetProcess()
+        buffer_addr = target.FindFirstGlobalVariable("g_buffer").GetLoadAddress()
+        self.assertTrue(buffer_addr != lldb.LLDB_INVALID_ADDRESS)
+        buffer_size = 64 * 1024
+
+        self.runCmd("log enable -f %s linux memory" % self.log_file)
+
+        error = lldb.SBError()
+        data = process.ReadMemory(buffer_addr, buffer_size, error)
+        self.assertTrue(error.Success(), "Read the buffer")
+        self.assertTrue(len(data) == buffer_size, "Read the whole buffer")
+        for i in range(buffer_size):
+            if ord(data[i]) != (i * 7) % 256:
+                self.fail("Byte %u of the buffer is wrong" % i)
+
+        new_data = "".join(chr((i * 3) % 256) for i in range(buffer_size))
+        bytes_written = process.WriteMemory(buffer_addr, new_data, error)
+        self.assertTrue(error.Success(), "Wrote the buffer")
+        self.assertTrue(bytes_written == buffer_size, "Wrote the whole buffer")
+
+        self.runCmd("log disable linux memory")
+
+        # The inferior sees the new contents.
+        self.expect("expression -- (int)g_buffer[%u]" % (buffer_size - 1),
+            substrs = ['= %u' % (((buffer_size - 1) * 3) % 256)])
+        self.expect("expression -- (int)g_buffer[1]", substrs = ['= 3'])
+
+        # Both transfers were done in bulk, without falling back to ptrace.
+        with open(self.log_file, "r") as f:
+            log = f.read()
+        self.assertTrue("bulk read %u bytes" % buffer_size in log,
+                        "The buffer was read in bulk")
+        self.assertTrue("bulk wrote %u bytes" % buffer_size in log,
+                        "The buffer was written in bulk")
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,19 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+unsigned char g_buffer[64 * 1024];
+
+int main (int argc, char const *argv[])
+{
+    for (unsigned i = 0; i < sizeof(g_buffer); ++i)
+        g_buffer[i] = (unsigned char)(i * 7);
+    printf("g_buffer=%p\n", g_buffer); // Set break point at this line.
+    return 0;
+}
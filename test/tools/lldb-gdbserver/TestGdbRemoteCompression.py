@@ -0,0 +1,104 @@
+import struct
+import unittest2
+
+import gdbremote_testcase
+from lldbtest import *
+
+class TestGdbRemoteCompression(gdbremote_testcase.GdbRemoteTestCaseBase):
+
+    COMPRESSIONS_FEATURE_NAME = "SupportedCompressions"
+
+    def decompress_lz4(self, compressed, decompressed_size):
+        # Decode an LZ4 block.
+        decompressed = ""
+        pos = 0
+        while pos < len(compressed):
+            token = ord(compressed[pos])
+            pos += 1
+
+            def read_length(length, pos):
+                if length == 15:
+                    while True:
+                        byte = ord(compressed[pos])
+                        pos += 1
+                        length += byte
+                        if byte != 255:
+                            break
+                return (length, pos)
+
+            (literal_length, pos) = read_length(token >> 4, pos)
+            decompressed += compressed[pos:pos + literal_length]
+            pos += literal_length
+            if pos == len(compressed):
+                break
+
+            offset = struct.unpack("<H", compressed[pos:pos + 2])[0]
+            pos += 2
+            self.assertTrue(offset > 0 and offset <= len(decompressed))
+            (match_length, pos) = read_length(token & 0xf, pos)
+            match_pos = len(decompressed) - offset
+            for i in range(match_length + 4):
+                decompressed += decompressed[match_pos + i]
+
+        self.assertEquals(len(decompressed), decompressed_size)
+        return decompressed
+
+    def get_host_info_packet(self):
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: $qHostInfo#00",
+             {"direction":"send", "regex":re.compile(r"^\$(.+)#[0-9a-fA-F]{2}$", re.MULTILINE|re.DOTALL), "capture":{1:"host_info"} }],
+            True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        self.assertIsNotNone(context.get("host_info"))
+        return context.get("host_info")
+
+    def lz4_compression_round_trips(self):
+        server = self.connect_to_debug_monitor()
+        self.assertIsNotNone(server)
+
+        self.add_no_ack_remote_stream()
+        self.add_qSupported_packets()
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        features = self.parse_qSupported_response(context)
+        self.assertTrue(self.COMPRESSIONS_FEATURE_NAME in features)
+        self.assertTrue("lz4" in features[self.COMPRESSIONS_FEATURE_NAME].split(","))
+
+        # Grab the host info before enabling compression so we know what to expect.
+        host_info = self.get_host_info_packet()
+
+        # Compress everything, no matter how small.
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: $QEnableCompression:type:lz4;minsize:0;#00",
+             "send packet: $OK#00"],
+            True)
+        self.assertIsNotNone(self.expect_gdbremote_sequence())
+
+        # Every packet is now framed as compressed or not compressed.
+        framed_host_info = self.decode_gdbremote_binary(self.get_host_info_packet())
+        if framed_host_info[0] == "N":
+            self.assertEquals(framed_host_info[1:], host_info)
+        else:
+            self.assertEquals(framed_host_info[0], "C")
+            colon_pos = framed_host_info.find(":")
+            self.assertTrue(colon_pos > 1)
+            decompressed_size = int(framed_host_info[1:colon_pos])
+            self.assertEquals(self.decompress_lz4(framed_host_info[colon_pos + 1:], decompressed_size), host_info)
+
+    @debugserver_test
+    def test_lz4_compression_round_trips_debugserver(self):
+        self.init_debugserver_test()
+        self.lz4_compression_round_trips()
+
+    @llgs_test
+    def test_lz4_compression_round_trips_llgs(self):
+        self.init_llgs_test()
+        self.lz4_compression_round_trips()
+
+
+if __name__ == '__main__':
+    unittest2.main()
@@ -0,0 +1,149 @@
+import unittest2
+
+import gdbremote_testcase
+from lldbtest import *
+
+class TestGdbRemoteConditionalBreakpoints(gdbremote_testcase.GdbRemoteTestCaseBase):
+
+    CONDITIONAL_BREAKPOINTS_FEATURE_NAME = "ConditionalBreakpoints"
+
+    # Agent expressions: "const8 <value>; end"
+    FALSE_CONDITION = "2200" + "27"
+    TRUE_CONDITION = "2201" + "27"
+
+    # Note this might need to be switched per platform (ARM, mips, etc.).
+    BREAKPOINT_KIND = 1
+
+    def launch_and_get_function_address(self):
+        # Start up the inferior.
+        procs = self.prep_debug_monitor_and_inferior(
+            inferior_args=["get-code-address-hex:hello", "sleep:1", "call-function:hello"])
+
+        # Run the process
+        self.test_sequence.add_log_lines(
+            [# Start running after initial stop.
+             "read packet: $c#00",
+             # Match output line that prints the memory address of the function call entry point.
+             # Note we require launch-only testing so we can get inferior otuput.
+             { "type":"output_match", "regex":r"^code address: 0x([0-9a-fA-F]+)\r\n$", "capture":{ 1:"function_address"} },
+             # Now stop the inferior.
+             "read packet: {}".format(chr(03)),
+             # And wait for the stop notification.
+             {"direction":"send", "regex":r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);", "capture":{1:"stop_signo", 2:"stop_thread_id"} }],
+            True)
+        self.add_qSupported_packets()
+
+        # Run the packet stream.
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        features = self.parse_qSupported_response(context)
+        self.assertTrue(self.CONDITIONAL_BREAKPOINTS_FEATURE_NAME in features)
+        self.assertEquals(features[self.CONDITIONAL_BREAKPOINTS_FEATURE_NAME], "+")
+
+        # Grab the function address.
+        self.assertIsNotNone(context.get("function_address"))
+        return int(context.get("function_address"), 16)
+
+    def add_set_conditional_breakpoint_packets(self, address, condition):
+        self.test_sequence.add_log_lines(
+            [# Set the breakpoint with its condition.
+             "read packet: $Z0,{0:x},{1};X{2:x},{3}#00".format(address, self.BREAKPOINT_KIND, len(condition) / 2, condition),
+             # Verify the stub could set it.
+             "send packet: $OK#00",
+             ], True)
+
+    def false_condition_does_not_stop(self):
+        function_address = self.launch_and_get_function_address()
+
+        self.reset_test_sequence()
+        self.add_set_conditional_breakpoint_packets(function_address, self.FALSE_CONDITION)
+        self.test_sequence.add_log_lines(
+            [# Continue running.
+             "read packet: $c#00",
+             # The breakpoint is hit but its condition is false, so the call completes.
+             { "type":"output_match", "regex":r"^hello, world\r\n$" },
+             # And wait for program completion.
+             {"direction":"send", "regex":r"^\$W00(.*)#[0-9a-fA-F]{2}$" },
+             ], True)
+
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+    @debugserver_test
+    @dsym_test
+    def test_false_condition_does_not_stop_debugserver_dsym(self):
+        self.init_debugserver_test()
+        self.buildDsym()
+        self.set_inferior_startup_launch()
+        self.false_condition_does_not_stop()
+
+    def true_condition_stops(self):
+        function_address = self.launch_and_get_function_address()
+
+        self.reset_test_sequence()
+        self.add_set_conditional_breakpoint_packets(function_address, self.TRUE_CONDITION)
+        self.test_sequence.add_log_lines(
+            [# Continue running.
+             "read packet: $c#00",
+             # Expect a breakpoint stop report.
+             {"direction":"send", "regex":r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);", "capture":{1:"stop_signo", 2:"stop_thread_id"} },
+             ], True)
+
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        # Verify the stop signal reported was the breakpoint signal number.
+        stop_signo = context.get("stop_signo")
+        self.assertIsNotNone(stop_signo)
+        self.assertEquals(int(stop_signo,16), signal.SIGTRAP)
+
+        # Ensure the call didn't run.
+        self.assertEquals(len(context["O_content"]), 0)
+
+        # Remove the breakpoint and let the call complete.
+        self.reset_test_sequence()
+        self.add_remove_breakpoint_packets(function_address, self.BREAKPOINT_KIND)
+        self.test_sequence.add_log_lines(
+            ["read packet: $c#00",
+             { "type":"output_match", "regex":r"^hello, world\r\n$" },
+             {"direction":"send", "regex":r"^\$W00(.*)#[0-9a-fA-F]{2}$" },
+             ], True)
+
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+    @debugserver_test
+    @dsym_test
+    def test_true_condition_stops_debugserver_dsym(self):
+        self.init_debugserver_test()
+        self.buildDsym()
+        self.set_inferior_startup_launch()
+        self.true_condition_stops()
+
+    def oversized_condition_length_is_rejected(self):
+        function_address = self.launch_and_get_function_address()
+
+        # Claim lengths longer than the bytes in the packet, and longer
+        # than any condition the stub accepts.
+        self.reset_test_sequence()
+        for condition_len in [len(self.TRUE_CONDITION) / 2 + 1, 0xffffffff]:
+            self.test_sequence.add_log_lines(
+                ["read packet: $Z0,{0:x},{1};X{2:x},{3}#00".format(function_address, self.BREAKPOINT_KIND, condition_len, self.TRUE_CONDITION),
+                 "send packet: $E03#00",
+                 ], True)
+
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+    @debugserver_test
+    @dsym_test
+    def test_oversized_condition_length_is_rejected_debugserver_dsym(self):
+        self.init_debugserver_test()
+        self.buildDsym()
+        self.set_inferior_startup_launch()
+        self.oversized_condition_length_is_rejected()
+
+
+if __name__ == '__main__':
+    unittest2.main()
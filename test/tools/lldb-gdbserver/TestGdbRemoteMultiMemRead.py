@@ -0,0 +1,115 @@
+import unittest2
+
+import gdbremote_testcase
+from lldbtest import *
+
+class TestGdbRemoteMultiMemRead(gdbremote_testcase.GdbRemoteTestCaseBase):
+
+    MULTI_MEM_READ_FEATURE_NAME = "qMultiMemRead"
+
+    MEMORY_CONTENTS = "Test contents 0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ abcdefghijklmnopqrstuvwxyz"
+
+    def launch_and_get_message_address(self):
+        # Start up the inferior.
+        procs = self.prep_debug_monitor_and_inferior(
+            inferior_args=["set-message:%s" % self.MEMORY_CONTENTS, "get-data-address-hex:g_message", "sleep:5"])
+
+        # Run the process
+        self.test_sequence.add_log_lines(
+            [
+             # Start running after initial stop.
+             "read packet: $c#00",
+             # Match output line that prints the memory address of the message buffer within the inferior.
+             # Note we require launch-only testing so we can get inferior otuput.
+             { "type":"output_match", "regex":r"^data address: 0x([0-9a-fA-F]+)\r\n$", "capture":{ 1:"message_address"} },
+             # Now stop the inferior.
+             "read packet: {}".format(chr(03)),
+             # And wait for the stop notification.
+             {"direction":"send", "regex":r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);", "capture":{1:"stop_signo", 2:"stop_thread_id"} }],
+            True)
+        self.add_qSupported_packets()
+
+        # Run the packet stream.
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        features = self.parse_qSupported_response(context)
+        self.assertTrue(self.MULTI_MEM_READ_FEATURE_NAME in features)
+        self.assertEquals(features[self.MULTI_MEM_READ_FEATURE_NAME], "+")
+        self.assertTrue("PacketSize" in features)
+        self.packet_size = int(features["PacketSize"], 16)
+
+        # Grab the message address.
+        self.assertIsNotNone(context.get("message_address"))
+        return int(context.get("message_address"), 16)
+
+    def qMultiMemRead_reads_multiple_ranges(self):
+        message_address = self.launch_and_get_message_address()
+
+        # Read the start and the end of the message, plus a range that can't be read.
+        ranges = [(message_address, 13), (0, 8), (message_address + 25, 26)]
+        packet = "qMultiMemRead:" + "".join(["{0:x},{1:x};".format(addr, length) for (addr, length) in ranges])
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: ${}#00".format(packet),
+             {"direction":"send", "regex":r"^\$([0-9a-fA-F,]+);([0-9a-fA-F]*)#[0-9a-fA-F]{2}$", "capture":{1:"counts", 2:"read_contents"} }],
+            True)
+
+        # Run the packet stream.
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        # Ensure we get a count for every range, and nothing for the bad one.
+        counts = [int(count, 16) for count in context.get("counts").split(",")]
+        self.assertEquals(counts, [13, 0, 26])
+
+        # Ensure what we read from inferior memory is what we wrote.
+        read_contents = context.get("read_contents").decode("hex")
+        self.assertEquals(read_contents, self.MEMORY_CONTENTS[0:13] + self.MEMORY_CONTENTS[25:51])
+
+    def qMultiMemRead_rejects_oversized_reply(self):
+        message_address = self.launch_and_get_message_address()
+        packet_size = self.packet_size
+
+        # One range whose hex encoded bytes alone wouldn't fit, and several
+        # ranges that each fit but together don't, must both be refused.
+        for ranges in [[(message_address, packet_size)],
+                       [(message_address, packet_size / 4)] * 3]:
+            packet = "qMultiMemRead:" + "".join(["{0:x},{1:x};".format(addr, length) for (addr, length) in ranges])
+            self.reset_test_sequence()
+            self.test_sequence.add_log_lines(
+                ["read packet: ${}#00".format(packet),
+                 {"direction":"send", "regex":r"^\$E([0-9a-fA-F]{2})#[0-9a-fA-F]{2}$", "capture":{1:"error"} }],
+                True)
+            context = self.expect_gdbremote_sequence()
+            self.assertIsNotNone(context)
+            self.assertIsNotNone(context.get("error"))
+
+    @debugserver_test
+    @dsym_test
+    def test_qMultiMemRead_rejects_oversized_reply_debugserver_dsym(self):
+        self.init_debugserver_test()
+        self.buildDsym()
+        self.set_inferior_startup_launch()
+        self.qMultiMemRead_rejects_oversized_reply()
+
+    @debugserver_test
+    @dsym_test
+    def test_qMultiMemRead_reads_multiple_ranges_debugserver_dsym(self):
+        self.init_debugserver_test()
+        self.buildDsym()
+        self.set_inferior_startup_launch()
+        self.qMultiMemRead_reads_multiple_ranges()
+
+    @llgs_test
+    @dwarf_test
+    @unittest2.expectedFailure()
+    def test_qMultiMemRead_reads_multiple_ranges_llgs_dwarf(self):
+        self.init_llgs_test()
+        self.buildDwarf()
+        self.set_inferior_startup_launch()
+        self.qMultiMemRead_reads_multiple_ranges()
+
+
+if __name__ == '__main__':
+    unittest2.main()
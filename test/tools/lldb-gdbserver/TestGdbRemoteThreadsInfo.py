@@ -0,0 +1,99 @@
+import json
+import unittest2
+
+import gdbremote_testcase
+from lldbtest import *
+
+class TestGdbRemoteThreadsInfo(gdbremote_testcase.GdbRemoteTestCaseBase):
+
+    THREADS_INFO_FEATURE_NAME = "jThreadsInfo"
+
+    def launch_and_stop_with_threads(self, thread_count):
+        # Start up the inferior with the requested number of threads.
+        inferior_args = []
+        for i in range(thread_count - 1):
+            inferior_args.append("thread:new")
+        inferior_args.append("sleep:5")
+        procs = self.prep_debug_monitor_and_inferior(inferior_args=inferior_args)
+
+        self.test_sequence.add_log_lines(["read packet: $c#00"], True)
+        self.add_qSupported_packets()
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        features = self.parse_qSupported_response(context)
+        self.assertTrue(self.THREADS_INFO_FEATURE_NAME in features)
+        self.assertEquals(features[self.THREADS_INFO_FEATURE_NAME], "+")
+
+        # Give the threads time to start up, then stop the inferior.
+        time.sleep(1)
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: {}".format(chr(03)),
+             {"direction":"send", "regex":r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);", "capture":{1:"stop_signo", 2:"stop_thread_id"} }],
+            True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        # Wait until all threads have started.
+        threads = self.wait_for_thread_count(thread_count, timeout_seconds=3)
+        self.assertIsNotNone(threads)
+        self.assertEquals(len(threads), thread_count)
+        return threads
+
+    def get_threads_info(self):
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: $jThreadsInfo#00",
+             {"direction":"send", "regex":r"^\$(.+)#[0-9a-fA-F]{2}$", "capture":{1:"threads_info"} }],
+            True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        threads_info_raw = context.get("threads_info")
+        self.assertIsNotNone(threads_info_raw)
+        threads_info = json.loads(self.decode_gdbremote_binary(threads_info_raw))
+        self.assertTrue(isinstance(threads_info, list))
+        return threads_info
+
+    def jThreadsInfo_reports_all_threads(self):
+        threads = self.launch_and_stop_with_threads(3)
+
+        # Grab the register number of the pc so we can check it is expedited.
+        reg_infos = self.gather_register_infos()
+        pc_reg_info = self.find_generic_register_with_name(reg_infos, "pc")
+        self.assertIsNotNone(pc_reg_info)
+
+        threads_info = self.get_threads_info()
+        self.assertEquals(len(threads_info), len(threads))
+
+        reported_tids = set()
+        for thread_info in threads_info:
+            self.assertTrue("tid" in thread_info)
+            self.assertTrue("signal" in thread_info)
+            self.assertTrue("registers" in thread_info)
+            self.assertTrue(str(pc_reg_info["lldb_register_index"]) in thread_info["registers"])
+            reported_tids.add(thread_info["tid"])
+
+        self.assertEquals(reported_tids, set(threads))
+
+    @debugserver_test
+    @dsym_test
+    def test_jThreadsInfo_reports_all_threads_debugserver_dsym(self):
+        self.init_debugserver_test()
+        self.buildDsym()
+        self.set_inferior_startup_launch()
+        self.jThreadsInfo_reports_all_threads()
+
+    @llgs_test
+    @dwarf_test
+    @unittest2.expectedFailure()
+    def test_jThreadsInfo_reports_all_threads_llgs_dwarf(self):
+        self.init_llgs_test()
+        self.buildDwarf()
+        self.set_inferior_startup_launch()
+        self.jThreadsInfo_reports_all_threads()
+
+
+if __name__ == '__main__':
+    unittest2.main()
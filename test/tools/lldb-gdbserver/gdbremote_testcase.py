@@ -474,6 +474,10 @@ class GdbRemoteTestCaseBase(TestBase):
         "qXfer:auxv:read",
         "qXfer:libraries:read",
         "qXfer:libraries-svr4:read",
+        "qMultiMemRead",
+        "jThreadsInfo",
+        "SupportedCompressions",
+        "ConditionalBreakpoints",
     ]
 
     def parse_qSupported_response(self, context):
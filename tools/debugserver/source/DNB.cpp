@@ -1179,6 +1179,23 @@ DNBBreakpointClear (nub_process_t pid, nub_addr_t addr)
     return false; // Failed
 }
 
+//----------------------------------------------------------------------
+// Temporarily remove or re-insert the breakpoint at ADDR without
+// changing its reference count.
+//----------------------------------------------------------------------
+nub_bool_t
+DNBBreakpointSetEnabled (nub_process_t pid, nub_addr_t addr, nub_bool_t enabled)
+{
+    MachProcessSP procSP;
+    if (GetProcessSP (pid, procSP))
+    {
+        if (enabled)
+            return procSP->EnableBreakpoint(addr);
+        return procSP->DisableBreakpoint(addr, false);
+    }
+    return false; // Failed
+}
+
 
 //----------------------------------------------------------------------
 // Watchpoints
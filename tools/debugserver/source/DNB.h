@@ -143,6 +143,7 @@ nub_addr_t      DNBGetTSDAddressForThread       (nub_process_t pid, nub_thread_t
 //----------------------------------------------------------------------
 nub_bool_t      DNBBreakpointSet                (nub_process_t pid, nub_addr_t addr, nub_size_t size, nub_bool_t hardware);
 nub_bool_t      DNBBreakpointClear              (nub_process_t pid, nub_addr_t addr);
+nub_bool_t      DNBBreakpointSetEnabled         (nub_process_t pid, nub_addr_t addr, nub_bool_t enabled);
 
 //----------------------------------------------------------------------
 // Watchpoint functions
@@ -27,6 +27,7 @@
 #include "RNBContext.h"
 #include "RNBServices.h"
 #include "RNBSocket.h"
+#include "Utility/LZ4Block.h"
 #include "Utility/StringExtractor.h"
 #include "MacOSX/Genealogy.h"
 
@@ -59,6 +60,11 @@
 #define FLOAT(n, d)     std::setfill(' ') << std::setw((n)+(d)+1) << std::setprecision(d) << std::showpoint << std::fixed
 #define INDENT_WITH_SPACES(iword_idx)   std::setfill(' ') << std::setw((iword_idx)) << ""
 #define INDENT_WITH_TABS(iword_idx)     std::setfill('\t') << std::setw((iword_idx)) << ""
+
+// The packet size we advertise in qSupported; replies we build from a
+// client supplied length must not be larger than this.
+static const uint32_t g_max_packet_size = 128 * 1024;  // 128KBytes is a reasonable max packet size--debugger can always use less
+
 // Class to handle communications via gdb remote protocol.
 
 extern void ASLLogCallback(void *baton, uint32_t flags, const char *format, va_list args);
@@ -78,7 +84,14 @@ RNBRemote::RNBRemote () :
     m_extended_mode(false),
     m_noack_mode(false),
     m_thread_suffix_supported (false),
-    m_list_threads_in_stop_reply (false)
+    m_list_threads_in_stop_reply (false),
+    m_compression_enabled (false),
+    m_compression_min_size (0),
+    m_breakpoint_conditions (),
+    m_filtered_breakpoint_hits (),
+    m_resume_actions (),
+    m_step_over_bp_addr (INVALID_NUB_ADDRESS),
+    m_step_over_tid (INVALID_NUB_THREAD)
 {
     DNBLogThreadedIf (LOG_RNB_REMOTE, "%s", __PRETTY_FUNCTION__);
     CreatePacketTable ();
@@ -178,6 +191,7 @@ RNBRemote::CreatePacketTable  ()
     t.push_back (Packet (query_process_info,            &RNBRemote::HandlePacket_qProcessInfo,     NULL, "qProcessInfo", "Replies with multiple 'key:value;' tuples appended to each other."));
 //  t.push_back (Packet (query_symbol_lookup,           &RNBRemote::HandlePacket_UNIMPLEMENTED, NULL, "qSymbol", "Notify that host debugger is ready to do symbol lookups"));
     t.push_back (Packet (json_query_thread_extended_info,          &RNBRemote::HandlePacket_jThreadExtendedInfo,     NULL, "jThreadExtendedInfo", "Replies with JSON data of thread extended information."));
+    t.push_back (Packet (json_query_threads_info,       &RNBRemote::HandlePacket_jThreadsInfo,  NULL, "jThreadsInfo", "Replies with JSON data of the stop information and expedited registers for all threads."));
     t.push_back (Packet (start_noack_mode,              &RNBRemote::HandlePacket_QStartNoAckMode        , NULL, "QStartNoAckMode", "Request that " DEBUGSERVER_PROGRAM_NAME " stop acking remote protocol packets"));
     t.push_back (Packet (prefix_reg_packets_with_tid,   &RNBRemote::HandlePacket_QThreadSuffixSupported , NULL, "QThreadSuffixSupported", "Check if thread specifc packets (register packets 'g', 'G', 'p', and 'P') support having the thread ID appended to the end of the command"));
     t.push_back (Packet (set_logging_mode,              &RNBRemote::HandlePacket_QSetLogging            , NULL, "QSetLogging:", "Check if register packets ('g', 'G', 'p', and 'P' support having the thread ID prefix"));
@@ -199,11 +213,13 @@ RNBRemote::CreatePacketTable  ()
     t.push_back (Packet (save_register_state,           &RNBRemote::HandlePacket_SaveRegisterState, NULL, "QSaveRegisterState", "Save the register state for the current thread and return a decimal save ID."));
     t.push_back (Packet (restore_register_state,        &RNBRemote::HandlePacket_RestoreRegisterState, NULL, "QRestoreRegisterState:", "Restore the register state given a save ID previosly returned from a call to QSaveRegisterState."));
     t.push_back (Packet (memory_region_info,            &RNBRemote::HandlePacket_MemoryRegionInfo, NULL, "qMemoryRegionInfo", "Return size and attributes of a memory region that contains the given address"));
+    t.push_back (Packet (read_memory_ranges,            &RNBRemote::HandlePacket_qMultiMemRead, NULL, "qMultiMemRead:", "Read multiple ranges of memory"));
     t.push_back (Packet (get_profile_data,              &RNBRemote::HandlePacket_GetProfileData, NULL, "qGetProfileData", "Return profiling data of the current target."));
     t.push_back (Packet (set_enable_profiling,          &RNBRemote::HandlePacket_SetEnableAsyncProfiling, NULL, "QSetEnableAsyncProfiling", "Enable or disable the profiling of current target."));
     t.push_back (Packet (watchpoint_support_info,       &RNBRemote::HandlePacket_WatchpointSupportInfo, NULL, "qWatchpointSupportInfo", "Return the number of supported hardware watchpoints"));
     t.push_back (Packet (set_process_event,             &RNBRemote::HandlePacket_QSetProcessEvent, NULL, "QSetProcessEvent:", "Set a process event, to be passed to the process, can be set before the process is started, or after."));
     t.push_back (Packet (set_detach_on_error,           &RNBRemote::HandlePacket_QSetDetachOnError, NULL, "QSetDetachOnError:", "Set whether debugserver will detach (1) or kill (0) from the process it is controlling if it loses connection to lldb."));
+    t.push_back (Packet (enable_compression,            &RNBRemote::HandlePacket_QEnableCompression, NULL, "QEnableCompression:", "Compress the packets " DEBUGSERVER_PROGRAM_NAME " sends with the specified codec."));
     t.push_back (Packet (speed_test,                    &RNBRemote::HandlePacket_qSpeedTest, NULL, "qSpeedTest:", "Test the maximum speed at which packet can be sent/received."));
 }
 
@@ -303,10 +319,48 @@ RNBRemote::SendAsyncProfileDataPacket (char *buf, nub_size_t buf_size)
     return SendPacket(packet);
 }
 
+// Frame a payload for a connection that has compression enabled. Small
+// payloads and ones that don't shrink are sent as "N<payload>", the rest as
+// "C<uncompressed size>:<escaped lz4 data>".
+std::string
+RNBRemote::CompressPayload (const std::string &payload)
+{
+    if (payload.size() >= m_compression_min_size)
+    {
+        std::string compressed;
+        LZ4Block::Compress ((const uint8_t *)payload.data(), payload.size(), compressed);
+        if (compressed.size() < payload.size())
+        {
+            char header[32];
+            snprintf (header, sizeof header, "C%llu:", (unsigned long long)payload.size());
+            std::string framed (header);
+            for (size_t i = 0; i < compressed.size(); ++i)
+            {
+                // Escape everything that has a meaning in the packet framing
+                const char ch = compressed[i];
+                if (ch == '#' || ch == '$' || ch == '}' || ch == '*')
+                {
+                    framed.push_back (0x7d);
+                    framed.push_back (ch ^ 0x20);
+                }
+                else
+                {
+                    framed.push_back (ch);
+                }
+            }
+            // Escaping can eat up the savings for payloads that barely compress
+            if (framed.size() <= payload.size())
+                return framed;
+        }
+    }
+    return "N" + payload;
+}
+
 rnb_err_t
-RNBRemote::SendPacket (const std::string &s)
+RNBRemote::SendPacket (const std::string &payload)
 {
-    DNBLogThreadedIf (LOG_RNB_MAX, "%8d RNBRemote::%s (%s) called", (uint32_t)m_comm.Timer().ElapsedMicroSeconds(true), __FUNCTION__, s.c_str());
+    DNBLogThreadedIf (LOG_RNB_MAX, "%8d RNBRemote::%s (%s) called", (uint32_t)m_comm.Timer().ElapsedMicroSeconds(true), __FUNCTION__, payload.c_str());
+    const std::string s = m_compression_enabled ? CompressPayload (payload) : payload;
     std::string sendpacket = "$" + s + "#";
     int cksum = 0;
     char hexbuf[5];
@@ -1058,10 +1112,335 @@ RNBRemote::InitializeRegisters (bool force)
 void
 RNBRemote::NotifyThatProcessStopped (void)
 {
+    if (ResumeIfBreakpointConditionsAreFalse ())
+        return;
     RNBRemote::HandlePacket_last_signal (NULL);
     return;
 }
 
+// The largest breakpoint condition we accept in a Z packet. Conditions
+// are compiled from simple comparisons, so real ones are far smaller.
+static const uint32_t g_max_agent_expression_size = 0x1000;
+
+//----------------------------------------------------------------------
+// Evaluate the agent expression BYTECODE (see "Agent Expressions" in
+// the gdb manual) in thread TID. Only the opcodes needed for breakpoint
+// conditions are supported, anything else is an error.
+//
+// RETURNS: true and the value on top of the stack in RESULT if the
+// expression reached its "end" opcode, false otherwise.
+//----------------------------------------------------------------------
+static bool
+evaluate_agent_expression (nub_process_t pid, nub_thread_t tid, const std::vector<uint8_t> &bytecode, uint64_t &result)
+{
+    std::vector<uint64_t> stack;
+    const size_t size = bytecode.size();
+    size_t pc = 0;
+    // Bound the number of executed opcodes in case of a backward jump
+    for (size_t count = 0; pc < size && count < 0x10000; ++count)
+    {
+        const uint8_t op = bytecode[pc++];
+        switch (op)
+        {
+            case 0x02:  // add
+            case 0x03:  // sub
+            case 0x13:  // equal
+            case 0x14:  // less_signed
+            case 0x15:  // less_unsigned
+                {
+                    if (stack.size() < 2)
+                        return false;
+                    const uint64_t b = stack.back();
+                    stack.pop_back();
+                    const uint64_t a = stack.back();
+                    uint64_t &value = stack.back();
+                    if (op == 0x02)
+                        value = a + b;
+                    else if (op == 0x03)
+                        value = a - b;
+                    else if (op == 0x13)
+                        value = a == b;
+                    else if (op == 0x14)
+                        value = (int64_t)a < (int64_t)b;
+                    else
+                        value = a < b;
+                }
+                break;
+
+            case 0x0e:  // log_not
+                if (stack.empty())
+                    return false;
+                stack.back() = stack.back() == 0;
+                break;
+
+            case 0x16:  // ext n
+            case 0x2a:  // zero_ext n
+                {
+                    if (stack.empty() || pc >= size)
+                        return false;
+                    const uint32_t bits = bytecode[pc++];
+                    if (bits == 0)
+                        return false;
+                    if (bits < 64)
+                    {
+                        const uint32_t shift = 64 - bits;
+                        if (op == 0x16)
+                            stack.back() = (uint64_t)((int64_t)(stack.back() << shift) >> shift);
+                        else
+                            stack.back() &= (UINT64_MAX >> shift);
+                    }
+                }
+                break;
+
+            case 0x17:  // ref8
+            case 0x18:  // ref16
+            case 0x19:  // ref32
+            case 0x1a:  // ref64
+                {
+                    if (stack.empty())
+                        return false;
+                    const nub_size_t byte_size = 1u << (op - 0x17);
+                    uint8_t buf[8];
+                    if (DNBProcessMemoryRead (pid, stack.back(), byte_size, buf) != byte_size)
+                        return false;
+                    uint64_t value = 0;
+                    switch (byte_size)
+                    {
+                        case 1: value = buf[0]; break;
+                        case 2: { uint16_t v; memcpy (&v, buf, sizeof(v)); value = v; } break;
+                        case 4: { uint32_t v; memcpy (&v, buf, sizeof(v)); value = v; } break;
+                        case 8: memcpy (&value, buf, sizeof(value)); break;
+                    }
+                    stack.back() = value;
+                }
+                break;
+
+            case 0x20:  // if_goto offset
+            case 0x21:  // goto offset
+                {
+                    if (pc + 2 > size)
+                        return false;
+                    const size_t target = ((size_t)bytecode[pc] << 8) | bytecode[pc + 1];
+                    pc += 2;
+                    bool jump = true;
+                    if (op == 0x20)
+                    {
+                        if (stack.empty())
+                            return false;
+                        jump = stack.back() != 0;
+                        stack.pop_back();
+                    }
+                    if (jump)
+                        pc = target;
+                }
+                break;
+
+            case 0x22:  // const8
+            case 0x23:  // const16
+            case 0x24:  // const32
+            case 0x25:  // const64
+                {
+                    const size_t byte_size = 1u << (op - 0x22);
+                    if (pc + byte_size > size)
+                        return false;
+                    uint64_t value = 0;
+                    for (size_t i = 0; i < byte_size; ++i)
+                        value = (value << 8) | bytecode[pc++];
+                    stack.push_back (value);
+                }
+                break;
+
+            case 0x26:  // reg n
+                {
+                    if (pc + 2 > size)
+                        return false;
+                    const uint32_t reg = ((uint32_t)bytecode[pc] << 8) | bytecode[pc + 1];
+                    pc += 2;
+                    if (g_reg_entries == NULL || reg >= g_num_reg_entries)
+                        return false;
+                    DNBRegisterValue reg_value;
+                    if (!DNBThreadGetRegisterValueByID (pid, tid, g_reg_entries[reg].nub_info.set, g_reg_entries[reg].nub_info.reg, &reg_value))
+                        return false;
+                    uint64_t value = 0;
+                    switch (reg_value.info.size)
+                    {
+                        case 1: value = reg_value.value.uint8; break;
+                        case 2: value = reg_value.value.uint16; break;
+                        case 4: value = reg_value.value.uint32; break;
+                        case 8: value = reg_value.value.uint64; break;
+                        default:
+                            return false;
+                    }
+                    stack.push_back (value);
+                }
+                break;
+
+            case 0x27:  // end
+                if (stack.empty())
+                    return false;
+                result = stack.back();
+                return true;
+
+            case 0x28:  // dup
+                if (stack.empty())
+                    return false;
+                stack.push_back (stack.back());
+                break;
+
+            case 0x29:  // pop
+                if (stack.empty())
+                    return false;
+                stack.pop_back();
+                break;
+
+            case 0x2b:  // swap
+                if (stack.size() < 2)
+                    return false;
+                std::swap (stack[stack.size() - 1], stack[stack.size() - 2]);
+                break;
+
+            default:
+                return false;
+        }
+    }
+    return false;
+}
+
+//----------------------------------------------------------------------
+// Check whether this stop is a hit of a conditional breakpoint whose
+// conditions are all false, and if so step the thread over the
+// breakpoint and keep the process going the way the debugger last
+// resumed it. The debugger only learns how many such hits there were
+// from the "filteredhits" keys in the next stop reply.
+//
+// RETURNS: true if the process was resumed and no stop reply must be
+// sent.
+//----------------------------------------------------------------------
+bool
+RNBRemote::ResumeIfBreakpointConditionsAreFalse (void)
+{
+    const nub_process_t pid = m_ctx.ProcessID();
+    if (pid == INVALID_NUB_PROCESS || !DNBProcessIsAlive (pid))
+        return false;
+
+    // Find the only thread with a stop reason
+    nub_thread_t stop_tid = INVALID_NUB_THREAD;
+    DNBThreadStopInfo stop_info;
+    const nub_size_t num_threads = DNBProcessGetNumThreads (pid);
+    for (nub_size_t i = 0; i < num_threads; ++i)
+    {
+        const nub_thread_t tid = DNBProcessGetThreadAtIndex (pid, i);
+        DNBThreadStopInfo tid_stop_info;
+        if (!DNBThreadGetStopReason (pid, tid, &tid_stop_info))
+            continue;
+        if (tid_stop_info.reason == eStopTypeInvalid ||
+            (tid_stop_info.reason == eStopTypeException && tid_stop_info.details.exception.type == 0))
+            continue;
+        if (stop_tid != INVALID_NUB_THREAD)
+        {
+            stop_tid = INVALID_NUB_THREAD;
+            break;
+        }
+        stop_tid = tid;
+        stop_info = tid_stop_info;
+    }
+
+    // Breakpoint traps and single steps are both EXC_BREAKPOINT, watchpoint
+    // hits also have the data address in the second exception data word
+    bool is_trap = stop_tid != INVALID_NUB_THREAD &&
+                   stop_info.reason == eStopTypeException &&
+                   stop_info.details.exception.type == EXC_BREAKPOINT &&
+                   (stop_info.details.exception.data_count < 2 || stop_info.details.exception.data[1] == 0);
+    nub_addr_t pc = INVALID_NUB_ADDRESS;
+    if (is_trap)
+    {
+        DNBRegisterValue pc_value;
+        if (DNBThreadGetRegisterValueByID (pid, stop_tid, REGISTER_SET_GENERIC, GENERIC_REGNUM_PC, &pc_value))
+            pc = pc_value.info.size == 4 ? pc_value.value.uint32 : pc_value.value.uint64;
+    }
+
+    if (m_step_over_bp_addr != INVALID_NUB_ADDRESS)
+    {
+        // We were stepping over a breakpoint whose conditions were false,
+        // put it back and continue if that step is all that happened
+        const nub_addr_t bp_addr = m_step_over_bp_addr;
+        const nub_thread_t step_tid = m_step_over_tid;
+        m_step_over_bp_addr = INVALID_NUB_ADDRESS;
+        m_step_over_tid = INVALID_NUB_THREAD;
+        DNBBreakpointSetEnabled (pid, bp_addr, true);
+        if (is_trap && stop_tid == step_tid && pc != bp_addr && pc != INVALID_NUB_ADDRESS)
+        {
+            DNBLogThreadedIf (LOG_RNB_PROC, "RNBRemote::%s() stepped over conditional breakpoint at 0x%llx, resuming", __FUNCTION__, (uint64_t)bp_addr);
+            // If the step landed on another breakpoint it will trap right
+            // away and be handled like any other hit
+            return DNBProcessResume (pid, m_resume_actions.GetFirst(), m_resume_actions.GetSize());
+        }
+        return false;
+    }
+
+    if (!is_trap || m_breakpoint_conditions.empty())
+        return false;
+
+    BreakpointConditionsMap::const_iterator pos = m_breakpoint_conditions.find (pc);
+    if (pos == m_breakpoint_conditions.end())
+        return false;
+
+    // Only plain continues can be resumed again without changing what
+    // the debugger asked for
+    if (m_resume_actions.IsEmpty())
+        return false;
+    for (size_t i = 0; i < m_resume_actions.GetSize(); ++i)
+    {
+        const DNBThreadResumeAction &action = m_resume_actions.GetFirst()[i];
+        if (action.state != eStateRunning || action.signal != 0 || action.addr != INVALID_NUB_ADDRESS)
+            return false;
+    }
+
+    // Stop if any condition is true or can't be evaluated
+    const std::vector<AgentExpression> &conditions = pos->second;
+    for (size_t i = 0; i < conditions.size(); ++i)
+    {
+        uint64_t result = 0;
+        if (!evaluate_agent_expression (pid, stop_tid, conditions[i], result) || result != 0)
+            return false;
+    }
+
+    DNBLogThreadedIf (LOG_RNB_PROC, "RNBRemote::%s() conditions of breakpoint at 0x%llx are false, stepping over it", __FUNCTION__, (uint64_t)pc);
+    if (!DNBBreakpointSetEnabled (pid, pc, false))
+        return false;
+
+    DNBThreadResumeActions step_actions;
+    step_actions.AppendAction (stop_tid, eStateStepping);
+    step_actions.SetDefaultThreadActionIfNeeded (eStateStopped, 0);
+    if (!DNBProcessResume (pid, step_actions.GetFirst(), step_actions.GetSize()))
+    {
+        DNBBreakpointSetEnabled (pid, pc, true);
+        return false;
+    }
+    m_step_over_bp_addr = pc;
+    m_step_over_tid = stop_tid;
+    // The debugger still counts these hits, the next stop reply tells it
+    // how many there were
+    ++m_filtered_breakpoint_hits[pc];
+    return true;
+}
+
+
+//----------------------------------------------------------------------
+// Report the breakpoint hits we stepped over without stopping since the
+// last stop reply, so the debugger can add them to its hit counts:
+//  "filteredhits:100000f20,4;"
+//----------------------------------------------------------------------
+void
+RNBRemote::AppendFilteredBreakpointHits (std::ostringstream &ostrm)
+{
+    for (std::map<nub_addr_t, uint32_t>::const_iterator pos = m_filtered_breakpoint_hits.begin();
+         pos != m_filtered_breakpoint_hits.end();
+         ++pos)
+        ostrm << std::hex << "filteredhits:" << pos->first << ',' << pos->second << ';';
+    m_filtered_breakpoint_hits.clear();
+}
+
 
 /* 'A arglen,argnum,arg,...'
  Update the inferior context CTX with the program name and arg
@@ -1894,6 +2273,33 @@ RNBRemote::HandlePacket_QStartNoAckMode (const char *p)
 }
 
 
+rnb_err_t
+RNBRemote::HandlePacket_QEnableCompression (const char *p)
+{
+    StringExtractor packet(p += sizeof ("QEnableCompression:") - 1);
+    bool lz4 = false;
+    uint32_t min_size = 0;
+    std::string name;
+    std::string value;
+    while (packet.GetNameColonValue(name, value))
+    {
+        if (name.compare ("type") == 0)
+            lz4 = value.compare ("lz4") == 0;
+        else if (name.compare ("minsize") == 0)
+            min_size = strtoul (value.c_str(), NULL, 10);
+    }
+
+    // lz4 is the only codec we have
+    if (!lz4)
+        return SendPacket ("E01");
+
+    // Send the OK packet uncompressed, everything after it is compressed
+    rnb_err_t result = SendPacket ("OK");
+    m_compression_enabled = true;
+    m_compression_min_size = min_size;
+    return result;
+}
+
 rnb_err_t
 RNBRemote::HandlePacket_QSetLogging (const char *p)
 {
@@ -2274,6 +2680,31 @@ gdb_regnum_with_fixed_width_hex_register_value (std::ostream& ostrm,
     }
 }
 
+// Translate any mach exceptions to gdb versions, unless they are
+// common exceptions like a breakpoint or a soft signal.
+static int
+gdb_signal_for_stop_info (const struct DNBThreadStopInfo &tid_stop_info)
+{
+    int signum = tid_stop_info.details.signal.signo;
+    switch (tid_stop_info.details.exception.type)
+    {
+        default:                    signum = 0; break;
+        case EXC_BREAKPOINT:        signum = SIGTRAP; break;
+        case EXC_BAD_ACCESS:        signum = TARGET_EXC_BAD_ACCESS; break;
+        case EXC_BAD_INSTRUCTION:   signum = TARGET_EXC_BAD_INSTRUCTION; break;
+        case EXC_ARITHMETIC:        signum = TARGET_EXC_ARITHMETIC; break;
+        case EXC_EMULATION:         signum = TARGET_EXC_EMULATION; break;
+        case EXC_SOFTWARE:
+            if (tid_stop_info.details.exception.data_count == 2 &&
+                tid_stop_info.details.exception.data[0] == EXC_SOFT_SIGNAL)
+                signum = tid_stop_info.details.exception.data[1];
+            else
+                signum = TARGET_EXC_SOFTWARE;
+            break;
+    }
+    return signum;
+}
+
 rnb_err_t
 RNBRemote::SendStopReplyPacketForThread (nub_thread_t tid)
 {
@@ -2295,28 +2726,9 @@ RNBRemote::SendStopReplyPacketForThread (nub_thread_t tid)
         std::ostringstream ostrm;
         // Output the T packet with the thread
         ostrm << 'T';
-        int signum = tid_stop_info.details.signal.signo;
-        DNBLogThreadedIf (LOG_RNB_PROC, "%8d %s got signal signo = %u, exc_type = %u", (uint32_t)m_comm.Timer().ElapsedMicroSeconds(true), __FUNCTION__, signum, tid_stop_info.details.exception.type);
-
-        // Translate any mach exceptions to gdb versions, unless they are
-        // common exceptions like a breakpoint or a soft signal.
-        switch (tid_stop_info.details.exception.type)
-        {
-            default:                    signum = 0; break;
-            case EXC_BREAKPOINT:        signum = SIGTRAP; break;
-            case EXC_BAD_ACCESS:        signum = TARGET_EXC_BAD_ACCESS; break;
-            case EXC_BAD_INSTRUCTION:   signum = TARGET_EXC_BAD_INSTRUCTION; break;
-            case EXC_ARITHMETIC:        signum = TARGET_EXC_ARITHMETIC; break;
-            case EXC_EMULATION:         signum = TARGET_EXC_EMULATION; break;
-            case EXC_SOFTWARE:
-                if (tid_stop_info.details.exception.data_count == 2 &&
-                    tid_stop_info.details.exception.data[0] == EXC_SOFT_SIGNAL)
-                    signum = tid_stop_info.details.exception.data[1];
-                else
-                    signum = TARGET_EXC_SOFTWARE;
-                break;
-        }
+        DNBLogThreadedIf (LOG_RNB_PROC, "%8d %s got signal signo = %u, exc_type = %u", (uint32_t)m_comm.Timer().ElapsedMicroSeconds(true), __FUNCTION__, tid_stop_info.details.signal.signo, tid_stop_info.details.exception.type);
 
+        int signum = gdb_signal_for_stop_info (tid_stop_info);
         ostrm << RAWHEX8(signum & 0xff);
 
         ostrm << std::hex << "thread:" << tid << ';';
@@ -2372,6 +2784,8 @@ RNBRemote::SendStopReplyPacketForThread (nub_thread_t tid)
             }
         }
 
+        AppendFilteredBreakpointHits (ostrm);
+
         if (g_num_reg_entries == 0)
             InitializeRegisters ();
 
@@ -2475,16 +2889,21 @@ RNBRemote::HandlePacket_last_signal (const char *unused)
                 }
                 
                 const char *exit_info = DNBProcessGetExitInfo (pid);
-                if (exit_info != NULL && *exit_info != '\0')
+                if ((exit_info != NULL && *exit_info != '\0') || !m_filtered_breakpoint_hits.empty())
                 {
                     std::ostringstream exit_packet;
                     exit_packet << pid_exited_packet;
                     exit_packet << ';';
-                    exit_packet << RAW_HEXBASE << "description";
-                    exit_packet << ':';
-                    for (size_t i = 0; exit_info[i] != '\0'; i++)
-                        exit_packet << RAWHEX8(exit_info[i]);
-                    exit_packet << ';';
+                    if (exit_info != NULL && *exit_info != '\0')
+                    {
+                        exit_packet << RAW_HEXBASE << "description";
+                        exit_packet << ':';
+                        for (size_t i = 0; exit_info[i] != '\0'; i++)
+                            exit_packet << RAWHEX8(exit_info[i]);
+                        exit_packet << ';';
+                    }
+                    // Hits since the last stop still count
+                    AppendFilteredBreakpointHits (exit_packet);
                     return SendPacket (exit_packet.str());
                 }
                 else
@@ -2630,6 +3049,83 @@ RNBRemote::HandlePacket_m (const char *p)
     return SendPacket (ostrm.str ());
 }
 
+// Read multiple ranges of memory with a single packet.
+// Usage:  qMultiMemRead:ADDR,LEN;ADDR,LEN;...
+// ADDR and LEN are both base 16.
+//
+// Responds with
+//
+// COUNT,COUNT,...;DATA
+//
+// where there is a COUNT of bytes that could be read for each range, in
+// base 16, and DATA is the hex encoded bytes for all ranges in order.
+// A range that can't be read has a COUNT of zero. A request whose reply
+// could be larger than the PacketSize we advertise is rejected with E78.
+
+rnb_err_t
+RNBRemote::HandlePacket_qMultiMemRead (const char *p)
+{
+    const char *ranges = p + strlen ("qMultiMemRead:");
+    std::vector<std::pair<nub_addr_t, uint32_t> > requests;
+    // Each range costs up to 8 hex digits and a separator in the COUNT list
+    // plus two hex digits per byte of DATA.
+    uint64_t reply_size = 0;
+    while (*ranges != '\0')
+    {
+        char *c;
+        errno = 0;
+        nub_addr_t addr = strtoull (ranges, &c, 16);
+        if (errno != 0 || c == ranges || *c != ',')
+        {
+            return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Invalid address in qMultiMemRead packet");
+        }
+        ranges = c + 1;
+
+        errno = 0;
+        uint64_t length = strtoull (ranges, &c, 16);
+        if (errno != 0 || c == ranges || *c != ';')
+        {
+            return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Invalid length in qMultiMemRead packet");
+        }
+        ranges = c + 1;
+        if (length > g_max_packet_size / 2)
+        {
+            return SendPacket ("E78");
+        }
+        reply_size += 9 + 2 * length;
+        if (reply_size > g_max_packet_size)
+        {
+            return SendPacket ("E78");
+        }
+        requests.push_back (std::make_pair (addr, length));
+    }
+
+    if (requests.empty())
+    {
+        return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "No ranges in qMultiMemRead packet");
+    }
+
+    std::ostringstream counts;
+    std::ostringstream data;
+    std::string buf;
+    for (size_t i = 0; i < requests.size(); ++i)
+    {
+        nub_size_t bytes_read = 0;
+        if (requests[i].second > 0)
+        {
+            buf.resize (requests[i].second);
+            bytes_read = DNBProcessMemoryRead (m_ctx.ProcessID(), requests[i].first, buf.size(), &buf[0]);
+        }
+        if (i > 0)
+            counts << ',';
+        counts << std::hex << bytes_read;
+        for (nub_size_t j = 0; j < bytes_read; j++)
+            data << RAWHEX8(buf[j]);
+    }
+    counts << ';';
+    return SendPacket (counts.str() + data.str());
+}
+
 // Read memory, sent it up as binary data.
 // Usage:  xADDR,LEN
 // ADDR and LEN are both base 16.
@@ -3063,9 +3559,8 @@ GetProcessNameFrom_vAttach (const char *&p, std::string &attach_name)
 rnb_err_t
 RNBRemote::HandlePacket_qSupported (const char *p)
 {
-    uint32_t max_packet_size = 128 * 1024;  // 128KBytes is a reasonable max packet size--debugger can always use less
-    char buf[64];
-    snprintf (buf, sizeof(buf), "PacketSize=%x", max_packet_size);
+    char buf[256];
+    snprintf (buf, sizeof(buf), "PacketSize=%x;qMultiMemRead+;jThreadsInfo+;ConditionalBreakpoints+;SupportedCompressions=lz4", g_max_packet_size);
     return SendPacket (buf);
 }
 
@@ -3165,6 +3660,7 @@ RNBRemote::HandlePacket_v (const char *p)
         // If a default action for all other threads wasn't mentioned
         // then we should stop the threads
         thread_actions.SetDefaultThreadActionIfNeeded (eStateStopped, 0);
+        m_resume_actions = thread_actions;
         DNBProcessResume(m_ctx.ProcessID(), thread_actions.GetFirst (), thread_actions.GetSize());
         return rnb_success;
     }
@@ -3327,11 +3823,35 @@ RNBRemote::HandlePacket_z (const char *p)
                     // these calls must be ref counted.
                     bool hardware = (break_type == '1');
 
+                    // Optional ";X<len>,<hex bytes>" agent expressions, the
+                    // breakpoint only stops when one of them is true
+                    std::vector<AgentExpression> conditions;
+                    StringExtractor conditions_packet (c);
+                    while (conditions_packet.GetBytesLeft() > 0)
+                    {
+                        if (conditions_packet.GetChar() != ';' || conditions_packet.GetChar() != 'X')
+                            return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Invalid breakpoint condition in Z packet");
+                        const uint32_t condition_len = conditions_packet.GetHexMaxU32 (false, 0);
+                        if (condition_len == 0 || conditions_packet.GetChar() != ',')
+                            return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Invalid breakpoint condition length in Z packet");
+                        // Don't allocate more than the packet can actually hold
+                        if (condition_len > conditions_packet.GetBytesLeft() / 2 || condition_len > g_max_agent_expression_size)
+                            return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Breakpoint condition length in Z packet is too large");
+                        AgentExpression condition (condition_len);
+                        if (conditions_packet.GetHexBytes (&condition[0], condition_len, 0) != condition_len)
+                            return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Invalid breakpoint condition bytes in Z packet");
+                        conditions.push_back (condition);
+                    }
+
                     if (DNBBreakpointSet (pid, addr, byte_size, hardware))
                     {
                         // We successfully created a breakpoint, now lets full out
                         // a ref count structure with the breakID and add it to our
                         // map.
+                        if (conditions.empty())
+                            m_breakpoint_conditions.erase (addr);
+                        else
+                            m_breakpoint_conditions[addr].swap (conditions);
                         return SendPacket ("OK");
                     }
                     else
@@ -3378,6 +3898,7 @@ RNBRemote::HandlePacket_z (const char *p)
         {
             case '0':   // remove software breakpoint
             case '1':   // remove hardware breakpoint
+                m_breakpoint_conditions.erase (addr);
                 if (DNBBreakpointClear (pid, addr))
                 {
                     return SendPacket ("OK");
@@ -3580,6 +4101,7 @@ RNBRemote::HandlePacket_c (const char *p)
     DNBThreadResumeActions thread_actions;
     thread_actions.Append(action);
     thread_actions.SetDefaultThreadActionIfNeeded(eStateRunning, 0);
+    m_resume_actions = thread_actions;
     if (!DNBProcessResume (pid, thread_actions.GetFirst(), thread_actions.GetSize()))
         return SendPacket ("E25");
     // Don't send an "OK" packet; response is the stopped/exited message.
@@ -3819,6 +4341,7 @@ RNBRemote::HandlePacket_C (const char *p)
     thread_actions.SetDefaultThreadActionIfNeeded (eStateRunning, action.signal);
     if (!DNBProcessSignal(pid, process_signo))
         return SendPacket ("E52");
+    m_resume_actions = thread_actions;
     if (!DNBProcessResume (pid, thread_actions.GetFirst(), thread_actions.GetSize()))
         return SendPacket ("E38");
     /* Don't send an "OK" packet; response is the stopped/exited message.  */
@@ -3902,6 +4425,7 @@ RNBRemote::HandlePacket_s (const char *p)
 
     // Make all other threads stop when we are stepping
     thread_actions.SetDefaultThreadActionIfNeeded (eStateStopped, 0);
+    m_resume_actions = thread_actions;
     if (!DNBProcessResume (pid, thread_actions.GetFirst(), thread_actions.GetSize()))
         return SendPacket ("E49");
     // Don't send an "OK" packet; response is the stopped/exited message.
@@ -3952,6 +4476,7 @@ RNBRemote::HandlePacket_S (const char *p)
 
     // Make all other threads stop when we are stepping
     thread_actions.SetDefaultThreadActionIfNeeded(eStateStopped, 0);
+    m_resume_actions = thread_actions;
     if (!DNBProcessResume (pid, thread_actions.GetFirst(), thread_actions.GetSize()))
         return SendPacket ("E39");
 
@@ -4316,6 +4841,109 @@ RNBRemote::HandlePacket_jThreadExtendedInfo (const char *p)
     return SendPacket ("OK");
 }
 
+// jThreadsInfo
+//
+// Replies with a JSON array that contains a dictionary for each thread
+// in the process, with the information from the stop reply packet for
+// that thread plus the values of its PC, SP and FP registers. This lets
+// the debugger get the stop state of every thread with one packet instead
+// of sending qThreadStopInfo and p packets for each thread.
+//
+// [{"tid":4611,"signal":5,"name":"main","metype":6,"medata":[2,0],
+//   "registers":{"16":"e00c000001000000","7":"f0f8bfef5f7f0000"}},...]
+//
+// Numbers are in base 10, register numbers are the gdb register numbers
+// and register values are hex encoded bytes in target byte order.
+
+rnb_err_t
+RNBRemote::HandlePacket_jThreadsInfo (const char *p)
+{
+    if (!m_ctx.HasValidProcessID())
+        return SendPacket ("E85");
+
+    const nub_process_t pid = m_ctx.ProcessID();
+
+    if (g_num_reg_entries == 0)
+        InitializeRegisters ();
+
+    std::ostringstream json;
+    json << "[";
+    bool need_to_print_comma = false;
+    const nub_size_t numthreads = DNBProcessGetNumThreads (pid);
+    for (nub_size_t i = 0; i < numthreads; ++i)
+    {
+        nub_thread_t tid = DNBProcessGetThreadAtIndex (pid, i);
+        struct DNBThreadStopInfo tid_stop_info;
+        if (!DNBThreadGetStopReason (pid, tid, &tid_stop_info))
+            continue;
+
+        if (need_to_print_comma)
+            json << ",";
+        need_to_print_comma = true;
+
+        json << "{\"tid\":" << std::dec << tid;
+        json << ",\"signal\":" << std::dec << gdb_signal_for_stop_info (tid_stop_info);
+
+        const char *thread_name = DNBThreadGetName (pid, tid);
+        if (thread_name && thread_name[0])
+            json << ",\"name\":\"" << json_string_quote_metachars (thread_name) << "\"";
+
+        thread_identifier_info_data_t thread_ident_info;
+        if (DNBThreadGetIdentifierInfo (pid, tid, &thread_ident_info))
+        {
+            if (thread_ident_info.dispatch_qaddr != 0)
+                json << ",\"qaddr\":" << std::dec << thread_ident_info.dispatch_qaddr;
+        }
+
+        if (tid_stop_info.reason == eStopTypeExec)
+        {
+            json << ",\"reason\":\"exec\"";
+        }
+        else if (tid_stop_info.details.exception.type)
+        {
+            json << ",\"metype\":" << std::dec << tid_stop_info.details.exception.type;
+            json << ",\"medata\":[";
+            for (int j = 0; j < tid_stop_info.details.exception.data_count; ++j)
+            {
+                if (j > 0)
+                    json << ",";
+                json << std::dec << tid_stop_info.details.exception.data[j];
+            }
+            json << "]";
+        }
+
+        if (g_reg_entries != NULL)
+        {
+            json << ",\"registers\":{";
+            bool need_reg_comma = false;
+            DNBRegisterValue reg_value;
+            for (uint32_t reg = 0; reg < g_num_reg_entries; reg++)
+            {
+                const uint32_t reg_generic = g_reg_entries[reg].nub_info.reg_generic;
+                if (reg_generic != GENERIC_REGNUM_PC &&
+                    reg_generic != GENERIC_REGNUM_SP &&
+                    reg_generic != GENERIC_REGNUM_FP)
+                    continue;
+
+                if (!DNBThreadGetRegisterValueByID (pid, tid, g_reg_entries[reg].nub_info.set, g_reg_entries[reg].nub_info.reg, &reg_value))
+                    continue;
+
+                if (need_reg_comma)
+                    json << ",";
+                need_reg_comma = true;
+                json << "\"" << std::dec << g_reg_entries[reg].gdb_regnum << "\":\"";
+                register_value_in_hex_fixed_width (json, pid, tid, &g_reg_entries[reg], &reg_value);
+                json << "\"";
+            }
+            json << "}";
+        }
+        json << "}";
+    }
+    json << "]";
+
+    return SendPacket (binary_encode_string (json.str()));
+}
+
 // Note that all numeric values returned by qProcessInfo are hex encoded,
 // including the pid and the cpu type.
 
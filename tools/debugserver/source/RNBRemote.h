@@ -16,6 +16,7 @@
 
 #include "RNBDefs.h"
 #include "DNB.h"
+#include "DNBThreadResumeActions.h"
 #include "RNBContext.h"
 #include "RNBSocket.h"
 #include "PThreadMutex.h"
@@ -23,6 +24,7 @@
 #include <vector>
 #include <deque>
 #include <map>
+#include <sstream>
 
 class RNBSocket;
 class RNBContext;
@@ -100,6 +102,7 @@ public:
         query_gdb_server_version,       // 'qGDBServerVersion'
         query_process_info,             // 'qProcessInfo'
         json_query_thread_extended_info,// 'jThreadExtendedInfo'
+        json_query_threads_info,        // 'jThreadsInfo'
         pass_signals_to_inferior,       // 'QPassSignals'
         start_noack_mode,               // 'QStartNoAckMode'
         prefix_reg_packets_with_tid,    // 'QPrefixRegisterPacketsWithThreadID
@@ -117,6 +120,7 @@ public:
         set_list_threads_in_stop_reply, // 'QListThreadsInStopReply:'
         sync_thread_state,              // 'QSyncThreadState:'
         memory_region_info,             // 'qMemoryRegionInfo:'
+        read_memory_ranges,             // 'qMultiMemRead:'
         get_profile_data,               // 'qGetProfileData'
         set_enable_profiling,           // 'QSetEnableAsyncProfiling'
         watchpoint_support_info,        // 'qWatchpointSupportInfo:'
@@ -127,6 +131,7 @@ public:
         restore_register_state,         // '_G'
         speed_test,                     // 'qSpeedTest:'
         set_detach_on_error,            // 'QSetDetachOnError:'
+        enable_compression,             // 'QEnableCompression:'
         unknown_type
     } PacketEnum;
 
@@ -170,6 +175,8 @@ public:
     void            StopReadRemoteDataThread ();
 
     void NotifyThatProcessStopped (void);
+    bool ResumeIfBreakpointConditionsAreFalse (void);
+    void AppendFilteredBreakpointHits (std::ostringstream &ostrm);
 
     rnb_err_t HandlePacket_A (const char *p);
     rnb_err_t HandlePacket_H (const char *p);
@@ -184,12 +191,14 @@ public:
     rnb_err_t HandlePacket_qSyncThreadStateSupported (const char *p);
     rnb_err_t HandlePacket_qThreadInfo (const char *p);
     rnb_err_t HandlePacket_jThreadExtendedInfo (const char *p);
+    rnb_err_t HandlePacket_jThreadsInfo (const char *p);
     rnb_err_t HandlePacket_qThreadExtraInfo (const char *p);
     rnb_err_t HandlePacket_qThreadStopInfo (const char *p);
     rnb_err_t HandlePacket_qHostInfo (const char *p);
     rnb_err_t HandlePacket_qGDBServerVersion (const char *p);
     rnb_err_t HandlePacket_qProcessInfo (const char *p);
     rnb_err_t HandlePacket_QStartNoAckMode (const char *p);
+    rnb_err_t HandlePacket_QEnableCompression (const char *p);
     rnb_err_t HandlePacket_QThreadSuffixSupported (const char *p);
     rnb_err_t HandlePacket_QSetLogging (const char *p);
     rnb_err_t HandlePacket_QSetDisableASLR (const char *p);
@@ -206,6 +215,7 @@ public:
     rnb_err_t HandlePacket_QSetProcessEvent (const char *p);
     rnb_err_t HandlePacket_last_signal (const char *p);
     rnb_err_t HandlePacket_m (const char *p);
+    rnb_err_t HandlePacket_qMultiMemRead (const char *p);
     rnb_err_t HandlePacket_M (const char *p);
     rnb_err_t HandlePacket_x (const char *p);
     rnb_err_t HandlePacket_X (const char *p);
@@ -305,6 +315,7 @@ protected:
 
     rnb_err_t       GetPacket (std::string &packet_data, RNBRemote::Packet& packet_info, bool wait);
     rnb_err_t       SendPacket (const std::string &);
+    std::string     CompressPayload (const std::string &);
 
     void CreatePacketTable ();
     rnb_err_t GetPacketPayload (std::string &);
@@ -332,6 +343,19 @@ protected:
                                                                 // "$g;thread:TTTT" instead of "$g"
                                                                 // "$GVVVVVVVVVVVVVV;thread:TTTT;#00 instead of "$GVVVVVVVVVVVVVV"
     bool            m_list_threads_in_stop_reply;
+    bool            m_compression_enabled;      // Frame packets we send as "N<payload>" or "C<size>:<lz4 data>"
+    uint32_t        m_compression_min_size;     // Don't compress payloads smaller than this
+
+    // Agent expression conditions sent with Z0/Z1 packets, keyed by
+    // breakpoint address. Hits where none of them is true are stepped
+    // over and the process is resumed without telling the debugger.
+    typedef std::vector<uint8_t> AgentExpression;
+    typedef std::map<nub_addr_t, std::vector<AgentExpression> > BreakpointConditionsMap;
+    BreakpointConditionsMap m_breakpoint_conditions;
+    std::map<nub_addr_t, uint32_t> m_filtered_breakpoint_hits; // Hits we stepped over since the last stop reply, by breakpoint address
+    DNBThreadResumeActions m_resume_actions;    // The thread actions of the last resume packet
+    nub_addr_t      m_step_over_bp_addr;        // The breakpoint that is disabled while we step over it, or INVALID_NUB_ADDRESS
+    nub_thread_t    m_step_over_tid;            // The thread that steps over m_step_over_bp_addr
 };
 
 /* We translate the /usr/include/mach/exception_types.h exception types